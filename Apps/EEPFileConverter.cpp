@@ -8,13 +8,26 @@
 #include "trax/collections/TrackSystem.h"
 
 #include "appframe/CommandLine.h"
+#include "common/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
-std::string version{ "EEPFileConverter, Version: 1.13.0" };
+std::string version{ "EEPFileConverter, Version: 1.14.0" };
 
 namespace
 {
+	using Clock = std::chrono::steady_clock;
+
 	void PrintUsage()
 	{
 		std::cout << version << std::endl;
@@ -24,129 +37,375 @@ namespace
 "Allowed options:\n"
 "  -H, --help              Produces help message.\n"
 "  -V, --version           Prints the version string.\n"
-"  -I, --input <file>      Input *.anl3 or *.anl4 file, obligatory.\n"
-"  -O, --output <file>     Output *.anl4 file, obligatory.\n"
+"  -I, --input <file>      Input *.anl3 or *.anl4 file, obligatory if not\n"
+"                          in batch mode.\n"
+"  -O, --output <file>     Output *.anl4 file, obligatory. In batch mode the\n"
+"                          directory to write the converted files to.\n"
+"  -B, --batch <source>    Batch mode. Converts all *.anl3 and *.anl4 files\n"
+"                          in the directory <source> and its subdirectories,\n"
+"                          or all the files listed in the text file <source>,\n"
+"                          one per line.\n"
+"  -J, --jobs <count>      Number of threads to use for converting files and\n"
+"                          tracks. Defaults to the number of cores.\n"
 "  -P, --polygonal_chain   Convert track curves to polygonal chains.\n"
 "      --verbosity <level> Output verbosity. Options are: 'silent', 'error',\n"
 "                          'normal' (the default), 'detailed', 'verbose'.\n"
 "  -Q, --quiet             Disables all output except errors.\n"
 			<< std::endl;
 	}
-}
 
-int wmain( int argc, wchar_t* argv[] )
-{
-	try{
-		appframe::WCommandLine cmd( argc, argv );
-
-		if( cmd.Has( L"version" ) || cmd.Has( L"V" ) ){
-			std::cout << version << std::endl;
-			return 0;
-		}
+	/// Option names for the character type of the command line.
+	template<typename CharT>
+	std::basic_string<CharT> Option( const char* name )
+	{
+		return { name, name + std::strlen( name ) };
+	}
 
-		if( cmd.Has( L"help" ) || cmd.Has( L"H" ) ){
-			PrintUsage();
-			return 0;
-		}
+	std::string Display( const std::filesystem::path& path )
+	{
+		return path.u8string();
+	}
 
-		// Accept both the long and short option spellings.
-		const bool hasInput =
-			cmd.HasValue( L"input" ) || cmd.HasValue( L"I" );
+	double Milliseconds( Clock::duration duration ) noexcept
+	{
+		return std::chrono::duration<double,std::milli>( duration ).count();
+	}
 
-		// The output may be given as an option or as the first positional
-		// argument (matching the previous Boost positional behaviour).
-		const bool hasOutputOption =
-			cmd.HasValue( L"output" ) || cmd.HasValue( L"O" );
-		const bool hasOutput =
-			hasOutputOption || cmd.PositionalCount() > 0;
+	/// Calls function( idx ) for all idx in [0,count) with at most nThreads threads.
+	struct Conversion{
+		std::filesystem::path input;
+		std::filesystem::path output;
+		bool bSuccess = false;
+		int tracks = 0;
+		int failedTracks = 0;
+		Clock::duration read{};
+		Clock::duration convert{};
+		Clock::duration write{};
+		std::string log;
+	};
 
-		if( !hasInput ){
-			std::cerr << "EEPFileConverter: Input file is missing! Use --help for usage manual." << std::endl;
-			return 0;
-		}
+	/// The polygonal chains are calculated in parallel; since
+	/// attaching them changes the tracks, this is done afterwards
+	/// in one go.
+	void ConvertToPolygonalChains( trax::TrackSystem& trackSystem, unsigned int nThreads, Conversion& conversion, std::ostream& log )
+	{
+		std::vector<trax::TrackBuilder*> tracks;
+		for( auto& track : trackSystem )
+			tracks.push_back( &track );
 
-		if( !hasOutput ){
-			std::cerr << "EEPFileConverter: Output file is missing! Use --help for usage manual." << std::endl;
-			return 0;
-		}
+		std::vector<std::shared_ptr<trax::TrackBuilder>> newTracks( tracks.size() );
+		std::vector<std::string> errors( tracks.size() );
+		common::ParallelFor( tracks.size(), nThreads, [&]( std::size_t idx ){
+			try{
+				newTracks[idx] = trax::MakeParallelTrackWithPolygonalChain( *tracks[idx], tracks[idx]->Range() );
+				if( !newTracks[idx] )
+					errors[idx] = "no polygonal chain created.";
+			}
+			catch( std::exception& e ){
+				errors[idx] = e.what();
+			}
+		} );
 
-		if( cmd.HasValue( L"verbosity" ) ){
-			const std::wstring verbosity = cmd.Get( L"verbosity" );
-			if( verbosity == L"verbose" ){
-				trax::SetReportVerbosity( trax::Verbosity::verbose );
+		for( std::size_t idx = 0; idx < tracks.size(); ++idx ){
+			trax::TrackBuilder& track = *tracks[idx];
+			try{
+				if( auto& pNewTrack = newTracks[idx] ){
+					track.SetFrame( pNewTrack->GetFrame() );
+					track.Attach( pNewTrack->DetachCurve() );
+					track.Attach( pNewTrack->DetachTwist() );
+				}
 			}
-			else if( verbosity == L"detailed" ){
-				trax::SetReportVerbosity( trax::Verbosity::detailed );
+			catch( std::exception& e ){
+				errors[idx] = e.what();
 			}
-			else if( verbosity == L"error" ){
-				trax::SetReportVerbosity( trax::Verbosity::error );
+
+			if( !errors[idx].empty() ){
+				++conversion.failedTracks;
+				log << trax::Verbosity::error << "EEPFileConverter: Error: " << errors[idx] << '\n';
+				log << trax::Verbosity::error << "Could not convert track to polygonal chain. Track ID: " << track.ID() << '\n';
 			}
-			else if( verbosity == L"silent" || verbosity == L"quiet" ){
-				trax::SetReportVerbosity( trax::Verbosity::silent );
+		}
+
+		conversion.tracks = static_cast<int>(tracks.size());
+	}
+
+	void Convert( Conversion& conversion, bool bPolygonalChain, unsigned int nThreads )
+	{
+		std::ostringstream log;
+		try{
+			Clock::time_point start = Clock::now();
+			std::unique_ptr<trax::ModuleCollection> pModuleCollection = trax::AnlReaderBase{}.ReadModuleCollection( conversion.input );
+			conversion.read = Clock::now() - start;
+
+			if( pModuleCollection )
+			{
+				if( auto pModule = pModuleCollection->GetFirst() )
+				{
+					start = Clock::now();
+					if( bPolygonalChain ){
+						if( auto pTrackSystem = pModule->GetTrackSystem() )
+							ConvertToPolygonalChains( *pTrackSystem, nThreads, conversion, log );
+					}
+					conversion.convert = Clock::now() - start;
+
+					start = Clock::now();
+					if( !conversion.output.parent_path().empty() )
+						std::filesystem::create_directories( conversion.output.parent_path() );
+					trax::Write( *pModule, conversion.output );
+					conversion.write = Clock::now() - start;
+					conversion.bSuccess = true;
+				}
+				else
+					log << trax::Verbosity::error << "EEPFileConverter: No module found in file: " << Display( conversion.input ) << '\n';
 			}
+			else
+				log << trax::Verbosity::error << "EEPFileConverter: Could not read file: " << Display( conversion.input ) << '\n';
+		}
+		catch( std::exception& e ){
+			log << trax::Verbosity::error << "EEPFileConverter: error: " << e.what() << '\n';
 		}
 
-		if( cmd.Has( L"quiet" ) || cmd.Has( L"Q" ) ){
-			trax::SetReportVerbosity( trax::Verbosity::silent );
+		conversion.log = log.str();
+	}
+
+	bool IsLayoutFile( const std::filesystem::path& path )
+	{
+		std::string extension = path.extension().string();
+		std::transform( extension.begin(), extension.end(), extension.begin(), []( unsigned char c ){ return static_cast<char>(std::tolower( c )); } );
+		return extension == ".anl3" || extension == ".anl4";
+	}
+
+	/// Collects the files to convert from a directory or a list file.
+	/// The directory structure below source gets mirrored in outputDirectory.
+	std::vector<Conversion> CollectBatch( const std::filesystem::path& source, const std::filesystem::path& outputDirectory )
+	{
+		std::vector<Conversion> batch;
+		auto Add = [&batch,&outputDirectory]( const std::filesystem::path& input, const std::filesystem::path& relative ){
+			Conversion conversion;
+			conversion.input = input;
+			conversion.output = outputDirectory / relative;
+			conversion.output.replace_extension( ".anl4" );
+			batch.push_back( std::move(conversion) );
+		};
+
+		if( std::filesystem::is_directory( source ) ){
+			for( const auto& entry : std::filesystem::recursive_directory_iterator{ source } ){
+				if( entry.is_regular_file() && IsLayoutFile( entry.path() ) )
+					Add( entry.path(), std::filesystem::relative( entry.path(), source ) );
+			}
 		}
+		else{
+			std::ifstream list{ source };
+			if( !list )
+				throw std::runtime_error( "Could not open batch list: " + Display( source ) );
+
+			std::string line;
+			while( std::getline( list, line ) ){
+				line.erase( std::find_if( line.rbegin(), line.rend(), []( unsigned char c ){ return !std::isspace( c ); } ).base(), line.end() );
+				if( line.empty() || line.front() == '#' )
+					continue;
 
-		// On Windows std::wstring is the native path encoding, so construct the
-		// path directly - no quoting or code-page conversion involved.
-		const std::wstring inputValue =
-			cmd.HasValue( L"input" ) ? cmd.Get( L"input" ) : cmd.Get( L"I" );
+				std::filesystem::path input = std::filesystem::u8path( line );
+				if( input.is_relative() )
+					input = source.parent_path() / input;
 
-		const std::wstring outputValue =
-			hasOutputOption
-				? ( cmd.HasValue( L"output" ) ? cmd.Get( L"output" ) : cmd.Get( L"O" ) )
-				: cmd.Positional( 0 );
+				Add( input, input.filename() );
+			}
+		}
 
-		const std::filesystem::path inputPath { inputValue };
-		const std::filesystem::path outputPath{ outputValue };
+		std::sort( batch.begin(), batch.end(), []( const Conversion& a, const Conversion& b ){ return a.input < b.input; } );
+		return batch;
+	}
 
-		std::wcout << trax::Verbosity::normal << L"Input: "  << inputPath  << std::endl;
-		std::wcout << trax::Verbosity::normal << L"Output: " << outputPath << std::endl;
+	int RunBatch( const std::filesystem::path& source, const std::filesystem::path& outputDirectory, bool bPolygonalChain, unsigned int nThreads )
+	{
+		std::vector<Conversion> batch = CollectBatch( source, outputDirectory );
 
-		if( std::unique_ptr<trax::ModuleCollection> pModuleCollection = trax::AnlReaderBase{}.ReadModuleCollection( inputPath );
-			pModuleCollection )
-		{
-			if( auto pModule = pModuleCollection->GetFirst() )
-			{
-				if( cmd.Has( L"polygonal_chain" ) || cmd.Has( L"P" ) ){
-					if( auto pTrackSystem = pModule->GetTrackSystem() ){
-						for( auto& track : *pTrackSystem ){
-							try{
-								auto pNewTrack = trax::MakeParallelTrackWithPolygonalChain( track, track.Range() );
-								track.SetFrame( pNewTrack->GetFrame() );
-								track.Attach( pNewTrack->DetachCurve() );
-								track.Attach( pNewTrack->DetachTwist() );
-							}
-							catch( std::exception& e ){
-								std::cerr << trax::Verbosity::error  << "EEPFileConverter: Error: " << e.what() << std::endl;
-								std::cerr << trax::Verbosity::error  << "Could not convert track to polygonal chain. Track ID: " << track.ID() << std::endl;
-							}
-						}
-					}
-				}
+		std::cout << trax::Verbosity::normal << "Batch: " << Display( source ) << ", " << batch.size() << " files, " << nThreads << " threads." << std::endl;
+		std::cout << trax::Verbosity::normal << "Output: " << Display( outputDirectory ) << std::endl;
 
-				trax::Write( *pModule, outputPath );
+		// Files get converted in parallel; the threads left over if
+		// there are less files than threads go to the tracks:
+		const unsigned int nFileThreads = static_cast<unsigned int>(std::max<std::size_t>( 1, std::min<std::size_t>( batch.size(), nThreads ) ));
+		const unsigned int nTrackThreads = std::max( 1u, nThreads / nFileThreads );
+
+		std::mutex outputMutex;
+		std::atomic<int> done{ 0 };
+		const Clock::time_point start = Clock::now();
+		common::ParallelFor( batch.size(), nFileThreads, [&]( std::size_t idx ){
+			Conversion& conversion = batch[idx];
+			if( std::error_code ec; std::filesystem::equivalent( conversion.input, conversion.output, ec ) ){
+				conversion.log = "EEPFileConverter: error: output would overwrite input.\n";
 			}
 			else
-				std::wcerr << trax::Verbosity::error  << L"EEPFileConverter: No module found in file: " << inputPath << std::endl;
+				Convert( conversion, bPolygonalChain, nTrackThreads );
+
+			std::lock_guard<std::mutex> lock{ outputMutex };
+			std::cerr << conversion.log;
+			std::ostream& out = std::cout << trax::Verbosity::normal;
+			out << '[' << ++done << '/' << batch.size() << "] "
+				<< Display( conversion.input ) << (conversion.bSuccess ? "" : " FAILED")
+				<< ": read " << Milliseconds( conversion.read ) << "ms"
+				<< ", convert " << Milliseconds( conversion.convert ) << "ms"
+				<< ", write " << Milliseconds( conversion.write ) << "ms"
+				<< ", " << conversion.tracks << " tracks";
+			if( conversion.failedTracks )
+				out << " (" << conversion.failedTracks << " failed)";
+			out << std::endl;
+		} );
+		const Clock::duration wallTime = Clock::now() - start;
 
-			std::wcout << trax::Verbosity::normal << L"EEPFileConverter: file " << outputPath << L" successfully created." << std::endl;
+		int converted = 0, tracks = 0, failedTracks = 0;
+		Clock::duration read{}, convert{}, write{};
+		for( const Conversion& conversion : batch ){
+			if( conversion.bSuccess )
+				++converted;
+			tracks += conversion.tracks;
+			failedTracks += conversion.failedTracks;
+			read += conversion.read;
+			convert += conversion.convert;
+			write += conversion.write;
 		}
-	}
-	catch( std::exception& e ) {
-		std::cerr << trax::Verbosity::error << "EEPFileConverter: error: " << e.what() << std::endl;
-		return 1;
-	}
-	catch( ... ) {
-		std::cerr << trax::Verbosity::error << "EEPFileConverter: Exception of unknown type!" << std::endl;
-		return 1;
+
+		const int failed = static_cast<int>(batch.size()) - converted;
+		std::cout << trax::Verbosity::normal << "EEPFileConverter: " << converted << " files converted, " << failed << " failed, "
+			<< tracks << " tracks (" << failedTracks << " failed)." << std::endl;
+		std::ostream& out = std::cout << trax::Verbosity::normal;
+		out << "Time: " << Milliseconds( wallTime ) << "ms total, "
+			<< Milliseconds( read ) << "ms reading, " << Milliseconds( convert ) << "ms converting, " << Milliseconds( write ) << "ms writing";
+		if( wallTime > Clock::duration::zero() )
+			out << ", " << batch.size() / std::chrono::duration<double>( wallTime ).count() << " files/s";
+		out << std::endl;
+
+		if( failed )
+			for( const Conversion& conversion : batch )
+				if( !conversion.bSuccess )
+					std::cerr << trax::Verbosity::error << "Failed: " << Display( conversion.input ) << std::endl;
+
+		return failed ? 1 : 0;
 	}
 
-	return 0;
-}
+	template<typename CharT>
+	int Run( int argc, CharT* argv[] )
+	{
+		const auto O = Option<CharT>;
+
+		try{
+			appframe::BasicCommandLine<CharT> cmd( argc, argv );
+
+			if( cmd.Has( O("version") ) || cmd.Has( O("V") ) ){
+				std::cout << version << std::endl;
+				return 0;
+			}
+
+			if( cmd.Has( O("help") ) || cmd.Has( O("H") ) ){
+				PrintUsage();
+				return 0;
+			}
+
+			// Accept both the long and short option spellings.
+			const bool hasInput =
+				cmd.HasValue( O("input") ) || cmd.HasValue( O("I") );
+
+			const bool hasBatch =
+				cmd.HasValue( O("batch") ) || cmd.HasValue( O("B") );
+
+			// The output may be given as an option or as the first positional
+			// argument (matching the previous Boost positional behaviour).
+			const bool hasOutputOption =
+				cmd.HasValue( O("output") ) || cmd.HasValue( O("O") );
+			const bool hasOutput =
+				hasOutputOption || cmd.PositionalCount() > 0;
+
+			if( !hasInput && !hasBatch ){
+				std::cerr << "EEPFileConverter: Input file is missing! Use --help for usage manual." << std::endl;
+				return 0;
+			}
+
+			if( !hasOutput ){
+				std::cerr << "EEPFileConverter: Output file is missing! Use --help for usage manual." << std::endl;
+				return 0;
+			}
+
+			if( cmd.HasValue( O("verbosity") ) ){
+				const auto verbosity = cmd.Get( O("verbosity") );
+				if( verbosity == O("verbose") ){
+					trax::SetReportVerbosity( trax::Verbosity::verbose );
+				}
+				else if( verbosity == O("detailed") ){
+					trax::SetReportVerbosity( trax::Verbosity::detailed );
+				}
+				else if( verbosity == O("error") ){
+					trax::SetReportVerbosity( trax::Verbosity::error );
+				}
+				else if( verbosity == O("silent") || verbosity == O("quiet") ){
+					trax::SetReportVerbosity( trax::Verbosity::silent );
+				}
+			}
+
+			if( cmd.Has( O("quiet") ) || cmd.Has( O("Q") ) ){
+				trax::SetReportVerbosity( trax::Verbosity::silent );
+			}
+
+			const bool bPolygonalChain = cmd.Has( O("polygonal_chain") ) || cmd.Has( O("P") );
+
+			const int jobs = cmd.HasValue( O("jobs") ) ? cmd.GetInt( O("jobs") ) : cmd.GetInt( O("J"), 0 );
+			const unsigned int nThreads = jobs > 0 ? static_cast<unsigned int>(jobs) : std::max( 1u, std::thread::hardware_concurrency() );
+
+			// std::filesystem::path takes the native encoding, so construct
+			// the paths directly - no quoting or code-page conversion involved.
+			const std::filesystem::path outputPath{
+				hasOutputOption
+					? ( cmd.HasValue( O("output") ) ? cmd.Get( O("output") ) : cmd.Get( O("O") ) )
+					: cmd.Positional( 0 ) };
+
+			if( hasBatch )
+				return RunBatch(
+					std::filesystem::path{ cmd.HasValue( O("batch") ) ? cmd.Get( O("batch") ) : cmd.Get( O("B") ) },
+					outputPath,
+					bPolygonalChain,
+					nThreads );
+
+			Conversion conversion;
+			conversion.input = cmd.HasValue( O("input") ) ? cmd.Get( O("input") ) : cmd.Get( O("I") );
+			conversion.output = outputPath;
+
+			std::cout << trax::Verbosity::normal << "Input: "  << Display( conversion.input ) << std::endl;
+			std::cout << trax::Verbosity::normal << "Output: " << Display( conversion.output ) << std::endl;
 
+			Convert( conversion, bPolygonalChain, nThreads );
+			std::cerr << conversion.log;
 
+			if( conversion.bSuccess )
+				std::cout << trax::Verbosity::normal << "EEPFileConverter: file " << Display( conversion.output ) << " successfully created." << std::endl;
+			std::cout << trax::Verbosity::detailed << "Time: read " << Milliseconds( conversion.read ) << "ms"
+				<< ", convert " << Milliseconds( conversion.convert ) << "ms"
+				<< ", write " << Milliseconds( conversion.write ) << "ms" << std::endl;
 
+			if( !conversion.bSuccess )
+				return 1;
+		}
+		catch( std::exception& e ) {
+			std::cerr << trax::Verbosity::error << "EEPFileConverter: error: " << e.what() << std::endl;
+			return 1;
+		}
+		catch( ... ) {
+			std::cerr << trax::Verbosity::error << "EEPFileConverter: Exception of unknown type!" << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+}
+
+#if defined(_WIN32)
+int wmain( int argc, wchar_t* argv[] )
+{
+	return Run( argc, argv );
+}
+#else
+int main( int argc, char* argv[] )
+{
+	return Run( argc, argv );
+}
+#endif
@@ -0,0 +1,161 @@
+//	trax track library
+//	AD 2025
+//
+//  "the resolution of all the fruitless searches"
+//
+//								Peter Gabriel
+//
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace common{
+
+	/// \brief Persistent worker threads, that call a job for a range of indices.
+	///
+	/// The calling thread joins in on every batch; the indices get claimed
+	/// one by one from a shared counter, so there is no ordering between the
+	/// calls. The job must not throw.
+	class ThreadPool{
+	public:
+		/// \param numWorkers Number of worker threads besides the calling one.
+		/// If not all of them can get started, the pool does with the ones it got.
+		explicit ThreadPool( unsigned int numWorkers ){
+			m_Workers.reserve( numWorkers );
+			try{
+				for( unsigned int i = 0; i < numWorkers; ++i )
+					m_Workers.emplace_back( &ThreadPool::WorkerLoop, this );
+			}
+			catch( const std::system_error& ){
+				// Do with the threads we've got.
+			}
+		}
+
+		ThreadPool( const ThreadPool& ) = delete;
+		ThreadPool& operator=( const ThreadPool& ) = delete;
+
+		~ThreadPool(){
+			{
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				m_bQuit = true;
+			}
+			m_WorkAvailable.notify_all();
+
+			for( std::thread& worker : m_Workers )
+				worker.join();
+		}
+
+
+		/// \returns The number of worker threads actually running.
+		unsigned int Workers() const noexcept{
+			return static_cast<unsigned int>(m_Workers.size());
+		}
+
+
+		/// \brief Calls job( idx ) for every idx in [0,count) and returns if all are done.
+		void Run( std::size_t count, const std::function<void(std::size_t)>& job ){
+			if( m_Workers.empty() ){
+				for( std::size_t idx = 0; idx < count; ++idx )
+					job( idx );
+				return;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				m_pJob = &job;
+				m_Count = count;
+				m_Next = 0;
+				m_Busy = m_Workers.size();
+				++m_Batch;
+			}
+			m_WorkAvailable.notify_all();
+
+			Work();
+
+			std::unique_lock<std::mutex> lock{ m_Mutex };
+			m_WorkDone.wait( lock, [this]{ return m_Busy == 0; } );
+			m_pJob = nullptr;
+		}
+	private:
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::condition_variable m_WorkDone;
+		const std::function<void(std::size_t)>* m_pJob = nullptr;
+		std::size_t m_Count = 0;
+		std::atomic<std::size_t> m_Next{ 0 };
+		std::size_t m_Busy = 0;
+		std::uint64_t m_Batch = 0;
+		bool m_bQuit = false;
+
+		void Work(){
+			for( std::size_t idx = m_Next++; idx < m_Count; idx = m_Next++ )
+				(*m_pJob)( idx );
+		}
+
+		void WorkerLoop(){
+			std::uint64_t batch = 0;
+			for(;;){
+				{
+					std::unique_lock<std::mutex> lock{ m_Mutex };
+					m_WorkAvailable.wait( lock, [this,batch]{ return m_bQuit || m_Batch != batch; } );
+					if( m_bQuit )
+						return;
+					batch = m_Batch;
+				}
+
+				Work();
+
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				if( --m_Busy == 0 )
+					m_WorkDone.notify_one();
+			}
+		}
+	};
+
+
+	/// \brief Calls function( idx ) for every idx in [0,count) on up to
+	/// nThreads threads, the calling one included.
+	///
+	/// The function must not throw.
+	template<typename Function>
+	void ParallelFor( std::size_t count, unsigned int nThreads, Function&& function ){
+		const std::size_t nUsed = std::min<std::size_t>( count, nThreads );
+		if( nUsed <= 1 ){
+			for( std::size_t idx = 0; idx < count; ++idx )
+				function( idx );
+			return;
+		}
+
+		ThreadPool pool{ static_cast<unsigned int>(nUsed - 1) };
+		pool.Run( count, std::function<void(std::size_t)>{ std::ref(function) } );
+	}
+}
@@ -54,6 +54,51 @@ namespace common{
 	inline std::string ReadPureAlphaToken( std::istream& is );
 
 
+	/// \brief Read only stream buffer on a contiguous range of memory.
+	///
+	/// The memory does not get copied and has to outlive the buffer.
+	class MemoryStreamBuffer : public std::streambuf{
+	public:
+		MemoryStreamBuffer( const char* bufferStart, const char* bufferEnd ) noexcept{
+			char* pStart = const_cast<char*>(bufferStart);
+			setg( pStart, pStart, const_cast<char*>(bufferEnd) );
+		}
+	protected:
+		pos_type seekoff( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in ) override{
+			if( !(which & std::ios_base::in) )
+				return pos_type(off_type(-1));
+
+			char* pPos = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+			if( off < eback() - pPos || off > egptr() - pPos )
+				return pos_type(off_type(-1));
+
+			setg( eback(), pPos + off, egptr() );
+			return pos_type(gptr() - eback());
+		}
+
+		pos_type seekpos( pos_type pos, std::ios_base::openmode which = std::ios_base::in ) override{
+			return seekoff( off_type(pos), std::ios_base::beg, which );
+		}
+	};
+
+
+	/// \brief Input stream on a contiguous range of memory.
+	///
+	/// Other than std::istringstream this reads the memory in place, without
+	/// copying it. The memory has to outlive the stream.
+	class MemoryInStream : private MemoryStreamBuffer, public std::istream{
+	public:
+		MemoryInStream( const char* bufferStart, const char* bufferEnd )
+			: MemoryStreamBuffer{ bufferStart, bufferEnd },
+			std::istream{ static_cast<MemoryStreamBuffer*>(this) }
+		{}
+
+		MemoryInStream( const unsigned char* bufferStart, const unsigned char* bufferEnd )
+			: MemoryInStream{ reinterpret_cast<const char*>(bufferStart), reinterpret_cast<const char*>(bufferEnd) }
+		{}
+	};
+
+
 template<typename Valtype> inline
 std::ostream& operator << ( std::ostream& os, const common::Interval<Valtype>& i ){
 	os << "Interval( " << i.Near() << ", " << i.Far() << " )";
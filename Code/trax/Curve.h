@@ -287,6 +287,46 @@ namespace trax
 		virtual void Transition( Length s, spat::Frame<Length,One>& frame ) const = 0;
 
 
+		///	\brief Copies the 3D TBN-Frame, the curvature and the torsion at the specified location.
+		///
+		/// Gives the same results as calling Transition( s, frame ), Curvature( s ) and 
+		/// Torsion( s ), but lets curves share the intermediate results of the evaluation.
+		/// \param s Arc length parameter along the curve
+		///	\param frame TBN-Frame on curve at parameter s
+		///	\param curvature Receives the curvature of the curve at parameter s.
+		///	\param torsion Receives the torsion of the curve at parameter s.
+		/// \throws std::out_of_range if s is not in the valid range of the curve.
+		virtual void Transition( Length s, spat::Frame<Length,One>& frame, AnglePerLength& curvature, AnglePerLength& torsion ) const{
+			Transition( s, frame );
+			curvature = Curvature( s );
+			torsion = Torsion( s );
+		}
+
+
+		/// \name Batch Transition
+		///	\brief Copies the 3D Positions or TBN-Frames for a whole range of parameters.
+		///
+		/// The default implementations evaluate the parameters one by one; curve
+		/// types with cheap closed forms override them with tight loops, so that 
+		/// there is only one virtual dispatch per batch.
+		/// \param sBegin Pointer to the first arc length parameter along the curve.
+		/// \param sEnd Pointer behind the last arc length parameter.
+		///	\param pos Array with at least sEnd - sBegin elements to receive the positions.
+		///	\param frame Array with at least sEnd - sBegin elements to receive the frames.
+		/// \throws std::out_of_range if a parameter is not in the valid range of the curve.
+		///@{
+		virtual void Transition( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const{
+			for( ; sBegin != sEnd; ++sBegin, ++pos )
+				Transition( *sBegin, *pos );
+		}
+
+		virtual void Transition( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const{
+			for( ; sBegin != sEnd; ++sBegin, ++frame )
+				Transition( *sBegin, *frame );
+		}
+		///@}
+
+
 		/// \brief Returns a list of parameters at which the normal vector
 		/// flips from one side to the other.
 		///
@@ -1154,6 +1194,36 @@ namespace trax
 		virtual common::Interval<Length> Shorten( common::Interval<Length> toRange ) = 0;
 
 
+		/// \name Arc Length Parametrization
+		/// \brief The curve maps arc length to its internal parameter by a table 
+		/// sampled every meter. 
+		///
+		/// By default the table gets integrated roughly and interpolated linearly. With 
+		/// high accuracy switched on, the table gets computed precisely and a monotone 
+		/// cubic Hermite interpolation is used, that takes the exact derivatives at the 
+		/// samples into account. This needs a second table and is slightly more expensive 
+		/// to evaluate, but its error is magnitudes smaller. The setting survives Create() 
+		/// and gets copied by Clone().
+		///@{
+		
+		/// \brief Switches the high accuracy mode on or off.
+		///
+		/// Since the length of the curve gets calculated more precisely, it might 
+		/// change slightly, so switch prior to attaching the curve to a track.
+		/// \returns The new total curve range.
+		virtual common::Interval<Length> HighAccuracyParametrization( bool bHighAccuracy ) = 0;
+
+
+		/// \returns true if the high accuracy mode is switched on.
+		virtual bool HighAccuracyParametrization() const noexcept = 0;
+
+
+		/// \returns The maximum deviation in arc length of the parametrization,
+		/// measured at the centers of the sample intervals.
+		virtual Length ParametrizationError() const = 0;
+		///@}
+
+
 		/// \brief Retrieves the data to construct this curve type. A roundtrip 
 		/// is guaranteed to be invariant.
 		virtual const Data& GetData() const noexcept = 0;
@@ -1383,6 +1453,18 @@ namespace trax
 		virtual common::Interval<Length> Shorten( common::Interval<Length> toRange ) = 0;
 
 
+		/// \name Arc Length Parametrization
+		/// \brief Same as for Cubic.
+		/// \see Cubic::HighAccuracyParametrization
+		///@{
+		virtual common::Interval<Length> HighAccuracyParametrization( bool bHighAccuracy ) = 0;
+
+		virtual bool HighAccuracyParametrization() const noexcept = 0;
+
+		virtual Length ParametrizationError() const = 0;
+		///@}
+
+
 		/// \brief Retrieves the data to construct this curve type. A roundtrip 
 		/// is guaranteed to be invariant.
 		virtual const Data& GetData() const noexcept = 0;
@@ -34,6 +34,7 @@
 #include "dim/support/DimSupportStream.h"
 #include "spat/Matrix.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -100,34 +101,9 @@ namespace trax{
 			return sqrt(k2(D1,D2,D1D1));
 		}
 
-		AnglePerLength Torsion( Length s ) const override
-		// Bronstein 1991 4.3.2.2.
-		{
+		AnglePerLength Torsion( Length s ) const override{
 			const Real ts = t(s);
-			Vector<Length> D1 = f.D1( ts );
-			Vector<Length> D2 = f.D2( ts );
-			Vector<Length> D3 = f.D3( ts );
-
-			const auto D1D1 = D1*D1;
-			const auto k2_ = k2(D1,D2,D1D1);
-			if( k2_.Units() ){
-				SquareMatrix<Length,3> m;
-				m(0,0) = D1.dx;
-				m(1,0) = D1.dy;
-				m(2,0) = D1.dz;
-
-				m(0,1) = D2.dx;
-				m(1,1) = D2.dy;
-				m(2,1) = D2.dz;
-
-				m(0,2) = D3.dx;
-				m(1,2) = D3.dy;
-				m(2,2) = D3.dz;
-
-				return Determinant( m ) / (k2_ * pow<3>(D1D1)); //Why is that?
-			}
-
-			return 0_1Im;
+			return TorsionAt( f.D1( ts ), f.D2( ts ), f.D3( ts ) );
 		}
 
 		void Transition( Length s, Position<Length>& pos ) const override{
@@ -154,55 +130,34 @@ namespace trax{
 		}
 
 		void Transition( Length s, VectorBundle2<Length,One>& bundle ) const override{
-			Real ts = t(s);
-			Vector<One> D1{ f.D1(ts) / Length{1} }, D2{ f.D2(ts) / Length{1} };
-
-			bundle.P = f.P( ts );
-			if( D1 == Null<One> )
-			// If D1 is zero, T = D1/|D1| is undefined, but we can define T then to be 
-			// the direction of D2, since this is the direction D1 will have in the 
-			// following point.
-			{
-				bundle.T = f.D2( t(s) ) / Length{1};
-				if( ts == 1.f )
-					// since there is no following point, we have
-					//to take the direction at the previous one.
-					bundle.T *= -1;
+			const Real ts = t(s);
+			BundleAt( ts, f.D1( ts ), f.D2( ts ), bundle );
+		}
 
-				bundle.T.Normalize();
-				bundle.N = Null<One>; // trigger calculations below...
-			}
-			else{
-				bundle.T = D1;
-				bundle.T.Normalize();
-				bundle.N = D2 - (D1*D2)/(D1*D1) * D1;
-			}
+		void Transition( Length s, Frame<Length,One>& frame ) const override{
+			Transition( s, reinterpret_cast<VectorBundle2<Length,One>&>(frame) );
+			frame.B = frame.T % frame.N;
+		}
 
-			if( bundle.N.Length() < (1.0f + D2.Length()) * 10 * epsilon )
-			// If N is quite small we try to derive it from a
-			// neighbouring point. If this doesn't work, use Up.
-			{
-				ts += (ts >= 100*epsilon ? -100*epsilon : +100*epsilon);
-				D1 = f.D1(ts) / Length{1};
-				D2 = f.D2(ts) / Length{1};
-				
-				if( D1 == Null<One> )
-					bundle.N = D2;
-				else
-					bundle.N = D2 - (D1*D2)/(D1*D1) * D1;
+		void Transition( Length s, Frame<Length,One>& frame, AnglePerLength& curvature, AnglePerLength& torsion ) const override{
+			const Real ts = t(s);
+			const Vector<Length> D1 = f.D1( ts );
+			const Vector<Length> D2 = f.D2( ts );
 
-				if( bundle.N.Length() < (1.0f + D2.Length()) * 10 * epsilon )
-					bundle.N = Up % bundle.T;
-			}
+			BundleAt( ts, D1, D2, reinterpret_cast<VectorBundle2<Length,One>&>(frame) );
+			frame.B = frame.T % frame.N;
+			curvature = sqrt(k2(D1,D2,D1*D1));
+			torsion = TorsionAt( D1, D2, f.D3( ts ) );
+		}
 
-			bundle.N = bundle.N - (bundle.N * bundle.T) * bundle.T;
-			bundle.N.Normalize();
-			assert( abs(bundle.T * bundle.N) < 10 * epsilon );
+		void Transition( const Length* sBegin, const Length* sEnd, Position<Length>* pos ) const override{
+			for( ; sBegin != sEnd; ++sBegin, ++pos )
+				Curve_Imp::Transition( *sBegin, *pos );
 		}
 
-		void Transition( Length s, Frame<Length,One>& frame ) const override{
-			Transition( s, reinterpret_cast<VectorBundle2<Length,One>&>(frame) );
-			frame.B = frame.T % frame.N;
+		void Transition( const Length* sBegin, const Length* sEnd, Frame<Length,One>* frame ) const override{
+			for( ; sBegin != sEnd; ++sBegin, ++frame )
+				Curve_Imp::Transition( *sBegin, *frame );
 		}
 
 		std::vector<Length> ZeroSet() const override{
@@ -308,6 +263,10 @@ namespace trax{
 			assert( ds > 0_m );
 			assert( dtMax > One{0} );
 
+			if( m_bHighAccuracy )
+				return SampleAccurately();
+
+			m_Slopes.clear();
 			m_Samples.clear();
 			m_Samples.reserve( static_cast<std::size_t>(std::ceil(10_m/ds)) + 1 );
 			One t = 0;
@@ -347,6 +306,71 @@ namespace trax{
 			return {0_m,L};
 		}
 
+		/// Instead of the Euler integration above, the samples get placed by solving
+		/// ArcLength( t(i*ds), t((i+1)*ds) ) == ds with a Gauss-Legendre quadrature 
+		/// and a safeguarded Newton iteration. Together with the derivatives 
+		/// dt/ds = 1/|D1| at the samples, t(s) then gets interpolated by monotone 
+		/// cubic Hermite polynomials, which makes the error drop from O(ds²) to O(ds⁴).
+		common::Interval<Length> SampleAccurately(){
+			m_Samples.clear();
+			m_Samples.reserve( static_cast<std::size_t>(std::ceil(10_m/ds)) + 1 );
+			m_Samples.push_back( 0 );
+
+			Length rest = ArcLength( 0, 1 );
+			while( rest > ds ){
+				m_Samples.push_back( Advance( m_Samples.back(), ds ) );
+				rest = ArcLength( m_Samples.back(), 1 );
+			}
+
+			if( rest < epsilon__length && m_Samples.size() > 1 )
+			// merge a tiny rest into the last interval:
+			{
+				m_Samples.pop_back();
+				rest += ds;
+			}
+
+			m_Samples.push_back( One{1} );
+			m_Samples.shrink_to_fit();
+
+			dsLast = rest;
+			L = (narrow_cast<Real>(m_Samples.size()) - 2) * ds + dsLast;
+
+			SampleSlopes();
+			return {0_m,L};
+		}
+
+		/// \brief Switches between the default and a high accuracy arc length 
+		/// parametrization. 
+		/// \returns The new parameter range of the curve.
+		common::Interval<Length> HighAccuracy( bool bHighAccuracy ){
+			m_bHighAccuracy = bHighAccuracy;
+			return f.IsValid() ? Sample() : common::Interval<Length>{0_m,0_m};
+		}
+
+		bool HighAccuracy() const noexcept{
+			return m_bHighAccuracy;
+		}
+
+		/// \brief Measures the error of the t(s) interpolation.
+		///
+		/// At the center of each sample interval the arc length to the interpolated 
+		/// parameter gets integrated (Gauss-Legendre) and compared to the requested 
+		/// arc length. 
+		/// \returns The maximum deviation in arc length.
+		Length ArcLengthError() const{
+			Length maxError = 0_m;
+			for( std::size_t i = 0; i+1 < m_Samples.size(); ++i ){
+				const Length h = SampleLength( i );
+				const Length sCenter = narrow_cast<Real>(i)*ds + h/2;
+				if( sCenter >= L )
+					break;
+
+				maxError = std::max( maxError, abs(ArcLength( m_Samples[i], t(sCenter) ) - h/2) );
+			}
+
+			return maxError;
+		}
+
 		/// Parameter from arc length function to evaluate f.
 		One t( Length s ) const noexcept{
 			if( s <= 0_m ) return 0;
@@ -359,6 +383,9 @@ namespace trax{
 			if( i+1 == m_Samples.size()-1 )// the last sample does correspond not to ds but to dsLast
 				fraction = fraction * ds / dsLast;
 
+			if( m_bHighAccuracy )
+				return Hermite( i, fraction );
+
 			return (1.f - fraction) * m_Samples[i] + fraction * m_Samples[i+1];
 		}
 
@@ -373,7 +400,22 @@ namespace trax{
 				t >= m_Samples[middle] ? r.Near( middle ) : r.Far( middle );
 			}
 
-			return r.Near() * ds + (t - m_Samples[r.Near()]) / (m_Samples[r.Far()] - m_Samples[r.Near()]) * (r.Near() == narrow_cast<int>(m_Samples.size())-2 ? dsLast : ds);
+			const std::size_t i = static_cast<std::size_t>(r.Near());
+			Real u = (t - m_Samples[i]) / (m_Samples[i+1] - m_Samples[i]);
+
+			if( m_bHighAccuracy )
+			// Newton iterations on the Hermite polynomial, starting from the linear guess:
+			{
+				for( int iteration = 0; iteration < 3; ++iteration ){
+					const Real dHdu = HermiteD1( i, u );
+					if( dHdu <= 0 )
+						break;
+
+					u = std::clamp( u - _1(Hermite( i, u ) - t) / dHdu, Real{0}, Real{1} );
+				}
+			}
+
+			return r.Near() * ds + u * SampleLength( i );
 		}
 
 		bool CheckSamples() const noexcept{
@@ -393,6 +435,95 @@ namespace trax{
 		const One dtMin = 1.0f/10000;			// min integrator step
 		std::vector<One> m_Samples;				// samples of t(i*ds)
 		Length dsLast{0};						// length of the last sample. L = n*ds + dsLast with n = m_Samples.size() - 2
+		bool m_bHighAccuracy = false;			// use Hermite interpolation for t(s)
+		std::vector<AnglePerLength> m_Slopes;	// dt/ds at the samples; only with m_bHighAccuracy
+
+
+		inline Length SampleLength( std::size_t i ) const noexcept{
+			return i+2 == m_Samples.size() ? dsLast : ds;
+		}
+
+		// Cubic Hermite polynomial on sample interval i:
+		inline One Hermite( std::size_t i, Real u ) const noexcept{
+			const Real u2 = u*u;
+			const Real u3 = u2*u;
+			const Length h = SampleLength( i );
+
+			return	(2*u3 - 3*u2 + 1) * m_Samples[i] + 
+					(u3 - 2*u2 + u) * _1(h * m_Slopes[i]) + 
+					(3*u2 - 2*u3) * m_Samples[i+1] + 
+					(u3 - u2) * _1(h * m_Slopes[i+1]);
+		}
+
+		inline Real HermiteD1( std::size_t i, Real u ) const noexcept{
+			const Real u2 = u*u;
+			const Length h = SampleLength( i );
+
+			return	(6*u2 - 6*u) * (m_Samples[i] - m_Samples[i+1]) + 
+					(3*u2 - 4*u + 1) * _1(h * m_Slopes[i]) + 
+					(3*u2 - 2*u) * _1(h * m_Slopes[i+1]);
+		}
+
+		// The slopes are the exact dt/ds at the samples, limited after
+		// Fritsch and Carlson to keep the interpolation monotone.
+		void SampleSlopes(){
+			m_Slopes.resize( m_Samples.size() );
+			for( std::size_t i = 0; i < m_Samples.size(); ++i ){
+				const Length D1 = f.D1( m_Samples[i] ).Length();
+				m_Slopes[i] = D1 > 0_m ? 1 / D1 : std::numeric_limits<AnglePerLength>::max();
+			}
+
+			for( std::size_t i = 0; i+1 < m_Samples.size(); ++i ){
+				const AnglePerLength delta = (m_Samples[i+1] - m_Samples[i]) / SampleLength( i );
+				if( delta <= 0_1Im ){
+					m_Slopes[i] = m_Slopes[i+1] = 0_1Im;
+					continue;
+				}
+
+				const One alpha = std::min( m_Slopes[i] / delta, One{3} );
+				const One beta = std::min( m_Slopes[i+1] / delta, One{3} );
+				const One tau = std::min( One{3 / std::sqrt( alpha*alpha + beta*beta )}, One{1} );
+				m_Slopes[i] = tau * alpha * delta;
+				m_Slopes[i+1] = tau * beta * delta;
+			}
+		}
+
+		// Finds t with ArcLength( t0, t ) == length.
+		One Advance( One t0, Length length ) const{
+			One lo = t0, hi = 1;
+			const Length speed0 = f.D1( t0 ).Length();
+			One t = speed0 > 0_m ? t0 + length / speed0 : (lo + hi) / 2;
+			if( !(t > lo && t < hi) )
+				t = (lo + hi) / 2;
+
+			for( int iteration = 0; iteration < 30; ++iteration ){
+				const Length error = ArcLength( t0, t ) - length;
+				if( abs(error) < 1e-3f * epsilon__length )
+					break;
+
+				error > 0_m ? hi = t : lo = t;
+				const Length speed = f.D1( t ).Length();
+				One tNext = speed > 0_m ? t - error / speed : (lo + hi) / 2;
+				if( !(tNext > lo && tNext < hi) )
+					tNext = (lo + hi) / 2;
+
+				t = tNext;
+			}
+
+			return t;
+		}
+
+		// Five point Gauss-Legendre quadrature of |D1| between t0 and t1.
+		Length ArcLength( One t0, One t1 ) const{
+			constexpr Real x[] = { 0, -0.5384693101056831f, +0.5384693101056831f, -0.9061798459386640f, +0.9061798459386640f };
+			constexpr Real w[] = { 0.5688888888888889f, 0.4786286704993665f, 0.4786286704993665f, 0.2369268850561891f, 0.2369268850561891f };
+
+			Length retval = 0_m;
+			for( int i = 0; i < 5; ++i )
+				retval += w[i] * f.D1( (t0 + t1)/2 + x[i] * (t1 - t0)/2 ).Length();
+
+			return retval * (t1 - t0) / 2;
+		}
 
 
 		Length CloseInOnCurvatureZero( Length s1, const Vector<One>& N1, Length s2, const Vector<One>& N2 ) const{
@@ -411,6 +542,77 @@ namespace trax{
 			return s;
 		}
 
+		AnglePerLength TorsionAt( const Vector<Length>& D1, const Vector<Length>& D2, const Vector<Length>& D3 ) const
+		// Bronstein 1991 4.3.2.2.
+		{
+			const auto D1D1 = D1*D1;
+			const auto k2_ = k2(D1,D2,D1D1);
+			if( k2_.Units() ){
+				SquareMatrix<Length,3> m;
+				m(0,0) = D1.dx;
+				m(1,0) = D1.dy;
+				m(2,0) = D1.dz;
+
+				m(0,1) = D2.dx;
+				m(1,1) = D2.dy;
+				m(2,1) = D2.dz;
+
+				m(0,2) = D3.dx;
+				m(1,2) = D3.dy;
+				m(2,2) = D3.dz;
+
+				return Determinant( m ) / (k2_ * pow<3>(D1D1)); //Why is that?
+			}
+
+			return 0_1Im;
+		}
+
+		void BundleAt( Real ts, const Vector<Length>& D1_, const Vector<Length>& D2_, VectorBundle2<Length,One>& bundle ) const{
+			Vector<One> D1{ D1_ / Length{1} }, D2{ D2_ / Length{1} };
+
+			bundle.P = f.P( ts );
+			if( D1 == Null<One> )
+			// If D1 is zero, T = D1/|D1| is undefined, but we can define T then to be 
+			// the direction of D2, since this is the direction D1 will have in the 
+			// following point.
+			{
+				bundle.T = D2;
+				if( ts == 1.f )
+					// since there is no following point, we have
+					//to take the direction at the previous one.
+					bundle.T *= -1;
+
+				bundle.T.Normalize();
+				bundle.N = Null<One>; // trigger calculations below...
+			}
+			else{
+				bundle.T = D1;
+				bundle.T.Normalize();
+				bundle.N = D2 - (D1*D2)/(D1*D1) * D1;
+			}
+
+			if( bundle.N.Length() < (1.0f + D2.Length()) * 10 * epsilon )
+			// If N is quite small we try to derive it from a
+			// neighbouring point. If this doesn't work, use Up.
+			{
+				ts += (ts >= 100*epsilon ? -100*epsilon : +100*epsilon);
+				D1 = f.D1(ts) / Length{1};
+				D2 = f.D2(ts) / Length{1};
+				
+				if( D1 == Null<One> )
+					bundle.N = D2;
+				else
+					bundle.N = D2 - (D1*D2)/(D1*D1) * D1;
+
+				if( bundle.N.Length() < (1.0f + D2.Length()) * 10 * epsilon )
+					bundle.N = Up % bundle.T;
+			}
+
+			bundle.N = bundle.N - (bundle.N * bundle.T) * bundle.T;
+			bundle.N.Normalize();
+			assert( abs(bundle.T * bundle.N) < 10 * epsilon );
+		}
+
 		inline Value<Dimension<-2,0,0>> k2( const Vector<Length>& D1, const Vector<Length>& D2, Area D1D1 ) const{
 			if( D1D1 == 0_m2 ) return Value<Dimension<-2,0,0>>{0};
 			const Value<Dimension<-2,0,0>> k2{ std::max( (D2*D2 - (pow<2>(D1*D2)/D1D1))/D1D1/D1D1, 0_1Im2 ) };
@@ -447,6 +649,11 @@ namespace trax{
 			bundle.N = N( bundle.T, DTds( s ) );
 		}
 
+		void Transition( Length s, Frame<Length,One>& frame, AnglePerLength& curvature, AnglePerLength& torsion ) const override{
+			// Curvature and torsion are interpolated differently here, so don't use the Curve_Imp shortcut.
+			Base::Transition( s, frame, curvature, torsion );
+		}
+
 		using Curve_Imp<Function,Base>::Range;
 		using Curve_Imp<Function,Base>::GetData;
 	protected:
@@ -566,6 +773,16 @@ namespace trax{
 			frame.B = frame.T % frame.N;
 		}
 
+		void Transition( const Length* sBegin, const Length* sEnd, Position<Length>* pos ) const override{
+			for( ; sBegin != sEnd; ++sBegin, ++pos )
+				CurveArcLength_Imp::Transition( *sBegin, *pos );
+		}
+
+		void Transition( const Length* sBegin, const Length* sEnd, Frame<Length,One>* frame ) const override{
+			for( ; sBegin != sEnd; ++sBegin, ++frame )
+				CurveArcLength_Imp::Transition( *sBegin, *frame );
+		}
+
 		std::vector<Length> ZeroSet() const override{
 			if( !IsValid() )
 				throw std::runtime_error( "This curve has to be created prior to receiving the zero set." );
@@ -28,10 +28,13 @@
 
 #include "trax/ObjectID.h"
 #include "trax/Units.h"
+#include "trax/collections/Collection.h"
 
+#include <algorithm>
 #include <stack>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "spat/Frame.h"
 
@@ -94,7 +97,7 @@ namespace trax{
 	template<class TraxType, class Base>
 	class Container_Imp : public Base{
 	public:
-		Container_Imp() noexcept;
+		explicit Container_Imp( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 		using Base::Add;
 		using Base::Remove;
@@ -163,18 +166,82 @@ namespace trax{
 		void SetDecorator( Base* pDecorator ) noexcept override; // has to derive immediatley from the collection interface
 		Base* Decorator() const noexcept{ return m_pDecorator; }
 
+		// Calls function with the std::shared_ptr of every element in order of ids:
+		template<typename Function>
+		void ForEach( Function function ) const{
+			if( m_bDense )
+				std::for_each( m_Dense.begin(), m_Dense.end(), function );
+			else
+				for( const auto& pair : m_Container )
+					function( pair.second );
+		}
+
+		// Only used with CollectionStorage::tree:
 		using ContainerType = std::map<IDType,std::shared_ptr<TraxType>>;
 		ContainerType m_Container;
 	private:
 		Base* m_pDecorator;
 
+		// CollectionStorage::dense; the elements ordered by id and 
+		// their indices into m_Dense by id, -1 for free ids:
+		bool m_bDense;
+		std::vector<std::shared_ptr<TraxType>> m_Dense;
+		std::vector<int> m_Slots;
+
+		// Ids up to this many beyond twice the element count still 
+		// get stored dense:
+		static constexpr std::size_t sm_DenseSlack = 1024;
+
+		bool FitsDense( IDType::Type maxID, std::size_t count ) const noexcept{
+			return maxID <= 2 * count + sm_DenseSlack;
+		}
+
+		// Moves the elements to m_Container for good, if the ids got too 
+		// sparse for the slot table:
+		void FallBackToTree();
+
+		int Slot( IDType id ) const noexcept{
+			return id.GetID() < m_Slots.size() ? m_Slots[id.GetID()] : -1;
+		}
+
+		void Reindex( std::size_t from ) noexcept{
+			for( std::size_t idx = from; idx < m_Dense.size(); ++idx )
+				m_Slots[m_Dense[idx]->ID().GetID()] = static_cast<int>(idx);
+		}
+
+		void Insert( std::shared_ptr<TraxType> pTraxType );
+
+		bool Erase( IDType id ) noexcept;
+
 		bool IsFree( IDType id ) const noexcept{
+			if( m_bDense )
+				return Slot( id ) < 0;
+
 			return m_Container.find( id ) == m_Container.end();
 		}
 
 		std::stack<IDType> m_ActiveStack;
 
 		IDType GetFree() const noexcept{
+			if( m_bDense ){
+				// The ids are ordered and unique, so the first gap in the id 
+				// range is where an id stops to equal its index plus one:
+				std::size_t lower = 0, upper = m_Dense.size();
+				while( lower < upper ){
+					const std::size_t middle = (lower + upper) / 2;
+					if( m_Dense[middle]->ID().GetID() == middle + 1 )
+						lower = middle + 1;
+					else
+						upper = middle;
+				}
+
+				return static_cast<IDType::Type>(lower + 1);
+			}
+
+			// Without any gaps the ids run from 1 to the element count:
+			if( m_Container.empty() || m_Container.rbegin()->first.GetID() == m_Container.size() )
+				return static_cast<IDType::Type>(m_Container.size() + 1);
+
 			IDType x = 1;
 			for( auto citer = m_Container.begin();
 				citer != m_Container.end(); ++x, ++citer )
@@ -193,8 +260,9 @@ namespace trax{
 // inlines:
 ///////////////////////////////////////
 template<class TraxType, class Base>
-inline Container_Imp<TraxType, Base>::Container_Imp() noexcept
-	:	Base{}
+inline Container_Imp<TraxType, Base>::Container_Imp( CollectionStorage storage ) noexcept
+	:	Base{},
+		m_bDense{ storage == CollectionStorage::dense }
 {
 	SetDecorator( this );
 }
@@ -222,7 +290,7 @@ IDType Container_Imp<TraxType,Base>::Add( std::shared_ptr<TraxType> pTraxType ){
 	else
 		pTraxType->ID( GetFree() );
 
-	m_Container.insert( std::make_pair( pTraxType->ID(), pTraxType ) );
+	Insert( pTraxType );
 	Decorator()->PushActive(pTraxType->ID());
 
 	return pTraxType->ID();
@@ -256,18 +324,74 @@ bool Container_Imp<TraxType,Base>::Remove( TraxType* pTraxType, bool zeroIDs ){
 		if( zeroIDs ){
 			const IDType id = pTraxType->ID();
 			pTraxType->ID( 0 );
-			if( m_Container.erase( id ) > 0 )
+			if( Erase( id ) )
 				return true; // the object might be deleted here
 			else
 				pTraxType->ID( id );
 		}
 		else
-			return m_Container.erase( pTraxType->ID() ) > 0;
+			return Erase( pTraxType->ID() );
 	}
 
 	return false;
 }
 
+template<class TraxType, class Base>
+void Container_Imp<TraxType,Base>::Insert( std::shared_ptr<TraxType> pTraxType ){
+	const IDType id = pTraxType->ID();
+	if( m_bDense && id.GetID() >= m_Slots.size() && !FitsDense( id.GetID(), m_Dense.size() + 1 ) )
+		FallBackToTree();
+
+	if( !m_bDense ){
+		m_Container.insert( std::make_pair( id, std::move(pTraxType) ) );
+		return;
+	}
+
+	if( m_Slots.size() <= id.GetID() )
+		m_Slots.resize( id.GetID() + 1, -1 );
+
+	// Mostly ids get added in increasing order:
+	auto iter = m_Dense.end();
+	if( !m_Dense.empty() && id < m_Dense.back()->ID() )
+		iter = std::lower_bound( m_Dense.begin(), m_Dense.end(), id,
+			[]( const std::shared_ptr<TraxType>& pElement, IDType id ) noexcept{ return pElement->ID() < id; } );
+
+	const std::size_t idx = iter - m_Dense.begin();
+	m_Dense.insert( iter, std::move(pTraxType) );
+	Reindex( idx );
+}
+
+template<class TraxType, class Base>
+void Container_Imp<TraxType,Base>::FallBackToTree(){
+	assert( m_bDense );
+	ContainerType container;
+	for( std::shared_ptr<TraxType>& pTraxType : m_Dense )
+		container.emplace_hint( container.end(), pTraxType->ID(), pTraxType );
+
+	m_Container.swap( container );
+	m_Dense.clear();
+	m_Dense.shrink_to_fit();
+	m_Slots.clear();
+	m_Slots.shrink_to_fit();
+	m_bDense = false;
+}
+
+template<class TraxType, class Base>
+bool Container_Imp<TraxType,Base>::Erase( IDType id ) noexcept{
+	if( !m_bDense )
+		return m_Container.erase( id ) > 0;
+
+	const int idx = Slot( id );
+	if( idx < 0 )
+		return false;
+
+	m_Slots[id.GetID()] = -1;
+	std::shared_ptr<TraxType> pRemoved = std::move(m_Dense[idx]);
+	m_Dense.erase( m_Dense.begin() + idx );
+	Reindex( idx );
+	return true; // the object might be deleted here
+}
+
 template<class TraxType, class Base>
 int Container_Imp<TraxType,Base>::Take( typename Base::collection_type& collection ){
 	const int offset = MaxID();
@@ -287,6 +411,14 @@ int Container_Imp<TraxType,Base>::Take( typename Base::collection_type& collecti
 template<class TraxType, class Base>
 std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetNext( const std::shared_ptr<TraxType>& pTraxType ) const{
 	assert( pTraxType );
+	if( m_bDense ){
+		const int idx = Slot( pTraxType->ID() );
+		if( idx >= 0 && idx + 1 < static_cast<int>(m_Dense.size()) )
+			return m_Dense[idx + 1];
+
+		return nullptr;
+	}
+
 	auto iter = m_Container.find( pTraxType->ID() );
 	if( iter != m_Container.end() &&
 		++iter != m_Container.end() )
@@ -298,6 +430,14 @@ std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetNext( const std::shar
 template<class TraxType, class Base>
 std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetPrevious( const std::shared_ptr<TraxType>& pTraxType ) const{
 	assert( pTraxType );
+	if( m_bDense ){
+		const int idx = Slot( pTraxType->ID() );
+		if( idx > 0 )
+			return m_Dense[idx - 1];
+
+		return nullptr;
+	}
+
 	auto iter = m_Container.find( pTraxType->ID() );
 	if( iter != m_Container.end() &&
 		iter != m_Container.begin() )
@@ -311,6 +451,11 @@ bool Container_Imp<TraxType,Base>::IsMember( const TraxType& item ) const noexce
 	if( !item.ID() )
 		return false;
 
+	if( m_bDense ){
+		const int idx = Slot( item.ID() );
+		return idx >= 0 && m_Dense[idx].get() == &item;
+	}
+
 	const auto iter = m_Container.find( item.ID() );
 	if( iter == m_Container.end() )
 		return false;
@@ -321,47 +466,73 @@ bool Container_Imp<TraxType,Base>::IsMember( const TraxType& item ) const noexce
 template<class TraxType, class Base>
 void Container_Imp<TraxType,Base>::Clear() noexcept{
 	m_Container.clear();
+	m_Dense.clear();
+	m_Slots.clear();
 	while( !m_ActiveStack.empty() )
 		m_ActiveStack.pop();
 }
 
 template<class TraxType, class Base>
 int Container_Imp<TraxType,Base>::Count() const noexcept{
+	if( m_bDense )
+		return static_cast<int>(m_Dense.size());
+
 	return static_cast<int>(m_Container.size());
 }
 
 template<class TraxType, class Base>
 typename Base::collection_type::iterator Container_Imp<TraxType,Base>::begin() noexcept{
+	if( m_bDense )
+		return typename Base::collection_type::iterator{ m_Dense.data() };
+
 	return { m_Container.begin() };
 }
 
 template<class TraxType, class Base>
 typename Base::collection_type::iterator Container_Imp<TraxType,Base>::end() noexcept{
+	if( m_bDense )
+		return typename Base::collection_type::iterator{ m_Dense.data() + m_Dense.size() };
+
 	return { m_Container.end() };
 }
 
 template<class TraxType, class Base>
 typename Base::collection_type::const_iterator Container_Imp<TraxType,Base>::begin() const noexcept{
+	if( m_bDense )
+		return typename Base::collection_type::const_iterator{ m_Dense.data() };
+
 	return { m_Container.begin() };
 }
 
 template<class TraxType, class Base>
 typename Base::collection_type::const_iterator Container_Imp<TraxType,Base>::end() const noexcept{
+	if( m_bDense )
+		return typename Base::collection_type::const_iterator{ m_Dense.data() + m_Dense.size() };
+
 	return { m_Container.end() };
 }
 
 template<class TraxType, class Base>
 typename Base::collection_type::const_iterator Container_Imp<TraxType,Base>::cbegin() const noexcept{
+	if( m_bDense )
+		return typename Base::collection_type::const_iterator{ m_Dense.data() };
+
 	return { m_Container.begin() };
 }
 
 template<class TraxType, class Base>
 typename Base::collection_type::const_iterator Container_Imp<TraxType,Base>::cend() const noexcept{
+	if( m_bDense )
+		return typename Base::collection_type::const_iterator{ m_Dense.data() + m_Dense.size() };
+
 	return { m_Container.end() };
 }
 
 template<class TraxType, class Base>
 std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetFirst() const noexcept{
+	if( m_bDense )
+		return m_Dense.empty() ? nullptr : m_Dense.front();
+
 	const auto iter = m_Container.begin();
 	if( iter != m_Container.end() )
 		return (*iter).second;
@@ -371,6 +542,9 @@ std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetFirst() const noexcep
 
 template<class TraxType, class Base>
 std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetLast() const{
+	if( m_bDense )
+		return m_Dense.empty() ? nullptr : m_Dense.back();
+
 	const auto iter = m_Container.rbegin();
 	if( iter != m_Container.rend() )
 		return (*iter).second;
@@ -380,6 +554,11 @@ std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::GetLast() const{
 
 template<class TraxType, class Base>
 std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::Get( IDType id ) const{
+	if( m_bDense ){
+		const int idx = Slot( id );
+		return idx >= 0 ? m_Dense[idx] : nullptr;
+	}
+
 	const auto iter = m_Container.find( id );
 	if( iter != m_Container.end() )
 		return (*iter).second;
@@ -389,6 +568,14 @@ std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::Get( IDType id ) const{
 
 template<class TraxType, class Base>
 std::shared_ptr<TraxType> Container_Imp<TraxType,Base>::Get( const char* name ) const{
+	if( m_bDense ){
+		for( const std::shared_ptr<TraxType>& pTraxType : m_Dense )
+			if( std::string{pTraxType->Reference( "name" )}.compare( name ) == 0 )
+				return pTraxType;
+
+		return nullptr;
+	}
+
 	for( auto iter = m_Container.begin(); iter != m_Container.end(); ++iter )
 		if( std::string{(*iter).second->Reference( "name" )}.compare( name ) == 0 )
 			return (*iter).second;
@@ -424,7 +611,7 @@ bool Container_Imp<TraxType,Base>::IsMember( IDType id ) const noexcept{
 
 template<class TraxType, class Base>
 inline void Container_Imp<TraxType, Base>::ShiftIDs( int offset ){
-	if( m_Container.empty() )
+	if( Count() == 0 )
 		return;
 	if( MinID().GetID() + offset <= 0 )
 		throw std::out_of_range( "Can not shift id space." );
@@ -439,6 +626,19 @@ inline void Container_Imp<TraxType, Base>::ShiftIDs( int offset ){
 		tempStack.pop();
 	}
 
+	if( m_bDense && !FitsDense( MaxID().GetID() + offset, m_Dense.size() ) )
+		FallBackToTree();
+
+	if( m_bDense ){
+		// The order stays the same:
+		for( const std::shared_ptr<TraxType>& pTraxType : m_Dense )
+			pTraxType->ID( pTraxType->ID() + offset );
+
+		m_Slots.assign( m_Dense.back()->ID().GetID() + 1, -1 );
+		Reindex( 0 );
+		return;
+	}
+
 	ContainerType tempContainer;
 	for( const auto& pair : m_Container ){
 		pair.second->ID( pair.second->ID() + offset );
@@ -450,6 +650,9 @@ inline void Container_Imp<TraxType, Base>::ShiftIDs( int offset ){
 
 template<class TraxType, class Base>
 inline IDType Container_Imp<TraxType, Base>::MaxID() const noexcept{
+	if( m_bDense )
+		return m_Dense.empty() ? IDType{} : m_Dense.back()->ID();
+
 	if( m_Container.empty() )
 		return 0;
 
@@ -458,6 +661,9 @@ inline IDType Container_Imp<TraxType, Base>::MaxID() const noexcept{
 
 template<class TraxType, class Base>
 inline IDType Container_Imp<TraxType, Base>::MinID() const noexcept{
+	if( m_bDense )
+		return m_Dense.empty() ? IDType{} : m_Dense.front()->ID();
+
 	if( m_Container.empty() )
 		return 0;
 
@@ -480,8 +686,7 @@ void Container_Imp<TraxType, Base>::SetDecorator( Base* pDecorator ) noexcept{
 template<class ContainerType>
 inline bool IsValid_Imp( const ContainerType& container ){
 	bool bOK = true;
-	for( const auto& pair : container ){
-		auto& element = *(pair.second);
+	for( const auto& element : container ){
 		if( !element.IsValid() ){
 			bOK = false;
 		}
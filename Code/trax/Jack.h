@@ -72,11 +72,16 @@
 #include "ObjectID.h"
 
 #include <cassert>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace trax{
 
 	struct Plug;
 	struct JackEnumerator;
+	class PulseGraph;
 
 	/// \brief A jack a plug can get connected with.
 	struct Jack : Identified<Jack>
@@ -165,10 +170,196 @@ namespace trax{
 		bool		m_bPulsing;
 		IDType		m_RefPlugID;
 
+		friend class PulseGraph;
+		PulseGraph* m_pGraph = nullptr;
+		int			m_GraphNode = -1;
+
+		std::shared_ptr<Jack_Imp*> m_pPulseToken; ///< Lets pulses deferred to a PulseQueue find this jack, or find out it is gone.
+
 		void DoClear() noexcept;
 	};
 
 
+	/// \brief Collects pulses instead of delivering them right away.
+	///
+	/// While a queue is active for a thread, Jack_Imp::Pulse() on that thread 
+	/// records the pulse with the queue. Commit() then delivers the pulses 
+	/// in the order they were recorded. The Scene uses this to update objects 
+	/// concurrently and still deliver their pulses in a deterministic order.
+	class PulseQueue{
+	public:
+		/// \brief Activates a queue for the calling thread for the lifetime 
+		/// of the Scope object. Scopes can get nested.
+		class Scope{
+		public:
+			dclspc explicit Scope( PulseQueue* pQueue ) noexcept;
+			dclspc ~Scope() noexcept;
+
+			Scope( const Scope& ) = delete;
+			Scope& operator=( const Scope& ) = delete;
+		private:
+			PulseQueue* m_pPrevious;
+		};
+
+
+		/// \returns The queue active for the calling thread or nullptr.
+		static dclspc PulseQueue* Active() noexcept;
+
+
+		/// \brief Statistics about the commits of a queue.
+		struct Statistics{
+			std::size_t commits = 0;				///< Number of Commit() calls.
+			std::size_t delivered = 0;				///< Total number of pulses and actions delivered.
+			std::size_t lastDepth = 0;				///< Number of pulses and actions delivered by the last commit.
+			std::size_t maxDepth = 0;				///< Largest number of pulses and actions delivered by one commit.
+			std::chrono::nanoseconds lastDelivery{};	///< Time the last commit took.
+			std::chrono::nanoseconds totalDelivery{};	///< Time all the commits took.
+		};
+
+
+		/// \brief Records an action to be done on Commit().
+		///
+		/// Actions other than pulses, that are not allowed to run concurrently 
+		/// (e.g. writes to the physics scene), can get deferred this way too.
+		dclspc void Defer( std::function<void()> action );
+
+
+		/// \brief Moves the recorded pulses and actions of another queue to 
+		/// the end of this one.
+		///
+		/// Queues that got filled on different threads can get merged this 
+		/// way in a deterministic order without any locking.
+		dclspc void Append( PulseQueue&& queue );
+
+
+		/// \brief Delivers the recorded pulses and performs the deferred actions.
+		///
+		/// No queue is active for the calling thread while doing so. An 
+		/// exception thrown by an action gets reported to std::cerr and 
+		/// does not keep the remaining actions from getting done.
+		dclspc void Commit() noexcept;
+
+
+		/// \returns True if there is nothing to commit.
+		dclspc bool Empty() const noexcept;
+
+
+		/// \returns The number of pulses and actions recorded for the next commit.
+		dclspc std::size_t Depth() const noexcept;
+
+
+		/// \returns Statistics about the commits since construction or the 
+		/// last call to ResetStatistics().
+		dclspc const Statistics& GetStatistics() const noexcept;
+
+
+		/// \brief Sets all statistics to zero.
+		dclspc void ResetStatistics() noexcept;
+	private:
+		std::vector<std::function<void()>> m_Actions;
+		Statistics m_Statistics;
+	};
+
+
+	/// \brief Flattened Jack/Plug wiring for delivering pulses without
+	/// recursion.
+	///
+	/// Compile() walks the plug chains of a set of jacks and stores them in 
+	/// contiguous arrays. A pulse on one of these jacks then gets delivered 
+	/// breadth first: the plugs of the jack get their pulse in chain order and
+	/// jacks pulsed by the plugs' actions get queued instead of being called 
+	/// recursively. A plug that forwards the pulse before doing its own action 
+	/// (like a toggle plug) still acts after the rest of the chain, as it would
+	/// without the graph. A jack gets queued as often as it gets pulsed, so with 
+	/// fan-in wiring it pulses once per incoming pulse; only a pulse to a jack 
+	/// that is itself delivering the pulse (cyclic wiring) gets dropped, like 
+	/// the recursive delivery does. Pulses to a MultiPlugJack get resolved to 
+	/// its index at compile time. After the queue has grown to the largest 
+	/// delivery, no memory gets allocated while delivering.
+	///
+	/// Any change to the wiring of a compiled jack or plug chain (Insert(), 
+	/// Clear(), destruction) invalidates the graph; the jacks then deliver 
+	/// their pulses the usual way until Compile() gets called again. This also
+	/// holds for a wiring change made from within a pulse: the remaining 
+	/// plugs of the pulsing jack get skipped and queued jacks pulse the usual way.
+	///
+	/// A jack can be part of one graph only. The graph is not thread safe; 
+	/// an active PulseQueue still takes precedence.
+	class PulseGraph{
+	public:
+		dclspc PulseGraph() noexcept;
+		dclspc ~PulseGraph() noexcept;
+
+		PulseGraph( const PulseGraph& ) = delete;
+		PulseGraph& operator=( const PulseGraph& ) = delete;
+
+
+		/// \name Compile
+		/// \brief Builds the graph from jacks and the plug chains inserted 
+		/// into them.
+		///
+		/// Jacks other than Jack_Imp are ignored. Jacks that are part of 
+		/// another graph get removed from it; that graph gets invalidated.
+		///@{
+		dclspc void Compile( JackEnumerator& jackEnumerator );
+
+		dclspc void Compile( const std::vector<Jack*>& jacks );
+		///@}
+
+
+		/// \returns True if the graph was compiled and no wiring has 
+		/// changed since.
+		dclspc bool IsValid() const noexcept;
+
+
+		/// \brief Releases all the jacks from the graph.
+		dclspc void Invalidate() noexcept;
+
+
+		/// \returns The number of jacks in the graph.
+		dclspc int CountNodes() const noexcept;
+
+
+		/// \returns The number of plugs and jacks that get pulsed by the 
+		/// jacks of the graph.
+		dclspc int CountTargets() const noexcept;
+	private:
+		friend class Jack_Imp;
+
+		struct Node{
+			Jack_Imp*	pJack;
+			int			firstTarget;
+			int			countTargets;
+		};
+
+		struct Target{
+			Plug*		pPlug;
+			int			node;		///< Index of a node to pulse instead of the plug or -1.
+			bool		bForeward;	///< The plug's jack is not part of the chain.
+			bool		bActsLast;	///< The plug forwards the pulse before its action.
+		};
+
+		struct Entry{
+			int			node;
+			int			parent;		///< Index of the queue entry that pulsed this one or -1.
+		};
+
+		std::vector<Node>			m_Nodes;
+		std::vector<Target>			m_Targets;
+		std::vector<Jack_Imp*>		m_ChainJacks;
+		std::vector<Entry>			m_Queue;
+		std::vector<int>			m_Unwind;
+		int							m_Head;
+		bool						m_bValid;
+		bool						m_bPropagating;
+
+		void Pulse( int node ) noexcept;
+		void Enqueue( int node ) noexcept;
+		void Detach( Jack_Imp& jack ) noexcept;
+		void Release() noexcept;
+	};
+
+
 	/// \brief Interface for enumerating the Jacks an object provides.
 	///
 	/// The interface can be retrieved by dynamic_cast for every object that provides Jacks.
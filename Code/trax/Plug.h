@@ -114,9 +114,13 @@ namespace trax{
 		virtual void Remove() noexcept = 0;
 	protected:
 		friend class Jack_Imp;
+		friend class PulseGraph;
 
 		virtual void Pulse( bool /*bForewardToJack*/ ) noexcept{}
 
+		/// \returns true if Pulse() forwards to JackOnPulse() before doing the plug's action.
+		virtual bool ForewardsFirst() const noexcept{ return false; }
+
 		virtual void Release() noexcept{}
 
 		virtual void ConnectTo( Jack& /*jack*/ ) noexcept{}
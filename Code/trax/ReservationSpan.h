@@ -0,0 +1,148 @@
+//	trax track library
+//	AD 2026
+//
+//  "Keep on movin', don't stop, no"
+//
+//				Soul II Soul
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+/// \page docu_reservationspan ReservationSpan
+/// \section reservationspan_intro Introduction
+/// Location::Reserve() places one reservation that gets forwarded from track to
+/// connected track. Deleting and making such a reservation again every simulation
+/// step, to follow a moving train, means to rebuild the reservations on all the
+/// tracks along the way. A ReservationSpan instead reserves track by track and
+/// remembers the pieces it made. Reserve() again with a new Location only changes
+/// the pieces that differ: typically the one at the head and the one at the tail,
+/// and nothing at all for a standing train.
+///
+/// \section reservationspan_examples Example:
+///
+/// \code
+/// ReservationSpan span;
+/// ...
+/// // every simulation step:
+/// span.Reserve( location, { -rearOverhang, frontOverhang + lookAhead }, trainID );
+/// ...
+/// if( !location.Overlaps( trainID ).empty() )
+///		...
+/// \endcode
+
+#include "IDType.h"
+#include "Location.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace trax{
+
+	class Track_Imp;
+
+	/// \brief A reservation along the tracks that gets updated incrementally.
+	///
+	/// The reservations are made for one ID, that should be used for nothing
+	/// else, since the pieces would get mixed up with other reservations.
+	class ReservationSpan{
+	public:
+		/// \brief The part of the reservation on one track.
+		struct Piece{
+			std::shared_ptr<const Track> pTrack;	///< The track.
+			common::Interval<Length> range;			///< Reserved parameter range on the track.
+		};
+
+		dclspc ReservationSpan() noexcept = default;
+		ReservationSpan( const ReservationSpan& ) = delete;
+		ReservationSpan( ReservationSpan&& ) = delete;
+
+		/// \brief Deletes the reservation.
+		dclspc ~ReservationSpan();
+
+		ReservationSpan& operator=( const ReservationSpan& ) = delete;
+		ReservationSpan& operator=( ReservationSpan&& ) = delete;
+
+
+		/// \brief Reserves range relative to location for forID, like
+		/// Location::Reserve() would do.
+		///
+		/// Only the pieces on tracks that differ from the recent reservation
+		/// get changed. If neither location nor range moved by more than
+		/// epsilon__length and no track along the span changed, nothing is done.
+		/// If the span hits an open track end, it gets cut there.
+		/// \param location Location to reserve relative to.
+		/// \param range Range to reserve in the direction of location.
+		/// \param forID ID to reserve for. With a different ID than before,
+		/// the recent reservation gets deleted first.
+		/// \returns true if any reservation changed.
+		/// \throws std::logic_error if location is not on a track.
+		dclspc bool Reserve( const Location& location, common::Interval<Length> range, IDType forID );
+
+
+		/// \brief Collects the tracks a Reserve() with the same arguments 
+		/// would change reservations on.
+		///
+		/// Nothing gets collected, if Reserve() would not change anything.
+		/// \param location Location to reserve relative to.
+		/// \param range Range to reserve in the direction of location.
+		/// \param forID ID to reserve for.
+		/// \param tracks Receives the tracks; a track might appear more than once.
+		dclspc void CollectTracks( const Location& location, common::Interval<Length> range, IDType forID, std::vector<const Track*>& tracks );
+
+
+		/// \brief Deletes the reservation.
+		dclspc void Clear() noexcept;
+
+
+		/// \returns The ID the reservation was made for, or anyID
+		/// if there is none.
+		dclspc IDType ID() const noexcept;
+
+
+		/// \returns The total length reserved.
+		dclspc Length GetLength() const noexcept;
+
+
+		/// \name Pieces
+		/// \brief The pieces of the reservation in the direction of the location
+		/// it was reserved for.
+		///@{
+		dclspc std::size_t CountPieces() const noexcept;
+
+		dclspc const Piece& GetPiece( std::size_t idx ) const;
+		///@}
+	private:
+		IDType									m_ID;
+		Location								m_Location;
+		common::Interval<Length>				m_Range;
+
+		std::vector<Piece>						m_Pieces;
+		std::vector<Piece>						m_Walk;
+		std::vector<std::uint64_t>				m_Revisions;
+		std::uint64_t							m_LatestRevision = 0;
+
+		bool IsUnchanged( const Location& location, common::Interval<Length> range, IDType forID ) const noexcept;
+		void Walk( const Location& location, common::Interval<Length> range );
+		void Delete( const Piece& piece ) const noexcept;
+		void Make( const Piece& piece ) const;
+		void Change( const Piece& piece, const Piece& toPiece ) const;
+	};
+}
@@ -133,6 +133,16 @@ namespace trax
 		virtual AnglePerLength D1( Length s ) const = 0;
 
 
+		/// \brief Gets the twist angle and its first derivative in one evaluation.
+		/// \param s track parameter to get the twist for [0,Track::GetLength()].
+		/// \param d1 Receives the first derivative of twist at s.
+		/// \returns Twisting angle in radiants.
+		virtual Angle TwistD1( Length s, AnglePerLength& d1 ) const{
+			d1 = D1( s );
+			return Twist( s );
+		}
+
+
 		/// Activates a rotation of pi around the tangent vector, if
 		/// the curve attached to the track would transition a point of 
 		/// zero curvature and is flipping its main normal vector around.
@@ -230,6 +240,13 @@ namespace trax
 		virtual AnglePerLength DoD1( Length ) const = 0;
 
 
+		/// \returns The twist and its derivative without ZeroFlip or addaptions for general flip.
+		virtual Angle DoTwistD1( Length s, AnglePerLength& d1 ) const{
+			d1 = DoD1( s );
+			return DoTwist( s );
+		}
+
+
 		void* operator new  (std::size_t n)     { return dll_alloc(n); }
 		void  operator delete(void* p) noexcept { dll_free(p); }
 
@@ -28,6 +28,7 @@
 
 #include "Units.h"
 
+#include <vector>
 
 namespace trax{
 
@@ -87,6 +88,36 @@ namespace trax{
 		virtual void Update( Time dt = fixed_timestep ) = 0;
 
 
+		/// \name Parallel Update
+		/// \brief Support for updating objects concurrently.
+		/// \see Scene::UpdateThreads()
+		///@{
+		
+		/// \returns true if PreUpdate() and Update() of this object only 
+		/// touch data of the object itself and of the objects given by 
+		/// UpdateNeighbours(), so that it can get updated concurrently with 
+		/// other objects. Pulses get deferred by the scene; other actions 
+		/// that must not run concurrently can get deferred with the 
+		/// PulseQueue::Active() queue.
+		virtual bool ParallelUpdate() const noexcept{
+			return false;
+		}
+
+
+		/// \brief Collects the objects this one shares data with while 
+		/// getting updated.
+		///
+		/// These can be other Simulated objects, that then get updated on 
+		/// the same thread as this one, or any other objects, like the tracks 
+		/// a train changes reservations on: all the Simulated objects that 
+		/// name the same object get updated on the same thread.
+		/// \param neighbours Receives the addresses of the objects. Simulated 
+		/// objects have to be given by their Simulated address.
+		virtual void UpdateNeighbours( std::vector<const void*>& /*neighbours*/ ) const{
+		}
+		///@}
+
+
 		/// \brief Called if the simulation is paused.
 		virtual void Pause() noexcept = 0;
 
@@ -139,6 +170,14 @@ namespace trax{
 			m_pComponent->Update( dt );
 		}
 
+		bool ParallelUpdate() const noexcept override{
+			return m_pComponent->ParallelUpdate();
+		}
+
+		void UpdateNeighbours( std::vector<const void*>& neighbours ) const override{
+			m_pComponent->UpdateNeighbours( neighbours );
+		}
+
 		void Pause() noexcept override{
 			m_pComponent->Pause();
 		}
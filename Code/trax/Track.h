@@ -247,6 +247,9 @@
 #include "spat/VectorBundle.h"
 #include "spat/VectorBundle2.h"
 
+#include <optional>
+#include <vector>
+
 namespace trax
 {
 	struct Body;
@@ -508,6 +511,24 @@ namespace trax
 		///@}
 
 
+		/// \name Batch Transition
+		/// \brief Gives the poses for a whole range of parameters at once.
+		///
+		/// Works like the corresponding \ref transition "Transition()" for every 
+		/// parameter in [sBegin,sEnd), but evaluates the curve in one batch.
+		/// \param sBegin Pointer to the first parameter along the track.
+		/// \param sEnd Pointer behind the last parameter.
+		/// \param pos Array with at least sEnd - sBegin elements to receive the positions.
+		/// \param frame Array with at least sEnd - sBegin elements to receive the frames.
+		/// \throws std::logic_error if no proper curve is attached with the track.
+		/// \throws std::range_error if a parameter is outside the [0,Length()] range.
+		///@{
+		virtual void Transition( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const = 0;
+
+		virtual void Transition( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const = 0;
+		///@}
+
+
 		/// \brief Gives the Track connected to this at the specified end.
 		/// \param thisEnd End of this track to get the connected track for.
 		/// \returns The connected track end.
@@ -764,6 +785,91 @@ namespace trax
 	///@}
 
 
+	/// \brief Calculates all the segments of a track or curve in one pass.
+	///
+	/// Segment_Checked() and Segment_TotallyChecked() evaluate curvature and
+	/// torsion anew for every segment length they probe. A Segmentation 
+	/// evaluates them once on construction and keeps upper bounds for them in 
+	/// cells of about the given resolution. For curves with constant curvature 
+	/// (Line, Arc, Helix) and twists with constant derivative (Zero, Constant, 
+	/// Linear) the bounds are known analytically and a single cell covers the 
+	/// whole track; for a Rotator the curvature is bounded by sqrt(a²+b²). For 
+	/// a Clothoid the bounds taken from the cell ends are exact; for other 
+	/// curves they are sampled the same way Segment_TotallyChecked() does.
+	///
+	/// The segments then follow from the Segment() formulas, applied to the 
+	/// bounds of all the cells a segment touches.
+	class Segmentation{
+	public:
+		/// \brief Samples the curvature and torsion of a track.
+		/// \param track The track to segment.
+		/// \param resolution The length of the cells to sample the bounds for.
+		/// Curves shorter than this might get missed.
+		/// \param ignoreCuvesTorsion If true the torsion of the curve is not 
+		/// taken into consideration (but the twist still is). 
+		/// \throws std::invalid_argument if the track is not valid or of infinite
+		/// length or resolution <= 0_m.
+		dclspc Segmentation( const Track& track, Length resolution, bool ignoreCuvesTorsion = false );
+
+
+		/// \brief Samples the curvature and torsion of a curve.
+		/// \param curve The curve to segment.
+		/// \param range The range of curve parameters to segment.
+		/// \param resolution The length of the cells to sample the bounds for.
+		/// \throws std::invalid_argument if the curve is not valid, range is 
+		/// empty or infinite or resolution <= 0_m.
+		dclspc Segmentation( const Curve& curve, common::Interval<Length> range, Length resolution );
+
+
+		/// \returns The range of parameters that gets segmented.
+		inline common::Interval<Length> Range() const noexcept{
+			return { m_Start, m_Start + m_Length };
+		}
+
+		/// \returns The number of cells with separate bounds.
+		inline int CountCells() const noexcept{
+			return static_cast<int>(m_Cells.size());
+		}
+
+		/// \returns Upper bounds for the absolute values of curvature and 
+		/// torsion inside the range of parameters.
+		dclspc std::pair<AnglePerLength,AnglePerLength> Bounds( common::Interval<Length> range ) const noexcept;
+
+
+		/// \name Segments
+		/// \brief Calculates the segments for the whole range.
+		/// \param e Distance failure that is assumed not to matter visibly.
+		/// \param w maximum width of the track model.
+		/// \param h maximum height of the track model.
+		/// \param segmentLimits The minimum and maximum segment length to deliver. 
+		/// The last segment might be shorter, to go to the range's end.
+		/// \returns The parameters of the segment ends in ascending order; the 
+		/// last one is Range().Far(). The first segment starts at Range().Near().
+		/// \see Segment
+		///@{
+		dclspc std::vector<Length> Segments( Length e, common::Interval<Length> segmentLimits ) const;
+
+		dclspc std::vector<Length> Segments( Length e, Length w, Length h, common::Interval<Length> segmentLimits ) const;
+		///@}
+	private:
+		struct Cell{
+			Length			s;	///< Start of the cell relative to m_Start.
+			AnglePerLength	k;	///< Bound of curvature.
+			AnglePerLength	t;	///< Bound of torsion.
+		};
+
+		Length				m_Start = 0_m;
+		Length				m_Length = 0_m;
+		std::vector<Cell>	m_Cells;
+
+		template<class Curvature, class Torsion>
+		void Sample( Length resolution, std::optional<AnglePerLength> k, Curvature curvature, std::optional<AnglePerLength> t, Torsion torsion );
+
+		template<class SegmentFunction>
+		std::vector<Length> Segments( common::Interval<Length> segmentLimits, SegmentFunction segment_ds ) const;
+	};
+
+
 	/// \defgroup Group_Foot Track's Foot Point 
 	/// \brief Foot of a point in space on a track. Finds a point on a track so that the line from it to the target point stands 
 	/// perpendicular on the track's tangent at that point.
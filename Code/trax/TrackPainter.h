@@ -36,10 +36,43 @@
 #include "spat/VectorBundle2.h"
 #include "spat/Frame.h"
 
+#include <cstdint>
+#include <type_traits>
+#include <map>
 #include <vector>
 
 namespace trax{
 
+	/// \brief Vertex data for a profile point of a section.
+	/// \param rFrame Position and orientation of the section.
+	/// \param pt The profile point.
+	/// \param textcoord Texture coordinates for the vertex.
+	template<typename PointType>
+	PointType SectionVertex( const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& textcoord );
+
+	template<> inline
+	spat::Position<Length> SectionVertex<spat::Position<Length>>( const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& /*textcoord*/ ){
+		return rFrame.P + pt.p.x * rFrame.N + pt.p.y * rFrame.B;
+	}
+
+	template<> inline
+	std::pair<spat::VectorBundle<Length,One>,spat::Position2D<One>> SectionVertex<std::pair<spat::VectorBundle<Length,One>,spat::Position2D<One>>>( 
+		const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& textcoord ){
+		return {{	rFrame.P + pt.p.x * rFrame.N + pt.p.y * rFrame.B, 
+					pt.n.dx * rFrame.N + pt.n.dy * rFrame.B },
+					textcoord};
+	}
+
+	template<> inline
+	std::pair<spat::VectorBundle2<Length,One>,spat::Position2D<One>> SectionVertex<std::pair<spat::VectorBundle2<Length,One>,spat::Position2D<One>>>( 
+		const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& textcoord ){
+		return {{	rFrame.P + pt.p.x * rFrame.N + pt.p.y * rFrame.B, 
+					rFrame.T,
+					pt.n.dx * rFrame.N + pt.n.dy * rFrame.B },
+					textcoord};
+	}
+
+
 	/// \brief Base class for painting tracks as a series of short straight pieces.
 	class TrackPainter{
 	public:
@@ -48,8 +81,8 @@ namespace trax{
 			mode_leftHandedFaces			= 0x01, ///< Produces triangles according to the left hand rule. Default it is the right hand rule.
 			mode_constantSegmentLength		= 0x02, ///< Uses segmentLimits.Far() as segment length.
 			mode_SegmentLength				= 0x04, ///< Checks each segment at its starting point. The default.
-			mode_checkedSegmentLength		= 0x04,	///< Checks the end point of the segment, shrinks if necessary. Use it if the curvature changes much inside the segmentLimits.Far() distance.
-			mode_totallycheckedSegmentLength= 0x08, ///< Checks every point of the segment with respect to the segmentLimits.Near() grid. Use it if sudden curves might occure inside the segmentLimits.Far() distance.
+			mode_checkedSegmentLength		= 0x04,	///< Checks the segment against curvature and torsion bounds sampled on a coarse grid, shrinks if necessary. Use it if the curvature changes much inside the segmentLimits.Far() distance. \see Segmentation
+			mode_totallycheckedSegmentLength= 0x08, ///< Checks the segment against curvature and torsion bounds sampled on the segmentLimits.Near() grid. Use it if sudden curves might occure inside the segmentLimits.Far() distance. \see Segmentation
 			mode_ignoreCuvesTorsion			= 0x10, ///< Ignores the curves torsion (but not the track's twist) for segment calculations.
 			mode_localFrame					= 0x20, ///< Paints the track in it's local frame of reference. To get global coordinates, the tracks's transformations have to be applied to the geometric data.
 			mode_startFrame					= 0x40,	///< Paints the track around it's start frame. The first segment will start at {0,0,0} with it's tangent heading towards {1,0,0}.
@@ -125,6 +158,10 @@ namespace trax{
 
 		int m_CountSegmentsLastPaint = 0;
 		spat::Frame<Length,One> m_Transformation;
+
+		// Kept from paint to paint to reuse the memory:
+		std::vector<Length> m_Parameters;
+		std::vector<spat::Frame<Length,One>> m_Frames;
 	};
 
 
@@ -211,8 +248,8 @@ namespace trax{
 		}
 
 	protected:
-		void AddVertex( const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& /*textcoord*/ ) override{
-			m_Points.push_back( rFrame.P + pt.p.x * rFrame.N + pt.p.y * rFrame.B );
+		void AddVertex( const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& textcoord ) override{
+			m_Points.push_back( SectionVertex<PointType>( rFrame, pt, textcoord ) );
 		}
 	};
 
@@ -230,9 +267,7 @@ namespace trax{
 
 	protected:
 		void AddVertex( const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& textcoord ) override{
-			m_Points.push_back( {{	rFrame.P + pt.p.x * rFrame.N + pt.p.y * rFrame.B, 
-									pt.n.dx * rFrame.N + pt.n.dy * rFrame.B },
-									textcoord} );
+			m_Points.push_back( SectionVertex<PointType>( rFrame, pt, textcoord ) );
 		}
 	};
 
@@ -250,10 +285,262 @@ namespace trax{
 
 	protected:
 		void AddVertex( const spat::Frame<Length,One>& rFrame, const Section::SectionPoint& pt, const spat::Position2D<One>& textcoord ) override{
-			m_Points.push_back( {{	rFrame.P + pt.p.x * rFrame.N + pt.p.y * rFrame.B, 
-									rFrame.T,
-									pt.n.dx * rFrame.N + pt.n.dy * rFrame.B },
-									textcoord} );
+			m_Points.push_back( SectionVertex<PointType>( rFrame, pt, textcoord ) );
 		}
 	};
+
+	/// \brief Vertices and triangles of a track for one level of detail.
+	template<typename PointType>
+	struct MeshChunk{
+		Length					epsilon = epsilon__length;	///< Maximum distance of the mesh to the exact surface.
+		std::vector<PointType>	points;						///< One row of section points per sample.
+		std::vector<int>		indices;					///< Three indices into points per triangle.
+	};
+
+
+	/// \brief Paints tracks with several levels of detail in one go.
+	///
+	/// The track gets sampled once with the smallest epsilon. The coarser levels
+	/// use subsets of these rows of vertices: a row gets dropped, as long as none 
+	/// of its section points is farther away from the mesh than the level's epsilon. 
+	/// The buffers for each level are sized before they get filled.
+	///
+	/// At an end that is connected to another track, the end row is calculated
+	/// from the end frame of the track with the lower ID, so the meshes of both
+	/// tracks use the same vertices at the joint and show no cracks.
+	class LODPainter{
+	public:
+		/// \param epsilons Distance failures for the levels of detail. They get
+		/// sorted, level 0 is the one with the smallest value.
+		/// \param mode Combination of TrackPainter::Mode flags.
+		/// \param segmentLimits The minimum and maximum segment length to deliver.
+		/// \throws std::invalid_argument if there are no epsilons or one is <= 0_m, 
+		/// or for invalid segmentLimits.
+		dclspc LODPainter( 
+			std::vector<Length> epsilons = { 1_mm, 1_cm, 10_cm, 1_m }, 
+			int mode = TrackPainter::Mode::mode_default, 
+			common::Interval<Length> segmentLimits = {epsilon__length,plausible_maximum_length} );
+
+
+		/// \returns The number of levels of detail.
+		inline int CountLODs() const noexcept{
+			return common::narrow_cast<int>(m_Epsilons.size());
+		}
+
+		/// \returns The distance failure for level of detail lod.
+		inline Length Epsilon( int lod ) const{
+			return m_Epsilons.at( lod );
+		}
+
+		/// \returns The mode setting adjusted on constructor call.
+		inline int GetMode() const noexcept{
+			return m_Mode;
+		}
+
+
+		/// \brief Samples the track for all the levels of detail.
+		///
+		/// \param track The track to paint.
+		/// \param section The section to be used for painting.
+		/// \throws std::invalid_argument for an invalid track or section.
+		dclspc void Tessellate( const TrackBuilder& track, const Section& section );
+
+
+		/// \returns The track parameters of the rows sampled by the last 
+		/// Tessellate() call.
+		inline const std::vector<Length>& Parameters() const noexcept{
+			return m_Parameters;
+		}
+
+		/// \returns The frames of the rows sampled by the last Tessellate() call.
+		inline const std::vector<spat::Frame<Length,One>>& Frames() const noexcept{
+			return m_Frames;
+		}
+
+		/// \returns Indices into Parameters() and Frames() of the rows used
+		/// for level of detail lod.
+		inline const std::vector<int>& Rows( int lod ) const{
+			return m_Rows.at( lod );
+		}
+
+
+		/// \brief Paints the track, one MeshChunk per level of detail.
+		///
+		/// \param track The track to paint.
+		/// \param section The section to be used for painting.
+		/// \param chunks Receives the meshes. Gets resized to CountLODs().
+		/// \param offset Texture offset, like with TrackPainter::Paint().
+		/// \returns track.GetLength() + offset
+		template<typename PointType>
+		Length Paint( const TrackBuilder& track, const Section& section, std::vector<MeshChunk<PointType>>& chunks, Length offset = 0_m );
+
+
+		/// \returns A number that changes whenever the geometry or the connections
+		/// of the track change; 0 if the track does not keep such a number.
+		static dclspc std::uint64_t Revision( const Track& track ) noexcept;
+	private:
+		std::vector<Length>					m_Epsilons;
+		int									m_Mode;
+		common::Interval<Length>			m_SegmentLimits;
+
+		std::vector<Length>					m_Parameters;
+		std::vector<spat::Frame<Length,One>> m_Frames;
+		std::vector<std::vector<int>>		m_Rows;
+	};
+
+
+	/// \brief Keeps multi level of detail meshes for a set of tracks and 
+	/// repaints only the tracks that changed.
+	template<typename PointType>
+	class TrackMeshCache{
+	public:
+		TrackMeshCache( LODPainter painter = {} )
+			: m_Painter{ std::move(painter) }
+		{}
+
+
+		/// \brief Paints the tracks that are new or changed since the last 
+		/// call and drops the meshes of tracks that are gone.
+		///
+		/// A track gets repainted if its geometry or connections changed, or 
+		/// the ones of the tracks connected to it, since its end rows depend on
+		/// them. Tracks that are no SectionTrack or have no section are skipped.
+		/// \param tracks Range of TrackBuilder objects or pointers to them, 
+		/// e.g. a TrackCollection.
+		/// \returns The number of tracks painted.
+		template<class Tracks>
+		int Update( const Tracks& tracks );
+
+
+		/// \returns The meshes for the track with ID id or nullptr if there
+		/// are none.
+		const std::vector<MeshChunk<PointType>>* Get( IDType id ) const noexcept{
+			auto iter = m_Meshes.find( id );
+			return iter != m_Meshes.end() ? &iter->second.chunks : nullptr;
+		}
+
+		/// \returns The number of tracks with meshes.
+		std::size_t Count() const noexcept{
+			return m_Meshes.size();
+		}
+
+		/// \brief Makes the next Update() repaint the track.
+		void Invalidate( IDType id ) noexcept{
+			if( auto iter = m_Meshes.find( id ); iter != m_Meshes.end() )
+				iter->second.revisions[0] = 0;
+		}
+
+		/// \brief Drops all meshes.
+		void Clear() noexcept{
+			m_Meshes.clear();
+		}
+	private:
+		struct Entry{
+			std::uint64_t revisions[3] = {};	///< The track's and the connected tracks' revisions.
+			std::uint64_t update = 0;
+			std::vector<MeshChunk<PointType>> chunks;
+		};
+
+		static const TrackBuilder& Deref( const TrackBuilder& track ) noexcept{
+			return track;
+		}
+
+		template<class Pointer, typename = std::enable_if_t<!std::is_base_of_v<TrackBuilder,Pointer>>>
+		static const TrackBuilder& Deref( const Pointer& pTrack ) noexcept{
+			return *pTrack;
+		}
+
+		LODPainter							m_Painter;
+		std::map<IDType,Entry>				m_Meshes;
+		std::uint64_t						m_Update = 0;
+	};
+
+
+template<typename PointType>
+Length LODPainter::Paint( const TrackBuilder& track, const Section& section, std::vector<MeshChunk<PointType>>& chunks, Length offset )
+{
+	Tessellate( track, section );
+
+	const int nPoints = section.CountPoints();
+	const auto texScaleU = section.TextureExtent().Length() / section.PolygonChainLength();
+
+	chunks.resize( m_Rows.size() );
+	for( std::size_t lod = 0; lod < m_Rows.size(); ++lod )
+	{
+		const std::vector<int>& rows = m_Rows[lod];
+		MeshChunk<PointType>& chunk = chunks[lod];
+		chunk.epsilon = m_Epsilons[lod];
+		chunk.points.resize( rows.size() * nPoints );
+		chunk.indices.resize( (rows.size() - 1) * (nPoints - 1) * 6 );
+
+		PointType* pPoint = chunk.points.data();
+		for( const int row : rows ){
+			const One u = (offset + m_Parameters[row]) * texScaleU;
+			for( int i = 0; i < nPoints; ++i ){
+				const Section::SectionPoint& pt = section.Get( i );
+				*pPoint++ = SectionVertex<PointType>( m_Frames[row], pt, { u, pt.t } );
+			}
+		}
+
+		int* pIndex = chunk.indices.data();
+		for( int row = 1; row < common::narrow_cast<int>(rows.size()); ++row ){
+			for( int i = row * nPoints; i < (row + 1) * nPoints - 1; ++i ){
+				if( m_Mode & TrackPainter::Mode::mode_leftHandedFaces ){
+					*pIndex++ = i; *pIndex++ = i - nPoints + 1; *pIndex++ = i + 1;
+					*pIndex++ = i; *pIndex++ = i - nPoints;		*pIndex++ = i - nPoints + 1;
+				}
+				else{
+					*pIndex++ = i; *pIndex++ = i + 1;			*pIndex++ = i - nPoints + 1;
+					*pIndex++ = i; *pIndex++ = i - nPoints + 1; *pIndex++ = i - nPoints;
+				}
+			}
+		}
+	}
+
+	return track.GetLength() + offset;
+}
+
+template<typename PointType>
+template<class Tracks>
+int TrackMeshCache<PointType>::Update( const Tracks& tracks )
+{
+	auto RevisionAt = []( const TrackBuilder& track, EndType end ) noexcept -> std::uint64_t{
+		const Track::TrackEnd other = track.TransitionEnd( end );
+		return other.pTrack ? LODPainter::Revision( *other.pTrack ) : 0;
+	};
+
+	++m_Update;
+	int painted = 0;
+	for( const auto& element : tracks )
+	{
+		const TrackBuilder& track = Deref( element );
+		const SectionTrack* pSectionTrack = dynamic_cast<const SectionTrack*>(&track);
+		if( !pSectionTrack || !pSectionTrack->GetSection() || !track.IsValid() )
+			continue;
+
+		Entry& entry = m_Meshes[track.ID()];
+		entry.update = m_Update;
+
+		const std::uint64_t revisions[3] = { 
+			LODPainter::Revision( track ), 
+			RevisionAt( track, EndType::north ), 
+			RevisionAt( track, EndType::south ) };
+		if( revisions[0] && !entry.chunks.empty() &&
+			std::equal( std::begin(revisions), std::end(revisions), std::begin(entry.revisions) ) )
+			continue;
+
+		m_Painter.Paint( track, *pSectionTrack->GetSection(), entry.chunks );
+		std::copy( std::begin(revisions), std::end(revisions), std::begin(entry.revisions) );
+		++painted;
+	}
+
+	for( auto iter = m_Meshes.begin(); iter != m_Meshes.end(); ){
+		if( iter->second.update != m_Update )
+			iter = m_Meshes.erase( iter );
+		else
+			++iter;
+	}
+
+	return painted;
+}
 }
\ No newline at end of file
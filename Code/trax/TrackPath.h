@@ -0,0 +1,195 @@
+//	trax track library
+//	AD 2026
+//
+//  "The long and winding road
+//	 that leads to your door"
+//
+//				The Beatles
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+/// \page docu_trackpath TrackPath
+/// \section trackpath_intro Introduction
+/// A TrackPath is the sequence of tracks a Location would travel along, with the
+/// current switch settings, up to some horizon. The track chain gets walked once
+/// on building the path and is stored as a flat array of entries, each holding the
+/// track, the parameter range travelled on it and the distance from the start of
+/// the path. Look-ahead queries like 'next signal', 'distance to a location' or
+/// 'reservations ahead' then are answered by binary searches along that array,
+/// instead of walking the connected tracks again for every query.
+///
+/// The path does not get updated by itself. If a Connector switches, a track
+/// gets connected or disconnected, or signals or geometry of a track on the path
+/// change, IsValid() will return false and the path has to be built anew.
+///
+/// \section trackpath_examples Example:
+///
+/// \code
+/// TrackPath path{ location, 2_km };
+/// ...
+/// // every simulation step:
+/// if( !path.IsValid() || path.Distance( location ) > path.GetLength() - 1_km )
+///		path.Build( location, 2_km );
+///
+/// const Length here = path.Distance( location );
+/// const auto nextSignal = path.NextSignal( here );
+/// if( nextSignal.first && nextSignal.second - here < brakingDistance )
+///		...
+/// \endcode
+
+#include "IDType.h"
+#include "Location.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace trax{
+
+	struct Signal;
+	class Track_Imp;
+
+	/// \brief A flattened sequence of tracks ahead of a Location.
+	///
+	/// All distances are measured along the path from the Location
+	/// the path was built for, positive in its Orientation.
+	class TrackPath{
+	public:
+		/// \brief One track along the path.
+		struct Entry{
+			std::shared_ptr<const Track> pTrack;	///< The track.
+			common::Interval<Length> range;			///< Parameter range on the track in travel direction.
+			Orientation orientation;				///< Travel direction relative to the track.
+			Length offset;							///< Distance from the start of the path to range.Near().
+		};
+
+		/// \brief Construction
+		///
+		/// \param start Location to build the path from.
+		/// \param horizon Minimum length of the path, if no open track end is hit before.
+		/// \throws std::logic_error if start is not on a track.
+		/// \throws std::invalid_argument if horizon is negative or not finite.
+		///@{
+		dclspc TrackPath() noexcept = default;
+		dclspc TrackPath( const Location& start, Length horizon );
+		///@}
+
+
+		/// \brief Walks the tracks from start up to horizon with the
+		/// current switch settings.
+		/// 
+		/// The walk stops at the horizon, at an open track end or if it runs
+		/// into a loop. 
+		/// \throws std::logic_error if start is not on a track.
+		/// \throws std::invalid_argument if horizon is negative or not finite.
+		dclspc void Build( const Location& start, Length horizon );
+
+
+		/// \brief Empties the path.
+		dclspc void Clear() noexcept;
+
+
+		/// \returns True if no track along the path changed its connections,
+		/// geometry or signals since the path was built. An empty path is invalid.
+		dclspc bool IsValid() const noexcept;
+
+
+		/// \returns The length covered by the path. This is at least the horizon, if
+		/// the path is not ended by an open track end or is complete.
+		dclspc Length GetLength() const noexcept;
+
+
+		/// \returns True if the path ends at an open track end.
+		dclspc bool IsOpenEnded() const noexcept;
+
+
+		/// \returns True if the path ends because the tracks ahead form a loop.
+		/// If the loop leads back to the start, the path ends at the start location,
+		/// otherwise after the loop got travelled at least once.
+		dclspc bool IsComplete() const noexcept;
+
+
+		/// \name Entries
+		///@{
+		dclspc std::size_t CountEntries() const noexcept;
+
+		dclspc const Entry& GetEntry( std::size_t idx ) const;
+
+		dclspc std::vector<Entry>::const_iterator begin() const noexcept;
+
+		dclspc std::vector<Entry>::const_iterator end() const noexcept;
+		///@}
+
+
+		/// \brief Gets the entry for a distance along the path.
+		/// \returns The index of the entry covering distance or CountEntries()
+		/// if distance is not on the path.
+		dclspc std::size_t Find( Length distance ) const noexcept;
+
+
+		/// \brief Gets the location at a distance along the path.
+		/// \returns The Location with the path's direction as orientation.
+		/// \throws std::out_of_range if distance is not on the path.
+		dclspc Location LocationAt( Length distance ) const;
+
+
+		/// \brief Gets the distance of a location along the path.
+		/// \returns The distance from the start of the path to loc or
+		/// +infinite__length if loc is not on the path.
+		dclspc Length Distance( const Location& loc ) const noexcept;
+
+
+		/// \brief Gets the next Signal along the path.
+		///
+		/// Only signals working in the direction of the path are considered.
+		/// \param from Distance along the path to search from.
+		/// \returns The signal and the distance along the path to the near end of its
+		/// range, or {nullptr,+infinite__length} if there is no signal between from and the 
+		/// end of the path. The distance is less than from, if from is inside the signal's range.
+		dclspc std::pair<Signal*,Length> NextSignal( Length from = 0_m ) const noexcept;
+
+
+		/// \brief Gets the nearest reservation ahead, that is not for exceptID.
+		/// \param exceptID Reservations for this ID are ignored, e.g. the ID of the train
+		/// asking. With anyID all reservations count.
+		/// \param from Distance along the path to search from.
+		/// \param to Distance along the path to search to.
+		/// \returns The ID of the reservation and its distance along the path or
+		/// {anyID,+infinite__length} if the range is free.
+		dclspc std::pair<IDType,Length> NextReservation( IDType exceptID, Length from, Length to ) const;
+	private:
+		std::vector<Entry>											m_Entries;
+		bool														m_bOpenEnded = false;
+		bool														m_bComplete = false;
+
+		// The tracks with their revisions at the time of building:
+		std::vector<std::pair<const Track_Imp*,std::uint64_t>>		m_Revisions;
+		mutable std::uint64_t										m_LatestRevision = 0;
+
+		// Entry indices sorted by track:
+		std::vector<std::pair<const Track*,std::size_t>>			m_ByTrack;
+
+		// Signals with their range of distances along the path, sorted
+		// by the near distance, and the running maximum of the far distances:
+		std::vector<std::pair<common::Interval<Length>,Signal*>>	m_Signals;
+		std::vector<Length>											m_SignalsReach;
+	};
+}
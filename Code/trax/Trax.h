@@ -82,6 +82,7 @@ namespace trax{
 #include "ParallelTrack.h"
 #include "Parser.h"
 #include "Plug.h"
+#include "ReservationSpan.h"
 #include "RoadwayTwist.h"
 #include "Section.h"
 #include "SectionTrack.h"
@@ -95,6 +96,7 @@ namespace trax{
 #include "TrackData.h"
 #include "TrackLocation.h"
 #include "TrackPainter.h"
+#include "TrackPath.h"
 #include "Units.h"
 #include "UnitsHelper.h"
 #include "Version.h"
@@ -13,9 +13,21 @@
 #include "ObjectIDDecorator.h"
 
 #include <map>
+#include <type_traits>
 
 namespace trax{
 
+	/// \brief The way a collection stores its elements.
+	enum class CollectionStorage : char{
+		tree = 0,	///< Balanced tree ordered by id; adding and removing elements is cheap.
+		dense		///< Contiguous array ordered by id with an id indexed slot table; iteration 
+					///< and lookup by id are fast, adding and removing an element not at the 
+					///< end of the id range moves the following elements. The slot table takes 
+					///< memory proportional to the highest id, so if the ids get too sparse 
+					///< the collection falls back to tree storage.
+	};
+
+
 	template<class Collection_Type,class Value_Type>
 	struct Collection : virtual DllHeap{
 
@@ -38,6 +50,7 @@ namespace trax{
 			using distance_type = int;
 			using pointer = std::shared_ptr<_value_type>;
 			using reference = _value_type&;
+			using dense_pointer = const std::shared_ptr<std::remove_const_t<_value_type>>*;
 			///@}
 
 
@@ -45,49 +58,63 @@ namespace trax{
 				: m_Current{iter}
 			{}
 
+			/// \brief Iterator into the array of a CollectionStorage::dense collection.
+			inline explicit iterator_imp( dense_pointer pDense ) noexcept
+				: m_pDense{pDense},
+				  m_bDense{true}
+			{}
+
 
 			/// \name Iterator Operators
 			///@{
 			inline bool operator==( const iterator_imp& iter ) const noexcept{
-				return m_Current == iter.m_Current;
+				return m_bDense ? m_pDense == iter.m_pDense : m_Current == iter.m_Current;
 			}
 
 			inline bool operator!=( const iterator_imp& iter ) const noexcept{
-				return m_Current != iter.m_Current;
+				return !operator==( iter );
 			}
 
 			inline iterator_imp& operator++() noexcept{
-				++m_Current;
+				if( m_bDense )
+					++m_pDense;
+				else
+					++m_Current;
 				return *this;
 			}
 
 			inline iterator_imp operator++(int) noexcept{
 				iterator_imp retval( *this );
-				++m_Current;
+				operator++();
 				return retval;
 			}
 
 			inline iterator_imp& operator--() noexcept{		
-				--m_Current;
+				if( m_bDense )
+					--m_pDense;
+				else
+					--m_Current;
 				return *this;
 			}
 
 			inline iterator_imp operator--(int) noexcept{
 				iterator_imp retval( *this );
-				--m_Current;
+				operator--();
 				return retval;
 			}
 
 			inline reference operator*() const noexcept{
-				return *m_Current->second;
+				return m_bDense ? **m_pDense : *m_Current->second;
 			}
 
 			inline pointer operator->() const noexcept{
-				return m_Current->second;
+				return m_bDense ? *m_pDense : m_Current->second;
 			}
 			///@}
 		private:
 			_std_iterator_type m_Current;
+			dense_pointer m_pDense = nullptr;
+			bool m_bDense = false;
 		};
 
 		using iterator = iterator_imp<value_type,typename std::map<IDType,std::shared_ptr<value_type>>::const_iterator>;
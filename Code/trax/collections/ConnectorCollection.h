@@ -38,7 +38,8 @@ namespace trax{
 	struct ConnectorCollection : Collection<ConnectorCollection,Connector>{
 
 		/// \brief Makes a standard ConnectorCollection object.
-		static std::unique_ptr<ConnectorCollection> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static std::unique_ptr<ConnectorCollection> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 
 		virtual bool RemoveIncompleteConnectors( SocketRegistry* pRegistry = nullptr ) noexcept = 0;
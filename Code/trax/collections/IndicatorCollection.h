@@ -38,7 +38,8 @@ namespace trax{
 	struct IndicatorCollection : Collection<IndicatorCollection,Indicator>
 	{
 		/// \brief Makes a IndicatorCollection object.
-		static dclspc std::unique_ptr<IndicatorCollection> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<IndicatorCollection> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 
 		/// \brief Called during simulation to update position values.
@@ -35,7 +35,8 @@ namespace trax{
 									Identified<PulseCounterCollection>
 	{
 		/// \brief Makes a PulseCounterCollection object.
-		static dclspc std::unique_ptr<PulseCounterCollection> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<PulseCounterCollection> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 	};
 
@@ -36,7 +36,8 @@ namespace trax{
 	struct SignalCollection : Collection<SignalCollection,Signal>{
 
 		/// \brief Makes a SignalCollection object.
-		static dclspc std::unique_ptr<SignalCollection> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<SignalCollection> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 	};
 
 
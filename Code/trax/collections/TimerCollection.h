@@ -34,7 +34,8 @@ namespace trax{
 	struct TimerCollection : Collection<TimerCollection,Timer>
 	{
 		/// \brief Makes a TimerCollection object.
-		static dclspc std::unique_ptr<TimerCollection> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<TimerCollection> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 
 		virtual void Update() = 0;
@@ -47,7 +47,8 @@ namespace trax{
 								Identified<TrackCollection>
 	{
 		/// \brief Makes a standard TrackCollection object.
-		static dclspc std::unique_ptr<TrackCollection> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<TrackCollection> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 
 		///	\brief Sets the frame of references for this TrackCollection 
@@ -115,6 +116,31 @@ namespace trax{
 	std::pair<Track::TrackEnd,Track::TrackEnd> dclspc Connect( const TrackCollection& collection, Track::TrackEnd trackEnd, Length maxDistance = 1_m, Angle maxKink = pi );
 
 
+	/// \name Reservations
+	/// \brief Reservations for an id on all the tracks of a collection.
+	/// 
+	/// For TrackCollection objects made by TrackCollection::Make() the tracks
+	/// are indexed by the ids of their reservations, so only the tracks actually
+	/// carrying reservations for forID get visited.
+	/// @{
+
+	/// \brief Deletes all the reservations for forID on the tracks of the collection.
+	///
+	/// Reservations reaching into connected tracks get deleted there as well, 
+	/// like with Track::DeleteReservation().
+	/// \param collection Track collection with tracks to evaluate.
+	/// \param forID ID to delete the reservations for.
+	void dclspc DeleteReservations( TrackCollection& collection, IDType forID );
+
+
+	/// \param collection Track collection with tracks to evaluate.
+	/// \param forID ID of the reservations to test.
+	/// \returns The overlaps of the reservations for forID with other reservations
+	/// on the tracks of the collection, without duplicates. See Track::Overlaps().
+	std::vector<Track::Overlap> dclspc Overlaps( const TrackCollection& collection, IDType forID );
+	/// @}
+
+
 	/// \brief A decorator for TrackCollection.
 	///
 	/// With trax decorators can get used to augment trax objects with additional 
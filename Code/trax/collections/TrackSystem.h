@@ -163,6 +163,7 @@ namespace trax{
 		/// than maxDistance.
 		/// \param maxDistance A threshold for the distance to search track ends around the to be connected end.
 		/// \param maxKink A threshold for the maximum allowed kink angle in T and B respectively.
+		/// \throws std::invalid_argument if maxDistance or maxKink are not positive.
 		virtual void ConnectAll( Length maxDistance = 1_m, Angle maxKink = pi ) = 0;
 
 
@@ -252,6 +253,24 @@ namespace trax{
 	/// @}
 
 
+	/// \name Reservations
+	/// \brief Reservations for an id on all the tracks of a system.
+	/// @{
+
+	/// \brief Deletes all the reservations for forID on the tracks of the system.
+	/// \param system Track system with tracks to evaluate.
+	/// \param forID ID to delete the reservations for.
+	void dclspc DeleteReservations( TrackSystem& system, IDType forID );
+
+
+	/// \param system Track system with tracks to evaluate.
+	/// \param forID ID of the reservations to test.
+	/// \returns The overlaps of the reservations for forID with other reservations
+	/// on the tracks of the system, without duplicates. See Track::Overlaps().
+	std::vector<Track::Overlap> dclspc Overlaps( const TrackSystem& system, IDType forID );
+	/// @}
+
+
 	/// \brief A decorator for TrackSystems.
 	///
 	/// With trax decorators can get used to augment trax objects with additional 
@@ -61,6 +61,14 @@ namespace trax{
 
 		virtual bool CurveStart() noexcept(false) { return true; }
 
+		virtual bool BasicLine() noexcept(false) { return true; }
+
+		virtual bool BasicArc( 
+			const Arc::Data& /*data*/ ) noexcept(false) { return true; }
+
+		virtual bool BasicHelix( 
+			const Helix::Data& /*data*/ ) noexcept(false) { return true; }
+
 		virtual bool Line( 
 			const LineP::Data& /*data*/ ) noexcept(false) { return true; }
 
@@ -113,7 +121,8 @@ namespace trax{
 			PiecewiseTwist::Data /*data*/ ) noexcept(false) { return true; }
 
 		virtual bool DirectionalTwist( 
-			spat::Vector<One> /*attractor*/ ) noexcept(false) { return true; }
+			spat::Vector<One> /*attractor*/,
+			bool /*bFrozen*/ ) noexcept(false) { return true; }
 
 		virtual bool CombinedTwistStart() noexcept(false) { return true; }
 
@@ -139,9 +148,23 @@ namespace trax{
 
 	};
 
+	/// \name Streaming
+	/// \brief Parses the first track system in a traxML document and reports
+	/// it to the callback as it goes.
+	///
+	/// The document is read by a pull parser; there is no document tree built
+	/// in memory. A file gets mapped into memory for reading.
+	/// \returns false if there is no track system in the document or a callback
+	/// returned false.
+	/// \throws std::runtime_error if the document is no wellformed XML or the
+	/// file can not be read.
+	///@{
 	bool dclspc ParseTrackSystem( std::basic_istream<char>& stream, TrackSystemParser& callback ) noexcept(false);
 
 	bool dclspc ParseTrackSystem( std::string filePath, TrackSystemParser& callback ) noexcept(false);
+
+	bool dclspc ParseTrackSystem( const char* bufferStart, const char* bufferEnd, TrackSystemParser& callback ) noexcept(false);
+	///@}
 	 
 	bool dclspc ParseTrackSystem( const TrackSystem& trackSystem, TrackSystemParser& callback ) noexcept(false);
 
@@ -28,10 +28,10 @@
 
 namespace trax{
 
-std::unique_ptr<ConnectorCollection> ConnectorCollection::Make() noexcept
+std::unique_ptr<ConnectorCollection> ConnectorCollection::Make( CollectionStorage storage ) noexcept
 {
 	try{
-		return std::make_unique<ConnectorCollection_Imp>();
+		return std::make_unique<ConnectorCollection_Imp>( storage );
 	}
 	catch( const std::bad_alloc& ){
 		return nullptr;
@@ -44,26 +44,25 @@ const char* ConnectorCollection_Imp::TypeName() const noexcept{
 
 bool ConnectorCollection_Imp::IsValid() const noexcept
 {
-	return IsValid_Imp( m_Container );
+	return IsValid_Imp( *this );
 }
 
 bool ConnectorCollection_Imp::RemoveIncompleteConnectors( SocketRegistry* pRegistry ) noexcept
 {
 	bool bRemoved = false;
-	for( auto iter = m_Container.begin(); iter != m_Container.end(); )
+	for( std::shared_ptr<Connector> pConnector = GetFirst(); pConnector; )
 	{
-		auto& connector = *(iter->second);
-		if( !connector.IsComplete() )
+		std::shared_ptr<Connector> pNext = GetNext( pConnector );
+		if( !pConnector->IsComplete() )
 		{
 			if( pRegistry )
-				connector.UnregisterSockets( *pRegistry );
+				pConnector->UnregisterSockets( *pRegistry );
 
-			iter = m_Container.erase( iter );
+			ConnectorCollection_Base::Remove( pConnector.get() );
 			bRemoved = true;
 		}
-		else{
-			++iter;
-		}
+
+		pConnector = std::move(pNext);
 	}
 
 	return bRemoved;
@@ -35,6 +35,8 @@ namespace trax{
 
 	class ConnectorCollection_Imp : public ConnectorCollection_Base{
 	public:
+		using ConnectorCollection_Base::ConnectorCollection_Base;
+
 		const char* TypeName() const noexcept override;
 
 		bool IsValid() const noexcept override;
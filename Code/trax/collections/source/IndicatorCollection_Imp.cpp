@@ -28,11 +28,12 @@
 
 namespace trax{
 ////////////////////////////////////////
-std::unique_ptr<IndicatorCollection> IndicatorCollection::Make() noexcept{
-	return std::make_unique<IndicatorCollection_Imp>();
+std::unique_ptr<IndicatorCollection> IndicatorCollection::Make( CollectionStorage storage ) noexcept{
+	return std::make_unique<IndicatorCollection_Imp>( storage );
 }
 ////////////////////////////////////////
-IndicatorCollection_Imp::IndicatorCollection_Imp() noexcept
+IndicatorCollection_Imp::IndicatorCollection_Imp( CollectionStorage storage ) noexcept
+	: IndicatorCollection_Base{ storage }
 {}
 
 const char* IndicatorCollection_Imp::TypeName() const noexcept{
@@ -35,7 +35,7 @@ namespace trax{
 
 	class IndicatorCollection_Imp : public IndicatorCollection_Base{
 	public:
-		IndicatorCollection_Imp() noexcept;
+		explicit IndicatorCollection_Imp( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 		const char* TypeName() const noexcept override;
 
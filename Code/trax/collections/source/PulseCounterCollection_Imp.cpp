@@ -28,10 +28,14 @@
 
 namespace trax{
 ////////////////////////////////////////
-std::unique_ptr<PulseCounterCollection> PulseCounterCollection::Make() noexcept{
-	return std::make_unique<PulseCounterCollection_Imp>();
+std::unique_ptr<PulseCounterCollection> PulseCounterCollection::Make( CollectionStorage storage ) noexcept{
+	return std::make_unique<PulseCounterCollection_Imp>( storage );
 }
 ////////////////////////////////////////
+PulseCounterCollection_Imp::PulseCounterCollection_Imp( CollectionStorage storage ) noexcept
+	: Container_Imp<PulseCounter,PulseCounterCollection>{ storage }
+{}
+
 const char* PulseCounterCollection_Imp::TypeName() const noexcept{
 	return "PulseCounterCollection";
 }
@@ -36,6 +36,8 @@ namespace trax{
 
 	class PulseCounterCollection_Imp : public PulseCounterCollection_Base{
 	public:
+		explicit PulseCounterCollection_Imp( CollectionStorage storage = CollectionStorage::tree ) noexcept;
+
 		const char* TypeName() const noexcept override;
 
 		// Inherited via JackEnumerator
@@ -28,9 +28,9 @@
 
 namespace trax{
 ////////////////////////////////////////
-std::unique_ptr<SignalCollection> SignalCollection::Make() noexcept{
+std::unique_ptr<SignalCollection> SignalCollection::Make( CollectionStorage storage ) noexcept{
 	try{
-		return std::make_unique<SignalCollection_Imp>();
+		return std::make_unique<SignalCollection_Imp>( storage );
 	}
 	catch( ... ){
 		return nullptr;
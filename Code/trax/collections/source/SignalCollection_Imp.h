@@ -35,6 +35,8 @@ namespace trax{
 
 	class SignalCollection_Imp : public SignalCollection_Base{
 	public:
+		using SignalCollection_Base::SignalCollection_Base;
+
 		const char* TypeName() const noexcept override;
 	};
 
@@ -28,8 +28,8 @@
 
 namespace trax{
 ////////////////////////////////////////
-std::unique_ptr<TimerCollection> TimerCollection::Make() noexcept{
-	return std::make_unique<TimerCollection_Imp>();
+std::unique_ptr<TimerCollection> TimerCollection::Make( CollectionStorage storage ) noexcept{
+	return std::make_unique<TimerCollection_Imp>( storage );
 }
 ////////////////////////////////////////
 const char* TimerCollection_Imp::TypeName() const noexcept{
@@ -34,6 +34,8 @@ namespace trax{
 
 	class TimerCollection_Imp : public JackEnumerator_Imp<Container_Imp<Timer,TimerCollection>>{
 	public:
+		using JackEnumerator_Imp::JackEnumerator_Imp;
+
 		const char*	TypeName() const noexcept override;
 
 		void Update() override;
@@ -0,0 +1,377 @@
+//	trax track library
+//	AD 2026 
+//
+//  "the resolution of all the fruitless searches"
+//
+//								Peter Gabriel
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software 
+// and associated source code (the "Software"), to use, view, and study the 
+// Software for personal or internal business purposes, subject to the following 
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the 
+// Software is NOT permitted without prior written consent from the copyright 
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express 
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+
+#include "TrackAABBTree.h"
+
+#include "spat/Position.h"
+#include "spat/Vector.h"
+#include "spat/VectorBundle.h"
+
+#include <algorithm>
+
+namespace trax{
+	using namespace spat;
+
+static inline Area HalfSurface( const Box<Length>& box ) noexcept{
+	const Vector<Length> d = box.Diagonal();
+	return d.dx*d.dy + d.dy*d.dz + d.dz*d.dx;
+}
+
+static inline Box<Length> Union( const Box<Length>& a, const Box<Length>& b ) noexcept{
+	Box<Length> box;
+	return box.Union( a, b );
+}
+
+static inline bool Overlapping( const Interval<Length>& a, const Interval<Length>& b ) noexcept{
+	return a.Near() <= b.Far() && b.Near() <= a.Far();
+}
+
+static inline bool Overlapping( const Box<Length>& box, const Sphere<Length>& area ) noexcept{
+	const Box<Length> sphereBox = area.ExBox();
+	return	Overlapping( box.m_WidthX, sphereBox.m_WidthX ) &&
+			Overlapping( box.m_WidthY, sphereBox.m_WidthY ) &&
+			Overlapping( box.m_WidthZ, sphereBox.m_WidthZ );
+}
+
+// Slab test for the infinite line through ray.P along ray.T:
+static inline bool Overlapping( const Interval<Length>& slab, Length p, One t, Length& tmin, Length& tmax ) noexcept{
+	if( abs(t) < epsilon__one )
+		return slab.Near() <= p && p <= slab.Far();
+
+	Length t1 = (slab.Near() - p) / t;
+	Length t2 = (slab.Far() - p) / t;
+	if( t1 > t2 )
+		std::swap( t1, t2 );
+
+	tmin = std::max( tmin, t1 );
+	tmax = std::min( tmax, t2 );
+	return tmin <= tmax;
+}
+
+static inline bool Overlapping( const Box<Length>& box, const VectorBundle<Length,One>& ray ) noexcept{
+	Length tmin = -infinite__length;
+	Length tmax = +infinite__length;
+	return	Overlapping( box.m_WidthX, ray.P.x, ray.T.dx, tmin, tmax ) &&
+			Overlapping( box.m_WidthY, ray.P.y, ray.T.dy, tmin, tmax ) &&
+			Overlapping( box.m_WidthZ, ray.P.z, ray.T.dz, tmin, tmax );
+}
+///////////////////////////////////////
+TrackAABBTree::TrackAABBTree( Length tolerance ) noexcept
+	: m_Tolerance	{ tolerance },
+	  m_Root		{ null_node },
+	  m_FreeList	{ null_node }
+{
+	assert( m_Tolerance > 0_m );
+}
+
+TrackAABBTree::~TrackAABBTree(){
+	Clear();
+}
+
+void TrackAABBTree::Insert( Track_Imp& track ){
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	if( m_Leafs.find( &track ) != m_Leafs.end() )
+		return;
+
+	// Every track is at most once in the dirty list, so 
+	// reserving here keeps OnGeometryChanged() from allocating.
+	m_Dirty.reserve( m_Leafs.size() + 1 );
+	m_Leafs.emplace( &track, Leaf{} );
+	m_Dirty.push_back( &track );
+	track.SetGeometryListener( this );
+}
+
+void TrackAABBTree::Remove( Track_Imp& track ) noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	auto iter = m_Leafs.find( &track );
+	if( iter == m_Leafs.end() )
+		return;
+
+	if( iter->second.node != null_node ){
+		RemoveLeaf( iter->second.node );
+		FreeNode( iter->second.node );
+	}
+
+	if( iter->second.bDirty )
+		m_Dirty.erase( std::remove( m_Dirty.begin(), m_Dirty.end(), &track ), m_Dirty.end() );
+
+	m_Leafs.erase( iter );
+
+	if( track.GetGeometryListener() == this )
+		track.SetGeometryListener( nullptr );
+}
+
+void TrackAABBTree::Clear() noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	for( auto& pair : m_Leafs ){
+		Track_Imp& track = const_cast<Track_Imp&>(*pair.first);
+		if( track.GetGeometryListener() == this )
+			track.SetGeometryListener( nullptr );
+	}
+
+	m_Leafs.clear();
+	m_Dirty.clear();
+	m_Nodes.clear();
+	m_Root = null_node;
+	m_FreeList = null_node;
+}
+
+int TrackAABBTree::Count() const noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+	return static_cast<int>(m_Leafs.size());
+}
+
+std::vector<const Track_Imp*> TrackAABBTree::Query( const Sphere<Length>& area ) const{
+	return Collect( [&area]( const Box<Length>& box ) noexcept { return Overlapping( box, area ); } );
+}
+
+std::vector<const Track_Imp*> TrackAABBTree::Query( const VectorBundle<Length,One>& ray, Length distance ) const{
+	return Collect( [&ray,distance]( Box<Length> box ) noexcept { 
+		return Overlapping( box.Inflate( distance, distance, distance ), ray ); } );
+}
+
+Box<Length> TrackAABBTree::GetBox( const Track_Imp& track ) const{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+	Refit();
+
+	auto iter = m_Leafs.find( &track );
+	if( iter != m_Leafs.end() && iter->second.node != null_node )
+		return m_Nodes[iter->second.node].box;
+
+	return { 0_m, 0_m, 0_m, -1_m, -1_m, -1_m };
+}
+
+void TrackAABBTree::OnGeometryChanged( const Track_Imp& track ) noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	auto iter = m_Leafs.find( &track );
+	if( iter != m_Leafs.end() && !iter->second.bDirty ){
+		iter->second.bDirty = true;
+		m_Dirty.push_back( &track );
+	}
+}
+
+void TrackAABBTree::Refit() const{
+	for( const Track_Imp* pTrack : m_Dirty ){
+		auto iter = m_Leafs.find( pTrack );
+		if( iter == m_Leafs.end() || !iter->second.bDirty )
+			continue;
+
+		Leaf& leaf = iter->second;
+		Box<Length> box;
+		const bool bValid = CalculateBox( *pTrack, box );
+
+		if( leaf.node != null_node ){
+			RemoveLeaf( leaf.node );
+			if( !bValid ){
+				FreeNode( leaf.node );
+				leaf.node = null_node;
+			}
+		}
+		else if( bValid ){
+			leaf.node = AllocateNode();
+			m_Nodes[leaf.node].pTrack = pTrack;
+		}
+
+		if( bValid ){
+			m_Nodes[leaf.node].box = box;
+			InsertLeaf( leaf.node );
+		}
+
+		leaf.bDirty = false;
+	}
+
+	m_Dirty.clear();
+}
+
+bool TrackAABBTree::CalculateBox( const Track_Imp& track, Box<Length>& box ) const{
+	if( !track.IsValid() )
+		return false;
+
+	try{
+		const Length length = track.GetLength();
+		Position<Length> pos;
+		track.Transition( 0_m, pos );
+		box = { pos, pos };
+
+		for( Length s = 0_m; s < length; ){
+			// The deviation of the curve from the chord is about k*ds*ds/8 <= e/8 
+			// and for the shortest segments at most ds/2, which both are covered 
+			// by inflating the box with e.
+			const Length ds = Segment_Checked( track, s, m_Tolerance, { m_Tolerance, 100_m } );
+			if( ds <= 0_m )
+				break;
+
+			s = std::min( s + ds, length );
+			track.Transition( s, pos );
+			box.Expand( pos );
+		}
+
+		box.Inflate( m_Tolerance, m_Tolerance, m_Tolerance );
+		return true;
+	}
+	catch( const std::exception& ){
+		return false;
+	}
+}
+
+int TrackAABBTree::AllocateNode() const{
+	if( m_FreeList == null_node ){
+		m_Nodes.push_back( Node{} );
+		return static_cast<int>(m_Nodes.size()) - 1;
+	}
+
+	const int node = m_FreeList;
+	m_FreeList = m_Nodes[node].parent;
+	m_Nodes[node] = Node{};
+	return node;
+}
+
+void TrackAABBTree::FreeNode( int node ) const noexcept{
+	m_Nodes[node] = Node{};
+	m_Nodes[node].parent = m_FreeList;
+	m_FreeList = node;
+}
+
+void TrackAABBTree::InsertLeaf( int leaf ) const{
+	if( m_Root == null_node ){
+		m_Root = leaf;
+		m_Nodes[leaf].parent = null_node;
+		return;
+	}
+
+	// Find the best sibling by the surface area heuristic:
+	const Box<Length> leafBox = m_Nodes[leaf].box;
+	int sibling = m_Root;
+	while( !m_Nodes[sibling].IsLeaf() ){
+		const Node& node = m_Nodes[sibling];
+		const Area combinedArea = HalfSurface( Union( node.box, leafBox ) );
+		const Area cost = 2 * combinedArea;
+		const Area inheritanceCost = 2 * (combinedArea - HalfSurface( node.box ));
+
+		auto DescendCost = [this,&leafBox,inheritanceCost]( int child ) noexcept -> Area {
+			const Node& childNode = m_Nodes[child];
+			const Area area = HalfSurface( Union( childNode.box, leafBox ) );
+			return (childNode.IsLeaf() ? area : area - HalfSurface( childNode.box )) + inheritanceCost;
+		};
+
+		const Area costLeft = DescendCost( node.left );
+		const Area costRight = DescendCost( node.right );
+		if( cost < costLeft && cost < costRight )
+			break;
+
+		sibling = costLeft < costRight ? node.left : node.right;
+	}
+
+	const int newParent = AllocateNode();
+	const int oldParent = m_Nodes[sibling].parent;
+	m_Nodes[newParent].parent = oldParent;
+	m_Nodes[newParent].left = sibling;
+	m_Nodes[newParent].right = leaf;
+	m_Nodes[newParent].box = Union( leafBox, m_Nodes[sibling].box );
+	m_Nodes[sibling].parent = newParent;
+	m_Nodes[leaf].parent = newParent;
+
+	if( oldParent == null_node )
+		m_Root = newParent;
+	else if( m_Nodes[oldParent].left == sibling )
+		m_Nodes[oldParent].left = newParent;
+	else
+		m_Nodes[oldParent].right = newParent;
+
+	RefitAncestors( oldParent );
+}
+
+void TrackAABBTree::RemoveLeaf( int leaf ) const noexcept{
+	if( leaf == m_Root ){
+		m_Root = null_node;
+		return;
+	}
+
+	const int parent = m_Nodes[leaf].parent;
+	const int grandParent = m_Nodes[parent].parent;
+	const int sibling = m_Nodes[parent].left == leaf ? m_Nodes[parent].right : m_Nodes[parent].left;
+
+	if( grandParent == null_node ){
+		m_Root = sibling;
+		m_Nodes[sibling].parent = null_node;
+	}
+	else{
+		if( m_Nodes[grandParent].left == parent )
+			m_Nodes[grandParent].left = sibling;
+		else
+			m_Nodes[grandParent].right = sibling;
+
+		m_Nodes[sibling].parent = grandParent;
+	}
+
+	FreeNode( parent );
+	m_Nodes[leaf].parent = null_node;
+	RefitAncestors( grandParent );
+}
+
+void TrackAABBTree::RefitAncestors( int node ) const noexcept{
+	for( ; node != null_node; node = m_Nodes[node].parent )
+		m_Nodes[node].box = Union( m_Nodes[m_Nodes[node].left].box, m_Nodes[m_Nodes[node].right].box );
+}
+
+template<class Predicate>
+std::vector<const Track_Imp*> TrackAABBTree::Collect( Predicate&& overlaps ) const{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+	Refit();
+
+	std::vector<const Track_Imp*> tracks;
+	if( m_Root == null_node )
+		return tracks;
+
+	std::vector<int> stack;
+	stack.push_back( m_Root );
+	while( !stack.empty() ){
+		const Node& node = m_Nodes[stack.back()];
+		stack.pop_back();
+
+		if( !overlaps( node.box ) )
+			continue;
+
+		if( node.IsLeaf() )
+			tracks.push_back( node.pTrack );
+		else{
+			stack.push_back( node.left );
+			stack.push_back( node.right );
+		}
+	}
+
+	std::sort( tracks.begin(), tracks.end(), 
+		[]( const Track_Imp* pA, const Track_Imp* pB ) noexcept { return pA->ID() < pB->ID(); } );
+
+	return tracks;
+}
+
+}
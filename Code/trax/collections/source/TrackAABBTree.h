@@ -0,0 +1,137 @@
+//	trax track library
+//	AD 2026 
+//
+//  "the resolution of all the fruitless searches"
+//
+//								Peter Gabriel
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software 
+// and associated source code (the "Software"), to use, view, and study the 
+// Software for personal or internal business purposes, subject to the following 
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the 
+// Software is NOT permitted without prior written consent from the copyright 
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express 
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+
+#pragma once
+
+#include "trax/source/Track_Imp.h"
+
+#include "spat/Box.h"
+#include "spat/Sphere.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace trax{
+
+	/// \brief Dynamic bounding volume hierarchy over the tracks of a collection.
+	///
+	/// Every track gets a leaf with a tight axis aligned box around its curve,
+	/// sampled with Segment_Checked() and inflated by the sampling tolerance. 
+	/// The tree listens to the tracks' geometry changes and marks the leaves 
+	/// dirty; dirty leaves get refitted lazily on the next query. Invalid tracks
+	/// are kept but never reported.
+	class TrackAABBTree : public TrackGeometryListener{
+	public:
+		/// \param tolerance Maximum distance the sampled track 
+		/// polygon is allowed to deviate from the track.
+		TrackAABBTree( Length tolerance = 5_cm ) noexcept;
+		TrackAABBTree( const TrackAABBTree& ) = delete;
+		TrackAABBTree( TrackAABBTree&& ) = delete;
+		~TrackAABBTree();
+
+		TrackAABBTree& operator=( const TrackAABBTree& ) = delete;
+		TrackAABBTree& operator=( TrackAABBTree&& ) = delete;
+
+
+		/// \brief Adds the track to the index and registers as 
+		/// its geometry listener.
+		void Insert( Track_Imp& track );
+
+
+		/// \brief Removes the track from the index.
+		void Remove( Track_Imp& track ) noexcept;
+
+
+		/// \brief Removes all the tracks.
+		void Clear() noexcept;
+
+
+		/// \returns The number of tracks in the index.
+		int Count() const noexcept;
+
+
+		/// \returns All the tracks whose bounding box intersects the area,
+		/// ordered by their ID.
+		std::vector<const Track_Imp*> Query( const spat::Sphere<Length>& area ) const;
+
+
+		/// \returns All the tracks whose bounding box, inflated by distance, 
+		/// intersects the (infinite) line ray, ordered by their ID.
+		std::vector<const Track_Imp*> Query( const spat::VectorBundle<Length,One>& ray, Length distance ) const;
+
+
+		/// \returns The bounding box of the track; an unnormalized box 
+		/// if the track is not valid or not a member.
+		spat::Box<Length> GetBox( const Track_Imp& track ) const;
+
+
+		// TrackGeometryListener:
+		void OnGeometryChanged( const Track_Imp& track ) noexcept override;
+	private:
+		static constexpr int null_node = -1;
+
+		struct Node{
+			spat::Box<Length>	box;
+			int					parent	= null_node;
+			int					left	= null_node;
+			int					right	= null_node;
+			const Track_Imp*	pTrack	= nullptr;	// leafs only
+
+			bool IsLeaf() const noexcept{
+				return left == null_node;
+			}
+		};
+
+		struct Leaf{
+			int		node	= null_node; // null_node if the track has no valid box
+			bool	bDirty	= true;
+		};
+
+		const Length m_Tolerance;
+
+		mutable std::mutex m_Mutex;
+		mutable std::vector<Node> m_Nodes;
+		mutable int m_Root;
+		mutable int m_FreeList;
+		mutable std::unordered_map<const Track_Imp*,Leaf> m_Leafs;
+		mutable std::vector<const Track_Imp*> m_Dirty;
+
+		void Refit() const;
+		bool CalculateBox( const Track_Imp& track, spat::Box<Length>& box ) const;
+
+		int AllocateNode() const;
+		void FreeNode( int node ) const noexcept;
+		void InsertLeaf( int leaf ) const;
+		void RemoveLeaf( int leaf ) const noexcept;
+		void RefitAncestors( int node ) const noexcept;
+
+		template<class Predicate>
+		std::vector<const Track_Imp*> Collect( Predicate&& overlaps ) const;
+	};
+
+}
@@ -87,7 +87,7 @@ const char* TrackCollectionContainer_Imp::TypeName() const noexcept{
 }
 
 bool TrackCollectionContainer_Imp::IsValid() const noexcept{
-	return IsValid_Imp( m_Container );
+	return IsValid_Imp( *this );
 }
 
 IDType TrackCollectionContainer_Imp::Add( std::shared_ptr<TrackCollection> pTrackCollection ){
@@ -115,10 +115,9 @@ void TrackCollectionContainer_Imp::Clear() noexcept {
 }
 
 void TrackCollectionContainer_Imp::SetCollectionsAbsoluteFrame( const Frame<Length,One>& frame ) noexcept{
-	std::for_each( m_Container.begin(), m_Container.end(),
-		[&frame]( const std::pair<IDType,std::shared_ptr<TrackCollection>>& pair ) noexcept
+	ForEach( [&frame]( const std::shared_ptr<TrackCollection>& pTrackCollection ) noexcept
 	{
-		if( auto pTrackCollection_Imp = decorator_cast<TrackCollection_Imp*>( pair.second.get() ) )
+		if( auto pTrackCollection_Imp = decorator_cast<TrackCollection_Imp*>( pTrackCollection.get() ) )
 			pTrackCollection_Imp->SetAbsoluteFrame(frame);
 	});
 }
@@ -40,18 +40,19 @@
 
 namespace trax{
 
-TrackCollection_Imp::TrackCollection_Imp() noexcept
-	: m_pParent{ nullptr }
+TrackCollection_Imp::TrackCollection_Imp( CollectionStorage storage ) noexcept
+	: Container_Imp<TrackBuilder,TrackCollection>{ storage }
+	, m_pParent{ nullptr }
 {}
 
 TrackCollection_Imp::~TrackCollection_Imp(){
 	DoClear();
 }
 
-std::unique_ptr<TrackCollection> TrackCollection::Make() noexcept
+std::unique_ptr<TrackCollection> TrackCollection::Make( CollectionStorage storage ) noexcept
 {
 	try{
-		return std::make_unique<TrackCollection_Imp>();
+		return std::make_unique<TrackCollection_Imp>( storage );
 	}
 	catch( const std::bad_alloc& ){
 		return nullptr;
@@ -80,14 +81,17 @@ const char* TrackCollection_Imp::TypeName() const noexcept{
 
 bool TrackCollection_Imp::IsValid() const noexcept
 {
-	return IsValid_Imp( m_Container );
+	return IsValid_Imp( *this );
 }
 
 IDType TrackCollection_Imp::Add( std::shared_ptr<TrackBuilder> pTrack ){
 	if( IDType retval = TrackCollection_Base::Add( pTrack ) )
 	{
-		if( auto pTrack_Imp = dynamic_cast<Track_Imp*>(pTrack.get()) )
+		if( auto pTrack_Imp = dynamic_cast<Track_Imp*>(pTrack.get()) ){
 			pTrack_Imp->SetAbsoluteFrame( GetAbsoluteFrame() * GetFrame() );
+			m_TrackTree.Insert( *pTrack_Imp );
+			m_ReservationIndex.Insert( *pTrack_Imp );
+		}
 
 		return retval;
 	}
@@ -98,8 +102,11 @@ IDType TrackCollection_Imp::Add( std::shared_ptr<TrackBuilder> pTrack ){
 bool TrackCollection_Imp::Remove( TrackBuilder* pTrack, bool zeroIDs ){
 	if( TrackCollection_Base::Remove( pTrack, zeroIDs ) )
 	{
-		if( auto pTrack_Imp = dynamic_cast<Track_Imp*>(pTrack) )
+		if( auto pTrack_Imp = dynamic_cast<Track_Imp*>(pTrack) ){
+			m_TrackTree.Remove( *pTrack_Imp );
+			m_ReservationIndex.Remove( *pTrack_Imp );
 			pTrack_Imp->SetAbsoluteFrame( Identity<Length,One> );
+		}
 
 		return true;
 	}
@@ -113,6 +120,14 @@ void TrackCollection_Imp::Clear() noexcept {
 	TrackCollection_Base::Clear();
 }
 
+const TrackAABBTree& TrackCollection_Imp::GetTrackTree() const noexcept{
+	return m_TrackTree;
+}
+
+const TrackReservationIndex& TrackCollection_Imp::GetReservationIndex() const noexcept{
+	return m_ReservationIndex;
+}
+
 void TrackCollection_Imp::PropagateAbsoluteFrameToClients() noexcept{
 	TrackCollection_Base::PropagateAbsoluteFrameToClients();
 	SetTracksAbsoluteFrames( GetAbsoluteFrame() * GetFrame() );
@@ -124,14 +139,15 @@ void TrackCollection_Imp::SetTrackAbsoluteFrame( TrackBuilder* pTrack, const Fra
 }
 
 void TrackCollection_Imp::SetTracksAbsoluteFrames( const Frame<Length,One>& frame ) const noexcept{
-	std::for_each( m_Container.begin(), m_Container.end(),
-		[&frame,this]( const std::pair<IDType,std::shared_ptr<TrackBuilder>>& pair  ) noexcept
+	ForEach( [&frame,this]( const std::shared_ptr<TrackBuilder>& pTrack ) noexcept
 	{
-		SetTrackAbsoluteFrame( pair.second.get(), frame );
+		SetTrackAbsoluteFrame( pTrack.get(), frame );
 	});
 }
 
 void TrackCollection_Imp::DoClear() noexcept {
+	m_TrackTree.Clear();
+	m_ReservationIndex.Clear();
 	SetFrame( Identity<Length,One> );
 
 	for( TrackBuilder& track : *this ){
@@ -140,6 +156,20 @@ void TrackCollection_Imp::DoClear() noexcept {
 	}
 }
 ///////////////////////////////////////
+// The tracks of a collection that might be touched by the area 
+// in the order of their IDs, which is the order of the collection.
+template<class Function,typename Query>
+static void ForEachCandidate( const TrackCollection& collection, Query&& query, Function&& function ){
+	if( auto pCollection = decorator_cast<TrackCollection_Imp*>( const_cast<TrackCollection*>(&collection) ) ){
+		for( const Track_Imp* pTrack : query( pCollection->GetTrackTree() ) )
+			function( *pTrack );
+	}
+	else{
+		for( const TrackBuilder& track : collection )
+			function( track );
+	}
+}
+
 std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> FindTrackEnds( 
 	const TrackCollection& collection, 
 	const spat::Sphere<Length>& area, 
@@ -147,7 +177,10 @@ std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> FindTrackE
 {
 	std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> retval;
 
-	for( const TrackBuilder& track : collection ){
+	ForEachCandidate( collection, 
+		[&area]( const TrackAABBTree& tree ){ return tree.Query( area ); },
+		[&area,&retval]( const TrackBuilder& track )
+	{
 		if( track.IsValid() ){
 			Position<Length> trackEndPos;
 		
@@ -159,7 +192,7 @@ std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> FindTrackE
 			if( area.Includes(trackEndPos) )
 				retval.push_back( { std::const_pointer_cast<TrackBuilder>(track.This()), EndType::south, (trackEndPos-area.c).Length() } );
 		}
-	}
+	});
 
 	if( sort )
 		std::sort( retval.begin(), retval.end(), 
@@ -175,7 +208,10 @@ std::vector<std::pair<Location, Length>> FindTrackLocations(
 {
 	std::vector<std::pair<Location, Length>> locations;
 
-	for( const auto& track : collection ){
+	ForEachCandidate( collection, 
+		[&area]( const TrackAABBTree& tree ){ return tree.Query( area ); },
+		[&area,&locations]( const TrackBuilder& track )
+	{
 		Sphere<Length> boundingSphere;
 		boundingSphere.r = track.GetLength()/2;
 		track.Transition( boundingSphere.r, boundingSphere.c );
@@ -191,7 +227,7 @@ std::vector<std::pair<Location, Length>> FindTrackLocations(
 					locations.push_back( std::make_pair( Location{ track.This(), TrackLocation{ s } }, distance ) );
 			}
 		}
-	}
+	});
 
 	if( sort )
 		std::sort( locations.begin(), locations.end(), 
@@ -210,7 +246,9 @@ std::vector<std::pair<Location,Length>> FindTrackLocations(
 
 	if( gauge > 0_m )
 	{
-		for( const auto& track : collection )
+		ForEachCandidate( collection, 
+			[&ray,gauge]( const TrackAABBTree& tree ){ return tree.Query( ray, gauge/2 ); },
+			[&ray,gauge,&locations]( const TrackBuilder& track )
 		{
 			Sphere<Length> boundingSphere;
 			boundingSphere.r = track.GetLength()/2;
@@ -229,7 +267,7 @@ std::vector<std::pair<Location,Length>> FindTrackLocations(
 						locations.push_back( std::make_pair( Location{ track.This(), TrackLocation{ s } }, D.Length() ) );
 				}
 			}
-		}
+		});
 
 		if( sort )
 			std::sort( locations.begin(), locations.end(), 
@@ -351,7 +389,18 @@ std::pair<Track::TrackEnd,Track::TrackEnd> Connect(
 	trackEnd.pTrack->Transition( s, trackEndFrame );
 	const spat::Sphere<Length> searchArea{ trackEndFrame.P, maxDistance };
 
-	std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> TrackEnds = FindTrackEnds( collection, searchArea, true );
+	return ConnectToClosest( trackEnd, trackEndFrame, FindTrackEnds( collection, searchArea, true ), maxKink );
+}
+
+std::pair<Track::TrackEnd,Track::TrackEnd> ConnectToClosest( 
+	Track::TrackEnd trackEnd, 
+	const spat::Frame<Length,One>& trackEndFrame, 
+	std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> TrackEnds, 
+	Angle maxKink )
+{
+	assert( trackEnd.end == EndType::north || trackEnd.end == EndType::south );
+	const Length s = (trackEnd.end == EndType::north) ? 0_m : trackEnd.pTrack->GetLength();
+
 	TrackEnds.erase( 
 		std::remove_if( 
 			TrackEnds.begin(), 
@@ -470,5 +519,37 @@ std::pair<Track::TrackEnd,Track::TrackEnd> Connect(
 
 	return {};
 }
+
+void DeleteReservations( TrackCollection& collection, IDType forID ){
+	const common::Interval<Length> everywhere{ -infinite__length, +infinite__length };
+
+	if( auto pCollection = decorator_cast<TrackCollection_Imp*>( &collection ) ){
+		for( Track_Imp* pTrack : pCollection->GetReservationIndex().Query( forID ) )
+			pTrack->DeleteReservation( everywhere, forID );
+	}
+	else{
+		for( TrackBuilder& track : collection )
+			track.DeleteReservation( everywhere, forID );
+	}
+}
+
+std::vector<Track::Overlap> Overlaps( const TrackCollection& collection, IDType forID ){
+	std::vector<Track::Overlap> overlaps;
+
+	if( auto pCollection = decorator_cast<TrackCollection_Imp*>( const_cast<TrackCollection*>(&collection) ) ){
+		for( const Track_Imp* pTrack : pCollection->GetReservationIndex().Query( forID ) )
+			pTrack->Overlaps( forID, overlaps );
+	}
+	else{
+		for( const TrackBuilder& track : collection ){
+			const std::vector<Track::Overlap> trackOverlaps = track.Overlaps( forID );
+			overlaps.insert( overlaps.end(), trackOverlaps.begin(), trackOverlaps.end() );
+		}
+	}
+
+	std::sort( overlaps.begin(), overlaps.end() );
+	overlaps.erase( std::unique( overlaps.begin(), overlaps.end() ), overlaps.end() );
+	return overlaps;
+}
 ///////////////////////////////////////
 }
\ No newline at end of file
@@ -28,6 +28,8 @@
 
 #include "trax/collections/TrackCollection.h"
 #include "trax/ImplementationHelper.h"
+#include "TrackAABBTree.h"
+#include "TrackReservationIndex.h"
 
 namespace trax{
 
@@ -39,7 +41,7 @@ namespace trax{
 
 	class TrackCollection_Imp : public TrackCollection_Base{
 	public:
-		TrackCollection_Imp() noexcept;
+		explicit TrackCollection_Imp( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 		TrackCollection_Imp( const TrackCollection_Imp& ) = delete;
 		TrackCollection_Imp( TrackCollection_Imp&& ) = delete;
 		~TrackCollection_Imp();
@@ -61,8 +63,18 @@ namespace trax{
 		bool	Remove	( TrackBuilder* pTrack, bool zeroIDs = false ) override;
 		
 		void	Clear	() noexcept override;
+
+
+		/// \returns The spatial index over the collection's tracks.
+		const TrackAABBTree& GetTrackTree() const noexcept;
+
+
+		/// \returns The index of the collection's tracks by reservation ids.
+		const TrackReservationIndex& GetReservationIndex() const noexcept;
 	private:
 		TrackSystem* m_pParent;
+		TrackAABBTree m_TrackTree;
+		TrackReservationIndex m_ReservationIndex;
 
 		void PropagateAbsoluteFrameToClients() noexcept override;
 
@@ -73,4 +85,20 @@ namespace trax{
 		void DoClear() noexcept;
 	};
 
+
+	/// \brief Connects trackEnd to the nearest of the candidate ends, that 
+	/// does not belong to the same track, is not connected already and 
+	/// fits to trackEndFrame within maxKink.
+	/// \param trackEnd north or south end of a track.
+	/// \param trackEndFrame The frame of the track at trackEnd.
+	/// \param trackEnds Candidate track ends with their distances, sorted 
+	/// like delivered by FindTrackEnds().
+	/// \param maxKink Maximum angle between the track ends.
+	/// \returns The connected ends like Connect().
+	std::pair<Track::TrackEnd,Track::TrackEnd> ConnectToClosest( 
+		Track::TrackEnd trackEnd, 
+		const spat::Frame<Length,One>& trackEndFrame, 
+		std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> trackEnds, 
+		Angle maxKink );
+
 }
\ No newline at end of file
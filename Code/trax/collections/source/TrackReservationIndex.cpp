@@ -0,0 +1,129 @@
+//	trax track library
+//	AD 2026 
+//
+//  "the resolution of all the fruitless searches"
+//
+//								Peter Gabriel
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software 
+// and associated source code (the "Software"), to use, view, and study the 
+// Software for personal or internal business purposes, subject to the following 
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the 
+// Software is NOT permitted without prior written consent from the copyright 
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express 
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+
+
+
+#include "TrackReservationIndex.h"
+
+#include <algorithm>
+
+namespace trax{
+
+TrackReservationIndex::~TrackReservationIndex(){
+	Clear();
+}
+
+void TrackReservationIndex::Insert( Track_Imp& track ){
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	if( !m_Tracks.insert( &track ).second )
+		return;
+
+	for( auto iter = track.BeginReservations(); iter != track.EndReservations(); ++iter )
+		++m_Reservations[std::get<0>(*iter)][&track];
+
+	track.SetReservationListener( this );
+}
+
+void TrackReservationIndex::Remove( Track_Imp& track ) noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	if( m_Tracks.erase( &track ) == 0 )
+		return;
+
+	for( auto iter = m_Reservations.begin(); iter != m_Reservations.end(); ){
+		iter->second.erase( &track );
+		if( iter->second.empty() )
+			iter = m_Reservations.erase( iter );
+		else
+			++iter;
+	}
+
+	if( track.GetReservationListener() == this )
+		track.SetReservationListener( nullptr );
+}
+
+void TrackReservationIndex::Clear() noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	for( Track_Imp* pTrack : m_Tracks )
+		if( pTrack->GetReservationListener() == this )
+			pTrack->SetReservationListener( nullptr );
+
+	m_Tracks.clear();
+	m_Reservations.clear();
+}
+
+std::vector<Track_Imp*> TrackReservationIndex::Query( IDType forID ) const{
+	std::vector<Track_Imp*> tracks;
+
+	{
+		std::lock_guard<std::mutex> lock( m_Mutex );
+
+		if( auto iter = m_Reservations.find( forID ); iter != m_Reservations.end() ){
+			tracks.reserve( iter->second.size() );
+			for( const auto& pair : iter->second )
+				tracks.push_back( const_cast<Track_Imp*>(pair.first) );
+		}
+	}
+
+	std::sort( tracks.begin(), tracks.end(), 
+		[]( const Track_Imp* pA, const Track_Imp* pB ) noexcept { return pA->ID() < pB->ID(); } );
+
+	return tracks;
+}
+
+void TrackReservationIndex::OnReserved( const Track_Imp& track, IDType forID ) noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	try{
+		++m_Reservations[forID][&track];
+	}
+	catch( const std::bad_alloc& ){
+		assert( !"TrackReservationIndex: out of memory!" );
+	}
+}
+
+void TrackReservationIndex::OnReservationDeleted( const Track_Imp& track, IDType forID ) noexcept{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	auto iter = m_Reservations.find( forID );
+	if( iter == m_Reservations.end() )
+		return;
+
+	auto counter = iter->second.find( &track );
+	if( counter == iter->second.end() )
+		return;
+
+	if( --counter->second <= 0 ){
+		iter->second.erase( counter );
+		if( iter->second.empty() )
+			m_Reservations.erase( iter );
+	}
+}
+
+}
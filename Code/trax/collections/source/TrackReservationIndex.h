@@ -0,0 +1,85 @@
+//	trax track library
+//	AD 2026 
+//
+//  "the resolution of all the fruitless searches"
+//
+//								Peter Gabriel
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software 
+// and associated source code (the "Software"), to use, view, and study the 
+// Software for personal or internal business purposes, subject to the following 
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the 
+// Software is NOT permitted without prior written consent from the copyright 
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express 
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+
+
+#pragma once
+
+#include "trax/source/Track_Imp.h"
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace trax{
+
+	/// \brief Index of the tracks of a collection by the ids of their reservations.
+	///
+	/// The index listens to the tracks' reservations and counts them per id 
+	/// and track, so the tracks carrying reservations for a given id are 
+	/// found without visiting every track.
+	class TrackReservationIndex : public TrackReservationListener{
+	public:
+		TrackReservationIndex() = default;
+		TrackReservationIndex( const TrackReservationIndex& ) = delete;
+		TrackReservationIndex( TrackReservationIndex&& ) = delete;
+		~TrackReservationIndex();
+
+		TrackReservationIndex& operator=( const TrackReservationIndex& ) = delete;
+		TrackReservationIndex& operator=( TrackReservationIndex&& ) = delete;
+
+
+		/// \brief Adds the track with its present reservations to the 
+		/// index and registers as its reservation listener.
+		void Insert( Track_Imp& track );
+
+
+		/// \brief Removes the track from the index.
+		void Remove( Track_Imp& track ) noexcept;
+
+
+		/// \brief Removes all the tracks.
+		void Clear() noexcept;
+
+
+		/// \returns All the tracks carrying reservations for forID, 
+		/// ordered by their ID.
+		std::vector<Track_Imp*> Query( IDType forID ) const;
+
+
+		// TrackReservationListener:
+		void OnReserved( const Track_Imp& track, IDType forID ) noexcept override;
+
+		void OnReservationDeleted( const Track_Imp& track, IDType forID ) noexcept override;
+	private:
+		mutable std::mutex m_Mutex;
+		std::unordered_set<Track_Imp*> m_Tracks;
+		std::map<IDType,std::unordered_map<const Track_Imp*,int>> m_Reservations; // reservation count per id and track
+	};
+
+}
@@ -31,10 +31,13 @@
 #include "trax/collections/TrackCollection.h"
 #include "trax/collections/ConnectorCollection.h"
 #include "TrackCollectionContainer_Imp.h"
+#include "TrackCollection_Imp.h"
 #include "trax/source/Track_Imp.h"
 #include "spat/Sphere.h"
 
+#include <cmath>
 #include <iostream>
+#include <unordered_map>
 
 namespace trax{
 
@@ -404,19 +407,124 @@ void TrackSystem_Imp::Connection( const Track::Connection& couplings, Track::Con
 		}
 }
 
+// Uniform hash grid of track end positions with a cell size of the
+// search radius, so that a search only has to look into the 
+// neighbouring cells.
+class TrackEndGrid{
+public:
+	TrackEndGrid( const TrackCollection& collection, Length cellSize )
+		: m_CellSize{ cellSize }
+	{
+		m_Ends.reserve( 2 * collection.Count() );
+		m_Cells.reserve( 2 * collection.Count() );
+
+		for( const TrackBuilder& track : collection ){
+			if( track.IsValid() ){
+				Add( track, EndType::north );
+				Add( track, EndType::south );
+			}
+		}
+	}
+
+	// Delivers the same as FindTrackEnds( collection, area, true ) for area.r <= cellSize.
+	std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> Find( const spat::Sphere<Length>& area ) const{
+		assert( area.r <= m_CellSize );
+		const Cell center = CellOf( area.c );
+
+		std::vector<int> candidates;
+		for( int x = -1; x <= 1; ++x )
+			for( int y = -1; y <= 1; ++y )
+				for( int z = -1; z <= 1; ++z )
+					if( auto iter = m_Cells.find( { center.x + x, center.y + y, center.z + z } ); iter != m_Cells.end() )
+						candidates.insert( candidates.end(), iter->second.begin(), iter->second.end() );
+
+		// Keep the order of the collection to get the same
+		// results for ends with equal distances:
+		std::sort( candidates.begin(), candidates.end() );
+
+		std::vector<std::tuple<std::shared_ptr<TrackBuilder>,EndType,Length>> retval;
+		for( int idx : candidates ){
+			const End& end = m_Ends[idx];
+			if( area.Includes( end.position ) )
+				retval.push_back( { end.pTrack, end.type, (end.position - area.c).Length() } );
+		}
+
+		std::sort( retval.begin(), retval.end(), 
+			[]( const auto& a, const auto& b ) noexcept -> bool { return std::get<2>(a) < std::get<2>(b); } );
+
+		return retval;
+	}
+private:
+	struct Cell{
+		long long x, y, z;
+
+		bool operator==( const Cell& other ) const noexcept{
+			return x == other.x && y == other.y && z == other.z;
+		}
+	};
+
+	struct CellHash{
+		std::size_t operator()( const Cell& cell ) const noexcept{
+			return	std::hash<long long>{}( cell.x * 73856093LL ^ cell.y * 19349663LL ^ cell.z * 83492791LL );
+		}
+	};
+
+	struct End{
+		std::shared_ptr<TrackBuilder> pTrack;
+		EndType type;
+		Position<Length> position;
+	};
+
+	const Length m_CellSize;
+	std::vector<End> m_Ends;
+	std::unordered_map<Cell,std::vector<int>,CellHash> m_Cells;
+
+	Cell CellOf( const Position<Length>& pos ) const noexcept{
+		return {	static_cast<long long>(std::floor( _1(pos.x / m_CellSize) )),
+					static_cast<long long>(std::floor( _1(pos.y / m_CellSize) )),
+					static_cast<long long>(std::floor( _1(pos.z / m_CellSize) )) };
+	}
+
+	void Add( const TrackBuilder& track, EndType type ){
+		End end{ std::const_pointer_cast<TrackBuilder>(track.This()), type };
+		track.Transition( type == EndType::north ? 0_m : track.GetLength(), end.position );
+		m_Cells[CellOf( end.position )].push_back( static_cast<int>(m_Ends.size()) );
+		m_Ends.push_back( std::move(end) );
+	}
+};
+
 void TrackSystem_Imp::ConnectAll( Length maxDistance, Angle maxKink )
 {
+	if( maxDistance <= 0_m )
+		throw std::invalid_argument( "ConnectAll: maxDistance has to be positive!" );
+	if( maxKink <= 0_deg )
+		throw std::invalid_argument( "ConnectAll: maxKink has to be positive!" );
+
 	if( m_pTrackCollectionContainer )
 	{
 		for( TrackCollection& trackCollection : *m_pTrackCollectionContainer )
 		{
+			// The track ends do not move while connecting, so they get
+			// sampled once. Then every end is connected like trax::Connect()
+			// would do, but only the ends in the neighbouring grid cells 
+			// get examined.
+			const TrackEndGrid grid{ trackCollection, maxDistance };
+
 			for( TrackBuilder& track : trackCollection )
 			{
-				if( !track.IsConnected( EndType::north ) )
-					trax::Connect( trackCollection, {track.This(), EndType::north}, maxDistance, maxKink );
-
-				if( !track.IsConnected( EndType::south ) )
-					trax::Connect( trackCollection, {track.This(), EndType::south}, maxDistance, maxKink );
+				for( EndType end : { EndType::north, EndType::south } )
+				{
+					if( !track.IsConnected( end ) ){
+						spat::Frame<Length,One> trackEndFrame;
+						track.Transition( end == EndType::north ? 0_m : track.GetLength(), trackEndFrame );
+
+						ConnectToClosest( 
+							{ track.This(), end }, 
+							trackEndFrame, 
+							grid.Find( { trackEndFrame.P, maxDistance } ), 
+							maxKink );
+					}
+				}
 			}
 		}
 	}
@@ -504,10 +612,9 @@ const Jack& TrackSystem_Imp::_GetJack( int idx ) const{
 }
 
 void TrackSystem_Imp::DoDisconnectAll(){
-	std::for_each( m_Container.begin(), m_Container.end(),
-		[]( const std::pair<IDType,std::shared_ptr<TrackBuilder>>& pair  )
+	ForEach( []( const std::shared_ptr<TrackBuilder>& pTrack )
 	{ 
-		pair.second->Disconnect();
+		pTrack->Disconnect();
 	});
 }
 
@@ -748,5 +855,27 @@ std::shared_ptr<Connector> ConnectAndSnap(
 
 	return nullptr;
 }
+
+void DeleteReservations( TrackSystem& system, IDType forID ){
+	if( auto pCollectionContainer = system.GetCollectionContainer() ){
+		for( auto& trackCollection : *pCollectionContainer )
+			DeleteReservations( trackCollection, forID );
+	}
+}
+
+std::vector<Track::Overlap> Overlaps( const TrackSystem& system, IDType forID ){
+	std::vector<Track::Overlap> overlaps;
+
+	if( auto pCollectionContainer = system.GetCollectionContainer() ){
+		for( const auto& trackCollection : *pCollectionContainer ){
+			const std::vector<Track::Overlap> moreOverlaps = Overlaps( trackCollection, forID );
+			overlaps.insert( overlaps.end(), moreOverlaps.begin(), moreOverlaps.end() );
+		}
+	}
+
+	std::sort( overlaps.begin(), overlaps.end() );
+	overlaps.erase( std::unique( overlaps.begin(), overlaps.end() ), overlaps.end() );
+	return overlaps;
+}
 ///////////////////////////////////////
 }
@@ -0,0 +1,123 @@
+//	trax track library
+//	AD 2026
+//
+//  "Pull me under"
+//
+//								Dream Theater
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+/// \page docu_tracksystembuilder Streaming TrackSystem Reading
+/// \section tracksystembuilder_intro Introduction
+/// TrackSystemReader reads a whole .anl4 document into a property tree before
+/// it creates a single track. For big layouts that tree takes a multiple of the
+/// file's size in memory. The ParseTrackSystem() functions instead read the
+/// document with a pull parser and report what they find to a TrackSystemParser
+/// right away. A TrackSystemBuilder is a TrackSystemParser that creates a
+/// TrackSystem from these reports.
+///
+/// The builder creates the track collections with their tracks, curves, twists
+/// and sections and connects the tracks. Connectors, sensors, signals and the
+/// other parts of a module are not reported by the parser and have to be read
+/// by the other readers.
+///
+/// \section tracksystembuilder_examples Example:
+///
+/// \code
+/// TrackSystemBuilder builder;
+/// if( ParseTrackSystem( "Layout.anl4", builder ) )
+///		std::shared_ptr<TrackSystem> pTrackSystem = builder.GetTrackSystem();
+/// \endcode
+
+#include "trax/collections/TrackSystemParser.h"
+
+#include <memory>
+#include <vector>
+
+namespace trax{
+
+	struct CombinedTwist;
+	struct TrackBuilder;
+	struct TrackCollection;
+
+	/// \brief Builds a TrackSystem from the callbacks of a parser.
+	class TrackSystemBuilder : public TrackSystemParser{
+	public:
+		dclspc TrackSystemBuilder() noexcept;
+		dclspc ~TrackSystemBuilder();
+
+
+		/// \returns The track system built by the last parse, or nullptr
+		/// if none got completed.
+		dclspc std::shared_ptr<TrackSystem> GetTrackSystem() const noexcept;
+
+
+		/// \name TrackSystemParser
+		///@{
+		dclspc bool TrackSystemStart() override;
+		dclspc bool TrackCollectionStart( IDType id ) override;
+		dclspc void Frame( const spat::Frame<Length,One>& frame ) noexcept override;
+		dclspc bool TrackStart( IDType id, const std::string& reference ) override;
+		dclspc bool TrackConnection( const Track::Connection& connection ) override;
+		dclspc bool BufferStop( Track::End theOne ) override;
+		dclspc bool BasicLine() override;
+		dclspc bool BasicArc( const trax::Arc::Data& data ) override;
+		dclspc bool BasicHelix( const trax::Helix::Data& data ) override;
+		dclspc bool Line( const trax::LineP::Data& data ) override;
+		dclspc bool Arc( const trax::ArcP::Data& data ) override;
+		dclspc bool Helix( const trax::HelixP::Data& data ) override;
+		dclspc bool Clothoid( const trax::Clothoid::Data& data ) override;
+		dclspc bool Cubic( const trax::Cubic::Data& data ) override;
+		dclspc bool Spline( const trax::Spline::Data& data ) override;
+		dclspc bool Rotator( const trax::Rotator::Data& data ) override;
+		dclspc bool RotatorChain( const trax::RotatorChain::Data& data ) override;
+		dclspc bool PolygonalChain( const trax::PolygonalChain::Data& data ) override;
+		dclspc bool SampledCurve( const trax::SampledCurve::Data& data ) override;
+		dclspc bool EEPCurve( const trax::EEPCurve::Data& data ) override;
+		dclspc bool ConstantTwist( Angle twist ) override;
+		dclspc bool LinearTwist( Angle startAngle, Angle endAngle ) override;
+		dclspc bool PiecewiseTwist( trax::PiecewiseTwist::Data data ) override;
+		dclspc bool PiecewiseLinearTwist( trax::PiecewiseTwist::Data data ) override;
+		dclspc bool DirectionalTwist( spat::Vector<One> attractor, bool bFrozen ) override;
+		dclspc bool CombinedTwistStart() override;
+		dclspc void CombinedTwistEnd() override;
+		dclspc bool Section( trax::Section::SpecialSections type ) override;
+		dclspc void TrackEnd() override;
+		dclspc void TrackCollectionEnd() override;
+		dclspc void TrackSystemEnd( IDType activeTrack ) override;
+		///@}
+	private:
+		std::shared_ptr<TrackSystem> m_pTrackSystem;
+		std::shared_ptr<TrackSystem> m_pBuilding;
+		std::unique_ptr<TrackCollection> m_pTrackCollection;
+		std::shared_ptr<TrackBuilder> m_pTrack;
+		std::unique_ptr<Curve> m_pCurve;
+		std::unique_ptr<RoadwayTwist> m_pTwist;
+		std::vector<std::pair<std::unique_ptr<trax::CombinedTwist>,int>> m_CombinedTwists;
+		std::unique_ptr<trax::Section> m_pSection;
+		std::vector<Track::Connection> m_Couplings;
+
+		template<class CurveType>
+		bool Place( std::unique_ptr<CurveType> pCurve, const typename CurveType::Data& data );
+		bool Place( std::unique_ptr<RoadwayTwist> pTwist );
+	};
+}
@@ -42,6 +42,10 @@ namespace trax{
 
 		/// \name Track System Reading
 		/// \brief Reads a track system from a file or buffer.
+		///
+		/// Besides .anl4 and .anl3 XML, snapshots written by WriteSnapshot() are
+		/// recognized by their header and read by ReadSnapshot(). A buffer is
+		/// read in place, it does not get copied before parsing.
 		/// \param fromPath The path to the file to read from.
 		/// \param atIdx The index of the track system to read.
 		/// \return A shared pointer to the track system.
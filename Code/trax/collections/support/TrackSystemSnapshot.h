@@ -0,0 +1,117 @@
+//	trax track library
+//	AD 2026
+//
+//  "Take a picture, it'll last longer"
+//
+//								Sheryl Crow
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+/// \page docu_tracksystemsnapshot TrackSystem Snapshots
+/// \section tracksystemsnapshot_intro Introduction
+/// Reading a large layout from an .anl4 file spends most of its time with parsing
+/// XML and converting text to numbers. A snapshot stores a TrackSystem in a
+/// binary form instead: the curves' and twists' Data are stored as they are in
+/// memory, so that reading them back is a copy. Reading a snapshot from a file
+/// maps the file into memory and creates the objects right from the mapping.
+///
+/// A snapshot holds the track collections with their tracks, curves, twists,
+/// sections, sensors and track connections, the connectors and the plug/jack
+/// wiring between all of these. It is meant as a cache for layouts that were
+/// loaded from their source format before, not as an exchange format: it is
+/// only readable on machines with the same byte order and the same size of
+/// trax::Real as the one that wrote it. Curves that are shared by tracks stay
+/// shared. Interval sensors (e.g. traction sensors) belong to the trains
+/// library and can not be stored; WriteSnapshot() throws for them.
+///
+/// TrackSystemReader::Read() detects snapshots by their header and reads
+/// them as well.
+///
+/// \section tracksystemsnapshot_examples Example:
+///
+/// \code
+/// if( !std::filesystem::exists( "Layout.trxsnap" ) )
+///		WriteSnapshot( *TrackSystemReader{}.Read( "Layout.anl4" ), "Layout.trxsnap" );
+///
+/// std::shared_ptr<TrackSystem> pTrackSystem = ReadSnapshot( "Layout.trxsnap" );
+/// \endcode
+
+#include "trax/Configuration.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace trax{
+
+	struct TrackSystem;
+
+	/// \name TrackSystem Snapshots
+	///@{
+
+	/// \brief Current version of the snapshot format.
+	///
+	/// Snapshots of other versions are rejected by ReadSnapshot().
+	constexpr std::uint32_t snapshotVersion = 1;
+
+
+	/// \brief Writes a snapshot of a TrackSystem to a buffer.
+	/// \param trackSystem The track system to write.
+	/// \param buffer Buffer to append the snapshot to.
+	/// \throws std::invalid_argument if the track system holds objects
+	/// that can not be stored.
+	dclspc void WriteSnapshot( const TrackSystem& trackSystem, std::vector<unsigned char>& buffer );
+
+
+	/// \brief Writes a snapshot of a TrackSystem to a file.
+	/// \throws std::runtime_error if the file can not be written.
+	/// \throws std::invalid_argument if the track system holds objects
+	/// that can not be stored.
+	dclspc void WriteSnapshot( const TrackSystem& trackSystem, const std::filesystem::path& toPath );
+
+
+	/// \returns true if the buffer starts with a snapshot header.
+	dclspc bool IsSnapshot( const unsigned char* bufferStart, const unsigned char* bufferEnd ) noexcept;
+
+
+	/// \returns true if the file starts with a snapshot header.
+	dclspc bool IsSnapshot( const std::filesystem::path& path ) noexcept;
+
+
+	/// \brief Reads a TrackSystem from a snapshot in a buffer.
+	/// \returns A new track system.
+	/// \throws std::runtime_error if the buffer holds no valid snapshot, if it
+	/// got written with a different version, byte order or size of Real, or
+	/// if it is truncated.
+	dclspc std::shared_ptr<TrackSystem> ReadSnapshot( const unsigned char* bufferStart, const unsigned char* bufferEnd );
+
+
+	/// \brief Reads a TrackSystem from a snapshot file.
+	///
+	/// The file gets mapped into memory for reading.
+	/// \returns A new track system.
+	/// \throws std::runtime_error if the file can not be mapped or
+	/// holds no valid snapshot.
+	dclspc std::shared_ptr<TrackSystem> ReadSnapshot( const std::filesystem::path& fromPath );
+	///@}
+}
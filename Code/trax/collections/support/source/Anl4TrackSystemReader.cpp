@@ -1545,6 +1545,32 @@ std::shared_ptr<trax::TrackSystem> ReadTrackSystemFromANL4(
 	int atIdx )
 {
 	int Idx = 0;
+	auto ReadModule = [&reader,atIdx,&Idx]( const boost::property_tree::ptree& module ) -> std::shared_ptr<trax::TrackSystem>
+	{
+		if( std::unique_ptr<SocketRegistry> pSocketRegistry = SocketRegistry::Make(); pSocketRegistry )
+		{
+			pSocketRegistry->ReservePlugIDs( module.get( "<xmlattr>.maxValidPlugID", trax::IDType{ 0 } ) );
+
+			for( const auto& pairTrackSystem : module ){
+				if( pairTrackSystem.first == "TrackSystem" )
+				{
+					if( ++Idx == atIdx ){
+						if( std::shared_ptr<trax::TrackSystem> pTrackSystem = reader.ReadTrackSystem( pairTrackSystem.second, *pSocketRegistry ); pTrackSystem )
+						{
+							using trax::to_string;
+							pTrackSystem->Reference( "maxValidPlugID", to_string( module.get( "<xmlattr>.maxValidPlugID", trax::IDType{ 0 } ) ) );
+							return pTrackSystem;
+						}
+					}
+					else
+						break;
+				}
+			}
+		}
+
+		return nullptr;
+	};
+
 	for( const auto& pair : pt )
 	{
 		if( pair.first == "traxML" )
@@ -1552,24 +1578,17 @@ std::shared_ptr<trax::TrackSystem> ReadTrackSystemFromANL4(
 			for( const auto& pairModule : pair.second ){
 				if( pairModule.first == "Module" )
 				{
-					if( std::unique_ptr<SocketRegistry> pSocketRegistry = SocketRegistry::Make(); pSocketRegistry )
-					{
-						pSocketRegistry->ReservePlugIDs( pairModule.second.get( "<xmlattr>.maxValidPlugID", trax::IDType{ 0 } ) );
-
-						for( const auto& pairTrackSystem : pairModule.second ){
-							if( pairTrackSystem.first == "TrackSystem" )
-							{
-								if( ++Idx == atIdx ){
-									if( std::shared_ptr<trax::TrackSystem> pTrackSystem = reader.ReadTrackSystem( pairTrackSystem.second, *pSocketRegistry ); pTrackSystem )
-									{
-										using trax::to_string;
-										pTrackSystem->Reference( "maxValidPlugID", to_string( pairModule.second.get( "<xmlattr>.maxValidPlugID", trax::IDType{ 0 } ) ) );
-										return pTrackSystem;
-									}
-								}
-								else
-									break;
-							}
+					if( std::shared_ptr<trax::TrackSystem> pTrackSystem = ReadModule( pairModule.second ); pTrackSystem )
+						return pTrackSystem;
+				}
+				else if( pairModule.first == "ModuleCollection" )
+				{
+					// Module collections keep their modules one level deeper:
+					for( const auto& pairCollectionModule : pairModule.second ){
+						if( pairCollectionModule.first == "Module" )
+						{
+							if( std::shared_ptr<trax::TrackSystem> pTrackSystem = ReadModule( pairCollectionModule.second ); pTrackSystem )
+								return pTrackSystem;
 						}
 					}
 				}
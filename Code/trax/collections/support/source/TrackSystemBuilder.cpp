@@ -0,0 +1,320 @@
+//	trax track library
+//	AD 2026
+//
+//  "Pull me under"
+//
+//								Dream Theater
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "trax/collections/support/TrackSystemBuilder.h"
+
+#include "trax/collections/TrackCollection.h"
+#include "trax/collections/TrackCollectionContainer.h"
+#include "trax/collections/TrackSystem.h"
+
+#include "trax/rigid/MovableTrack.h"
+
+#include "trax/RoadwayTwist.h"
+#include "trax/SectionTrack.h"
+
+namespace trax{
+
+TrackSystemBuilder::TrackSystemBuilder() noexcept = default;
+
+TrackSystemBuilder::~TrackSystemBuilder() = default;
+
+std::shared_ptr<TrackSystem> TrackSystemBuilder::GetTrackSystem() const noexcept{
+	return m_pTrackSystem;
+}
+
+bool TrackSystemBuilder::TrackSystemStart(){
+	m_pTrackSystem.reset();
+	m_Couplings.clear();
+
+	m_pBuilding = TrackSystem::Make( TrackCollectionContainer::Make() );
+	if( !m_pBuilding )
+		return false;
+
+	m_pBuilding->Reference( "Name", "TrackSystem" + to_string(m_pBuilding->ID()) );
+	return true;
+}
+
+bool TrackSystemBuilder::TrackCollectionStart( IDType id ){
+	m_pTrackCollection = TrackCollection::Make();
+	if( !m_pTrackCollection )
+		return false;
+
+	m_pTrackCollection->ID( id );
+	m_pTrackCollection->Reference( "Name", "TrackCollection" + to_string(id) );
+	return true;
+}
+
+void TrackSystemBuilder::Frame( const spat::Frame<Length,One>& frame ) noexcept{
+	TrackSystemParser::Frame( frame );
+
+	// The track's frame is set with TrackEnd():
+	if( !m_pTrack && m_pTrackCollection )
+		m_pTrackCollection->SetFrame( frame );
+}
+
+bool TrackSystemBuilder::TrackStart( IDType id, const std::string& reference ){
+	m_pTrack = MovableTrack::Make( Track::TrackType::standard );
+	if( !m_pTrack )
+		return false;
+
+	m_pTrack->ID( id );
+	m_pTrack->Reference( "name", "Track" + to_string(id) );
+	m_pTrack->Reference( "reference", reference );
+
+	m_Frame.Init();
+	m_Interval = { 0_m, 10_m };
+	m_pCurve.reset();
+	m_pTwist.reset();
+	m_CombinedTwists.clear();
+	m_pSection.reset();
+	return true;
+}
+
+bool TrackSystemBuilder::TrackConnection( const Track::Connection& connection ){
+	m_Couplings.push_back( connection );
+	return true;
+}
+
+bool TrackSystemBuilder::BufferStop( Track::End theOne ){
+	if( m_pTrack )
+		m_pTrack->Reference( theOne.type == EndType::north ? "bufferStopBegin" : "bufferStopEnd", "true" );
+
+	return true;
+}
+
+template<class CurveType>
+bool TrackSystemBuilder::Place( std::unique_ptr<CurveType> pCurve, const typename CurveType::Data& data ){
+	if( !pCurve )
+		return false;
+
+	pCurve->Create( data );
+	m_pCurve = std::move(pCurve);
+	return true;
+}
+
+bool TrackSystemBuilder::BasicLine(){
+	m_pCurve = trax::Line::Make();
+	return m_pCurve != nullptr;
+}
+
+bool TrackSystemBuilder::BasicArc( const trax::Arc::Data& data ){
+	return Place( trax::Arc::Make(), data );
+}
+
+bool TrackSystemBuilder::BasicHelix( const trax::Helix::Data& data ){
+	return Place( trax::Helix::Make(), data );
+}
+
+bool TrackSystemBuilder::Line( const trax::LineP::Data& data ){
+	return Place( trax::LineP::Make(), data );
+}
+
+bool TrackSystemBuilder::Arc( const trax::ArcP::Data& data ){
+	return Place( trax::ArcP::Make(), data );
+}
+
+bool TrackSystemBuilder::Helix( const trax::HelixP::Data& data ){
+	return Place( trax::HelixP::Make(), data );
+}
+
+bool TrackSystemBuilder::Clothoid( const trax::Clothoid::Data& data ){
+	return Place( trax::Clothoid::Make(), data );
+}
+
+bool TrackSystemBuilder::Cubic( const trax::Cubic::Data& data ){
+	return Place( trax::Cubic::Make(), data );
+}
+
+bool TrackSystemBuilder::Spline( const trax::Spline::Data& data ){
+	return Place( trax::Spline::Make(), data );
+}
+
+bool TrackSystemBuilder::Rotator( const trax::Rotator::Data& data ){
+	const Curve::CurveType type = (data.a0 == 0_deg && data.b0 == 0_deg) ?
+		Curve::CurveType::Rotator : Curve::CurveType::RotatorWithOffset;
+
+	return Place( trax::Rotator::Make( type ), data );
+}
+
+bool TrackSystemBuilder::RotatorChain( const trax::RotatorChain::Data& data ){
+	return Place( trax::RotatorChain::Make(), data );
+}
+
+bool TrackSystemBuilder::PolygonalChain( const trax::PolygonalChain::Data& data ){
+	return Place( trax::PolygonalChain::Make(), data );
+}
+
+bool TrackSystemBuilder::SampledCurve( const trax::SampledCurve::Data& data ){
+	return Place( trax::SampledCurve::Make(), data );
+}
+
+bool TrackSystemBuilder::EEPCurve( const trax::EEPCurve::Data& data ){
+	return Place( trax::EEPCurve::Make(), data );
+}
+
+bool TrackSystemBuilder::Place( std::unique_ptr<RoadwayTwist> pTwist ){
+	if( !pTwist )
+		return false;
+
+	if( m_CombinedTwists.empty() )
+		m_pTwist = std::move(pTwist);
+	else{
+		auto& [pCombinedTwist, count] = m_CombinedTwists.back();
+		const int idx = count++;
+		if( idx == 0 )
+			pCombinedTwist->AttachTwist1( std::move(pTwist) );
+		else if( idx == 1 )
+			pCombinedTwist->AttachTwist2( std::move(pTwist) );
+	}
+
+	return true;
+}
+
+bool TrackSystemBuilder::ConstantTwist( Angle twist ){
+	std::unique_ptr<trax::ConstantTwist> pTwist = trax::ConstantTwist::Make();
+	if( !pTwist )
+		return false;
+
+	pTwist->TwistValue( twist );
+	return Place( std::move(pTwist) );
+}
+
+bool TrackSystemBuilder::LinearTwist( Angle startAngle, Angle endAngle ){
+	return Place( trax::LinearTwist::Make( startAngle, endAngle ) );
+}
+
+bool TrackSystemBuilder::PiecewiseTwist( trax::PiecewiseTwist::Data data ){
+	std::unique_ptr<trax::PiecewiseTwist> pTwist = trax::PiecewiseTwist::Make();
+	if( !pTwist )
+		return false;
+
+	pTwist->Create( data );
+	return Place( std::move(pTwist) );
+}
+
+bool TrackSystemBuilder::PiecewiseLinearTwist( trax::PiecewiseTwist::Data data ){
+	std::unique_ptr<trax::PiecewiseTwist> pTwist = trax::PiecewiseTwist::Make( RoadwayTwist::TwistType::PiecewiseLinear );
+	if( !pTwist )
+		return false;
+
+	pTwist->Create( data );
+	return Place( std::move(pTwist) );
+}
+
+bool TrackSystemBuilder::DirectionalTwist( spat::Vector<One> attractor, bool bFrozen ){
+	std::unique_ptr<trax::DirectionalTwist> pTwist = trax::DirectionalTwist::Make();
+	if( !pTwist )
+		return false;
+
+	pTwist->Freeze( bFrozen );
+	pTwist->Attractor( attractor );
+	return Place( std::move(pTwist) );
+}
+
+bool TrackSystemBuilder::CombinedTwistStart(){
+	std::unique_ptr<trax::CombinedTwist> pCombinedTwist = trax::CombinedTwist::Make();
+	if( !pCombinedTwist )
+		return false;
+
+	m_CombinedTwists.emplace_back( std::move(pCombinedTwist), 0 );
+	return true;
+}
+
+void TrackSystemBuilder::CombinedTwistEnd(){
+	if( m_CombinedTwists.empty() )
+		return;
+
+	std::unique_ptr<RoadwayTwist> pCombinedTwist = std::move(m_CombinedTwists.back().first);
+	m_CombinedTwists.pop_back();
+	Place( std::move(pCombinedTwist) );
+}
+
+bool TrackSystemBuilder::Section( trax::Section::SpecialSections type ){
+	m_pSection = trax::Section::Make( type );
+	return m_pSection != nullptr;
+}
+
+void TrackSystemBuilder::TrackEnd(){
+	if( !m_pTrack )
+		return;
+
+	m_pTrack->SetFrame( m_Frame );
+
+	if( m_pCurve )
+		m_pTrack->Attach( std::move(m_pCurve), m_Interval );
+
+	if( m_pTwist )
+		m_pTrack->Attach( std::move(m_pTwist) );
+
+	if( m_pSection ){
+		if( SectionTrack* pSectionTrack = dynamic_cast<SectionTrack*>(m_pTrack.get()); pSectionTrack )
+			pSectionTrack->Attach( std::move(m_pSection) );
+	}
+
+	if( m_pTrackCollection )
+		m_pTrackCollection->Add( m_pTrack );
+
+	m_pTrack.reset();
+	m_pSection.reset();
+}
+
+void TrackSystemBuilder::TrackCollectionEnd(){
+	if( m_pBuilding && m_pTrackCollection ){
+		if( auto pTrackCollectionContainer = m_pBuilding->GetCollectionContainer() )
+			pTrackCollectionContainer->Add( std::move(m_pTrackCollection) );
+	}
+
+	m_pTrackCollection.reset();
+}
+
+void TrackSystemBuilder::TrackSystemEnd( IDType activeTrack ){
+	if( !m_pBuilding )
+		return;
+
+	// contract doublettes:
+	for( auto i = m_Couplings.begin(); i != m_Couplings.end(); ++i ){
+		for( auto j = i+1; j != m_Couplings.end(); ++j ){
+			if( (*i).theOther == (*j).theOne &&
+				(*i).theOne == (*j).theOther )
+			{
+				(*i).theOther.type = (*j).theOne.type;
+				m_Couplings.erase( j );
+				break;
+			}
+		}
+	}
+
+	for( const Track::Connection& coupling : m_Couplings )
+		m_pBuilding->Connect( coupling, true );
+	m_Couplings.clear();
+
+	if( activeTrack )
+		m_pBuilding->PushActive( activeTrack );
+
+	m_pTrackSystem = std::move(m_pBuilding);
+}
+
+}
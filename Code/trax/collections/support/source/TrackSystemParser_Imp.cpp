@@ -57,7 +57,7 @@ bool ParseDirectionalTwist( const boost::property_tree::ptree& pt, TrackSystemPa
 		if( pair.first == "Vector" ){
 			spat::Vector<One> attractor;
 			spat::ptreesupport::ReadVector( pair.second, attractor );
-			return callback.DirectionalTwist( attractor );
+			return callback.DirectionalTwist( attractor, pt.get( "<xmlattr>.bFrozen", false ) );
 		}
 	}
 
@@ -267,7 +267,27 @@ bool ParseCurve( const boost::property_tree::ptree& pt, TrackSystemParser& callb
 
 	for( const auto& pair : pt )
 	{
-		if( pair.first == "Line" ){
+		if( pair.first == "BasicLine" ){
+			if( !callback.BasicLine() )
+				return false;
+		}
+
+		else if( pair.first == "BasicArc" ){
+			Arc::Data data;
+			data.k = get( pair.second, "<xmlattr>.k", 0_1Im, _1Im );
+			if( !callback.BasicArc( data ) )
+				return false;
+		}
+
+		else if( pair.first == "BasicHelix" ){
+			Helix::Data data;
+			data.k = get( pair.second, "<xmlattr>.k", data.k, _1Im );
+			data.t = get( pair.second, "<xmlattr>.t", data.t, _1Im );
+			if( !callback.BasicHelix( data ) )
+				return false;
+		}
+
+		else if( pair.first == "Line" ){
 			if( !ParseLine( pair.second, callback ) )
 				return false;
 		}
@@ -441,16 +461,6 @@ bool ParseTrackSystem( const boost::property_tree::ptree& pt, TrackSystemParser&
 
 } // namespace ptreesupport
 	
-bool ParseTrackSystem( std::basic_istream<char>& /*stream*/, TrackSystemParser& /*callback*/ ) noexcept(false){
-	assert( !"Not implemented yet!" );
-	return false;
-}
-
-bool ParseTrackSystem( std::string /*filePath*/, TrackSystemParser& /*callback*/ ) noexcept(false){
-	assert( !"Not implemented yet!" );
-	return false;
-}
-	 
 bool ParseTrackSystem( const TrackSystem& /*trackSystem*/, TrackSystemParser& /*callback*/ ) noexcept(false){
 	assert( !"Not implemented yet!" );
 	return false;
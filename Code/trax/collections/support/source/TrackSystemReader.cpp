@@ -28,6 +28,9 @@
 #include "../TrackSystemReader.h"
 #include "../Anl3TrackSystemReader.h"
 #include "../Anl4TrackSystemReader.h"
+#include "../TrackSystemSnapshot.h"
+
+#include "common/support/CommonSupportStream.h"
 
 
 #if defined(_MSC_VER)
@@ -78,6 +81,10 @@ static std::shared_ptr<TrackSystem> ReadTrackSystem( const boost::property_tree:
 
 std::shared_ptr<TrackSystem>dclspc TrackSystemReader::Read( const std::filesystem::path& fromPath, int atIdx ) const
 {
+	// A snapshot holds exactly one track system:
+	if( IsSnapshot( fromPath ) )
+		return atIdx == 1 ? ReadSnapshot( fromPath ) : nullptr;
+
 	boost::property_tree::ptree ptr;
 
 	boost::property_tree::read_xml( fromPath.string(), ptr );
@@ -87,8 +94,10 @@ std::shared_ptr<TrackSystem>dclspc TrackSystemReader::Read( const std::filesyste
 
 std::shared_ptr<TrackSystem>dclspc TrackSystemReader::Read( const unsigned char* bufferStart, const unsigned char * bufferEnd, int atIdx ) const
 {
-	std::string string( (const char*)bufferStart, bufferEnd - bufferStart );
-	std::istringstream stream( string );
+	if( IsSnapshot( bufferStart, bufferEnd ) )
+		return atIdx == 1 ? ReadSnapshot( bufferStart, bufferEnd ) : nullptr;
+
+	common::MemoryInStream stream( bufferStart, bufferEnd );
 
 	boost::property_tree::ptree ptr;
 
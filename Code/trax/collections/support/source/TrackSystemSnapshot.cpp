@@ -0,0 +1,1045 @@
+//	trax track library
+//	AD 2026
+//
+//  "Take a picture, it'll last longer"
+//
+//								Sheryl Crow
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "trax/collections/support/TrackSystemSnapshot.h"
+
+#include "trax/collections/ConnectorCollection.h"
+#include "trax/collections/TrackCollection.h"
+#include "trax/collections/TrackCollectionContainer.h"
+#include "trax/collections/TrackSystem.h"
+
+#include "trax/Curve.h"
+#include "trax/Jack.h"
+#include "trax/Plug.h"
+#include "trax/RoadwayTwist.h"
+#include "trax/Section.h"
+#include "trax/SectionTrack.h"
+#include "trax/Sensor.h"
+#include "trax/SocketRegistry.h"
+#include "trax/Switch.h"
+
+#include "trax/rigid/MovableTrack.h"
+#include "trax/rigid/trains/WheelFrameSensors.h"
+
+#if defined(_MSC_VER)
+#	pragma warning(push)
+#	pragma warning(disable: 6313 6387 26495)
+#endif
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#if defined(_MSC_VER)
+#	pragma warning(pop)
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+
+namespace trax{
+	using namespace spat;
+
+static const char snapshotMagic[8] = { 't','r','x','s','n','a','p','\0' };
+static const std::uint32_t snapshotByteOrder = 0x01020304u;
+
+struct SnapshotHeader{
+	char			magic[8];
+	std::uint32_t	version;
+	std::uint32_t	byteOrder;
+	std::uint32_t	sizeOfReal;
+	std::uint32_t	reserved;
+	std::uint64_t	payloadSize;
+	std::uint32_t	maxValidPlugID;
+	std::uint32_t	reserved2;
+};
+
+enum class SnapshotSensor : std::uint8_t{
+	sensor = 0,
+	velocity,
+	weigh
+};
+
+enum class SnapshotConnector : std::uint8_t{
+	switchType = 0,
+	threeWaySwitch,
+	singleSlipSwitch,
+	doubleSlipSwitch
+};
+
+///////////////////////////////////////
+class SnapshotWriter{
+public:
+	explicit SnapshotWriter( std::vector<unsigned char>& buffer ) noexcept
+		: m_Buffer{ buffer }
+	{}
+
+	template<typename T>
+	void Put( const T& value ){
+		static_assert( std::is_trivially_copyable_v<T>, "SnapshotWriter: type has to be trivially copyable!" );
+		const unsigned char* pBytes = reinterpret_cast<const unsigned char*>(&value);
+		m_Buffer.insert( m_Buffer.end(), pBytes, pBytes + sizeof(T) );
+	}
+
+	void PutBool( bool value ){
+		Put( static_cast<std::uint8_t>(value ? 1 : 0) );
+	}
+
+	void PutID( IDType id ){
+		Put( static_cast<std::uint32_t>(id.GetID()) );
+	}
+
+	// Strings get stored zero terminated, so that they can get
+	// used right from the mapped memory on reading:
+	void PutString( const char* pString ){
+		const std::size_t length = pString ? std::strlen( pString ) : 0;
+		Put( static_cast<std::uint32_t>(length) );
+		if( length )
+			m_Buffer.insert( m_Buffer.end(), pString, pString + length );
+		m_Buffer.push_back( '\0' );
+	}
+
+	template<typename T>
+	void PutVector( const std::vector<T>& values ){
+		static_assert( std::is_trivially_copyable_v<T>, "SnapshotWriter: type has to be trivially copyable!" );
+		Put( static_cast<std::uint32_t>(values.size()) );
+		if( !values.empty() ){
+			const unsigned char* pBytes = reinterpret_cast<const unsigned char*>(values.data());
+			m_Buffer.insert( m_Buffer.end(), pBytes, pBytes + values.size() * sizeof(T) );
+		}
+	}
+
+	template<class T>
+	void PutReferences( const Identified<T>& object ){
+		// The span returned by ReferenceNames() might not survive
+		// the calls to Reference():
+		const common::Span<const char*> span = object.ReferenceNames();
+		const std::vector<const char*> names( span.begin(), span.end() );
+
+		Put( static_cast<std::uint32_t>(names.size()) );
+		for( const char* pName : names ){
+			PutString( pName );
+			PutString( object.Reference( pName ) );
+		}
+	}
+
+	std::size_t Size() const noexcept{
+		return m_Buffer.size();
+	}
+
+	template<typename T>
+	void Patch( std::size_t at, const T& value ) noexcept{
+		static_assert( std::is_trivially_copyable_v<T>, "SnapshotWriter: type has to be trivially copyable!" );
+		std::memcpy( m_Buffer.data() + at, &value, sizeof(T) );
+	}
+private:
+	std::vector<unsigned char>& m_Buffer;
+};
+///////////////////////////////////////
+class SnapshotReader{
+public:
+	SnapshotReader( const unsigned char* bufferStart, const unsigned char* bufferEnd ) noexcept
+		: m_pCurrent{ bufferStart }
+		, m_pEnd{ bufferEnd }
+	{}
+
+	template<typename T>
+	T Get(){
+		static_assert( std::is_trivially_copyable_v<T>, "SnapshotReader: type has to be trivially copyable!" );
+		Need( sizeof(T) );
+		T value;
+		std::memcpy( &value, m_pCurrent, sizeof(T) );
+		m_pCurrent += sizeof(T);
+		return value;
+	}
+
+	bool GetBool(){
+		return Get<std::uint8_t>() != 0;
+	}
+
+	IDType GetID(){
+		return IDType{ Get<std::uint32_t>() };
+	}
+
+	const char* GetString(){
+		const std::size_t length = Get<std::uint32_t>();
+		Need( length + 1 );
+		const char* pString = reinterpret_cast<const char*>(m_pCurrent);
+		if( pString[length] != '\0' )
+			throw std::runtime_error( "TrackSystemSnapshot: broken string!" );
+
+		m_pCurrent += length + 1;
+		return pString;
+	}
+
+	// Reads the count of the elements that follow and makes sure 
+	// there are enough bytes left for them, before anything gets 
+	// allocated for a broken count:
+	std::size_t GetCount( std::size_t elementSize ){
+		const std::size_t count = Get<std::uint32_t>();
+		if( count > static_cast<std::size_t>(std::numeric_limits<int>::max()) )
+			throw std::runtime_error( "TrackSystemSnapshot: broken element count!" );
+		Need( count * elementSize );
+		return count;
+	}
+
+	template<typename T>
+	std::vector<T> GetVector(){
+		static_assert( std::is_trivially_copyable_v<T>, "SnapshotReader: type has to be trivially copyable!" );
+		const std::size_t count = GetCount( sizeof(T) );
+		std::vector<T> values( count );
+		if( count )
+			std::memcpy( values.data(), m_pCurrent, count * sizeof(T) );
+		m_pCurrent += count * sizeof(T);
+		return values;
+	}
+
+	template<class T>
+	void GetReferences( Identified<T>& object ){
+		for( std::uint32_t count = Get<std::uint32_t>(); count; --count ){
+			const char* pName = GetString();
+			object.Reference( pName, GetString() );
+		}
+	}
+
+	bool AtEnd() const noexcept{
+		return m_pCurrent == m_pEnd;
+	}
+private:
+	const unsigned char* m_pCurrent;
+	const unsigned char* m_pEnd;
+
+	void Need( std::size_t bytes ) const{
+		if( static_cast<std::size_t>(m_pEnd - m_pCurrent) < bytes )
+			throw std::runtime_error( "TrackSystemSnapshot: the snapshot is truncated!" );
+	}
+};
+///////////////////////////////////////
+// Writing:
+
+template<class CurveType>
+static bool PutCurveData( SnapshotWriter& writer, const Curve& curve ){
+	if( auto pCurve = dynamic_cast<const CurveType*>(&curve) ){
+		writer.Put( pCurve->GetData() );
+		return true;
+	}
+
+	return false;
+}
+
+template<class CurveType>
+static bool PutCurveVector( SnapshotWriter& writer, const Curve& curve ){
+	if( auto pCurve = dynamic_cast<const CurveType*>(&curve) ){
+		writer.PutVector( pCurve->GetData() );
+		return true;
+	}
+
+	return false;
+}
+
+static void PutCurve( SnapshotWriter& writer, const Curve& curve ){
+	writer.Put( curve.GetCurveType() );
+
+	switch( curve.GetCurveType() ){
+	case Curve::CurveType::Line:
+		return;
+	case Curve::CurveType::Arc:
+		if( PutCurveData<Arc>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::Helix:
+		if( PutCurveData<Helix>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::LineP:
+		if( PutCurveData<LineP>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::ArcP:
+		if( PutCurveData<ArcP>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::HelixP:
+		if( PutCurveData<HelixP>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::Clothoid:
+		if( PutCurveData<Clothoid>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::Cubic:
+		if( PutCurveData<Cubic>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::Rotator:
+	case Curve::CurveType::RotatorWithOffset:
+		if( PutCurveData<Rotator>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::EEPCurve:
+	case Curve::CurveType::EEPResidual:
+	case Curve::CurveType::EEPAlternative:
+		if( PutCurveData<EEPCurve>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::Spline:
+		if( PutCurveVector<Spline>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::PolygonalChain:
+		if( PutCurveVector<PolygonalChain>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::SampledCurve:
+		if( PutCurveVector<SampledCurve>( writer, curve ) ) return;
+		break;
+	case Curve::CurveType::RotatorChain:
+		if( auto pCurve = dynamic_cast<const RotatorChain*>(&curve) ){
+			writer.Put( static_cast<std::uint32_t>(pCurve->GetData().size()) );
+			for( const auto& link : pCurve->GetData() ){
+				writer.Put( std::get<0>(link) );
+				writer.Put( std::get<1>(link) );
+				writer.Put( std::get<2>(link) );
+			}
+			return;
+		}
+		break;
+	default:
+		break;
+	}
+
+	throw std::invalid_argument( std::string{ "TrackSystemSnapshot: curve type not supported: " } + curve.TypeName() );
+}
+
+static void PutTwist( SnapshotWriter& writer, const RoadwayTwist& twist ){
+	writer.Put( twist.GetTwistType() );
+
+	if( auto pConstantTwist = dynamic_cast<const ConstantTwist*>(&twist) )
+		writer.Put( pConstantTwist->TwistValue() );
+	else if( auto pLinearTwist = dynamic_cast<const LinearTwist*>(&twist) ){
+		writer.Put( pLinearTwist->From() );
+		writer.Put( pLinearTwist->To() );
+	}
+	else if( auto pPiecewiseTwist = dynamic_cast<const PiecewiseTwist*>(&twist) ){
+		writer.Put( static_cast<std::uint32_t>(pPiecewiseTwist->CntTwistValues()) );
+		for( int idx = 0; idx < pPiecewiseTwist->CntTwistValues(); ++idx ){
+			writer.Put( pPiecewiseTwist->Twist( idx ).first );
+			writer.Put( pPiecewiseTwist->Twist( idx ).second );
+		}
+	}
+	else if( auto pDirectionalTwist = dynamic_cast<const DirectionalTwist*>(&twist) )
+		writer.Put( pDirectionalTwist->Attractor() );
+	else if( auto pPiecewiseDirectionalTwist = dynamic_cast<const PiecewiseDirectionalTwist*>(&twist) ){
+		writer.Put( static_cast<std::uint32_t>(pPiecewiseDirectionalTwist->CntTwistValues()) );
+		for( int idx = 0; idx < pPiecewiseDirectionalTwist->CntTwistValues(); ++idx ){
+			writer.Put( pPiecewiseDirectionalTwist->Twist( idx ).first );
+			writer.Put( pPiecewiseDirectionalTwist->Twist( idx ).second );
+		}
+	}
+	else if( auto pCombinedTwist = dynamic_cast<const CombinedTwist*>(&twist) ){
+		PutTwist( writer, pCombinedTwist->Twist1() );
+		PutTwist( writer, pCombinedTwist->Twist2() );
+	}
+	else if( twist.GetTwistType() != RoadwayTwist::TwistType::Zero )
+		throw std::invalid_argument( std::string{ "TrackSystemSnapshot: twist type not supported: " } + twist.TypeName() );
+
+	writer.PutBool( twist.IsFrozen() );
+}
+
+// The plug a jack is wired to, or the ID of a plug that was not there to connect to:
+static IDType WiredPlugID( const Jack& jack ) noexcept{
+	if( jack.Plugged() ){
+		const Plug* pPlug = GetFirstNonZeroIDPlugInChain( *jack.GetPlug() );
+		return pPlug ? pPlug->ID() : IDType{};
+	}
+
+	return jack.RefPlugID();
+}
+
+static void PutJack( SnapshotWriter& writer, const Jack& jack ){
+	const IDType plugID = WiredPlugID( jack );
+	writer.PutID( plugID );
+	if( plugID ){
+		writer.PutID( jack.ID() );
+		writer.PutReferences( jack );
+	}
+}
+
+static void PutSockets( SnapshotWriter& writer, const Connector& connector ){
+	std::vector<const Plug*> plugs;
+	if( auto pPlugEnumerator = dynamic_cast<const PlugEnumerator*>(&connector) ){
+		for( const Plug& plug : *pPlugEnumerator ){
+			if( plug.Plugged() || WiredPlugID( plug.JackOnPulse() ) )
+				plugs.push_back( &plug );
+		}
+	}
+
+	writer.Put( static_cast<std::uint32_t>(plugs.size()) );
+	for( const Plug* pPlug : plugs ){
+		writer.PutID( pPlug->ID() );
+		writer.PutReferences( *pPlug );
+		PutJack( writer, pPlug->JackOnPulse() );
+	}
+
+	std::vector<const Jack*> jacks;
+	if( auto pJackEnumerator = dynamic_cast<const JackEnumerator*>(&connector) ){
+		for( const Jack& jack : *pJackEnumerator ){
+			if( WiredPlugID( jack ) )
+				jacks.push_back( &jack );
+		}
+	}
+
+	writer.Put( static_cast<std::uint32_t>(jacks.size()) );
+	for( const Jack* pJack : jacks )
+		PutJack( writer, *pJack );
+}
+
+static void PutSensor( SnapshotWriter& writer, const Sensor& sensor, const TrackLocation& trackLocation ){
+	if( auto pVelocitySensor = dynamic_cast<const VelocitySensor*>(&sensor) ){
+		writer.Put( SnapshotSensor::velocity );
+		writer.Put( pVelocitySensor->VelocityMin() );
+		writer.Put( pVelocitySensor->VelocityMax() );
+		writer.PutBool( pVelocitySensor->TriggerInside() );
+	}
+	else if( auto pWeighSensor = dynamic_cast<const WeighSensor*>(&sensor) ){
+		writer.Put( SnapshotSensor::weigh );
+		writer.Put( pWeighSensor->WeightMin() );
+		writer.Put( pWeighSensor->WeightMax() );
+		writer.PutBool( pWeighSensor->TriggerInside() );
+		writer.PutBool( pWeighSensor->WeighTrain() );
+	}
+	else
+		writer.Put( SnapshotSensor::sensor );
+
+	writer.PutID( sensor.ID() );
+	writer.PutReferences( sensor );
+	writer.Put( trackLocation.parameter );
+	writer.PutBool( trackLocation.orientation == Orientation::Value::para );
+
+	// A sensor has the one jack it triggers:
+	const Jack* pJack = nullptr;
+	if( auto pJackEnumerator = dynamic_cast<const JackEnumerator*>(&sensor) ){
+		for( const Jack& jack : *pJackEnumerator ){
+			if( jack.Plugged() ){
+				pJack = &jack;
+				break;
+			}
+		}
+	}
+
+	if( pJack )
+		PutJack( writer, *pJack );
+	else
+		writer.PutID( IDType{} );
+}
+
+static void PutTrack( SnapshotWriter& writer, const TrackBuilder& track, std::map<const Curve*,std::uint32_t>& curves ){
+	writer.Put( track.GetTrackType() );
+	writer.PutID( track.ID() );
+	writer.PutReferences( track );
+	writer.Put( track.GetFrame() );
+
+	// Curves shared by tracks get written once:
+	const auto curve = track.GetCurve();
+	writer.Put( curve.second );
+	if( !curve.first )
+		writer.Put( std::uint32_t{ 0 } );
+	else if( auto iter = curves.find( curve.first.get() ); iter != curves.end() )
+		writer.Put( iter->second );
+	else{
+		const std::uint32_t curveIdx = static_cast<std::uint32_t>(curves.size() + 1);
+		curves.insert( { curve.first.get(), curveIdx } );
+		writer.Put( curveIdx );
+		PutCurve( writer, *curve.first );
+	}
+
+	PutTwist( writer, track.GetTwist() );
+
+	std::vector<std::shared_ptr<const Section>> sections;
+	if( auto pSectionTrack = dynamic_cast<const SectionTrack*>(&track) ){
+		for( int idx = 0; idx < pSectionTrack->CntSections(); ++idx ){
+			if( std::shared_ptr<const Section> pSection = pSectionTrack->GetSection( idx ) )
+				sections.push_back( pSection );
+		}
+	}
+
+	writer.Put( static_cast<std::uint32_t>(sections.size()) );
+	for( const auto& pSection : sections ){
+		writer.Put( pSection->GetSectionType() );
+		if( pSection->GetSectionType() == Section::SpecialSections::custom ){
+			writer.Put( static_cast<std::uint32_t>(pSection->CountPoints()) );
+			for( int idx = 0; idx < pSection->CountPoints(); ++idx )
+				writer.Put( pSection->Get( idx ) );
+		}
+	}
+
+	for( const EndType end : { EndType::north, EndType::south } ){
+		const Track::End connected = track.TransitionEnd( end );
+		writer.PutID( connected.id );
+		writer.Put( connected.type );
+	}
+
+	std::vector<std::pair<std::shared_ptr<const Sensor>,TrackLocation>> sensors;
+	for( int idx = 0; idx < track.CountSensors(); ++idx ){
+		TrackLocation trackLocation;
+		if( std::shared_ptr<const Sensor> pSensor = track.GetSensor( idx );
+			pSensor && track.Attached( *pSensor, &trackLocation ) )
+		{
+			// Those come with the trains library, a snapshot could not make them:
+			if( dynamic_cast<const IntervalSensor*>(pSensor.get()) )
+				throw std::invalid_argument( std::string{ "TrackSystemSnapshot: sensor type not supported: " } + pSensor->TypeName() );
+
+			sensors.push_back( { pSensor, trackLocation } );
+		}
+	}
+
+	writer.Put( static_cast<std::uint32_t>(sensors.size()) );
+	for( const auto& pair : sensors )
+		PutSensor( writer, *pair.first, pair.second );
+}
+
+static void PutConnector( SnapshotWriter& writer, const Connector& connector ){
+	if( dynamic_cast<const Switch*>(&connector) )
+		writer.Put( SnapshotConnector::switchType );
+	else if( dynamic_cast<const ThreeWaySwitch*>(&connector) )
+		writer.Put( SnapshotConnector::threeWaySwitch );
+	else if( dynamic_cast<const SingleSlipSwitch*>(&connector) )
+		writer.Put( SnapshotConnector::singleSlipSwitch );
+	else if( dynamic_cast<const DoubleSlipSwitch*>(&connector) )
+		writer.Put( SnapshotConnector::doubleSlipSwitch );
+	else
+		throw std::invalid_argument( std::string{ "TrackSystemSnapshot: connector type not supported: " } + connector.TypeName() );
+
+	writer.PutID( connector.ID() );
+	writer.PutReferences( connector );
+	writer.Put( connector.Get() );
+
+	if( dynamic_cast<const SingleSlipSwitch*>(&connector) || dynamic_cast<const DoubleSlipSwitch*>(&connector) ){
+		Frame<Length,One> center;
+		connector.GetCenter( center );
+		writer.Put( center );
+	}
+
+	writer.Put( static_cast<std::uint32_t>(connector.CntSlots()) );
+	for( int slot = 0; slot < connector.CntSlots(); ++slot ){
+		const auto trackEnd = connector.Slot( slot );
+		writer.PutID( trackEnd.first ? trackEnd.first->ID() : IDType{} );
+		writer.Put( trackEnd.second );
+	}
+
+	PutSockets( writer, connector );
+}
+
+void WriteSnapshot( const TrackSystem& trackSystem, std::vector<unsigned char>& buffer ){
+	SnapshotWriter writer{ buffer };
+
+	const std::size_t headerAt = writer.Size();
+	SnapshotHeader header{};
+	std::memcpy( header.magic, snapshotMagic, sizeof(header.magic) );
+	header.version = snapshotVersion;
+	header.byteOrder = snapshotByteOrder;
+	header.sizeOfReal = sizeof(Real);
+	writer.Put( header );
+
+	const std::size_t payloadAt = writer.Size();
+	writer.PutID( trackSystem.ID() );
+	writer.PutReferences( trackSystem );
+	const std::shared_ptr<const TrackBuilder> pActive = trackSystem.GetActive();
+	writer.PutID( pActive ? pActive->ID() : IDType{} );
+
+	std::map<const Curve*,std::uint32_t> curves;
+	std::shared_ptr<const TrackCollectionContainer> pContainer = trackSystem.GetCollectionContainer();
+	writer.Put( static_cast<std::uint32_t>(pContainer ? pContainer->Count() : 0) );
+	if( pContainer ){
+		for( const TrackCollection& trackCollection : *pContainer ){
+			writer.PutID( trackCollection.ID() );
+			writer.PutReferences( trackCollection );
+			writer.Put( trackCollection.GetFrame() );
+			writer.Put( static_cast<std::uint32_t>(trackCollection.Count()) );
+			for( const TrackBuilder& track : trackCollection )
+				PutTrack( writer, track, curves );
+		}
+	}
+
+	const ConnectorCollection* pConnectorCollection = trackSystem.GetConnectorCollection();
+	writer.Put( static_cast<std::uint32_t>(pConnectorCollection ? pConnectorCollection->Count() : 0) );
+	if( pConnectorCollection ){
+		for( const Connector& connector : *pConnectorCollection )
+			PutConnector( writer, connector );
+	}
+
+	header.payloadSize = writer.Size() - payloadAt;
+	if( !trackSystem.IsEmptyReference( "maxValidPlugID" ) )
+		header.maxValidPlugID = static_cast<std::uint32_t>(std::stoul( trackSystem.Reference( "maxValidPlugID" ) ));
+	writer.Patch( headerAt, header );
+}
+
+void WriteSnapshot( const TrackSystem& trackSystem, const std::filesystem::path& toPath ){
+	std::vector<unsigned char> buffer;
+	WriteSnapshot( trackSystem, buffer );
+
+	std::ofstream file{ toPath, std::ios::binary | std::ios::trunc };
+	if( !file )
+		throw std::runtime_error( "TrackSystemSnapshot: can not open file for writing: " + toPath.string() );
+
+	file.write( reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()) );
+	if( !file )
+		throw std::runtime_error( "TrackSystemSnapshot: failed to write file: " + toPath.string() );
+}
+///////////////////////////////////////
+// Reading:
+
+template<class CurveType>
+static std::unique_ptr<Curve> GetCurveData( SnapshotReader& reader, std::unique_ptr<CurveType> pCurve ){
+	const typename CurveType::Data data = reader.Get<typename CurveType::Data>();
+	if( pCurve )
+		pCurve->Create( data );
+
+	return pCurve;
+}
+
+template<class CurveType>
+static std::unique_ptr<Curve> GetCurveVector( SnapshotReader& reader, std::unique_ptr<CurveType> pCurve ){
+	const typename CurveType::Data data = reader.GetVector<typename CurveType::Data::value_type>();
+	if( pCurve )
+		pCurve->Create( data );
+
+	return pCurve;
+}
+
+static std::unique_ptr<Curve> GetCurve( SnapshotReader& reader ){
+	const Curve::CurveType type = reader.Get<Curve::CurveType>();
+	switch( type ){
+	case Curve::CurveType::Line:
+		return Line::Make();
+	case Curve::CurveType::Arc:
+		return GetCurveData( reader, Arc::Make() );
+	case Curve::CurveType::Helix:
+		return GetCurveData( reader, Helix::Make() );
+	case Curve::CurveType::LineP:
+		return GetCurveData( reader, LineP::Make() );
+	case Curve::CurveType::ArcP:
+		return GetCurveData( reader, ArcP::Make() );
+	case Curve::CurveType::HelixP:
+		return GetCurveData( reader, HelixP::Make() );
+	case Curve::CurveType::Clothoid:
+		return GetCurveData( reader, Clothoid::Make() );
+	case Curve::CurveType::Cubic:
+		return GetCurveData( reader, Cubic::Make() );
+	case Curve::CurveType::Rotator:
+	case Curve::CurveType::RotatorWithOffset:
+		return GetCurveData( reader, Rotator::Make( type ) );
+	case Curve::CurveType::EEPCurve:
+	case Curve::CurveType::EEPResidual:
+	case Curve::CurveType::EEPAlternative:
+		return GetCurveData( reader, EEPCurve::Make( type ) );
+	case Curve::CurveType::Spline:
+		return GetCurveVector( reader, Spline::Make() );
+	case Curve::CurveType::PolygonalChain:
+		return GetCurveVector( reader, PolygonalChain::Make() );
+	case Curve::CurveType::SampledCurve:
+		return GetCurveVector( reader, SampledCurve::Make() );
+	case Curve::CurveType::RotatorChain:
+	{
+		RotatorChain::Data data( reader.GetCount( 2 * sizeof(Angle) + sizeof(Length) ) );
+		for( auto& link : data ){
+			std::get<0>(link) = reader.Get<Angle>();
+			std::get<1>(link) = reader.Get<Angle>();
+			std::get<2>(link) = reader.Get<Length>();
+		}
+
+		std::unique_ptr<RotatorChain> pCurve = RotatorChain::Make();
+		if( pCurve )
+			pCurve->Create( data );
+		return pCurve;
+	}
+	default:
+		throw std::runtime_error( "TrackSystemSnapshot: unknown curve type!" );
+	}
+}
+
+static std::unique_ptr<RoadwayTwist> GetTwist( SnapshotReader& reader ){
+	const RoadwayTwist::TwistType type = reader.Get<RoadwayTwist::TwistType>();
+
+	std::unique_ptr<RoadwayTwist> pTwist;
+	switch( type ){
+	case RoadwayTwist::TwistType::Zero:
+		break;
+	case RoadwayTwist::TwistType::Constant:
+	{
+		std::unique_ptr<ConstantTwist> pConstantTwist = ConstantTwist::Make();
+		const Angle value = reader.Get<Angle>();
+		if( pConstantTwist )
+			pConstantTwist->TwistValue( value );
+		pTwist = std::move(pConstantTwist);
+		break;
+	}
+	case RoadwayTwist::TwistType::Linear:
+	{
+		const Angle from = reader.Get<Angle>();
+		pTwist = LinearTwist::Make( from, reader.Get<Angle>() );
+		break;
+	}
+	case RoadwayTwist::TwistType::Piecewise:
+	case RoadwayTwist::TwistType::PiecewiseLinear:
+	case RoadwayTwist::TwistType::PiecewiseCircular:
+	{
+		std::unique_ptr<PiecewiseTwist> pPiecewiseTwist = PiecewiseTwist::Make( type );
+		for( std::uint32_t count = reader.Get<std::uint32_t>(); count; --count ){
+			const Length s = reader.Get<Length>();
+			const Angle angle = reader.Get<Angle>();
+			if( pPiecewiseTwist )
+				pPiecewiseTwist->Add( s, angle );
+		}
+		pTwist = std::move(pPiecewiseTwist);
+		break;
+	}
+	case RoadwayTwist::TwistType::Directional:
+		pTwist = DirectionalTwist::Make( reader.Get<Vector<One>>() );
+		break;
+	case RoadwayTwist::TwistType::PiecewiseDirectional:
+	{
+		std::unique_ptr<PiecewiseDirectionalTwist> pPiecewiseDirectionalTwist = PiecewiseDirectionalTwist::Make();
+		for( std::uint32_t count = reader.Get<std::uint32_t>(); count; --count ){
+			const Length s = reader.Get<Length>();
+			const Vector<One> attractor = reader.Get<Vector<One>>();
+			if( pPiecewiseDirectionalTwist )
+				pPiecewiseDirectionalTwist->Add( s, attractor );
+		}
+		pTwist = std::move(pPiecewiseDirectionalTwist);
+		break;
+	}
+	case RoadwayTwist::TwistType::Combined:
+	{
+		std::unique_ptr<CombinedTwist> pCombinedTwist = CombinedTwist::Make();
+		std::unique_ptr<RoadwayTwist> pTwist1 = GetTwist( reader );
+		std::unique_ptr<RoadwayTwist> pTwist2 = GetTwist( reader );
+		if( pCombinedTwist ){
+			if( pTwist1 )
+				pCombinedTwist->AttachTwist1( std::move(pTwist1) );
+			if( pTwist2 )
+				pCombinedTwist->AttachTwist2( std::move(pTwist2) );
+		}
+		pTwist = std::move(pCombinedTwist);
+		break;
+	}
+	default:
+		throw std::runtime_error( "TrackSystemSnapshot: unknown twist type!" );
+	}
+
+	if( reader.GetBool() && pTwist )
+		pTwist->Freeze();
+
+	return pTwist;
+}
+
+static void GetJack( SnapshotReader& reader, SocketRegistry& socketRegistry, Jack& jack ){
+	if( const IDType plugID = reader.GetID() ){
+		jack.ID( reader.GetID() );
+		reader.GetReferences( jack );
+		jack.RefPlugID( plugID );
+		socketRegistry.ConnectJack( jack );
+	}
+}
+
+static void GetTrack( SnapshotReader& reader, SocketRegistry& socketRegistry, TrackCollection& trackCollection,
+	std::vector<std::shared_ptr<const Curve>>& curves, std::vector<Track::Connection>& couplings )
+{
+	const Track::TrackType trackType = reader.Get<Track::TrackType>();
+	std::shared_ptr<TrackBuilder> pTrack = MovableTrack::Make( trackType );
+	if( !pTrack )
+		throw std::runtime_error( "TrackSystemSnapshot: failed to create track!" );
+
+	pTrack->ID( reader.GetID() );
+	reader.GetReferences( *pTrack );
+	pTrack->SetFrame( reader.Get<Frame<Length,One>>() );
+
+	const common::Interval<Length> range = reader.Get<common::Interval<Length>>();
+	if( const std::uint32_t curveIdx = reader.Get<std::uint32_t>() ){
+		if( curveIdx == curves.size() + 1 )
+			curves.push_back( GetCurve( reader ) );
+		else if( curveIdx > curves.size() )
+			throw std::runtime_error( "TrackSystemSnapshot: broken curve index!" );
+
+		if( curves[curveIdx-1] )
+			pTrack->Attach( curves[curveIdx-1], range );
+	}
+
+	pTrack->Attach( GetTwist( reader ) );
+
+	SectionTrack* pSectionTrack = dynamic_cast<SectionTrack*>(pTrack.get());
+	for( std::uint32_t count = reader.Get<std::uint32_t>(); count; --count ){
+		std::unique_ptr<Section> pSection = Section::Make( reader.Get<Section::SpecialSections>() );
+		if( pSection && pSection->GetSectionType() == Section::SpecialSections::custom ){
+			pSection->SetCntPoints( static_cast<int>(reader.GetCount( sizeof(Section::SectionPoint) )) );
+			for( int idx = 0; idx < pSection->CountPoints(); ++idx )
+				pSection->Set( idx, reader.Get<Section::SectionPoint>() );
+		}
+
+		if( pSectionTrack && pSection )
+			pSectionTrack->Attach( std::move(pSection) );
+	}
+
+	for( const EndType end : { EndType::north, EndType::south } ){
+		Track::Connection coupling;
+		coupling.theOne = { pTrack->ID(), end };
+		coupling.theOther.id = reader.GetID();
+		coupling.theOther.type = reader.Get<EndType>();
+		if( coupling.theOther.id )
+			couplings.push_back( coupling );
+	}
+
+	for( std::uint32_t count = reader.Get<std::uint32_t>(); count; --count ){
+		std::shared_ptr<Sensor> pSensor;
+		switch( reader.Get<SnapshotSensor>() ){
+		case SnapshotSensor::sensor:
+			pSensor = Sensor::Make();
+			break;
+		case SnapshotSensor::velocity:
+		{
+			const Velocity velocityMin = reader.Get<Velocity>();
+			const Velocity velocityMax = reader.Get<Velocity>();
+			const bool bTriggerInside = reader.GetBool();
+			if( std::unique_ptr<VelocitySensor> pVelocitySensor = VelocitySensor::Make() ){
+				pVelocitySensor->SetVelocity( velocityMin, velocityMax );
+				pVelocitySensor->TriggerInside( bTriggerInside );
+				pSensor = std::move(pVelocitySensor);
+			}
+			break;
+		}
+		case SnapshotSensor::weigh:
+		{
+			const Mass weightMin = reader.Get<Mass>();
+			const Mass weightMax = reader.Get<Mass>();
+			const bool bTriggerInside = reader.GetBool();
+			const bool bWeighTrain = reader.GetBool();
+			if( std::unique_ptr<WeighSensor> pWeighSensor = WeighSensor::Make() ){
+				pWeighSensor->Weight( weightMin, weightMax );
+				pWeighSensor->TriggerInside( bTriggerInside );
+				pWeighSensor->WeighTrain( bWeighTrain );
+				pSensor = std::move(pWeighSensor);
+			}
+			break;
+		}
+		default:
+			throw std::runtime_error( "TrackSystemSnapshot: unknown sensor type!" );
+		}
+
+		// Read on even without a sensor, to stay in sync:
+		std::unique_ptr<Sensor> pDummy;
+		if( !pSensor ){
+			pDummy = Sensor::Make();
+			if( !pDummy )
+				throw std::runtime_error( "TrackSystemSnapshot: failed to create sensor!" );
+		}
+		Sensor& sensor = pSensor ? *pSensor : *pDummy;
+
+		sensor.ID( reader.GetID() );
+		reader.GetReferences( sensor );
+		TrackLocation trackLocation;
+		trackLocation.parameter = reader.Get<Length>();
+		trackLocation.orientation = reader.GetBool() ? Orientation::Value::para : Orientation::Value::anti;
+		GetJack( reader, socketRegistry, sensor.JackOnTrigger() );
+
+		if( pSensor )
+			pTrack->Attach( pSensor, trackLocation );
+	}
+
+	trackCollection.Add( pTrack );
+}
+
+template<class ConnectorType>
+static std::unique_ptr<Connector> GetConnector( SnapshotReader& reader, SocketRegistry& socketRegistry,
+	std::unique_ptr<ConnectorType> pConnector, const TrackSystem& trackSystem )
+{
+	if( !pConnector )
+		throw std::runtime_error( "TrackSystemSnapshot: failed to create connector!" );
+
+	pConnector->ID( reader.GetID() );
+	reader.GetReferences( *pConnector );
+	pConnector->Set( reader.Get<Connector::Status>(), false );
+
+	if constexpr( std::is_same_v<ConnectorType,SingleSlipSwitch> || std::is_same_v<ConnectorType,DoubleSlipSwitch> )
+		pConnector->SetCenter( reader.Get<Frame<Length,One>>() );
+
+	const int slots = static_cast<int>(reader.Get<std::uint32_t>());
+	for( int slot = 0; slot < slots; ++slot ){
+		const IDType trackID = reader.GetID();
+		const EndType end = reader.Get<EndType>();
+		if( auto pTrack = trackSystem.Get( trackID ) )
+			pConnector->Slot( slot, pTrack, end );
+	}
+
+	for( std::uint32_t count = reader.Get<std::uint32_t>(); count; --count ){
+		const IDType plugID = reader.GetID();
+		std::map<std::string,std::string> references;
+		for( std::uint32_t countReferences = reader.Get<std::uint32_t>(); countReferences; --countReferences ){
+			const char* pName = reader.GetString();
+			references[pName] = reader.GetString();
+		}
+
+		MultiPlug& multiPlug = pConnector->PlugTo( ConnectorStatusFrom( references["name"] ) );
+		Plug& plug = multiPlug.ID() ? multiPlug.Make( nullptr ) : static_cast<Plug&>(multiPlug);
+		for( const auto& pair : references )
+			plug.Reference( pair.first, pair.second );
+		plug.ID( plugID );
+		socketRegistry.RegisterPlug( plug );
+		GetJack( reader, socketRegistry, plug.JackOnPulse() );
+	}
+
+	for( std::uint32_t count = reader.Get<std::uint32_t>(); count; --count ){
+		const IDType plugID = reader.GetID();
+		if( !plugID )
+			continue;
+
+		const IDType jackID = reader.GetID();
+		std::map<std::string,std::string> references;
+		for( std::uint32_t countReferences = reader.Get<std::uint32_t>(); countReferences; --countReferences ){
+			const char* pName = reader.GetString();
+			references[pName] = reader.GetString();
+		}
+
+		Jack& jack = pConnector->JackOn( ConnectorStatusFrom( references["name"] ) );
+		for( const auto& pair : references )
+			jack.Reference( pair.first, pair.second );
+		jack.ID( jackID );
+		jack.RefPlugID( plugID );
+		socketRegistry.ConnectJack( jack );
+	}
+
+	return pConnector;
+}
+
+std::shared_ptr<TrackSystem> ReadSnapshot( const unsigned char* bufferStart, const unsigned char* bufferEnd ){
+	SnapshotReader reader{ bufferStart, bufferEnd };
+
+	const SnapshotHeader header = reader.Get<SnapshotHeader>();
+	if( std::memcmp( header.magic, snapshotMagic, sizeof(header.magic) ) != 0 )
+		throw std::runtime_error( "TrackSystemSnapshot: not a snapshot!" );
+	if( header.version != snapshotVersion )
+		throw std::runtime_error( "TrackSystemSnapshot: unsupported snapshot version: " + std::to_string( header.version ) );
+	if( header.byteOrder != snapshotByteOrder || header.sizeOfReal != sizeof(Real) )
+		throw std::runtime_error( "TrackSystemSnapshot: the snapshot was written on an incompatible platform!" );
+	if( header.payloadSize > static_cast<std::uint64_t>(bufferEnd - bufferStart) - sizeof(SnapshotHeader) )
+		throw std::runtime_error( "TrackSystemSnapshot: the snapshot is truncated!" );
+
+	reader = SnapshotReader{ bufferStart + sizeof(SnapshotHeader), bufferStart + sizeof(SnapshotHeader) + header.payloadSize };
+
+	std::unique_ptr<SocketRegistry> pSocketRegistry = SocketRegistry::Make();
+	std::shared_ptr<TrackSystem> pTrackSystem{ TrackSystem::Make( TrackCollectionContainer::Make() ) };
+	if( !pSocketRegistry || !pTrackSystem )
+		throw std::runtime_error( "TrackSystemSnapshot: failed to create track system!" );
+
+	pSocketRegistry->ReservePlugIDs( IDType{ header.maxValidPlugID } );
+
+	pTrackSystem->ID( reader.GetID() );
+	reader.GetReferences( *pTrackSystem );
+	const IDType activeTrackID = reader.GetID();
+
+	std::vector<std::shared_ptr<const Curve>> curves;
+	std::vector<Track::Connection> couplings;
+	for( std::uint32_t countCollections = reader.Get<std::uint32_t>(); countCollections; --countCollections ){
+		std::shared_ptr<TrackCollection> pTrackCollection = TrackCollection::Make();
+		if( !pTrackCollection )
+			throw std::runtime_error( "TrackSystemSnapshot: failed to create track collection!" );
+
+		pTrackCollection->ID( reader.GetID() );
+		reader.GetReferences( *pTrackCollection );
+		pTrackCollection->SetFrame( reader.Get<Frame<Length,One>>() );
+
+		for( std::uint32_t countTracks = reader.Get<std::uint32_t>(); countTracks; --countTracks )
+			GetTrack( reader, *pSocketRegistry, *pTrackCollection, curves, couplings );
+
+		pTrackSystem->GetCollectionContainer()->Add( pTrackCollection );
+	}
+
+	// contract doublettes:
+	for( auto i = couplings.begin(); i != couplings.end(); ++i ){
+		for( auto j = i+1; j != couplings.end(); ++j ){
+			if( (*i).theOther == (*j).theOne &&
+				(*i).theOne == (*j).theOther )
+			{
+				(*i).theOther.type = (*j).theOne.type;
+				couplings.erase( j );
+				break;
+			}
+		}
+	}
+
+	for( const Track::Connection& coupling : couplings )
+		pTrackSystem->Connect( coupling, true );
+
+	if( const std::uint32_t countConnectors = reader.Get<std::uint32_t>() ){
+		std::unique_ptr<ConnectorCollection> pConnectorCollection = ConnectorCollection::Make();
+		if( !pConnectorCollection )
+			throw std::runtime_error( "TrackSystemSnapshot: failed to create connector collection!" );
+
+		for( std::uint32_t count = countConnectors; count; --count ){
+			switch( reader.Get<SnapshotConnector>() ){
+			case SnapshotConnector::switchType:
+				pConnectorCollection->Add( GetConnector( reader, *pSocketRegistry, Switch::Make(), *pTrackSystem ) );
+				break;
+			case SnapshotConnector::threeWaySwitch:
+				pConnectorCollection->Add( GetConnector( reader, *pSocketRegistry, ThreeWaySwitch::Make(), *pTrackSystem ) );
+				break;
+			case SnapshotConnector::singleSlipSwitch:
+				pConnectorCollection->Add( GetConnector( reader, *pSocketRegistry, SingleSlipSwitch::Make(), *pTrackSystem ) );
+				break;
+			case SnapshotConnector::doubleSlipSwitch:
+				pConnectorCollection->Add( GetConnector( reader, *pSocketRegistry, DoubleSlipSwitch::Make(), *pTrackSystem ) );
+				break;
+			default:
+				throw std::runtime_error( "TrackSystemSnapshot: unknown connector type!" );
+			}
+		}
+
+		pTrackSystem->SetConnectorCollection( std::move(pConnectorCollection) );
+	}
+
+	if( !reader.AtEnd() )
+		throw std::runtime_error( "TrackSystemSnapshot: unexpected data at the end of the snapshot!" );
+
+	if( activeTrackID )
+		pTrackSystem->PushActive( activeTrackID );
+
+	return pTrackSystem;
+}
+
+std::shared_ptr<TrackSystem> ReadSnapshot( const std::filesystem::path& fromPath ){
+	try{
+		boost::interprocess::file_mapping file{ fromPath.string().c_str(), boost::interprocess::read_only };
+		boost::interprocess::mapped_region region{ file, boost::interprocess::read_only };
+
+		const unsigned char* pStart = static_cast<const unsigned char*>(region.get_address());
+		return ReadSnapshot( pStart, pStart + region.get_size() );
+	}
+	catch( const boost::interprocess::interprocess_exception& e ){
+		throw std::runtime_error( "TrackSystemSnapshot: can not map file " + fromPath.string() + ": " + e.what() );
+	}
+}
+
+bool IsSnapshot( const unsigned char* bufferStart, const unsigned char* bufferEnd ) noexcept{
+	return bufferEnd - bufferStart >= static_cast<std::ptrdiff_t>(sizeof(snapshotMagic)) &&
+		std::memcmp( bufferStart, snapshotMagic, sizeof(snapshotMagic) ) == 0;
+}
+
+bool IsSnapshot( const std::filesystem::path& path ) noexcept{
+	std::ifstream file{ path, std::ios::binary };
+	char magic[sizeof(snapshotMagic)];
+	return file.read( magic, sizeof(magic) ) && std::memcmp( magic, snapshotMagic, sizeof(snapshotMagic) ) == 0;
+}
+
+}
@@ -0,0 +1,686 @@
+//	trax track library
+//	AD 2026
+//
+//  "Pull me under"
+//
+//								Dream Theater
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "trax/collections/TrackSystemParser.h"
+
+#include "XMLPullParser.h"
+
+#include "common/Helpers.h"
+#include "dim/support/DimSupportStream.h"
+
+#if defined(_MSC_VER)
+#	pragma warning(push)
+#	pragma warning(disable: 6313 6387 26495)
+#endif
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#if defined(_MSC_VER)
+#	pragma warning(pop)
+#endif
+
+#include <cctype>
+#include <charconv>
+#include <iterator>
+#include <sstream>
+
+namespace trax{
+	using namespace common;
+	using namespace dim;
+	using namespace spat;
+
+// Values are written with their units appended, like "12.5m". Most of them get
+// converted right from the buffer; whatever the fast path does not understand
+// goes the way of the dim stream operators, like the property tree does:
+static bool SplitNumber( std::string_view text, Real& number, std::string_view& unit ) noexcept{
+	while( !text.empty() && std::isspace( static_cast<unsigned char>(text.front()) ) )
+		text.remove_prefix( 1 );
+	while( !text.empty() && std::isspace( static_cast<unsigned char>(text.back()) ) )
+		text.remove_suffix( 1 );
+
+	const std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), number );
+	if( result.ec != std::errc{} )
+		return false;
+
+	unit = text.substr( static_cast<std::size_t>(result.ptr - text.data()) );
+	return true;
+}
+
+template<typename ValueType>
+static ValueType FromStream( std::string_view text, ValueType defaultValue ){
+	std::istringstream stream{ std::string{ text } };
+	ValueType value;
+	if( stream >> value )
+		return value;
+
+	return defaultValue;
+}
+
+template<typename ValueType>
+static ValueType ToValue(
+	std::string_view text,
+	ValueType defaultValue,
+	ValueType (*defaultUnit)( Real ),
+	ValueType (*(*unitFrom)( std::string ))( Real ) )
+{
+	Real number;
+	std::string_view unit;
+	if( SplitNumber( text, number, unit ) ){
+		if( unit.empty() )
+			return defaultUnit( number );
+		if( auto streamIn = unitFrom( std::string{ unit } ) )
+			return streamIn( number );
+	}
+
+	return FromStream( text, defaultValue );
+}
+
+static Length Get( const XMLPullParser& parser, std::string_view name, Length defaultValue, StreamInLength defaultUnit = DefaultStreamInLength ){
+	std::string_view text;
+	return parser.Attribute( name, text ) ? ToValue( text, defaultValue, defaultUnit, StreamInLengthFrom ) : defaultValue;
+}
+
+static AnglePerLength Get( const XMLPullParser& parser, std::string_view name, AnglePerLength defaultValue, StreamInAnglePerLength defaultUnit = DefaultStreamInAnglePerLength ){
+	std::string_view text;
+	return parser.Attribute( name, text ) ? ToValue( text, defaultValue, defaultUnit, StreamInAnglePerLengthFrom ) : defaultValue;
+}
+
+static Angle Get( const XMLPullParser& parser, std::string_view name, Angle defaultValue ){
+	std::string_view text;
+	return parser.Attribute( name, text ) ? ToValue( text, defaultValue, DefaultStreamInAngle, StreamInAngleFrom ) : defaultValue;
+}
+
+static Real Get( const XMLPullParser& parser, std::string_view name, Real defaultValue ){
+	std::string_view text;
+	if( !parser.Attribute( name, text ) )
+		return defaultValue;
+
+	Real number;
+	std::string_view unit;
+	if( SplitNumber( text, number, unit ) && unit.empty() )
+		return number;
+
+	return FromStream( text, defaultValue );
+}
+
+static bool Get( const XMLPullParser& parser, std::string_view name, bool defaultValue ){
+	std::string_view text;
+	if( !parser.Attribute( name, text ) )
+		return defaultValue;
+
+	if( text == "true" || text == "1" )
+		return true;
+	if( text == "false" || text == "0" )
+		return false;
+
+	return defaultValue;
+}
+
+static IDType Get( const XMLPullParser& parser, std::string_view name, IDType defaultValue ){
+	std::string_view text;
+	if( !parser.Attribute( name, text ) )
+		return defaultValue;
+
+	unsigned int id = 0;
+	const std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), id );
+	if( result.ec != std::errc{} || result.ptr != text.data() + text.size() )
+		return FromStream( text, defaultValue );
+
+	return IDType{ id };
+}
+
+// Calls function for each child element of the current one. The function
+// has to consume the element it gets called for. Stops when the function
+// returns false:
+template<typename Function>
+static bool ForEachChild( XMLPullParser& parser, Function function ){
+	while( parser.Next() == XMLPullParser::Event::startElement ){
+		if( !function( parser.Name() ) )
+			return false;
+	}
+
+	return true;
+}
+
+template<typename Valtype>
+static void ReadPosition( XMLPullParser& parser, Position<Valtype>& position ){
+	position.x = DealDenormalizedNumbers( Get( parser, "x", Valtype{0} ) );
+	position.y = DealDenormalizedNumbers( Get( parser, "y", Valtype{0} ) );
+	position.z = DealDenormalizedNumbers( Get( parser, "z", Valtype{0} ) );
+	parser.Skip();
+}
+
+template<typename Valtype>
+static void ReadVector( XMLPullParser& parser, Vector<Valtype>& vector ){
+	vector.dx = DealDenormalizedNumbers( Get( parser, "dx", Valtype{1} ) );
+	vector.dy = DealDenormalizedNumbers( Get( parser, "dy", Valtype{0} ) );
+	vector.dz = DealDenormalizedNumbers( Get( parser, "dz", Valtype{0} ) );
+	parser.Skip();
+}
+
+// Reads a position followed by up to three vectors, like the property tree
+// versions do it, that stop at the first tag out of order:
+template<typename Valtype,typename ValtypeT>
+static void ReadPositionAndVectors( XMLPullParser& parser, Position<Valtype>& P, std::initializer_list<Vector<ValtypeT>*> vectors ){
+	std::size_t idx = 0;
+	bool bInOrder = true;
+	ForEachChild( parser, [&]( std::string_view name ){
+		if( bInOrder && idx == 0 && name == "Position" )
+			ReadPosition( parser, P );
+		else if( bInOrder && idx > 0 && idx <= vectors.size() && name == "Vector" )
+			ReadVector( parser, *vectors.begin()[idx-1] );
+		else{
+			bInOrder = false;
+			parser.Skip();
+		}
+
+		++idx;
+		return true;
+	} );
+}
+
+template<typename Valtype,typename ValtypeT>
+static void ReadFrame( XMLPullParser& parser, Frame<Valtype,ValtypeT>& frame ){
+	frame.Init();
+	ReadPositionAndVectors( parser, frame.P, { &frame.T, &frame.N, &frame.B } );
+}
+
+static void ReadVectorBundle( XMLPullParser& parser, VectorBundle<Length,One>& vectorBundle ){
+	vectorBundle.Init();
+	ReadPositionAndVectors( parser, vectorBundle.P, { &vectorBundle.T } );
+}
+
+static void ReadVectorBundle2( XMLPullParser& parser, VectorBundle2<Length,One>& vectorBundle2 ){
+	vectorBundle2.Init();
+	ReadPositionAndVectors( parser, vectorBundle2.P, { &vectorBundle2.T, &vectorBundle2.N } );
+}
+
+static void ReadCubic( XMLPullParser& parser, Cubic::Data& data ){
+	std::size_t idx = 0;
+	ForEachChild( parser, [&]( std::string_view name ){
+		if( name == "Position" )
+			ReadPosition( parser, data.a );
+		else if( name == "Vector" ){
+			Vector<Length> vector;
+			ReadVector( parser, vector );
+			switch( idx++ ){
+			case 0: data.b = vector; break;
+			case 1: data.c = vector; break;
+			case 2: data.d = vector; break;
+			default: break;
+			}
+		}
+		else
+			parser.Skip();
+
+		return true;
+	} );
+}
+
+static bool ParseTwist( XMLPullParser& parser, TrackSystemParser& callback );
+
+static bool ParsePiecewiseTwist( XMLPullParser& parser, PiecewiseTwist::Data& data ){
+	return ForEachChild( parser, [&]( std::string_view name ){
+		if( name == "TwistAngle" )
+			data.push_back( std::make_pair( Get( parser, "s", 0_m, _m ), Get( parser, "value", 0_rad ) ) );
+
+		parser.Skip();
+		return true;
+	} );
+}
+
+static bool ParseTwistType( XMLPullParser& parser, std::string_view name, TrackSystemParser& callback ){
+	if( name == "ConstantTwist" ){
+		if( !callback.ConstantTwist( Get( parser, "angle", 0_rad ) ) )
+			return false;
+	}
+
+	else if( name == "LinearTwist" ){
+		if( !callback.LinearTwist( Get( parser, "startangle", 0_rad ), Get( parser, "endangle", 0_rad ) ) )
+			return false;
+	}
+
+	else if( name == "PiecewiseTwist" ){
+		PiecewiseTwist::Data data;
+		ParsePiecewiseTwist( parser, data );
+		return callback.PiecewiseTwist( data );
+	}
+
+	else if( name == "PiecewiseLinearTwist" || name == "PiecewiseLinear" ){
+		PiecewiseTwist::Data data;
+		ParsePiecewiseTwist( parser, data );
+		return callback.PiecewiseLinearTwist( data );
+	}
+
+	else if( name == "DirectionalTwist" ){
+		const bool bFrozen = Get( parser, "bFrozen", false );
+		bool bAttractor = false;
+		Vector<One> attractor;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( !bAttractor && childName == "Vector" ){
+				ReadVector( parser, attractor );
+				bAttractor = true;
+			}
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return bAttractor && callback.DirectionalTwist( attractor, bFrozen );
+	}
+
+	else if( name == "CombinedTwist" ){
+		if( !callback.CombinedTwistStart() )
+			return false;
+
+		if( !ForEachChild( parser, [&]( std::string_view childName ){
+				if( childName == "Twist" )
+					return ParseTwist( parser, callback );
+
+				parser.Skip();
+				return true;
+			} ) )
+			return false;
+
+		callback.CombinedTwistEnd();
+		return true;
+	}
+
+	parser.Skip();
+	return true;
+}
+
+static bool ParseTwist( XMLPullParser& parser, TrackSystemParser& callback ){
+	if( !callback.TwistStart() )
+		return false;
+
+	if( !ForEachChild( parser, [&]( std::string_view name ){
+			return ParseTwistType( parser, name, callback ); } ) )
+		return false;
+
+	callback.TwistEnd();
+	return true;
+}
+
+static bool ParseCurveType( XMLPullParser& parser, std::string_view name, TrackSystemParser& callback ){
+	if( name == "BasicLine" ){
+		parser.Skip();
+		return callback.BasicLine();
+	}
+
+	else if( name == "BasicArc" ){
+		Arc::Data data;
+		data.k = Get( parser, "k", 0_1Im, _1Im );
+		parser.Skip();
+		return callback.BasicArc( data );
+	}
+
+	else if( name == "BasicHelix" ){
+		Helix::Data data;
+		data.k = Get( parser, "k", data.k, _1Im );
+		data.t = Get( parser, "t", data.t, _1Im );
+		parser.Skip();
+		return callback.BasicHelix( data );
+	}
+
+	else if( name == "Line" ){
+		LineP::Data data;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "VectorBundle" ){
+				ReadVectorBundle( parser, data.vb );
+				data.vb.T.Normalize();
+			}
+			else if( childName == "Vector" )
+				ReadVector( parser, data.up );
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.Line( data );
+	}
+
+	else if( name == "Arc" ){
+		ArcP::Data data;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "VectorBundle2" )
+				ReadVectorBundle2( parser, data.vb2 );
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.Arc( data );
+	}
+
+	else if( name == "Helix" ){
+		HelixP::Data data;
+		data.a = Get( parser, "a", data.a, _m );
+		data.b = Get( parser, "b", data.b, _m );
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "VectorBundle2" )
+				ReadVectorBundle2( parser, data.center );
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.Helix( data );
+	}
+
+	else if( name == "Clothoid" ){
+		Clothoid::Data data;
+		data.a = Get( parser, "a", data.a, _m );
+		parser.Skip();
+		return callback.Clothoid( data );
+	}
+
+	else if( name == "Cubic" ){
+		Cubic::Data data;
+		ReadCubic( parser, data );
+		return callback.Cubic( data );
+	}
+
+	else if( name == "Spline" ){
+		Spline::Data data;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "Cubic" ){
+				data.push_back( {} );
+				ReadCubic( parser, data.back() );
+			}
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.Spline( data );
+	}
+
+	else if( name == "Rotator" ){
+		Rotator::Data data;
+		data.a = Get( parser, "a", data.a );
+		data.b = Get( parser, "b", data.b );
+		data.a0 = Get( parser, "a0", data.a0 );
+		data.b0 = Get( parser, "b0", data.b0 );
+		parser.Skip();
+		return callback.Rotator( data );
+	}
+
+	else if( name == "RotatorChain" ){
+		RotatorChain::Data data;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "Link" )
+				data.push_back( {
+					Get( parser, "a", 0_rad ),
+					Get( parser, "b", 0_rad ),
+					Get( parser, "length", 1_m ) } );
+
+			parser.Skip();
+			return true;
+		} );
+
+		return callback.RotatorChain( data );
+	}
+
+	else if( name == "PolygonalChain" ){
+		PolygonalChain::Data data;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "VectorBundle" ){
+				data.push_back( {} );
+				ReadVectorBundle( parser, data.back() );
+			}
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.PolygonalChain( data );
+	}
+
+	else if( name == "SampledCurve" ){
+		SampledCurve::Data data;
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "Sample" || childName == "CurveSample" ){
+				data.push_back( {} );
+				CurveSample& sample = data.back();
+				sample.s = Get( parser, "s", sample.s );
+				sample.k = Get( parser, "k", sample.k );
+				sample.t = Get( parser, "t", sample.t );
+				ForEachChild( parser, [&]( std::string_view sampleChildName ){
+					if( sampleChildName == "Frame" )
+						ReadFrame( parser, sample.F );
+					else
+						parser.Skip();
+
+					return true;
+				} );
+			}
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.SampledCurve( data );
+	}
+
+	else if( name == "EEPCurve" ){
+		EEPCurve::Data data;
+		data.gc_Kruemmung = Get( parser, "Kruemmung", data.gc_Kruemmung );
+		data.gc_Windung = Get( parser, "Torsion", data.gc_Windung );
+		data.gc_Verdrillung = Get( parser, "Fuehrungsverdrehung", data.gc_Verdrillung );
+		data.gc_Laenge = Get( parser, "Laenge", data.gc_Laenge );
+		data.gc_Kurve = Get( parser, "Kurve", data.gc_Kurve );
+		data.m_FuehrungsVerdrehung = Get( parser, "Anfangsfuehrungsverdrehung", data.m_FuehrungsVerdrehung );
+		ForEachChild( parser, [&]( std::string_view childName ){
+			if( childName == "Frame" )
+				ReadFrame( parser, data.m_AnfangsBein );
+			else
+				parser.Skip();
+
+			return true;
+		} );
+
+		return callback.EEPCurve( data );
+	}
+
+	parser.Skip();
+	return true;
+}
+
+static bool ParseCurve( XMLPullParser& parser, TrackSystemParser& callback ){
+	if( !callback.CurveStart() )
+		return false;
+
+	if( !ForEachChild( parser, [&]( std::string_view name ){
+			return ParseCurveType( parser, name, callback ); } ) )
+		return false;
+
+	callback.CurveEnd();
+	return true;
+}
+
+static bool ParseTrackEnd( XMLPullParser& parser, Track::End theOne, TrackSystemParser& callback ){
+	return ForEachChild( parser, [&]( std::string_view name ){
+		if( name == "Connection" ){
+			Track::End theOther;
+			ForEachChild( parser, [&]( std::string_view childName ){
+				if( childName == "TrackEnd" ){
+					theOther.id = Get( parser, "refid", IDType{0} );
+					theOther.type = ToEndType( parser.AttributeString( "type", "front" ).c_str() );
+				}
+
+				parser.Skip();
+				return true;
+			} );
+
+			return callback.TrackConnection( { theOne, theOther } );
+		}
+
+		parser.Skip();
+		if( name == "BufferStop" )
+			return callback.BufferStop( theOne );
+		if( name == "OpenEnd" )
+			return callback.OpenEnd( theOne );
+
+		return true;
+	} );
+}
+
+static bool ParseTrack( XMLPullParser& parser, TrackSystemParser& callback ){
+	const IDType id = Get( parser, "id", IDType{0} );
+	if( !callback.TrackStart( id, parser.AttributeString( "reference" ) ) )
+		return false;
+
+	if( std::string_view length; parser.Attribute( "length", length ) )
+		callback.Interval( { 0_m, Get( parser, "length", 0_m ) } );
+
+	if( !ForEachChild( parser, [&]( std::string_view name ){
+			if( name == "Begin" )
+				return ParseTrackEnd( parser, { id, EndType::north }, callback );
+
+			else if( name == "End" )
+				return ParseTrackEnd( parser, { id, EndType::south }, callback );
+
+			else if( name == "Frame" ){
+				Frame<Length,One> frame;
+				ReadFrame( parser, frame );
+				callback.Frame( frame );
+				return true;
+			}
+
+			else if( name == "Interval" ){
+				callback.Interval( { Get( parser, "near", 0_m ), Get( parser, "far", 0_m ) } );
+				parser.Skip();
+				return true;
+			}
+
+			else if( name == "Curve" )
+				return ParseCurve( parser, callback );
+
+			else if( name == "Twist" )
+				return ParseTwist( parser, callback );
+
+			else if( name == "Section" ){
+				const Section::SpecialSections type = SpecialSection( parser.AttributeString( "type", "custom" ) );
+				parser.Skip();
+				return callback.Section( type );
+			}
+
+			parser.Skip();
+			return true;
+		} ) )
+		return false;
+
+	callback.TrackEnd();
+	return true;
+}
+
+static bool ParseTrackCollection( XMLPullParser& parser, TrackSystemParser& callback ){
+	if( !callback.TrackCollectionStart( Get( parser, "id", IDType{0} ) ) )
+		return false;
+
+	if( !ForEachChild( parser, [&]( std::string_view name ){
+			if( name == "Track" )
+				return ParseTrack( parser, callback );
+
+			else if( name == "Frame" ){
+				Frame<Length,One> frame;
+				ReadFrame( parser, frame );
+				callback.Frame( frame );
+				return true;
+			}
+
+			parser.Skip();
+			return true;
+		} ) )
+		return false;
+
+	callback.TrackCollectionEnd();
+	return true;
+}
+
+static bool ParseTrackSystem( XMLPullParser& parser, TrackSystemParser& callback ){
+	if( !callback.TrackSystemStart() )
+		return false;
+
+	const IDType activeTrack = Get( parser, "activeTrack", IDType{0} );
+
+	if( !ForEachChild( parser, [&]( std::string_view name ){
+			if( name == "TrackCollection" )
+				return ParseTrackCollection( parser, callback );
+
+			parser.Skip();
+			return true;
+		} ) )
+		return false;
+
+	callback.TrackSystemEnd( activeTrack );
+	return true;
+}
+
+bool ParseTrackSystem( const char* bufferStart, const char* bufferEnd, TrackSystemParser& callback ) noexcept(false){
+	XMLPullParser parser{ bufferStart, bufferEnd };
+	for( XMLPullParser::Event event = parser.Next(); event != XMLPullParser::Event::endDocument; event = parser.Next() ){
+		if( event == XMLPullParser::Event::startElement && parser.Name() == "TrackSystem" ){
+			if( !callback.ParsingStart() ||
+				!ParseTrackSystem( parser, callback ) )
+				return false;
+
+			callback.ParsingEnd();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ParseTrackSystem( std::basic_istream<char>& stream, TrackSystemParser& callback ) noexcept(false){
+	const std::string buffer{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+	return ParseTrackSystem( buffer.data(), buffer.data() + buffer.size(), callback );
+}
+
+bool ParseTrackSystem( std::string filePath, TrackSystemParser& callback ) noexcept(false){
+	boost::interprocess::file_mapping file;
+	boost::interprocess::mapped_region region;
+	try{
+		file = boost::interprocess::file_mapping{ filePath.c_str(), boost::interprocess::read_only };
+		region = boost::interprocess::mapped_region{ file, boost::interprocess::read_only };
+	}
+	catch( const boost::interprocess::interprocess_exception& e ){
+		throw std::runtime_error( "ParseTrackSystem: can not map file " + filePath + ": " + e.what() );
+	}
+
+	const char* pStart = static_cast<const char*>(region.get_address());
+	return ParseTrackSystem( pStart, pStart + region.get_size(), callback );
+}
+
+}
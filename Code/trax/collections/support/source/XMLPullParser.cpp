@@ -0,0 +1,281 @@
+//	trax track library
+//	AD 2026
+//
+//  "Pull me under"
+//
+//								Dream Theater
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "XMLPullParser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace trax{
+
+static bool IsWhitespace( char c ) noexcept{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool IsNameDelimiter( char c ) noexcept{
+	return IsWhitespace( c ) || c == '>' || c == '/' || c == '=';
+}
+
+static bool StartsWith( const char* pPos, const char* pEnd, std::string_view prefix ) noexcept{
+	return static_cast<std::size_t>(pEnd - pPos) >= prefix.size() &&
+		std::memcmp( pPos, prefix.data(), prefix.size() ) == 0;
+}
+
+static void AppendUTF8( std::string& string, unsigned long codePoint ){
+	if( codePoint < 0x80 )
+		string += static_cast<char>(codePoint);
+	else if( codePoint < 0x800 ){
+		string += static_cast<char>(0xC0 | (codePoint >> 6));
+		string += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else if( codePoint < 0x10000 ){
+		string += static_cast<char>(0xE0 | (codePoint >> 12));
+		string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		string += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+	else{
+		string += static_cast<char>(0xF0 | (codePoint >> 18));
+		string += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+		string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+		string += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+XMLPullParser::XMLPullParser( const char* bufferStart, const char* bufferEnd ) noexcept
+	: m_pStart{ bufferStart },
+	m_pPos{ bufferStart },
+	m_pEnd{ bufferEnd }
+{
+	// Byte order mark:
+	if( StartsWith( m_pPos, m_pEnd, "\xEF\xBB\xBF" ) )
+		m_pPos += 3;
+}
+
+XMLPullParser::Event XMLPullParser::Next(){
+	if( m_bEndPending ){
+		m_bEndPending = false;
+		m_Open.pop_back();
+		return Event::endElement;
+	}
+
+	m_Attributes.clear();
+
+	for( ;; ){
+		m_pPos = std::find( m_pPos, m_pEnd, '<' );
+		if( m_pPos == m_pEnd ){
+			if( !m_Open.empty() )
+				Error( "unexpected end of document" );
+
+			m_Name = {};
+			m_Depth = 0;
+			return Event::endDocument;
+		}
+
+		if( StartsWith( m_pPos, m_pEnd, "<?" ) )
+			SkipPast( "?>" );
+		else if( StartsWith( m_pPos, m_pEnd, "<!--" ) )
+			SkipPast( "-->" );
+		else if( StartsWith( m_pPos, m_pEnd, "<![CDATA[" ) )
+			SkipPast( "]]>" );
+		else if( StartsWith( m_pPos, m_pEnd, "<!" ) )
+			SkipPast( ">" );
+		else
+			break;
+	}
+
+	if( StartsWith( m_pPos, m_pEnd, "</" ) ){
+		m_pPos += 2;
+		m_Name = ReadName();
+		SkipWhitespace();
+		if( m_pPos == m_pEnd || *m_pPos != '>' )
+			Error( "'>' expected" );
+		++m_pPos;
+
+		if( m_Open.empty() || m_Open.back() != m_Name )
+			Error( "end tag does not match start tag" );
+
+		m_Depth = static_cast<int>(m_Open.size());
+		m_Open.pop_back();
+		return Event::endElement;
+	}
+
+	++m_pPos;
+	m_Name = ReadName();
+	m_Open.push_back( m_Name );
+	m_Depth = static_cast<int>(m_Open.size());
+
+	for( ;; ){
+		SkipWhitespace();
+		if( m_pPos == m_pEnd )
+			Error( "unexpected end of document" );
+
+		if( *m_pPos == '>' ){
+			++m_pPos;
+			return Event::startElement;
+		}
+
+		if( StartsWith( m_pPos, m_pEnd, "/>" ) ){
+			m_pPos += 2;
+			m_bEndPending = true;
+			return Event::startElement;
+		}
+
+		const std::string_view name = ReadName();
+		SkipWhitespace();
+		if( m_pPos == m_pEnd || *m_pPos != '=' )
+			Error( "'=' expected" );
+		++m_pPos;
+		SkipWhitespace();
+		if( m_pPos == m_pEnd || (*m_pPos != '"' && *m_pPos != '\'') )
+			Error( "quote expected" );
+
+		const char* pValueStart = m_pPos + 1;
+		const char* pValueEnd = std::find( pValueStart, m_pEnd, *m_pPos );
+		if( pValueEnd == m_pEnd )
+			Error( "unterminated attribute value" );
+
+		m_Attributes.emplace_back( name, std::string_view{ pValueStart, static_cast<std::size_t>(pValueEnd - pValueStart) } );
+		m_pPos = pValueEnd + 1;
+	}
+}
+
+void XMLPullParser::Skip(){
+	for( int depth = 1; depth > 0; ){
+		switch( Next() ){
+		case Event::startElement:
+			++depth;
+			break;
+		case Event::endElement:
+			--depth;
+			break;
+		case Event::endDocument:
+			Error( "unexpected end of document" );
+		}
+	}
+}
+
+std::string_view XMLPullParser::Name() const noexcept{
+	return m_Name;
+}
+
+int XMLPullParser::Depth() const noexcept{
+	return m_Depth;
+}
+
+bool XMLPullParser::Attribute( std::string_view name, std::string_view& value ) const noexcept{
+	for( const auto& attribute : m_Attributes ){
+		if( attribute.first == name ){
+			value = attribute.second;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::string XMLPullParser::AttributeString( std::string_view name, const std::string& defaultValue ) const{
+	std::string_view raw;
+	if( !Attribute( name, raw ) )
+		return defaultValue;
+
+	std::string value;
+	value.reserve( raw.size() );
+	for( std::size_t pos = 0; pos < raw.size(); ){
+		const std::size_t amp = raw.find( '&', pos );
+		value.append( raw.substr( pos, amp - pos ) );
+		if( amp == std::string_view::npos )
+			break;
+
+		const std::size_t semicolon = raw.find( ';', amp );
+		if( semicolon == std::string_view::npos )
+			Error( "unterminated entity" );
+
+		const std::string_view entity = raw.substr( amp + 1, semicolon - amp - 1 );
+		if( entity == "lt" )
+			value += '<';
+		else if( entity == "gt" )
+			value += '>';
+		else if( entity == "amp" )
+			value += '&';
+		else if( entity == "quot" )
+			value += '"';
+		else if( entity == "apos" )
+			value += '\'';
+		else if( entity.size() > 1 && entity[0] == '#' ){
+			const bool bHex = entity[1] == 'x' || entity[1] == 'X';
+			const std::string digits{ entity.substr( bHex ? 2 : 1 ) };
+			std::size_t count = 0;
+			unsigned long codePoint = 0;
+			try{
+				codePoint = std::stoul( digits, &count, bHex ? 16 : 10 );
+			}
+			catch( const std::logic_error& ){
+			}
+
+			if( digits.empty() || count != digits.size() || codePoint > 0x10FFFF )
+				Error( "invalid character reference" );
+			AppendUTF8( value, codePoint );
+		}
+		else
+			Error( "unknown entity" );
+
+		pos = semicolon + 1;
+	}
+
+	return value;
+}
+
+void XMLPullParser::SkipPast( std::string_view terminator ){
+	const std::string_view rest{ m_pPos, static_cast<std::size_t>(m_pEnd - m_pPos) };
+	const std::size_t pos = rest.find( terminator );
+	if( pos == std::string_view::npos )
+		Error( "unexpected end of document" );
+
+	m_pPos += pos + terminator.size();
+}
+
+std::string_view XMLPullParser::ReadName(){
+	const char* pNameStart = m_pPos;
+	while( m_pPos != m_pEnd && !IsNameDelimiter( *m_pPos ) )
+		++m_pPos;
+
+	if( m_pPos == pNameStart )
+		Error( "name expected" );
+
+	return { pNameStart, static_cast<std::size_t>(m_pPos - pNameStart) };
+}
+
+void XMLPullParser::SkipWhitespace() noexcept{
+	while( m_pPos != m_pEnd && IsWhitespace( *m_pPos ) )
+		++m_pPos;
+}
+
+void XMLPullParser::Error( const char* message ) const{
+	throw std::runtime_error( std::string{ "XMLPullParser: " } + message + " at offset " + std::to_string( m_pPos - m_pStart ) + "!" );
+}
+
+}
@@ -0,0 +1,102 @@
+//	trax track library
+//	AD 2026
+//
+//  "Pull me under"
+//
+//								Dream Theater
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace trax{
+
+	/// \brief Pull parser for the XML files written by trax.
+	///
+	/// Works in place on a buffer, that has to outlive the parser; names and
+	/// attribute values are views into that buffer. XML declarations, processing
+	/// instructions, comments, doctype declarations, CDATA sections and character
+	/// data are skipped. Namespaces are not resolved.
+	class XMLPullParser{
+	public:
+		enum class Event{
+			startElement,
+			endElement,
+			endDocument
+		};
+
+		XMLPullParser( const char* bufferStart, const char* bufferEnd ) noexcept;
+
+
+		/// \brief Advances to the next start or end of an element.
+		///
+		/// An empty element like <Tag/> gets reported as a start
+		/// followed by an end.
+		/// \throws std::runtime_error if the XML is malformed.
+		Event Next();
+
+
+		/// \brief Skips the content of the current element up to
+		/// and including its end.
+		/// \throws std::runtime_error if the XML is malformed.
+		void Skip();
+
+
+		/// \returns The name of the current element.
+		std::string_view Name() const noexcept;
+
+
+		/// \returns The nesting depth of the current element, 1 for
+		/// the root element.
+		int Depth() const noexcept;
+
+
+		/// \brief Gets the raw value of an attribute of the current
+		/// element, as it is written in the buffer.
+		/// \returns true if the element has the attribute.
+		bool Attribute( std::string_view name, std::string_view& value ) const noexcept;
+
+
+		/// \returns The value of an attribute of the current element with its
+		/// entities resolved, or defaultValue if there is no such attribute.
+		/// \throws std::runtime_error on an unknown entity.
+		std::string AttributeString( std::string_view name, const std::string& defaultValue = {} ) const;
+	private:
+		const char* m_pStart;
+		const char* m_pPos;
+		const char* m_pEnd;
+		bool m_bEndPending = false;
+		std::string_view m_Name;
+		int m_Depth = 0;
+		std::vector<std::string_view> m_Open;
+		std::vector<std::pair<std::string_view,std::string_view>> m_Attributes;
+
+		void SkipPast( std::string_view terminator );
+		std::string_view ReadName();
+		void SkipWhitespace() noexcept;
+		[[noreturn]] void Error( const char* message ) const;
+	};
+
+}
@@ -38,6 +38,7 @@
 #include "spat/Matrix.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace trax{
@@ -249,6 +250,20 @@ namespace trax{
 		virtual void SetLength( Length length ) = 0;
 
 		virtual Length GetLength() const = 0;
+
+
+		/// \brief Sets the number of segments the circumference of the 
+		/// cylinder gets approximated with.
+		///
+		/// Engines that have to build the cylinder from a mesh will use
+		/// that many vertices per cap. Default is 16.
+		/// \throws std::invalid_argument if nSegments is not in [3,127].
+		virtual void Tessellation( int nSegments ) = 0;
+
+
+		/// \returns The number of segments the circumference of the 
+		/// cylinder gets approximated with.
+		virtual int Tessellation() const noexcept = 0;
 	};
 
 
@@ -327,6 +342,24 @@ namespace trax{
 		virtual bool Create( const std::vector<spat::Position<Length>>& points, const std::vector<int>& indices ) = 0;
 
 
+		/// \name Cooking
+		/// \brief Creates the mesh in two steps.
+		///
+		/// Cook() does the expensive part of Create( points, indices ) and returns the 
+		/// engine specific cooked data. It neither changes the mesh nor the scene, so it
+		/// can be called concurrently from worker threads. Create( cookedData ) then makes
+		/// the mesh from the data on the thread owning the scene. The data can be stored and
+		/// reused as long as CookingSignature() stays the same.
+		///@{
+		
+		/// \returns The cooked data or an empty vector if the mesh could not be cooked.
+		virtual std::vector<unsigned char> Cook( const std::vector<spat::Position<Length>>& points, const std::vector<int>& indices ) const = 0;
+
+		virtual bool Create( const std::vector<unsigned char>& cookedData ) = 0;
+
+		/// \returns A string identifying the engine and settings the cooked data depends on.
+		virtual std::string CookingSignature() const = 0;
+		///@}
 	};
 
 
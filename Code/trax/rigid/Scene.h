@@ -29,6 +29,7 @@
 
 #include "trax/Configuration.h"
 #include "trax/Identified.h"
+#include "trax/Jack.h"
 #include "trax/Units.h"
 
 #include "spat/Frame.h"
@@ -125,6 +126,43 @@ namespace trax{
 		virtual void UnregisterAllSimulated() noexcept = 0;
 
 
+		/// \brief Sets the number of threads to update the Simulated objects with.
+		///
+		/// With more than one thread, the objects that allow for it (see 
+		/// Simulated::ParallelUpdate()) get their PreUpdate() and Update() called 
+		/// concurrently, after all other objects got them called in order of 
+		/// registration. Objects sharing data by Simulated::UpdateNeighbours(), 
+		/// like coupled bogies or trains that reserve on the same tracks, form 
+		/// groups that are updated on one thread in order of registration. Pulses 
+		/// fired during the concurrent updates are delivered group by group 
+		/// afterwards, so the results do not depend on thread scheduling.
+		/// \param numThreads Number of threads, including the calling one. 1 
+		/// means serial updates, which is the default.
+		/// \throws std::invalid_argument if numThreads is smaller than 1.
+		virtual void UpdateThreads( int numThreads ) = 0;
+
+
+		/// \returns The number of threads to update the Simulated objects with.
+		virtual int UpdateThreads() const noexcept = 0;
+
+
+		/// \brief Sets the number of worker threads the physics engine
+		/// runs its tasks on while stepping the simulation.
+		///
+		/// Default is std::thread::hardware_concurrency(). Do not call this
+		/// while a simulation step is running.
+		/// \param numThreads Number of worker threads. With 0 the engine's 
+		/// tasks run on the thread that starts them.
+		/// \param bPinToCores If true, worker i gets bound to processor core 
+		/// i modulo the number of cores, where the system supports it.
+		/// \throws std::invalid_argument if numThreads is negative.
+		virtual void EngineThreads( int numThreads, bool bPinToCores = false ) = 0;
+
+
+		/// \returns The number of worker threads of the physics engine.
+		virtual int EngineThreads() const noexcept = 0;
+
+
 		/// \name Simulate
 		/// \brief Enters a main simulation loop and simulates the
 		/// scene.
@@ -168,9 +206,59 @@ namespace trax{
 
 
 		/// \brief Completes one simulation step.
+		///
+		/// While the physics engine simulates, the Simulated objects get 
+		/// their Idle() calls; then the calling thread blocks until the 
+		/// engine is done.
 		virtual void Step( Time dt = fixed_timestep ) = 0;
 
 
+		/// \brief Switches pipelined stepping on or off.
+		///
+		/// In pipelined mode Step() starts the physics engine on the next 
+		/// step before it returns, so whatever the caller does between two 
+		/// calls to Step() (e.g. extracting data for rendering) runs in 
+		/// parallel to the physics. The step started ahead uses the time 
+		/// delta of the recent Step() call. Body states read between two 
+		/// Step() calls are the ones of the completed step; changes to them 
+		/// get applied when the step in flight completes. Loop() does not
+		/// leave a step in flight on return; EndSimulation() and switching 
+		/// pipelining off complete a step in flight.
+		/// Pipelining does not overlap trax's own work with the physics:
+		/// the Simulated objects get their PreUpdate() and Update() calls 
+		/// after the engine has finished a step, as without pipelining. Only 
+		/// their Idle() calls and the caller's code run while it simulates.
+		/// Default is false.
+		///@{
+		virtual void Pipelined( bool bPipelined ) = 0;
+
+		virtual bool Pipelined() const noexcept = 0;
+		///@}
+
+
+		/// \brief Switches deferred pulse delivery on or off.
+		///
+		/// With deferred pulses, the pulses fired while the Simulated objects 
+		/// get their PreUpdate() and Update() calls (e.g. by sensors a train 
+		/// rolls over) are recorded instead of triggering their actions in the
+		/// middle of the update. They get delivered after the update, before 
+		/// JackOnSimulationStep() pulses, in the order they were fired: the 
+		/// serially updated objects first, then the concurrently updated 
+		/// groups one by one (see UpdateThreads()). Actions deferred with 
+		/// PulseQueue::Active() get delivered at the same point.
+		/// Default is false.
+		///@{
+		virtual void DeferPulses( bool bDefer ) = 0;
+
+		virtual bool DeferPulses() const noexcept = 0;
+		///@}
+
+
+		/// \returns Statistics about the deferred pulse deliveries.
+		/// \see DeferPulses()
+		virtual const PulseQueue::Statistics& PulseStatistics() const noexcept = 0;
+
+
 		/// \brief Cleans up after the simulation ends.
 		///
 		/// If you do not use the Simulate() methods but Loop()
@@ -180,6 +268,9 @@ namespace trax{
 
 
 		/// \brief Pauses the simulation.
+		///
+		/// A running Loop() blocks until Resume() or Stop() gets called 
+		/// from another thread.
 		virtual void Pause() noexcept = 0;
 
 
@@ -188,6 +279,9 @@ namespace trax{
 
 
 		/// \brief Stops the simulation loop.
+		///
+		/// Can be called from another thread; the loop ends after the 
+		/// step it is running.
 		virtual void Stop() noexcept = 0;
 
 
@@ -0,0 +1,168 @@
+//	trax track library
+//	AD 2026
+//
+//  "Everybody's working for the weekend"
+//
+//								Loverboy
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#pragma once
+
+/// \page docu_statictrackcooker StaticTrackCooker
+/// \section statictrackcooker_intro Introduction
+/// A StaticTrack paints its section along the track and cooks a triangle mesh from
+/// it as its collision shape, every time its geometry changes. For a large layout
+/// this is done track by track on loading. A StaticTrackCooker collects the tracks
+/// instead and paints and cooks their meshes on worker threads; only the creation
+/// of the meshes in the physics scene happens on the calling thread.
+///
+/// With a cache directory, the cooked data is stored in files together with the
+/// key data identifying the mesh: the track's curve, twist and section, the painter 
+/// settings and the engine's cooking signature. A track with the same key data found 
+/// in the cache gets neither painted nor cooked. Only tracks with a dynamic twist,
+/// that depends on other tracks, get painted first and are identified by their 
+/// vertices and indices.
+///
+/// \section statictrackcooker_examples Example:
+///
+/// \code
+/// StaticTrackCooker cooker;
+/// cooker.CacheDirectory( "cache/meshes" );
+/// {
+///		StaticTrackCooker::Scope scope{ cooker };
+///
+///		// StaticTracks getting their geometry on this thread are collected
+///		// by the cooker instead of creating their shapes right away:
+///		LoadLayout( scene, trackSystem );
+/// }
+///
+/// cooker.Cook();
+/// \endcode
+
+#include "trax/Configuration.h"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace trax{
+
+	struct StaticTrack;
+	struct TrackSystem;
+
+	/// \brief Creates the shapes of many StaticTracks in parallel.
+	class StaticTrackCooker{
+	public:
+		/// \brief Activates a cooker for the calling thread for the lifetime
+		/// of the Scope object. Scopes can get nested.
+		class Scope{
+		public:
+			dclspc explicit Scope( StaticTrackCooker& cooker ) noexcept;
+			dclspc ~Scope() noexcept;
+
+			Scope( const Scope& ) = delete;
+			Scope& operator=( const Scope& ) = delete;
+		private:
+			StaticTrackCooker* m_pPrevious;
+		};
+
+
+		/// \returns The cooker active for the calling thread or nullptr.
+		static dclspc StaticTrackCooker* Active() noexcept;
+
+
+		/// \brief Statistics about the last Cook() call.
+		struct Statistics{
+			int cooked = 0;		///< Number of meshes cooked.
+			int painted = 0;	///< Number of meshes painted.
+			int loaded = 0;		///< Number of meshes loaded from the cache.
+			int failed = 0;		///< Number of tracks that did not get a shape.
+		};
+
+
+		dclspc StaticTrackCooker() noexcept = default;
+		StaticTrackCooker( const StaticTrackCooker& ) = delete;
+		StaticTrackCooker( StaticTrackCooker&& ) = delete;
+		dclspc ~StaticTrackCooker() = default;
+
+		StaticTrackCooker& operator=( const StaticTrackCooker& ) = delete;
+		StaticTrackCooker& operator=( StaticTrackCooker&& ) = delete;
+
+
+		/// \brief Sets the number of threads to cook with.
+		/// \param nThreads Number of threads including the calling one. With 0
+		/// std::thread::hardware_concurrency() threads are used.
+		/// \throws std::invalid_argument if nThreads is negative.
+		dclspc void Threads( int nThreads );
+
+
+		/// \returns The number of threads to cook with, 0 for
+		/// std::thread::hardware_concurrency().
+		dclspc int Threads() const noexcept;
+
+
+		/// \brief Sets the directory to cache cooked meshes in.
+		///
+		/// The directory gets created if it does not exist.
+		/// \param directory Path to the directory or an empty path for no caching.
+		/// \throws std::filesystem::filesystem_error if the directory can not be created.
+		dclspc void CacheDirectory( const std::filesystem::path& directory );
+
+
+		/// \returns The directory meshes are cached in or an empty path.
+		dclspc const std::filesystem::path& CacheDirectory() const noexcept;
+
+
+		/// \brief Adds a track to create the shape for with the next Cook() call.
+		///
+		/// Adding the same track more than once does no harm.
+		dclspc void Add( std::shared_ptr<StaticTrack> pTrack );
+
+
+		/// \brief Adds all the StaticTracks of a TrackSystem.
+		/// \returns The number of tracks added.
+		dclspc int Add( const TrackSystem& trackSystem );
+
+
+		/// \returns The number of tracks waiting to get cooked.
+		dclspc std::size_t Count() const noexcept;
+
+
+		/// \brief Creates the shapes for all the added tracks.
+		///
+		/// Tracks are painted and cooked on worker threads; the meshes get created
+		/// and attached to the tracks' shapes on the calling thread. Tracks with a
+		/// dynamic twist are painted on the calling thread, since their twist might
+		/// depend on other tracks. Tracks that were destroyed or became invalid in
+		/// the meantime are skipped. Afterwards no track is left in the cooker.
+		/// \returns The number of shapes created.
+		dclspc int Cook();
+
+
+		/// \returns Statistics about the last Cook() call.
+		dclspc const Statistics& GetStatistics() const noexcept;
+	private:
+		int										m_Threads = 0;
+		std::filesystem::path					m_CacheDirectory;
+		std::vector<std::weak_ptr<StaticTrack>>	m_Tracks;
+		Statistics								m_Statistics;
+	};
+}
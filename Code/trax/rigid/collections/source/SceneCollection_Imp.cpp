@@ -45,7 +45,7 @@ const char* SceneCollection_Imp::TypeName() const noexcept{
 
 bool SceneCollection_Imp::IsValid() const noexcept
 {
-	return IsValid_Imp( m_Container );
+	return IsValid_Imp( *this );
 }
 
 }
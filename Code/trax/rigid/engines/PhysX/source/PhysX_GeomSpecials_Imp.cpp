@@ -18,6 +18,8 @@
 
 #include "common/NarrowCast.h"
 
+#include <sstream>
+
 namespace trax{
 	using namespace common;
 ///////////////////////////////////////
@@ -239,6 +241,7 @@ PhysX_Cylinder_Imp::PhysX_Cylinder_Imp( const PhysX_Scene& scene )
 	, m_Scene			{ scene }
 	, m_Radius			{ 0.5f }
 	, m_Length			{ 1 }
+	, m_Tessellation	{ 16 }
 	, m_CylinderGeometry{}
 {}
 
@@ -247,6 +250,7 @@ PhysX_Cylinder_Imp::PhysX_Cylinder_Imp( const PhysX_Scene& scene, Length radius,
 	, m_Scene			{ scene }
 	, m_Radius			{ radius }
 	, m_Length			{ length }
+	, m_Tessellation	{ 16 }
 	, m_CylinderGeometry{}
 {
 	assert( m_Radius > 0_m );
@@ -260,7 +264,7 @@ const char*	PhysX_Cylinder_Imp::TypeName() const noexcept{
 }
 
 std::unique_ptr<Geom> PhysX_Cylinder_Imp::Instance() const noexcept{
-	// TODO: do real instancing...
+	// shares the convex mesh:
 	return std::make_unique<PhysX_Cylinder_Imp>( *this );
 }
 
@@ -305,65 +309,26 @@ Length PhysX_Cylinder_Imp::GetLength() const{
 	return m_Length;
 }
 
-void PhysX_Cylinder_Imp::CookConvexMesh(){
-	const physx::PxReal lh = static_cast<physx::PxReal>(_m(m_Length/2)/m_EngineMetersPerUnit);
-	const physx::PxReal r = static_cast<physx::PxReal>(_m(m_Radius)/m_EngineMetersPerUnit);
-
-	const physx::PxVec3 convexVerts[] ={
-		physx::PxVec3( r*cos( 0*physx::PxPi/8 ), r*sin( 0*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 1*physx::PxPi/8 ), r*sin( 1*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 2*physx::PxPi/8 ), r*sin( 2*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 3*physx::PxPi/8 ), r*sin( 3*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 4*physx::PxPi/8 ), r*sin( 4*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 5*physx::PxPi/8 ), r*sin( 5*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 6*physx::PxPi/8 ), r*sin( 6*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 7*physx::PxPi/8 ), r*sin( 7*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 8*physx::PxPi/8 ), r*sin( 8*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 9*physx::PxPi/8 ), r*sin( 9*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 10*physx::PxPi/8 ), r*sin( 10*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 11*physx::PxPi/8 ), r*sin( 11*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 12*physx::PxPi/8 ), r*sin( 12*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 13*physx::PxPi/8 ), r*sin( 13*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 14*physx::PxPi/8 ), r*sin( 14*physx::PxPi/8 ), -lh ),
-		physx::PxVec3( r*cos( 15*physx::PxPi/8 ), r*sin( 15*physx::PxPi/8 ), -lh ),
-
-		physx::PxVec3( r*cos( 0*physx::PxPi/8 ), r*sin( 0*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 1*physx::PxPi/8 ), r*sin( 1*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 2*physx::PxPi/8 ), r*sin( 2*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 3*physx::PxPi/8 ), r*sin( 3*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 4*physx::PxPi/8 ), r*sin( 4*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 5*physx::PxPi/8 ), r*sin( 5*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 6*physx::PxPi/8 ), r*sin( 6*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 7*physx::PxPi/8 ), r*sin( 7*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 8*physx::PxPi/8 ), r*sin( 8*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 9*physx::PxPi/8 ), r*sin( 9*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 10*physx::PxPi/8 ), r*sin( 10*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 11*physx::PxPi/8 ), r*sin( 11*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 12*physx::PxPi/8 ), r*sin( 12*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 13*physx::PxPi/8 ), r*sin( 13*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 14*physx::PxPi/8 ), r*sin( 14*physx::PxPi/8 ), lh ),
-		physx::PxVec3( r*cos( 15*physx::PxPi/8 ), r*sin( 15*physx::PxPi/8 ), lh ),
-	};
-
+void PhysX_Cylinder_Imp::Tessellation( int nSegments ){
+	if( nSegments < 3 || nSegments > 127 )
+		throw std::invalid_argument( "PhysX_Cylinder_Imp: the tessellation has to be in [3,127]!" );
 
-	physx::PxConvexMeshDesc convexDesc;
-	convexDesc.points.count     = 32;
-	convexDesc.points.stride    = sizeof( physx::PxVec3 );
-	convexDesc.points.data      = convexVerts;
-	convexDesc.flags            = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+	if( nSegments != m_Tessellation ){
+		m_Tessellation = nSegments;
+		if( m_pConvexMesh ){
+			CookConvexMesh();
+			AdjustShapeGeometry();
+		}
+	}
+}
 
-	physx::PxDefaultMemoryOutputStream buf;
-	physx::PxConvexMeshCookingResult::Enum result;
-#if (PX_PHYSICS_VERSION_MAJOR < 5)
-	if( !m_Scene.Simulator().Cooking().cookConvexMesh( convexDesc, buf, &result ) )
-		return;
-#else
-	if( !PxCookConvexMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, convexDesc, buf, &result ) )
-		return;
-#endif
+int PhysX_Cylinder_Imp::Tessellation() const noexcept{
+	return m_Tessellation;
+}
 
-	physx::PxDefaultMemoryInputData input( buf.getData(), buf.getSize() );
-	m_CylinderGeometry.convexMesh = m_Scene.Simulator().Physics().createConvexMesh( input );
+void PhysX_Cylinder_Imp::CookConvexMesh(){
+	m_pConvexMesh = m_Scene.CylinderMesh( m_Radius, m_Length, m_Tessellation );
+	m_CylinderGeometry.convexMesh = m_pConvexMesh.get();
 }
 ///////////////////////////////////////
 PhysX_HeightField::PhysX_HeightField( const PhysX_Scene& scene )
@@ -595,8 +560,69 @@ bool PhysX_ConvexMesh::Create( const std::vector<Position<Length>>& points, cons
 	return false;
 }
 
+std::vector<unsigned char> PhysX_ConvexMesh::Cook( const std::vector<Position<Length>>& points, const std::vector<int>& indices ) const
+{
+	physx::PxDefaultMemoryOutputStream buf;
+	if( points.size() > 2 ){
+		if( indices.size() > 2 ){
+			if( !CookToStream( points, indices, buf ) )
+				return {};
+		}
+		else if( !CookToStream( points, buf ) )
+			return {};
+
+		return std::vector<unsigned char>( buf.getData(), buf.getData() + buf.getSize() );
+	}
+
+	return {};
+}
+
+bool PhysX_ConvexMesh::Create( const std::vector<unsigned char>& cookedData ){
+	if( cookedData.empty() )
+		return false;
+
+	physx::PxDefaultMemoryInputData input( const_cast<physx::PxU8*>(cookedData.data()), common::narrow_cast<physx::PxU32>(cookedData.size()) );
+	if( CreateFromStream( input ) ){
+		AdjustShapeGeometry();
+		return true;
+	}
+
+	return false;
+}
+
+std::string PhysX_ConvexMesh::CookingSignature() const{
+	std::ostringstream stream;
+	stream << TypeName() << " PhysX " << PX_PHYSICS_VERSION_MAJOR << '.' << PX_PHYSICS_VERSION_MINOR << '.' << PX_PHYSICS_VERSION_BUGFIX 
+		<< " " << m_EngineMetersPerUnit;
+	return stream.str();
+}
+
 bool PhysX_ConvexMesh::CookConvexMesh( 
 	const std::vector<Position<Length>>& points )
+{
+	physx::PxDefaultMemoryOutputStream buf;
+	if( !CookToStream( points, buf ) )
+		return false;
+
+	physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+	return CreateFromStream( input );
+}
+
+bool PhysX_ConvexMesh::CookConvexMesh( 
+	const std::vector<Position<Length>>& points, 
+	const std::vector<int>& indices )
+{
+	physx::PxDefaultMemoryOutputStream buf;
+	if( !CookToStream( points, indices, buf ) )
+		return false;
+
+	physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+	return CreateFromStream( input );
+}
+
+bool PhysX_ConvexMesh::CookToStream( 
+	const std::vector<Position<Length>>& points,
+	physx::PxOutputStream& buf ) const
 {
 	physx::PxConvexMeshDesc convexDesc;
 	convexDesc.points.count     = narrow_cast<physx::PxU32>(points.size());
@@ -605,23 +631,17 @@ bool PhysX_ConvexMesh::CookConvexMesh(
 	convexDesc.flags            = physx::PxConvexFlag::eCOMPUTE_CONVEX;
 	//convexDesc.vertexLimit    = points.size();
 
-	physx::PxDefaultMemoryOutputStream buf;
 #if (PX_PHYSICS_VERSION_MAJOR < 5)
-	if(!m_Scene.Simulator().Cooking().cookConvexMesh( convexDesc, buf ))
-		return false;
+	return m_Scene.Simulator().Cooking().cookConvexMesh( convexDesc, buf );
 #else
-	if(!PxCookConvexMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, convexDesc, buf ))
-		return false;
+	return PxCookConvexMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, convexDesc, buf );
 #endif
-
-	physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
-	m_ConvexMesGeometry.convexMesh = m_Scene.Simulator().Physics().createConvexMesh(input);
-	return true;
 }
 
-bool PhysX_ConvexMesh::CookConvexMesh( 
+bool PhysX_ConvexMesh::CookToStream( 
 	const std::vector<Position<Length>>& points, 
-	const std::vector<int>& indices )
+	const std::vector<int>& indices,
+	physx::PxOutputStream& buf ) const
 	// not behaving very well in this state ....
 {
 	std::vector<physx::PxHullPolygon> hullPolygons;
@@ -655,18 +675,17 @@ bool PhysX_ConvexMesh::CookConvexMesh(
 	convexDesc.indices.data     = indices.data();
 	convexDesc.flags            = physx::PxConvexFlags{};
 
-	physx::PxDefaultMemoryOutputStream buf;
 #if (PX_PHYSICS_VERSION_MAJOR < 5)
-	if( !m_Scene.Simulator().Cooking().cookConvexMesh( convexDesc, buf ) )
-		return false;
+	return m_Scene.Simulator().Cooking().cookConvexMesh( convexDesc, buf );
 #else
-	if( !PxCookConvexMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, convexDesc, buf ) )
-		return false;
+	return PxCookConvexMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, convexDesc, buf );
 #endif
+}
 
-	physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+bool PhysX_ConvexMesh::CreateFromStream( physx::PxInputStream& input ){
 	m_ConvexMesGeometry.convexMesh = m_Scene.Simulator().Physics().createConvexMesh(input);
-	return true;
+	m_Volume = -1_m3;
+	return m_ConvexMesGeometry.convexMesh != nullptr;
 }
 
 float PhysX_ConvexMesh::CalculateVolume( physx::PxConvexMesh& convexMesh ) noexcept
@@ -746,7 +765,47 @@ bool PhysX_TriangleMesh::Create( const std::vector<Position<Length>>& points,con
 	return false;
 }
 
+std::vector<unsigned char> PhysX_TriangleMesh::Cook( const std::vector<Position<Length>>& points, const std::vector<int>& indices ) const
+{
+	assert( indices.size() % 3 == 0 );
+
+	if( points.size() > 2 && indices.size() > 2 ){
+		physx::PxDefaultMemoryOutputStream writeBuffer;
+		if( CookToStream( points, indices, writeBuffer ) )
+			return std::vector<unsigned char>( writeBuffer.getData(), writeBuffer.getData() + writeBuffer.getSize() );
+	}
+
+	return {};
+}
+
+bool PhysX_TriangleMesh::Create( const std::vector<unsigned char>& cookedData ){
+	if( cookedData.empty() )
+		return false;
+
+	physx::PxDefaultMemoryInputData readBuffer( const_cast<physx::PxU8*>(cookedData.data()), common::narrow_cast<physx::PxU32>(cookedData.size()) );
+	m_TriangleMeshGeometry.triangleMesh = m_Scene.Simulator().Physics().createTriangleMesh(readBuffer);
+	return m_TriangleMeshGeometry.triangleMesh != nullptr;
+}
+
+std::string PhysX_TriangleMesh::CookingSignature() const{
+	std::ostringstream stream;
+	stream << TypeName() << " PhysX " << PX_PHYSICS_VERSION_MAJOR << '.' << PX_PHYSICS_VERSION_MINOR << '.' << PX_PHYSICS_VERSION_BUGFIX 
+		<< " " << m_EngineMetersPerUnit;
+	return stream.str();
+}
+
 bool PhysX_TriangleMesh::CookTriangleMeshStream( const std::vector<Position<Length>>& points, const std::vector<int>& indices )
+{
+	physx::PxDefaultMemoryOutputStream writeBuffer;
+	if( !CookToStream( points, indices, writeBuffer ) )
+		return false;
+
+	physx::PxDefaultMemoryInputData readBuffer( writeBuffer.getData(), writeBuffer.getSize() );
+	m_TriangleMeshGeometry.triangleMesh = m_Scene.Simulator().Physics().createTriangleMesh(readBuffer);
+	return true;
+}
+
+bool PhysX_TriangleMesh::CookToStream( const std::vector<Position<Length>>& points, const std::vector<int>& indices, physx::PxOutputStream& writeBuffer ) const
 {
 	physx::PxTriangleMeshDesc meshDesc;
 	meshDesc.points.count           = common::narrow_cast<physx::PxU32>(points.size());
@@ -757,18 +816,11 @@ bool PhysX_TriangleMesh::CookTriangleMeshStream( const std::vector<Position<Leng
 	meshDesc.triangles.stride       = 3*sizeof(int);
 	meshDesc.triangles.data         = indices.data();
 
-	physx::PxDefaultMemoryOutputStream writeBuffer;
 #if (PX_PHYSICS_VERSION_MAJOR < 5)
-	if(!m_Scene.Simulator().Cooking().cookTriangleMesh( meshDesc, writeBuffer ))
-		return false;
+	return m_Scene.Simulator().Cooking().cookTriangleMesh( meshDesc, writeBuffer );
 #else
-	if(!PxCookTriangleMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, meshDesc, writeBuffer ))
-		return false;
+	return PxCookTriangleMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, meshDesc, writeBuffer );
 #endif
-
-	physx::PxDefaultMemoryInputData readBuffer( writeBuffer.getData(), writeBuffer.getSize() );
-	m_TriangleMeshGeometry.triangleMesh = m_Scene.Simulator().Physics().createTriangleMesh(readBuffer);
-	return true;
 }
 
 bool PhysX_TriangleMesh::CookTriangleMesh( const std::vector<Position<Length>>& points, const std::vector<int>& indices ){
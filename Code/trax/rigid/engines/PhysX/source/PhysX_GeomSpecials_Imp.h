@@ -137,6 +137,10 @@ namespace trax{
 
 		Length GetLength() const override;
 
+		void Tessellation( int nSegments ) override;
+
+		int Tessellation() const noexcept override;
+
 		const physx::PxGeometry& Geometry() const noexcept override{
 			return m_CylinderGeometry;
 		}
@@ -144,6 +148,8 @@ namespace trax{
 		const PhysX_Scene& m_Scene;
 		Length m_Radius;
 		Length m_Length;
+		int m_Tessellation;
+		std::shared_ptr<physx::PxConvexMesh> m_pConvexMesh;
 		physx::PxConvexMeshGeometry m_CylinderGeometry;
 		void CookConvexMesh();
 	};
@@ -210,6 +216,12 @@ namespace trax{
 
 		bool Create( const std::vector<Position<Length>>& points, const std::vector<int>& indices ) override;
 
+		std::vector<unsigned char> Cook( const std::vector<Position<Length>>& points, const std::vector<int>& indices ) const override;
+
+		bool Create( const std::vector<unsigned char>& cookedData ) override;
+
+		std::string CookingSignature() const override;
+
 
 		const physx::PxGeometry& Geometry() const noexcept override{
 			return m_ConvexMesGeometry;
@@ -221,6 +233,9 @@ namespace trax{
 
 		bool CookConvexMesh( const std::vector<Position<Length>>& points );
 		bool CookConvexMesh( const std::vector<Position<Length>>& points, const std::vector<int>& indices );
+		bool CookToStream( const std::vector<Position<Length>>& points, physx::PxOutputStream& stream ) const;
+		bool CookToStream( const std::vector<Position<Length>>& points, const std::vector<int>& indices, physx::PxOutputStream& stream ) const;
+		bool CreateFromStream( physx::PxInputStream& stream );
 		static float CalculateVolume( physx::PxConvexMesh& fromConvexMesh ) noexcept;
 	};
 
@@ -244,6 +259,12 @@ namespace trax{
 
 		bool Create( const std::vector<Position<Length>>& points, const std::vector<int>& indices ) override;
 
+		std::vector<unsigned char> Cook( const std::vector<Position<Length>>& points, const std::vector<int>& indices ) const override;
+
+		bool Create( const std::vector<unsigned char>& cookedData ) override;
+
+		std::string CookingSignature() const override;
+
 
 		const physx::PxGeometry& Geometry() const noexcept override{
 			return m_TriangleMeshGeometry;
@@ -253,6 +274,7 @@ namespace trax{
 		physx::PxTriangleMeshGeometry	m_TriangleMeshGeometry;
 
 		bool CookTriangleMeshStream( const std::vector<Position<Length>>& points, const std::vector<int>& indices );
+		bool CookToStream( const std::vector<Position<Length>>& points, const std::vector<int>& indices, physx::PxOutputStream& stream ) const;
 		bool CookTriangleMesh( const std::vector<Position<Length>>& points, const std::vector<int>& indices );
 	};
 
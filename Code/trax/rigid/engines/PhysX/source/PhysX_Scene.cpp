@@ -21,6 +21,18 @@
 #include "trax/rigid/Joint.h"
 #include "trax/rigid/TrackJointFeeder.h"
 
+#include <cmath>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define VC_EXTRALEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#elif defined(__linux__)
+#	include <pthread.h>
+#	include <sched.h>
+#endif
+
 namespace trax
 {
 ///////////////////////////////////////
@@ -49,11 +61,11 @@ std::unique_ptr<Scene> Scene::Make( const Simulator& simulator ) noexcept
 PhysX_Scene::PhysX_Scene( const PhysX_Simulator& simulator, Vector<Acceleration> _G )
 	: Scene_Imp					{}
 	, m_Simulator				{ simulator }
+	, m_CpuDispatcher			{ std::thread::hardware_concurrency() }
 	, m_Scene					{ InitScene( _G ) }
 	, m_bSceneCreated			{ false }
 	, m_EngineMetersPerUnit		{ meters_per_unit }
 	, m_EngineKilogramsPerUnit	{ kilograms_per_unit }
-	, m_CpuDispatcher			{ std::thread::hardware_concurrency() }
 {
 }
 
@@ -64,11 +76,11 @@ PhysX_Scene::PhysX_Scene(
 	Vector<Acceleration> _G )
 	: Scene_Imp					{}
 	, m_Simulator				{ simulator }
+	, m_CpuDispatcher			{ std::thread::hardware_concurrency() }
 	, m_Scene					{ InitScene( _G ) }
 	, m_bSceneCreated			{ false }
 	, m_EngineMetersPerUnit		{ engine_meters_per_unit }
 	, m_EngineKilogramsPerUnit	{ engine_kilograms_per_unit }
-	, m_CpuDispatcher			{ std::thread::hardware_concurrency() }
 {
 }
 
@@ -79,16 +91,18 @@ PhysX_Scene::PhysX_Scene(
 	Real engine_kilograms_per_unit )
 	: Scene_Imp					{}
 	, m_Simulator				{ simulator }
+	, m_CpuDispatcher			{ std::thread::hardware_concurrency() }
 	, m_Scene					{ scene }
 	, m_bSceneCreated			{ false }
 	, m_EngineMetersPerUnit		{ engine_meters_per_unit }
 	, m_EngineKilogramsPerUnit	{ engine_kilograms_per_unit }
-	, m_CpuDispatcher			{ std::thread::hardware_concurrency() }
 {
 }
 
 PhysX_Scene::~PhysX_Scene()
 {
+	AbortStep();
+
 	UnregisterAllSimulated();
 
 	m_TrackJoints.clear();
@@ -167,6 +181,67 @@ std::unique_ptr<GeomMesh> PhysX_Scene::CreateGeomTriangleMesh() const{
 	return std::make_unique<PhysX_TriangleMesh>( *this );
 }
 
+std::shared_ptr<physx::PxConvexMesh> PhysX_Scene::CylinderMesh( Length radius, Length length, int tessellation ) const
+{
+	const CylinderKey key{ std::llround( radius / epsilon__length ), std::llround( length / epsilon__length ), tessellation };
+
+	std::lock_guard<std::mutex> lock{ m_ConvexMeshesMutex };
+	if( auto iter = m_CylinderMeshes.find( key ); iter != m_CylinderMeshes.end() ){
+		if( std::shared_ptr<physx::PxConvexMesh> pMesh = iter->second.lock(); pMesh )
+			return pMesh;
+	}
+
+	// Forget about the meshes nobody uses anymore:
+	for( auto iter = m_CylinderMeshes.begin(); iter != m_CylinderMeshes.end(); ){
+		if( iter->second.expired() )
+			iter = m_CylinderMeshes.erase( iter );
+		else
+			++iter;
+	}
+
+	physx::PxConvexMesh* pConvexMesh = CookCylinderMesh( static_cast<Real>(std::get<0>(key)) * epsilon__length, static_cast<Real>(std::get<1>(key)) * epsilon__length, tessellation );
+	if( !pConvexMesh )
+		return nullptr;
+
+	// Shapes made with the mesh hold their own PhysX reference to it, 
+	// so it is safe to release ours with the last cylinder:
+	std::shared_ptr<physx::PxConvexMesh> pMesh{ pConvexMesh, []( physx::PxConvexMesh* pMeshToRelease ){ pMeshToRelease->release(); } };
+	m_CylinderMeshes[key] = pMesh;
+	return pMesh;
+}
+
+physx::PxConvexMesh* PhysX_Scene::CookCylinderMesh( Length radius, Length length, int tessellation ) const
+{
+	const physx::PxReal lh = static_cast<physx::PxReal>(_m(length/2)/m_EngineMetersPerUnit);
+	const physx::PxReal r = static_cast<physx::PxReal>(_m(radius)/m_EngineMetersPerUnit);
+
+	std::vector<physx::PxVec3> convexVerts( 2 * static_cast<std::size_t>(tessellation) );
+	for( int i = 0; i < tessellation; ++i ){
+		const physx::PxReal angle = 2 * i * physx::PxPi / tessellation;
+		convexVerts[i]					= physx::PxVec3( r*cos( angle ), r*sin( angle ), -lh );
+		convexVerts[i + tessellation]	= physx::PxVec3( r*cos( angle ), r*sin( angle ), lh );
+	}
+
+	physx::PxConvexMeshDesc convexDesc;
+	convexDesc.points.count     = static_cast<physx::PxU32>(convexVerts.size());
+	convexDesc.points.stride    = sizeof( physx::PxVec3 );
+	convexDesc.points.data      = convexVerts.data();
+	convexDesc.flags            = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+
+	physx::PxDefaultMemoryOutputStream buf;
+	physx::PxConvexMeshCookingResult::Enum result;
+#if (PX_PHYSICS_VERSION_MAJOR < 5)
+	if( !m_Simulator.Cooking().cookConvexMesh( convexDesc, buf, &result ) )
+		return nullptr;
+#else
+	if( !PxCookConvexMesh( physx::PxCookingParams{ physx::PxTolerancesScale{} }, convexDesc, buf, &result ) )
+		return nullptr;
+#endif
+
+	physx::PxDefaultMemoryInputData input( buf.getData(), buf.getSize() );
+	return m_Simulator.Physics().createConvexMesh( input );
+}
+
 std::unique_ptr<HingeJoint> PhysX_Scene::CreateHingeJoint( 
 	Body* pBodyA, 
 	const spat::Frame<Length,One>& localAnchorA, 
@@ -311,6 +386,21 @@ void PhysX_Scene::Release( TrackJointFeeder& feeder ) noexcept
 	}
 }
 
+void PhysX_Scene::EngineThreads( int numThreads, bool bPinToCores ){
+	if( numThreads < 0 )
+		throw std::invalid_argument( "PhysX_Scene::EngineThreads: the number of threads must not be negative!" );
+
+	if( static_cast<physx::PxU32>(numThreads) == m_CpuDispatcher.getWorkerCount() && 
+		bPinToCores == m_CpuDispatcher.PinnedToCores() )
+		return;
+
+	m_CpuDispatcher.Workers( static_cast<unsigned int>(numThreads), bPinToCores );
+}
+
+int PhysX_Scene::EngineThreads() const noexcept{
+	return static_cast<int>(m_CpuDispatcher.getWorkerCount());
+}
+
 void PhysX_Scene::DumpTasksTo( std::ostream & stream ) const noexcept
 {
 	m_CpuDispatcher.DumpTasksTo( stream );
@@ -418,11 +508,11 @@ void PhysX_Scene::Update( Time dt )
 	Scene_Imp::Update( dt );
 }
 
-bool PhysX_Scene::EndStep() noexcept
+bool PhysX_Scene::EndStep( bool bBlock ) noexcept
 {
 	physx::PxU32 errorState = 0;
 
-	if( !Scene().fetchResults(false,&errorState) ){
+	if( !Scene().fetchResults(bBlock,&errorState) ){
 		if( errorState ){
 			assert(errorState);
 			return true; 
@@ -549,132 +639,305 @@ physx::PxFilterFlags PhysX_Scene::PhysX_SceneFilterShader(
 	return physx::PxFilterFlag::eSUPPRESS;
 }
 
-PhysX_Scene::Dispatcher::Dispatcher( unsigned int numThreads )
+// The dispatcher and the worker index of the calling thread, if it is a worker:
+static thread_local const void* tl_pDispatcher = nullptr;
+static thread_local std::size_t tl_WorkerIdx = 0;
+
+PhysX_Scene::Dispatcher::Dispatcher( unsigned int numThreads, bool bPinToCores )
+	:	m_bPinToCores	{ false },
+		m_nInjected		{ 0 },
+		m_nParked		{ 0 },
+		m_WakeEpoch		{ 0 },
+		m_bQuit			{ false },
+		m_nPending		{ 0 }
 {
-	while( numThreads-- )
-		m_Threads.push_back( new ThreadInfo() );
+	Start( numThreads, bPinToCores );
 }
 
 PhysX_Scene::Dispatcher::~Dispatcher(){
-	for( size_t i = 0; i < m_Threads.size(); ++i )
-		delete m_Threads[i];
+	JoinAllTasks();
+	Stop();
 }
 
 void PhysX_Scene::Dispatcher::submitTask( physx::PxBaseTask& task ){
-	if( m_Threads.empty() )
+	m_nPending.fetch_add( 1 );
+
+	if( m_Workers.empty() )
 	// no worker threads, run directly
 	{
-		task.run();
-		task.release();
+		Run( task );
 		return;
 	}
 
-	unsigned int attempts = 0;
-	for(;;)
-	{
-		++attempts;
-
-		for( unsigned short i = 0; i < m_Threads.size(); ++ i ){
-			if( m_Threads[i]->Push( task, attempts ) )
-				return;
-		}
+	if( tl_pDispatcher == this )
+		m_Workers[tl_WorkerIdx]->deque.Push( &task );
+	else{
+		lock_guard lock{ m_InjectedMutex };
+		m_Injected.push_back( &task );
+		m_nInjected.fetch_add( 1 );
 	}
+
+	// Pairs with the parking worker announcing itself before 
+	// looking for work a last time:
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	Wake();
 }
 
 physx::PxU32 PhysX_Scene::Dispatcher::getWorkerCount() const{
-	return common::narrow_cast<physx::PxU32>(m_Threads.size());
+	return static_cast<physx::PxU32>(m_Workers.size());
+}
+
+void PhysX_Scene::Dispatcher::Workers( unsigned int numThreads, bool bPinToCores ){
+	JoinAllTasks();
+	Stop();
+	Start( numThreads, bPinToCores );
+}
+
+bool PhysX_Scene::Dispatcher::PinnedToCores() const noexcept{
+	return m_bPinToCores;
 }
 
 void PhysX_Scene::Dispatcher::JoinAllTasks() noexcept{
-	for( size_t i = 0; i < m_Threads.size(); ++i )
-		while( m_Threads[i]->IsWorking() )
-			;
+	unique_lock lock{ m_JoinMutex };
+	while( m_nPending.load() != 0 )
+		m_JoinCondition.wait( lock );
 }
 
 void PhysX_Scene::Dispatcher::DumpTasksTo( std::ostream& stream ) const noexcept{
-	for( auto pThreadInfo : m_Threads )
-		pThreadInfo->DumpTasksTo( stream );
+	for( const auto& pWorker : m_Workers )
+		stream << "PhysX Dispatcher number of PhysX Tasks processed: " << pWorker->nTasksRun.load() 
+			<< ", stolen: " << pWorker->nTasksStolen.load() << std::endl;
 }
 
-PhysX_Scene::Dispatcher::ThreadInfo::ThreadInfo()
-	:	m_bWorking		{ true },
-		m_bQuit			{ false },
-		m_nTasksAccepted{ 0 }
-{
-	assert(m_bWorking.is_lock_free());
-	m_pThread = new thread(ThreadFunc,this);
+void PhysX_Scene::Dispatcher::Start( unsigned int numThreads, bool bPinToCores ){
+	assert( m_Workers.empty() );
+	m_bPinToCores = bPinToCores;
+
+	// All the deques have to be there, before anyone starts stealing:
+	m_Workers.reserve( numThreads );
+	for( unsigned int i = 0; i < numThreads; ++i )
+		m_Workers.push_back( std::make_unique<Worker>() );
+
+	for( std::size_t i = 0; i < m_Workers.size(); ++i ){
+		m_Workers[i]->worker = thread{ [this,i](){ Loop( i ); } };
+		if( m_bPinToCores )
+			PinToCore( m_Workers[i]->worker, static_cast<unsigned int>(i) );
+	}
 }
 
-PhysX_Scene::Dispatcher::ThreadInfo::~ThreadInfo(){
-	if( m_pThread ){
-		{
-			unique_lock lock(m_Mutex);
-			m_bQuit = true;
-			m_Condition.notify_one();
-		}
+void PhysX_Scene::Dispatcher::Stop() noexcept{
+	{
+		lock_guard lock{ m_ParkMutex };
+		m_bQuit = true;
+		++m_WakeEpoch;
+	}
+	m_ParkCondition.notify_all();
 
-		m_pThread->join();
-		delete m_pThread;
+	for( const auto& pWorker : m_Workers ){
+		if( pWorker->worker.joinable() )
+			pWorker->worker.join();
 	}
 
 	if( GetReportVerbosity() >= Verbosity::verbose )
 		DumpTasksTo( std::clog );
-}
 
-void PhysX_Scene::Dispatcher::ThreadInfo::ThreadFunc( ThreadInfo* pTI ){
-	if( pTI )
-		pTI->Loop();
+	m_Workers.clear();
+	m_bQuit = false;
 }
 
-void PhysX_Scene::Dispatcher::ThreadInfo::Loop(){
-	while( !m_bQuit ){
-		unique_lock lock(m_Mutex);
-		while( m_Tasks.empty() ){
-			if (m_bQuit) {
-				m_bWorking = false;
-				return;
-			}
+void PhysX_Scene::Dispatcher::Loop( std::size_t idx ) noexcept{
+	tl_pDispatcher = this;
+	tl_WorkerIdx = idx;
 
-			m_bWorking = false;
-			m_Condition.wait(lock);
+	for(;;){
+		if( physx::PxBaseTask* pTask = FindTask( idx ); pTask ){
+			Run( *pTask );
+			continue;
 		}
 
-		auto task = m_Tasks.front();
-		m_Tasks.pop();
-		lock.unlock();
+		// Tasks often come in bursts, so look around a little before parking:
+		physx::PxBaseTask* pTask = nullptr;
+		for( int spin = 0; spin < 64 && !pTask; ++spin ){
+			std::this_thread::yield();
+			pTask = FindTask( idx );
+		}
+		if( pTask ){
+			Run( *pTask );
+			continue;
+		}
+
+		unique_lock lock{ m_ParkMutex };
+		if( m_bQuit )
+			break;
 
-		task->run();
-		task->release();
+		const std::uint64_t epoch = m_WakeEpoch;
+		m_nParked.fetch_add( 1 );
+		if( !HasWork() ){
+			while( m_WakeEpoch == epoch )
+				m_ParkCondition.wait( lock );
+		}
+		m_nParked.fetch_sub( 1 );
+
+		if( m_bQuit )
+			break;
 	}
 
-	m_bWorking = false;
+	tl_pDispatcher = nullptr;
 }
 
-bool PhysX_Scene::Dispatcher::ThreadInfo::Push( physx::PxBaseTask& rTask, unsigned int attempts ){
-	if( !m_Mutex.try_lock() )
-		return false;
+physx::PxBaseTask* PhysX_Scene::Dispatcher::FindTask( std::size_t idx ) noexcept{
+	Worker& self = *m_Workers[idx];
+	if( physx::PxBaseTask* pTask = self.deque.Pop(); pTask )
+		return pTask;
+
+	if( m_nInjected.load() > 0 ){
+		lock_guard lock{ m_InjectedMutex };
+		if( !m_Injected.empty() ){
+			physx::PxBaseTask* pTask = m_Injected.front();
+			m_Injected.pop_front();
+			m_nInjected.fetch_sub( 1 );
+			return pTask;
+		}
+	}
 
-	if( attempts > m_Tasks.size() ){
-		m_Tasks.push( &rTask );
-		m_bWorking = true;
-		m_Condition.notify_one();
-		m_Mutex.unlock();
-		++m_nTasksAccepted;
+	for( std::size_t i = 1; i < m_Workers.size(); ++i ){
+		if( physx::PxBaseTask* pTask = m_Workers[(idx + i) % m_Workers.size()]->deque.Steal(); pTask ){
+			self.nTasksStolen.fetch_add( 1, std::memory_order_relaxed );
+			return pTask;
+		}
+	}
+
+	return nullptr;
+}
+
+bool PhysX_Scene::Dispatcher::HasWork() const noexcept{
+	if( m_nInjected.load() > 0 )
 		return true;
+
+	for( const auto& pWorker : m_Workers ){
+		if( !pWorker->deque.Empty() )
+			return true;
 	}
 
-	m_Mutex.unlock();
 	return false;
 }
 
-bool PhysX_Scene::Dispatcher::ThreadInfo::IsWorking() const noexcept{
-	//unique_lock lock(m_Mutex); //this is causing temporary locks with std::thread on win32 ...
-	return m_bWorking;
+void PhysX_Scene::Dispatcher::Run( physx::PxBaseTask& task ) noexcept{
+	task.run();
+	task.release();
+
+	if( tl_pDispatcher == this )
+		m_Workers[tl_WorkerIdx]->nTasksRun.fetch_add( 1, std::memory_order_relaxed );
+
+	if( m_nPending.fetch_sub( 1 ) == 1 ){
+		lock_guard lock{ m_JoinMutex };
+		m_JoinCondition.notify_all();
+	}
+}
+
+void PhysX_Scene::Dispatcher::Wake() noexcept{
+	if( m_nParked.load() > 0 ){
+		{
+			lock_guard lock{ m_ParkMutex };
+			++m_WakeEpoch;
+		}
+		m_ParkCondition.notify_one();
+	}
+}
+
+void PhysX_Scene::Dispatcher::PinToCore( thread& worker, unsigned int core ) noexcept{
+	const unsigned int nCores = std::max( 1u, std::thread::hardware_concurrency() );
+	core %= nCores;
+#if defined(_WIN32)
+	if( core < 8 * sizeof(DWORD_PTR) )
+		SetThreadAffinityMask( worker.native_handle(), DWORD_PTR{1} << core );
+#elif defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO( &cpuSet );
+	CPU_SET( core, &cpuSet );
+	pthread_setaffinity_np( worker.native_handle(), sizeof(cpu_set_t), &cpuSet );
+#else
+	(void)worker;
+#endif
 }
 
-void PhysX_Scene::Dispatcher::ThreadInfo::DumpTasksTo( std::ostream& stream ) const noexcept
+PhysX_Scene::Dispatcher::TaskDeque::Buffer::Buffer( std::int64_t capacity_ )
+	:	capacity	{ capacity_ },
+		slots		{ std::make_unique<std::atomic<physx::PxBaseTask*>[]>( static_cast<std::size_t>(capacity_) ) }
 {
-	stream << "PhysX Dispatcher number of PhysX Tasks processed: " << m_nTasksAccepted << std::endl;
+	assert( (capacity & (capacity - 1)) == 0 );
+}
+
+PhysX_Scene::Dispatcher::TaskDeque::TaskDeque()
+	:	m_Top		{ 0 },
+		m_Bottom	{ 0 },
+		m_pBuffer	{ nullptr }
+{
+	m_Buffers.push_back( std::make_unique<Buffer>( 256 ) );
+	m_pBuffer.store( m_Buffers.back().get() );
+}
+
+void PhysX_Scene::Dispatcher::TaskDeque::Push( physx::PxBaseTask* pTask ){
+	const std::int64_t b = m_Bottom.load( std::memory_order_relaxed );
+	const std::int64_t t = m_Top.load( std::memory_order_acquire );
+	Buffer* pBuffer = m_pBuffer.load( std::memory_order_relaxed );
+	if( b - t > pBuffer->capacity - 1 ){
+		m_Buffers.push_back( std::make_unique<Buffer>( 2 * pBuffer->capacity ) );
+		Buffer* pGrown = m_Buffers.back().get();
+		for( std::int64_t i = t; i < b; ++i )
+			pGrown->Put( i, pBuffer->Get( i ) );
+
+		m_pBuffer.store( pGrown, std::memory_order_release );
+		pBuffer = pGrown;
+	}
+
+	pBuffer->Put( b, pTask );
+	std::atomic_thread_fence( std::memory_order_release );
+	m_Bottom.store( b + 1, std::memory_order_relaxed );
+}
+
+physx::PxBaseTask* PhysX_Scene::Dispatcher::TaskDeque::Pop() noexcept{
+	const std::int64_t b = m_Bottom.load( std::memory_order_relaxed ) - 1;
+	Buffer* pBuffer = m_pBuffer.load( std::memory_order_relaxed );
+	m_Bottom.store( b, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	std::int64_t t = m_Top.load( std::memory_order_relaxed );
+
+	if( t > b ){
+		// empty:
+		m_Bottom.store( b + 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+
+	physx::PxBaseTask* pTask = pBuffer->Get( b );
+	if( t == b ){
+		// the last one; race the thieves for it:
+		if( !m_Top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+			pTask = nullptr;
+
+		m_Bottom.store( b + 1, std::memory_order_relaxed );
+	}
+
+	return pTask;
+}
+
+physx::PxBaseTask* PhysX_Scene::Dispatcher::TaskDeque::Steal() noexcept{
+	std::int64_t t = m_Top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	const std::int64_t b = m_Bottom.load( std::memory_order_acquire );
+	if( t >= b )
+		return nullptr;
+
+	physx::PxBaseTask* pTask = m_pBuffer.load( std::memory_order_acquire )->Get( t );
+	if( !m_Top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) )
+		// lost the race:
+		return nullptr;
+
+	return pTask;
+}
+
+bool PhysX_Scene::Dispatcher::TaskDeque::Empty() const noexcept{
+	return m_Top.load() >= m_Bottom.load();
 }
 
 }
\ No newline at end of file
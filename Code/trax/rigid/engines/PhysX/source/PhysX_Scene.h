@@ -27,7 +27,13 @@
 #include <condition_variable>
 #endif
 
-#include <queue>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 namespace trax
 {
@@ -140,6 +146,10 @@ namespace trax
 			const spat::Frame<Length,One>& localAnchor, 
 			const Body& bodyTrack ) noexcept override;
 
+		void EngineThreads( int numThreads, bool bPinToCores = false ) override;
+
+		int EngineThreads() const noexcept override;
+
 		void Release( TrackJointFeeder& feeder ) noexcept override;
 
 		void DumpTasksTo( std::ostream& stream ) const noexcept override;
@@ -161,79 +171,146 @@ namespace trax
 
 		inline Real 				EngineMetersPerUnit() const noexcept { return m_EngineMetersPerUnit; }
 		inline Real 				EngineKilogramsPerUnit() const noexcept { return m_EngineKilogramsPerUnit; }
+
+
+		/// \brief Gets a cooked convex mesh for a cylinder, shared by all the cylinders 
+		/// of the scene with the same dimensions and tessellation.
+		///
+		/// The dimensions are quantized to epsilon__length before cooking and
+		/// looking up. The mesh gets released with the last pointer to it.
+		/// \returns A pointer to the mesh or nullptr if cooking failed.
+		std::shared_ptr<physx::PxConvexMesh> CylinderMesh( Length radius, Length length, int tessellation ) const;
 	
 	protected:
 		void StartStep( Time dt = fixed_timestep ) noexcept override;
 		void Update( Time dt = fixed_timestep ) override;
-		bool EndStep() noexcept override;
+		bool EndStep( bool bBlock ) noexcept override;
 
 	private:
-		const PhysX_Simulator& m_Simulator;
-		physx::PxScene&	m_Scene;
-
-		bool m_bSceneCreated;
-
-		using JointNFeeder = std::shared_ptr<TrackJointFeeder>;
-		std::vector<JointNFeeder>	m_TrackJoints; 
-		const Real					m_EngineMetersPerUnit;
-		const Real					m_EngineKilogramsPerUnit;
-
-		physx::PxScene& InitScene( const Vector<Acceleration>& g );
-		void ExitScene();
-
+		// Work stealing dispatcher for the PhysX tasks. Each worker owns a 
+		// Chase-Lev deque: it pushes and pops the tasks it spawns at the bottom,
+		// idle workers steal from the top. Tasks submitted by other threads go to
+		// an injection queue. Workers without anything to do park on a condition
+		// variable instead of spinning.
 		class Dispatcher : public physx::PxCpuDispatcher{
 		public:
-			Dispatcher( unsigned int numThreads );
+			Dispatcher( unsigned int numThreads, bool bPinToCores = false );
 			~Dispatcher();
 
-			virtual void submitTask( physx::PxBaseTask& task ) override;
+			void submitTask( physx::PxBaseTask& task ) override;
 
-			virtual physx::PxU32 getWorkerCount() const override;
+			physx::PxU32 getWorkerCount() const override;
 
-			void JoinAllTasks() noexcept;
+			/// Replaces the workers. No tasks must be running.
+			void Workers( unsigned int numThreads, bool bPinToCores );
 
-			void DumpTasksTo( std::ostream & stream ) const noexcept;
-		private:
+			bool PinnedToCores() const noexcept;
 
-			struct ThreadInfo{
-				ThreadInfo();
-				~ThreadInfo();
+			/// Blocks until all the submitted tasks have finished.
+			void JoinAllTasks() noexcept;
 
+			void DumpTasksTo( std::ostream& stream ) const noexcept;
+		private:
 #ifdef _BOOST_THREAD
-				using mutex = boost::mutex;
-				using condition_variable = boost::condition_variable;
-				using thread = boost::thread;
-				using unique_lock = boost::unique_lock<boost::mutex>;
+			using mutex = boost::mutex;
+			using condition_variable = boost::condition_variable;
+			using thread = boost::thread;
+			using unique_lock = boost::unique_lock<boost::mutex>;
+			using lock_guard = boost::lock_guard<boost::mutex>;
 #else
-				using mutex = std::mutex;
-				using condition_variable = std::condition_variable;
-				using thread = std::thread;
-				using unique_lock = std::unique_lock<std::mutex>;
+			using mutex = std::mutex;
+			using condition_variable = std::condition_variable;
+			using thread = std::thread;
+			using unique_lock = std::unique_lock<std::mutex>;
+			using lock_guard = std::lock_guard<std::mutex>;
 #endif
-				mutex							m_Mutex;
-				condition_variable				m_Condition;
-				thread*							m_pThread;
 
-				std::queue<physx::PxBaseTask*>	m_Tasks;
-				std::atomic_bool				m_bWorking;
-				bool							m_bQuit;
-				unsigned int					m_nTasksAccepted;
+			class TaskDeque{
+			public:
+				TaskDeque();
+
+				// Owner only:
+				void Push( physx::PxBaseTask* pTask );
+				physx::PxBaseTask* Pop() noexcept;
+
+				// Everybody:
+				physx::PxBaseTask* Steal() noexcept;
+				bool Empty() const noexcept;
+			private:
+				struct Buffer{
+					explicit Buffer( std::int64_t capacity );
+
+					const std::int64_t										capacity;
+					std::unique_ptr<std::atomic<physx::PxBaseTask*>[]>		slots;
+
+					physx::PxBaseTask* Get( std::int64_t i ) const noexcept{
+						return slots[i & (capacity - 1)].load( std::memory_order_acquire );
+					}
+
+					void Put( std::int64_t i, physx::PxBaseTask* pTask ) noexcept{
+						slots[i & (capacity - 1)].store( pTask, std::memory_order_release );
+					}
+				};
+
+				std::atomic<std::int64_t>				m_Top;
+				std::atomic<std::int64_t>				m_Bottom;
+				std::atomic<Buffer*>					m_pBuffer;
+				std::vector<std::unique_ptr<Buffer>>	m_Buffers; // the old ones might still be read by thieves
+			};
 
+			struct Worker{
+				TaskDeque					deque;
+				thread						worker;
+				std::atomic<std::size_t>	nTasksRun{ 0 };
+				std::atomic<std::size_t>	nTasksStolen{ 0 };
+			};
 
-				static void ThreadFunc( ThreadInfo* pTI );
+			std::vector<std::unique_ptr<Worker>>	m_Workers;
+			bool									m_bPinToCores;
+
+			mutex									m_InjectedMutex;
+			std::deque<physx::PxBaseTask*>			m_Injected;
+			std::atomic<std::size_t>				m_nInjected;
+
+			mutex									m_ParkMutex;
+			condition_variable						m_ParkCondition;
+			std::atomic<int>						m_nParked;
+			std::uint64_t							m_WakeEpoch;
+			bool									m_bQuit;
+
+			std::atomic<std::size_t>				m_nPending;
+			mutex									m_JoinMutex;
+			condition_variable						m_JoinCondition;
+
+			void Start( unsigned int numThreads, bool bPinToCores );
+			void Stop() noexcept;
+			void Loop( std::size_t idx ) noexcept;
+			physx::PxBaseTask* FindTask( std::size_t idx ) noexcept;
+			bool HasWork() const noexcept;
+			void Run( physx::PxBaseTask& task ) noexcept;
+			void Wake() noexcept;
+			static void PinToCore( thread& worker, unsigned int core ) noexcept;
+		};
 
-				void Loop();
+		const PhysX_Simulator& m_Simulator;
+		Dispatcher m_CpuDispatcher;
+		physx::PxScene&	m_Scene;
 
-				bool Push( physx::PxBaseTask& rTask, unsigned int attempts );
+		bool m_bSceneCreated;
 
-				bool IsWorking() const noexcept;
+		using JointNFeeder = std::shared_ptr<TrackJointFeeder>;
+		std::vector<JointNFeeder>	m_TrackJoints; 
+		const Real					m_EngineMetersPerUnit;
+		const Real					m_EngineKilogramsPerUnit;
 
-				void DumpTasksTo( std::ostream& stream ) const noexcept;
-			};
+		using CylinderKey = std::tuple<long long,long long,int>;
+		mutable std::mutex											m_ConvexMeshesMutex;
+		mutable std::map<CylinderKey,std::weak_ptr<physx::PxConvexMesh>>	m_CylinderMeshes;
 
-			std::vector<ThreadInfo*> m_Threads;
+		physx::PxConvexMesh* CookCylinderMesh( Length radius, Length length, int tessellation ) const;
 
-		} m_CpuDispatcher;
+		physx::PxScene& InitScene( const Vector<Acceleration>& g );
+		void ExitScene();
 
 		static physx::PxFilterFlags PhysX_SceneFilterShader(
 			physx::PxFilterObjectAttributes attributes0, physx::PxFilterData filterData0,
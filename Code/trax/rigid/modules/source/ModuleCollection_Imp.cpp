@@ -47,7 +47,7 @@ const char* ModuleCollection_Imp::TypeName() const noexcept{
 
 bool ModuleCollection_Imp::IsValid() const noexcept
 {
-	return IsValid_Imp( m_Container );
+	return IsValid_Imp( *this );
 }
 
 }
@@ -48,6 +48,8 @@ namespace trax{
 
 		/// \name Module Reading
 		/// \brief Reads a module from a file or buffer.
+		///
+		/// A buffer is read in place, it does not get copied before parsing.
 		/// \param fromPath The path to the file to read from.
 		/// \param atIdx The index of the module to read.
 		/// \return A unique pointer to the module.
@@ -59,6 +61,8 @@ namespace trax{
 
 		/// \name Track System Reading
 		/// \brief Reads a track system from a file or buffer.
+		///
+		/// A buffer is read in place, it does not get copied before parsing.
 		/// \param fromPath The path to the file to read from.
 		/// \param atIdx The index of the track system to read.
 		/// \return A shared pointer to the track system.
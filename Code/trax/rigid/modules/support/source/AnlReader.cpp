@@ -17,6 +17,8 @@
 #include "trax/rigid/modules/support/Anl3ModuleReader.h"
 #include "trax/rigid/modules/support/Anl4ModuleReader.h"
 
+#include "common/support/CommonSupportStream.h"
+
 #if defined(_MSC_VER)
 #	pragma warning(push)
 #	pragma warning(disable: 6313) //  Incorrect operator:  zero-valued flag cannot be tested with bitwise-and.  Use an equality test to check for zero-valued flags.
@@ -108,8 +110,7 @@ std::unique_ptr<ModuleCollection> AnlReader::ReadModuleCollection( const std::fi
 
 std::unique_ptr<ModuleCollection> AnlReader::ReadModuleCollection( const unsigned char* bufferStart, const unsigned char* bufferEnd ) const
 {
-	std::string string( (const char*)bufferStart, bufferEnd - bufferStart );
-	std::istringstream stream( string );
+	common::MemoryInStream stream( bufferStart, bufferEnd );
 
 	boost::property_tree::ptree ptr;
 
@@ -150,8 +151,7 @@ std::unique_ptr<Module> AnlReader::ReadModule( const std::filesystem::path& path
 
 std::unique_ptr<Module> AnlReader::ReadModule( const unsigned char* bufferStart, const unsigned char* bufferEnd, int atIdx ) const
 {
-	std::string string( (const char*)bufferStart, bufferEnd - bufferStart );
-	std::istringstream stream( string );
+	common::MemoryInStream stream( bufferStart, bufferEnd );
 
 	boost::property_tree::ptree ptr;
 
@@ -192,8 +192,7 @@ std::shared_ptr<TrackSystem> AnlReader::ReadTrackSystem( const std::filesystem::
 
 std::shared_ptr<TrackSystem> AnlReader::ReadTrackSystem( const unsigned char* bufferStart, const unsigned char* bufferEnd, int atIdx )
 {
-	std::string string( (const char*)bufferStart, bufferEnd - bufferStart );
-	std::istringstream stream( string );
+	common::MemoryInStream stream( bufferStart, bufferEnd );
 
 	boost::property_tree::ptree ptr;
 
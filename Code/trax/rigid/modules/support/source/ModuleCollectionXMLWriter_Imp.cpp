@@ -27,6 +27,8 @@
 
 #include "trax/rigid/modules/support/ModuleCollectionXMLWriter.h"
 
+#include "common/support/CommonSupportStream.h"
+
 #if defined(_MSC_VER)
 #	pragma warning(push)
 #	pragma warning(disable: 6313) //  Incorrect operator:  zero-valued flag cannot be tested with bitwise-and.  Use an equality test to check for zero-valued flags.
@@ -53,8 +55,7 @@ bool XMLWriteModuleCollection( const boost::property_tree::ptree& pt, ModuleColl
 
 bool XMLWriteModuleCollection( const unsigned char* bufferStart, const unsigned char* bufferEnd, ModuleCollectionParser& callback ) noexcept(false)
 {
-	std::string string{ (const char*)bufferStart, (const char*)(bufferEnd - bufferStart) };
-	std::istringstream stream{ string };
+	common::MemoryInStream stream{ bufferStart, bufferEnd };
 
 	boost::property_tree::ptree ptr;
 
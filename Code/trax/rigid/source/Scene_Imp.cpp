@@ -30,8 +30,13 @@
 #include "../Gestalt.h"
 #include "../GeomType.h"
 #include "trax/Simulated.h"
+#include "common/ThreadPool.h"
 
+#include <exception>
 #include <iostream>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
 
 namespace trax
 {
@@ -56,9 +61,19 @@ Scene_Imp::~Scene_Imp()
 
 void Scene_Imp::Register( Simulated& simulated ) noexcept
 {
-	if( std::find_if( m_Simulated.begin(), m_Simulated.end(),
-		[&simulated](const std::pair<Simulated*, bool>& pair){ return pair.first == &simulated; } ) == m_Simulated.end() &&
-		std::find( m_ToBeRegistered.begin(), m_ToBeRegistered.end(), &simulated ) == m_ToBeRegistered.end() )
+	if( auto iter = std::find_if( m_Simulated.begin(), m_Simulated.end(),
+		[&simulated](const std::pair<Simulated*, bool>& pair){ return pair.first == &simulated; } ); iter != m_Simulated.end() )
+	{
+		// Unregistered, but not removed yet:
+		if( auto iter2 = std::find( m_ToBeUnregistered.begin(), m_ToBeUnregistered.end(), &simulated ); 
+			iter2 != m_ToBeUnregistered.end() )
+		{
+			m_ToBeUnregistered.erase( iter2 );
+			iter->second = true;
+			simulated.Registered( *this );
+		}
+	}
+	else if( std::find( m_ToBeRegistered.begin(), m_ToBeRegistered.end(), &simulated ) == m_ToBeRegistered.end() )
 	{
 		m_ToBeRegistered.push_back( &simulated );
 		simulated.Registered( *this );
@@ -76,6 +91,13 @@ void Scene_Imp::Unregister( Simulated& simulated ) noexcept
 		simulated.Stop();
 		simulated.Unregistered( *this );
 	}
+	else if( auto iter2 = std::find( m_ToBeRegistered.begin(), m_ToBeRegistered.end(), &simulated ); 
+		iter2 != m_ToBeRegistered.end() )
+	{
+		// Never got into the simulation, it might be gone until the next step:
+		m_ToBeRegistered.erase( iter2 );
+		simulated.Unregistered( *this );
+	}
 }
 
 void Scene_Imp::UnregisterAllSimulated() noexcept
@@ -93,12 +115,37 @@ void Scene_Imp::UnregisterAllSimulated() noexcept
 	m_Simulated.clear();
 }
 
+void Scene_Imp::UpdateThreads( int numThreads )
+{
+	if( numThreads < 1 )
+		throw std::invalid_argument( "Scene_Imp::UpdateThreads: there has to be at least one thread!" );
+
+	if( numThreads == m_UpdateThreads )
+		return;
+
+	m_pUpdatePool.reset();
+	if( numThreads > 1 )
+		m_pUpdatePool = std::make_unique<common::ThreadPool>( static_cast<unsigned int>(numThreads - 1) );
+
+	m_UpdateThreads = numThreads;
+}
+
+int Scene_Imp::UpdateThreads() const noexcept{
+	return m_UpdateThreads;
+}
+
 void Scene_Imp::Simulate()
 {
 	BeginSimulation();
 
 	while( m_bSimulationRunning )
 	{
+		if( m_bPaused )
+		{
+			WaitWhilePaused();
+			continue;
+		}
+
 		Step();
 	}
 
@@ -137,49 +184,149 @@ void Scene_Imp::BeginSimulation() noexcept
 
 void Scene_Imp::Loop( Time forTimePeriod )
 {
-	if( m_bLoopRunning )
+	if( m_bLoopRunning.exchange( true ) )
 	{
 		std::cerr << Verbosity::error << "Scene_Imp::Loop: Loop is already running!" << std::endl;
 		return;
 	}
 
-	common::FlagBlocker flagBlocker( m_bLoopRunning );
+	// Stop() might reset the flag from another thread; it has to end up false either way:
+	struct LoopFlag{
+		std::atomic<bool>& m_Flag;
+		~LoopFlag() noexcept{ m_Flag = false; }
+	} loopFlag{ m_bLoopRunning };
 	m_LoopTime += forTimePeriod;
 
 	while( m_bLoopRunning )
 	{
 		if( m_bPaused )
+		{
+			WaitWhilePaused();
 			continue;
+		}
 
-		Step();
+		// Don't leave a step in flight behind:
+		DoStep( fixed_timestep, m_bPipelined && m_LoopTime > fixed_timestep );
 
 		if( m_LoopTime -= fixed_timestep; m_LoopTime <= 0_s )
 			break;
 	}
+
+	FinishStep();
 }
 
 void Scene_Imp::Step( Time dt )
 {
-	DoRegistrations();
+	DoStep( dt, m_bPipelined );
+}
+
+void Scene_Imp::Pipelined( bool bPipelined ){
+	if( !bPipelined )
+		FinishStep();
+
+	m_bPipelined = bPipelined;
+}
+
+bool Scene_Imp::Pipelined() const noexcept{
+	return m_bPipelined;
+}
+
+void Scene_Imp::DeferPulses( bool bDefer ){
+	m_bDeferPulses = bDefer;
+}
+
+bool Scene_Imp::DeferPulses() const noexcept{
+	return m_bDeferPulses;
+}
 
-	StartStep( dt );
+const PulseQueue::Statistics& Scene_Imp::PulseStatistics() const noexcept{
+	return m_PulseQueue.GetStatistics();
+}
+
+void Scene_Imp::DoStep( Time dt, bool bStartNext )
+{
+	if( !m_bStepInFlight )
+	{
+		DoRegistrations();
+		StartStep( dt );
+		m_InFlightDt = dt;
+		m_bStepInFlight = true;
+	}
 
 	Idle();
 
-	while( !EndStep() )
-		;
+	EndStep( true );
+	m_bStepInFlight = false;
 
-	m_SimulationTime += dt;
+	m_SimulationTime += m_InFlightDt;
 
-	PreUpdate();
+	if( m_bDeferPulses )
+	{
+		{
+			PulseQueue::Scope scope{ &m_PulseQueue };
+			try{
+				PreUpdate();
+				Update( m_InFlightDt );
+			}
+			catch( ... ){
+				// Deliver what got pulsed so far, as it would have been 
+				// without deferring, so nothing is left for the next step:
+				m_PulseQueue.Commit();
+				throw;
+			}
+		}
 
-	Update( dt );
+		m_PulseQueue.Commit();
+	}
+	else
+	{
+		PreUpdate();
+		Update( m_InFlightDt );
+	}
 
 	m_JackOnSimulationStep.Pulse();
+
+	if( bStartNext )
+	{
+		// Runs while the caller does its thing:
+		DoRegistrations();
+		StartStep( dt );
+		m_InFlightDt = dt;
+		m_bStepInFlight = true;
+	}
+}
+
+void Scene_Imp::FinishStep()
+{
+	if( m_bStepInFlight )
+		DoStep( m_InFlightDt, false );
+}
+
+void Scene_Imp::AbortStep() noexcept
+{
+	if( m_bStepInFlight )
+	{
+		EndStep( true );
+		m_bStepInFlight = false;
+	}
+}
+
+void Scene_Imp::WaitWhilePaused()
+{
+	std::unique_lock<std::mutex> lock{ m_PauseMutex };
+	m_PauseCondition.wait( lock, [this]{ return !m_bPaused || (!m_bLoopRunning && !m_bSimulationRunning); } );
 }
 
 void Scene_Imp::EndSimulation() noexcept
 {
+	try{
+		FinishStep();
+	}
+	catch( const std::exception& e ){
+		std::cerr << Verbosity::error << e.what() << std::endl;
+		AbortStep();
+	}
+
 	for( auto& [pSimulated,bRegistered] : m_Simulated )
 	{
 		if( bRegistered )
@@ -190,16 +337,25 @@ void Scene_Imp::EndSimulation() noexcept
 }
 
 void Scene_Imp::Pause() noexcept{
+	std::lock_guard<std::mutex> lock{ m_PauseMutex };
 	m_bPaused = true;
 }
 
 void Scene_Imp::Resume() noexcept{
-	m_bPaused = false;
+	{
+		std::lock_guard<std::mutex> lock{ m_PauseMutex };
+		m_bPaused = false;
+	}
+	m_PauseCondition.notify_all();
 }
 
 void Scene_Imp::Stop() noexcept{
-	m_bLoopRunning = false;
-	m_bSimulationRunning = false;
+	{
+		std::lock_guard<std::mutex> lock{ m_PauseMutex };
+		m_bLoopRunning = false;
+		m_bSimulationRunning = false;
+	}
+	m_PauseCondition.notify_all();
 }
 
 std::unique_ptr<Gestalt> Scene_Imp::CreateGestalt( Box<Length> box, Mass mass ) const noexcept
@@ -291,14 +447,13 @@ const Plug& Scene_Imp::_GetPlug( int idx ) const{
 
 void Scene_Imp::DoRegistrations() noexcept
 {
-	while( !m_ToBeRegistered.empty() )
+	// In order of registration, containers before their contents:
+	for( Simulated* pSimulated : m_ToBeRegistered )
 	{
-		auto& pSimulated = m_ToBeRegistered.back();
-
 		m_Simulated.push_back( std::make_pair(pSimulated,true) );
 		std::cout << Verbosity::detailed << "Registered a " << pSimulated->TypeName() << " for simulation." << std::endl;
-		m_ToBeRegistered.pop_back();
 	}
+	m_ToBeRegistered.clear();
 
 	while( !m_ToBeUnregistered.empty() )
 	{
@@ -326,17 +481,116 @@ void Scene_Imp::PreUpdate()
 {
 	for( auto& [pSimulated,bRegistered] : m_Simulated )
 	{
-		if( bRegistered )
+		if( bRegistered && !(m_pUpdatePool && pSimulated->ParallelUpdate()) )
 			pSimulated->PreUpdate();
 	}
+
+	if( m_pUpdatePool )
+		ParallelUpdate( []( Simulated& simulated ){ simulated.PreUpdate(); } );
 }
 
 void Scene_Imp::Update( Time dt )
 {
 	for( auto& [pSimulated,bRegistered] : m_Simulated )
 	{
-		if( bRegistered )
+		if( bRegistered && !(m_pUpdatePool && pSimulated->ParallelUpdate()) )
 			pSimulated->Update( dt );
 	}
+
+	if( m_pUpdatePool )
+		ParallelUpdate( [dt]( Simulated& simulated ){ simulated.Update( dt ); } );
+}
+
+void Scene_Imp::ParallelUpdate( const std::function<void(Simulated&)>& update )
+{
+	std::vector<Simulated*> objects;
+	std::unordered_map<const void*,std::size_t> indices;
+	for( auto& [pSimulated,bRegistered] : m_Simulated )
+	{
+		if( bRegistered && pSimulated->ParallelUpdate() ){
+			indices.emplace( static_cast<const void*>(pSimulated), objects.size() );
+			objects.push_back( pSimulated );
+		}
+	}
+
+	if( objects.empty() )
+		return;
+
+	// Union the neighbours, the first registered object of a group being its root.
+	// Neighbours that are no parallel objects, e.g. tracks, get nodes of their own 
+	// behind the objects, so they never become a root. The neighbourhood has to 
+	// be found anew for every update, since the serial objects might have changed 
+	// it, e.g. by coupling:
+	std::vector<std::size_t> roots( objects.size() );
+	std::iota( roots.begin(), roots.end(), std::size_t{0} );
+	auto Find = [&roots]( std::size_t idx ) noexcept{
+		while( roots[idx] != idx )
+			idx = roots[idx] = roots[roots[idx]];
+		return idx;
+	};
+
+	std::vector<const void*> neighbours;
+	for( std::size_t idx = 0; idx < objects.size(); ++idx ){
+		neighbours.clear();
+		objects[idx]->UpdateNeighbours( neighbours );
+		for( const void* pNeighbour : neighbours ){
+			auto [iter,bInserted] = indices.emplace( pNeighbour, roots.size() );
+			if( bInserted ){
+				roots.push_back( idx );
+				continue;
+			}
+
+			const std::size_t a = Find( idx ), b = Find( iter->second );
+			if( a < b )
+				roots[b] = a;
+			else if( b < a )
+				roots[a] = b;
+		}
+	}
+
+	std::vector<std::vector<Simulated*>> groups;
+	std::vector<std::size_t> groupOf( objects.size() );
+	for( std::size_t idx = 0; idx < objects.size(); ++idx ){
+		const std::size_t root = Find( idx );
+		if( root == idx ){
+			groupOf[idx] = groups.size();
+			groups.emplace_back();
+		}
+		else
+			groupOf[idx] = groupOf[root];
+
+		groups[groupOf[idx]].push_back( objects[idx] );
+	}
+
+	// Pulses get deferred while a group is updated and are
+	// committed afterwards in the order of the groups, to keep 
+	// the results independent from the thread scheduling:
+	std::vector<PulseQueue> queues( groups.size() );
+	std::vector<std::exception_ptr> errors( groups.size() );
+	m_pUpdatePool->Run( groups.size(), [&]( std::size_t idx ){
+		PulseQueue::Scope scope{ &queues[idx] };
+		try{
+			for( Simulated* pSimulated : groups[idx] )
+				update( *pSimulated );
+		}
+		catch( ... ){
+			errors[idx] = std::current_exception();
+		}
+	} );
+
+	// With an outer queue active, e.g. for deferred pulses, 
+	// the groups' pulses join it:
+	PulseQueue* pActive = PulseQueue::Active();
+	for( PulseQueue& queue : queues ){
+		if( pActive )
+			pActive->Append( std::move(queue) );
+		else
+			queue.Commit();
+	}
+
+	for( const std::exception_ptr& pError : errors ){
+		if( pError )
+			std::rethrow_exception( pError );
+	}
 }
 }
\ No newline at end of file
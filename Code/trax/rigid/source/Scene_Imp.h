@@ -31,6 +31,15 @@
 #include "trax/ObjectID.h"
 #include "trax/source/Plug_Imp.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+namespace common{
+	class ThreadPool;
+}
+
 namespace trax{
 
 	class Scene_Imp :	public virtual ObjectID_Imp<Scene>,
@@ -50,6 +59,10 @@ namespace trax{
 
 		void UnregisterAllSimulated() noexcept override;
 
+		void UpdateThreads( int numThreads ) override;
+
+		int UpdateThreads() const noexcept override;
+
 		void Simulate() override;
 
 		void Simulate( Time forTimePeriod ) override;
@@ -64,6 +77,16 @@ namespace trax{
 
 		void Step( Time dt = fixed_timestep ) override;
 
+		void Pipelined( bool bPipelined ) override;
+
+		bool Pipelined() const noexcept override;
+
+		void DeferPulses( bool bDefer ) override;
+
+		bool DeferPulses() const noexcept override;
+
+		const PulseQueue::Statistics& PulseStatistics() const noexcept override;
+
 		void EndSimulation() noexcept;
 		
 		void Pause() noexcept override;
@@ -98,17 +121,48 @@ namespace trax{
 				void Idle();
 				void PreUpdate();
 		virtual void Update( Time dt = fixed_timestep );
-		virtual bool EndStep() noexcept = 0;	
+		// Returns true if the step was finished; with bBlock it waits for it:
+		virtual bool EndStep( bool bBlock ) noexcept = 0;	
+
+				// Completes a step in flight, if any:
+				void FinishStep();
+				// Waits for a step in flight without updating the Simulated 
+				// objects; for derived classes before tearing down the engine:
+				void AbortStep() noexcept;
 	private:
-		bool m_bSimulationRunning = false;
+		std::atomic<bool> m_bSimulationRunning{ false };
 		Time m_SimulationTime = 0.0_s;
-		bool m_bLoopRunning = false;
+		std::atomic<bool> m_bLoopRunning{ false };
 		Time m_LoopTime = 0.0_s;
-		bool m_bPaused = false;
+
+		std::atomic<bool> m_bPaused{ false };
+		std::mutex m_PauseMutex;
+		std::condition_variable m_PauseCondition;
+
+		bool m_bPipelined = false;
+		bool m_bStepInFlight = false;
+		Time m_InFlightDt = 0.0_s;
+
+		bool m_bDeferPulses = false;
+		PulseQueue m_PulseQueue;
+
+		// Completes a step; with bStartNext the engine gets started 
+		// on the next one before returning:
+		void DoStep( Time dt, bool bStartNext );
+		void WaitWhilePaused();
 
 		std::vector<std::pair<Simulated*,bool>> m_Simulated;
 		std::vector<Simulated*> m_ToBeRegistered;
 		std::vector<Simulated*> m_ToBeUnregistered;
+
+		// Worker threads for updating Simulated objects concurrently;
+		// nullptr for serial updates:
+		std::unique_ptr<common::ThreadPool> m_pUpdatePool;
+		int m_UpdateThreads = 1;
+
+		// Calls update for the objects with Simulated::ParallelUpdate(), 
+		// grouped by their neighbourhood and in parallel:
+		void ParallelUpdate( const std::function<void(Simulated&)>& update );
 	
 		Jack_Imp m_JackOnSimulationStep{ "JackOnSimulationStep" };
 		MultiPlug_Imp<Plug_Imp_ParentPointer<Scene_Imp>> m_PlugToStop;
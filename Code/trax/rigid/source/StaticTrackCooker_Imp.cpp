@@ -0,0 +1,317 @@
+//	trax track library
+//	AD 2026
+//
+//  "Everybody's working for the weekend"
+//
+//								Loverboy
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "../StaticTrackCooker.h"
+
+#include "StaticTrack_Imp.h"
+#include "../Geom.h"
+#include "trax/collections/TrackSystem.h"
+#include "common/ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace trax{
+	using namespace spat;
+
+static thread_local StaticTrackCooker* s_pActiveCooker = nullptr;
+
+static const char cacheMagic[8] = { 't','r','x','m','e','s','h','2' };
+
+// A cache file holds the full key data, that gets compared before 
+// the cooked data is used, so colliding file names do no harm:
+// magic, key data size, key data, cooked data size, cooked data.
+static std::filesystem::path CachePath( const std::filesystem::path& directory, const std::vector<unsigned char>& keyData ){
+	std::ostringstream name;
+	name << std::hex << std::setw(16) << std::setfill('0') << StaticTrack_Imp::MeshKey( keyData ) << ".trxmesh";
+	return directory / name.str();
+}
+
+static bool LoadCached( const std::filesystem::path& path, const std::vector<unsigned char>& keyData, std::vector<unsigned char>& data ){
+	std::ifstream file{ path, std::ios::binary };
+	if( !file )
+		return false;
+
+	char magic[sizeof(cacheMagic)];
+	std::uint64_t keySize = 0;
+	file.read( magic, sizeof(magic) );
+	file.read( reinterpret_cast<char*>(&keySize), sizeof(keySize) );
+	if( !file || std::memcmp( magic, cacheMagic, sizeof(cacheMagic) ) != 0 || keySize != keyData.size() )
+		return false;
+
+	std::vector<unsigned char> fileKeyData( keyData.size() );
+	file.read( reinterpret_cast<char*>(fileKeyData.data()), static_cast<std::streamsize>(fileKeyData.size()) );
+	if( !file || fileKeyData != keyData )
+		return false;
+
+	std::uint64_t size = 0;
+	file.read( reinterpret_cast<char*>(&size), sizeof(size) );
+	if( !file )
+		return false;
+
+	data.resize( static_cast<std::size_t>(size) );
+	file.read( reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size) );
+	if( !file ){
+		data.clear();
+		return false;
+	}
+
+	return !data.empty();
+}
+
+static void StoreCached( const std::filesystem::path& path, const std::vector<unsigned char>& keyData, const std::vector<unsigned char>& data ){
+	// Write to a temporary file first, so that nobody ever reads
+	// a partly written one:
+	std::filesystem::path tempPath = path;
+	std::ostringstream suffix;
+	suffix << '.' << std::this_thread::get_id() << ".tmp";
+	tempPath += suffix.str();
+
+	{
+		std::ofstream file{ tempPath, std::ios::binary | std::ios::trunc };
+		if( !file )
+			return;
+
+		const std::uint64_t keySize = keyData.size();
+		const std::uint64_t size = data.size();
+		file.write( cacheMagic, sizeof(cacheMagic) );
+		file.write( reinterpret_cast<const char*>(&keySize), sizeof(keySize) );
+		file.write( reinterpret_cast<const char*>(keyData.data()), static_cast<std::streamsize>(keyData.size()) );
+		file.write( reinterpret_cast<const char*>(&size), sizeof(size) );
+		file.write( reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()) );
+		if( !file ){
+			file.close();
+			std::error_code ec;
+			std::filesystem::remove( tempPath, ec );
+			return;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename( tempPath, path, ec );
+	if( ec )
+		std::filesystem::remove( tempPath, ec );
+}
+
+StaticTrackCooker::Scope::Scope( StaticTrackCooker& cooker ) noexcept
+	: m_pPrevious{ s_pActiveCooker }
+{
+	s_pActiveCooker = &cooker;
+}
+
+StaticTrackCooker::Scope::~Scope() noexcept{
+	s_pActiveCooker = m_pPrevious;
+}
+
+StaticTrackCooker* StaticTrackCooker::Active() noexcept{
+	return s_pActiveCooker;
+}
+
+void StaticTrackCooker::Threads( int nThreads ){
+	if( nThreads < 0 )
+		throw std::invalid_argument( "StaticTrackCooker: the number of threads must not be negative!" );
+
+	m_Threads = nThreads;
+}
+
+int StaticTrackCooker::Threads() const noexcept{
+	return m_Threads;
+}
+
+void StaticTrackCooker::CacheDirectory( const std::filesystem::path& directory ){
+	if( !directory.empty() )
+		std::filesystem::create_directories( directory );
+
+	m_CacheDirectory = directory;
+}
+
+const std::filesystem::path& StaticTrackCooker::CacheDirectory() const noexcept{
+	return m_CacheDirectory;
+}
+
+void StaticTrackCooker::Add( std::shared_ptr<StaticTrack> pTrack ){
+	if( !pTrack )
+		throw std::invalid_argument( "StaticTrackCooker: track is nullptr!" );
+
+	m_Tracks.push_back( pTrack );
+}
+
+int StaticTrackCooker::Add( const TrackSystem& trackSystem ){
+	int count = 0;
+	for( auto iter = trackSystem.begin(); iter != trackSystem.end(); ++iter ){
+		if( auto pTrack = std::dynamic_pointer_cast<const StaticTrack>( (*iter).This() ); pTrack ){
+			Add( std::const_pointer_cast<StaticTrack>( pTrack ) );
+			++count;
+		}
+	}
+
+	return count;
+}
+
+std::size_t StaticTrackCooker::Count() const noexcept{
+	return m_Tracks.size();
+}
+
+int StaticTrackCooker::Cook()
+{
+	m_Statistics = {};
+
+	std::vector<std::shared_ptr<StaticTrack_Imp>> tracks;
+	tracks.reserve( m_Tracks.size() );
+	for( const std::weak_ptr<StaticTrack>& wpTrack : m_Tracks ){
+		if( auto pTrack = std::dynamic_pointer_cast<StaticTrack_Imp>( wpTrack.lock() ); pTrack && pTrack->IsValid() )
+			tracks.push_back( pTrack );
+	}
+	m_Tracks.clear();
+
+	std::sort( tracks.begin(), tracks.end() );
+	tracks.erase( std::unique( tracks.begin(), tracks.end() ), tracks.end() );
+
+	struct Job{
+		std::unique_ptr<GeomMesh>	pGeomMesh;
+		std::string					signature;
+		std::vector<unsigned char>	data;
+		bool						bLoaded = false;
+		bool						bPainted = false;
+		std::exception_ptr			pError;
+	};
+
+	// The geoms are made by the scene, so do it here:
+	std::vector<Job> jobs( tracks.size() );
+	for( std::size_t i = 0; i < tracks.size(); ++i ){
+		if( jobs[i].pGeomMesh = tracks[i]->CreateGeomMesh(); jobs[i].pGeomMesh )
+			jobs[i].signature = jobs[i].pGeomMesh->CookingSignature();
+	}
+
+	auto DoJob = [this,&tracks,&jobs]( std::size_t i ){
+		Job& job = jobs[i];
+		if( !job.pGeomMesh )
+			return;
+
+		try{
+			// Most tracks can get identified by their geometry, so that a 
+			// cached mesh needs neither painting nor cooking:
+			std::vector<unsigned char> keyData;
+			const bool bCache = !m_CacheDirectory.empty();
+			bool bKeyed = bCache && tracks[i]->MeshKeyData( job.signature, keyData );
+			if( bKeyed && LoadCached( CachePath( m_CacheDirectory, keyData ), keyData, job.data ) ){
+				job.bLoaded = true;
+				return;
+			}
+
+			std::vector<Position<Length>> points;
+			std::vector<int> indices;
+			if( !tracks[i]->PaintMesh( points, indices ) )
+				return;
+			job.bPainted = true;
+
+			// Others get identified by what would get cooked:
+			if( bCache && !bKeyed ){
+				StaticTrack_Imp::MeshKeyData( job.signature, points, indices, keyData );
+				bKeyed = true;
+				if( LoadCached( CachePath( m_CacheDirectory, keyData ), keyData, job.data ) ){
+					job.bLoaded = true;
+					return;
+				}
+			}
+
+			job.data = job.pGeomMesh->Cook( points, indices );
+			if( !job.data.empty() && bKeyed )
+				StoreCached( CachePath( m_CacheDirectory, keyData ), keyData, job.data );
+		}
+		catch( ... ){
+			job.pError = std::current_exception();
+		}
+	};
+
+	// A dynamic twist might read other tracks while they get painted:
+	std::vector<std::size_t> parallel;
+	parallel.reserve( tracks.size() );
+	for( std::size_t i = 0; i < tracks.size(); ++i ){
+		if( tracks[i]->GetTwist().IsDynamic() )
+			DoJob( i );
+		else
+			parallel.push_back( i );
+	}
+
+	const unsigned int nThreads = m_Threads > 0 ? static_cast<unsigned int>(m_Threads) : std::max( 1u, std::thread::hardware_concurrency() );
+	common::ParallelFor( parallel.size(), nThreads, [&parallel,&DoJob]( std::size_t idx ){ 
+		DoJob( parallel[idx] ); 
+	} );
+
+	int created = 0;
+	for( std::size_t i = 0; i < jobs.size(); ++i ){
+		Job& job = jobs[i];
+		try{
+			if( job.pError )
+				std::rethrow_exception( job.pError );
+
+			if( !job.pGeomMesh || job.data.empty() ){
+				++m_Statistics.failed;
+				continue;
+			}
+
+			bool bCreated = job.pGeomMesh->Create( job.data );
+			if( !bCreated && job.bLoaded ){
+				// The cached data might be broken:
+				std::vector<Position<Length>> points;
+				std::vector<int> indices;
+				job.bLoaded = false;
+				job.bPainted = true;
+				bCreated = tracks[i]->PaintMesh( points, indices ) && job.pGeomMesh->Create( points, indices );
+			}
+
+			if( job.bPainted )
+				++m_Statistics.painted;
+
+			if( bCreated ){
+				tracks[i]->AttachMesh( std::move(job.pGeomMesh) );
+				++(job.bLoaded ? m_Statistics.loaded : m_Statistics.cooked);
+				++created;
+			}
+			else
+				++m_Statistics.failed;
+		}
+		catch( const std::exception& e ){
+			std::cerr << e.what() << std::endl;
+			++m_Statistics.failed;
+		}
+	}
+
+	return created;
+}
+
+const StaticTrackCooker::Statistics& StaticTrackCooker::GetStatistics() const noexcept{
+	return m_Statistics;
+}
+
+}
@@ -27,15 +27,186 @@
 
 #include "StaticTrack_Imp.h"
 
+#include "../Geom.h"
 #include "../Shape.h"
 #include "../Scene.h"
+#include "../StaticTrackCooker.h"
+#include "trax/Curve.h"
+#include "trax/RoadwayTwist.h"
+#include "trax/Section.h"
 #include "trax/TrackPainter.h"
 
 #include <iostream>
+#include <type_traits>
 
 namespace trax{
 	using namespace spat;
 
+	// Settings for painting the mesh:
+	static constexpr int painterMode = TrackPainter::Mode::mode_localFrame;
+	static const common::Interval<Length> painterSegmentLimits{ 1_m, 1_m };
+
+	// Increase, if anything changes about the key:
+	static constexpr std::uint32_t keyVersion = 3;
+
+	// The kinds of key data:
+	enum class KeyKind : std::uint8_t{
+		geometry = 0,
+		painted
+	};
+
+namespace{
+	// Appends the bytes of the values to the key data:
+	class KeyWriter{
+	public:
+		explicit KeyWriter( std::vector<unsigned char>& keyData ) noexcept
+			: m_KeyData{ keyData }
+		{}
+
+		template<typename Type>
+		void Put( const Type& value ){
+			static_assert( std::is_trivially_copyable_v<Type>, "KeyWriter: type can not get written bytewise!" );
+			Put( &value, sizeof(Type) );
+		}
+
+		void Put( const std::string& value ){
+			Put( static_cast<std::uint64_t>(value.size()) );
+			Put( value.data(), value.size() );
+		}
+
+		template<typename Type>
+		void PutVector( const std::vector<Type>& values ){
+			static_assert( std::is_trivially_copyable_v<Type>, "KeyWriter: type can not get written bytewise!" );
+			Put( static_cast<std::uint64_t>(values.size()) );
+			Put( values.data(), values.size() * sizeof(Type) );
+		}
+	private:
+		std::vector<unsigned char>& m_KeyData;
+
+		void Put( const void* pData, std::size_t size ){
+			const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+			m_KeyData.insert( m_KeyData.end(), pBytes, pBytes + size );
+		}
+	};
+
+	void PutHeader( KeyWriter& writer, KeyKind kind, const std::string& cookingSignature ){
+		writer.Put( keyVersion );
+		writer.Put( kind );
+		writer.Put( cookingSignature );
+		writer.Put( painterMode );
+		writer.Put( painterSegmentLimits );
+	}
+
+	template<class CurveType>
+	bool PutCurveData( KeyWriter& writer, const Curve& curve ){
+		if( auto pCurve = dynamic_cast<const CurveType*>(&curve) ){
+			writer.Put( pCurve->GetData() );
+			return true;
+		}
+
+		return false;
+	}
+
+	template<class CurveType>
+	bool PutCurveVector( KeyWriter& writer, const Curve& curve ){
+		if( auto pCurve = dynamic_cast<const CurveType*>(&curve) ){
+			writer.PutVector( pCurve->GetData() );
+			return true;
+		}
+
+		return false;
+	}
+
+	bool PutCurve( KeyWriter& writer, const Curve& curve ){
+		writer.Put( curve.GetCurveType() );
+
+		switch( curve.GetCurveType() ){
+		case Curve::CurveType::Line:
+			return true;
+		case Curve::CurveType::Arc:
+			return PutCurveData<Arc>( writer, curve );
+		case Curve::CurveType::Helix:
+			return PutCurveData<Helix>( writer, curve );
+		case Curve::CurveType::LineP:
+			return PutCurveData<LineP>( writer, curve );
+		case Curve::CurveType::ArcP:
+			return PutCurveData<ArcP>( writer, curve );
+		case Curve::CurveType::HelixP:
+			return PutCurveData<HelixP>( writer, curve );
+		case Curve::CurveType::Clothoid:
+			return PutCurveData<Clothoid>( writer, curve );
+		case Curve::CurveType::Cubic:
+			return PutCurveData<Cubic>( writer, curve );
+		case Curve::CurveType::Rotator:
+		case Curve::CurveType::RotatorWithOffset:
+			return PutCurveData<Rotator>( writer, curve );
+		case Curve::CurveType::EEPCurve:
+		case Curve::CurveType::EEPResidual:
+		case Curve::CurveType::EEPAlternative:
+			return PutCurveData<EEPCurve>( writer, curve );
+		case Curve::CurveType::Spline:
+			return PutCurveVector<Spline>( writer, curve );
+		case Curve::CurveType::PolygonalChain:
+			return PutCurveVector<PolygonalChain>( writer, curve );
+		case Curve::CurveType::SampledCurve:
+			return PutCurveVector<SampledCurve>( writer, curve );
+		case Curve::CurveType::RotatorChain:
+			if( auto pCurve = dynamic_cast<const RotatorChain*>(&curve) ){
+				writer.Put( static_cast<std::uint64_t>(pCurve->GetData().size()) );
+				for( const auto& link : pCurve->GetData() ){
+					writer.Put( std::get<0>(link) );
+					writer.Put( std::get<1>(link) );
+					writer.Put( std::get<2>(link) );
+				}
+				return true;
+			}
+			return false;
+		default:
+			return false;
+		}
+	}
+
+	bool PutTwist( KeyWriter& writer, const RoadwayTwist& twist ){
+		writer.Put( twist.GetTwistType() );
+
+		if( auto pConstantTwist = dynamic_cast<const ConstantTwist*>(&twist) )
+			writer.Put( pConstantTwist->TwistValue() );
+		else if( auto pLinearTwist = dynamic_cast<const LinearTwist*>(&twist) ){
+			writer.Put( pLinearTwist->From() );
+			writer.Put( pLinearTwist->To() );
+		}
+		else if( auto pPiecewiseTwist = dynamic_cast<const PiecewiseTwist*>(&twist) ){
+			writer.Put( static_cast<std::uint64_t>(pPiecewiseTwist->CntTwistValues()) );
+			for( int idx = 0; idx < pPiecewiseTwist->CntTwistValues(); ++idx ){
+				writer.Put( pPiecewiseTwist->Twist( idx ).first );
+				writer.Put( pPiecewiseTwist->Twist( idx ).second );
+			}
+		}
+		else if( auto pDirectionalTwist = dynamic_cast<const DirectionalTwist*>(&twist) )
+			writer.Put( pDirectionalTwist->Attractor() );
+		else if( auto pPiecewiseDirectionalTwist = dynamic_cast<const PiecewiseDirectionalTwist*>(&twist) ){
+			writer.Put( static_cast<std::uint64_t>(pPiecewiseDirectionalTwist->CntTwistValues()) );
+			for( int idx = 0; idx < pPiecewiseDirectionalTwist->CntTwistValues(); ++idx ){
+				writer.Put( pPiecewiseDirectionalTwist->Twist( idx ).first );
+				writer.Put( pPiecewiseDirectionalTwist->Twist( idx ).second );
+			}
+		}
+		else if( auto pCombinedTwist = dynamic_cast<const CombinedTwist*>(&twist) )
+			return PutTwist( writer, pCombinedTwist->Twist1() ) && PutTwist( writer, pCombinedTwist->Twist2() );
+		else if( twist.GetTwistType() != RoadwayTwist::TwistType::Zero )
+			return false;
+
+		return true;
+	}
+
+	void PutSection( KeyWriter& writer, const Section& section ){
+		writer.Put( section.GetSectionType() );
+		writer.Put( static_cast<std::uint64_t>(section.CountPoints()) );
+		for( int idx = 0; idx < section.CountPoints(); ++idx )
+			writer.Put( section.Get( idx ) );
+	}
+}
+
 ///////////////////////////////////////
 std::shared_ptr<StaticTrack> StaticTrack::Make( const Scene& scene ) noexcept{
 	try{
@@ -88,34 +259,109 @@ void StaticTrack_Imp::PropagateAbsoluteFrameToClients() noexcept
 	m_pShape->SetFrame( GetAbsoluteFrame() * GetFrame() );
 }
 
+std::unique_ptr<GeomMesh> StaticTrack_Imp::CreateGeomMesh() const{
+	return m_Scene.CreateGeomTriangleMesh();
+}
+
+bool StaticTrack_Imp::PaintMesh( std::vector<Position<Length>>& points, std::vector<int>& indices ) const
+{
+	if( !GetSection() ){
+		std::cerr << "TrackPainter: No section for track!" << std::endl;
+		return false;
+	}
+
+	BufferedPainter<Position<Length>> painter{ points, indices, painterMode, painterSegmentLimits };
+	painter.Paint( *this, *GetSection() );
+	return true;
+}
+
+bool StaticTrack_Imp::MeshKeyData( const std::string& cookingSignature, std::vector<unsigned char>& keyData ) const
+{
+	// A dynamic twist depends on other tracks, so the 
+	// mesh has to get painted to know it:
+	if( !GetSection() || GetTwist().IsDynamic() )
+		return false;
+
+	const auto curve = GetCurve();
+	if( !curve.first )
+		return false;
+
+	// The mesh gets painted in the track's local frame, so equal 
+	// tracks at different places share their key:
+	keyData.clear();
+	KeyWriter writer{ keyData };
+	PutHeader( writer, KeyKind::geometry, cookingSignature );
+	writer.Put( curve.second );
+	if( !PutCurve( writer, *curve.first ) || !PutTwist( writer, GetTwist() ) )
+		return false;
+	PutSection( writer, *GetSection() );
+	return true;
+}
+
+void StaticTrack_Imp::MeshKeyData( 
+	const std::string& cookingSignature, 
+	const std::vector<Position<Length>>& points, 
+	const std::vector<int>& indices, 
+	std::vector<unsigned char>& keyData )
+{
+	keyData.clear();
+	KeyWriter writer{ keyData };
+	PutHeader( writer, KeyKind::painted, cookingSignature );
+	writer.PutVector( points );
+	writer.PutVector( indices );
+}
+
+std::uint64_t StaticTrack_Imp::MeshKey( const std::vector<unsigned char>& keyData ) noexcept
+{
+	// FNV-1a:
+	std::uint64_t hash = 14695981039346656037ull;
+	for( const unsigned char byte : keyData ){
+		hash ^= byte;
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+void StaticTrack_Imp::AttachMesh( std::unique_ptr<GeomMesh> pGeomMesh )
+{
+	m_pShape->Clear();
+
+	pGeomMesh->SetMaterial( m_Material );
+	pGeomMesh->TypeFilter( Geom::fTrack );
+	m_pShape->Attach( std::move(pGeomMesh) );
+}
+
 void StaticTrack_Imp::OnGeometryChanged() noexcept
 {
 	m_pShape->Clear();
 
-	if( IsValid() )
+	if( IsValid() ){
+		if( StaticTrackCooker* pCooker = StaticTrackCooker::Active(); pCooker ){
+			if( std::shared_ptr<StaticTrack> pThis = std::dynamic_pointer_cast<StaticTrack>( This() ); pThis ){
+				try{
+					pCooker->Add( pThis );
+					return;
+				}
+				catch( const std::exception& e ){
+					std::cerr << e.what() << std::endl;
+				}
+			}
+		}
+
 		CreateShape();
+	}
 }
 
 void StaticTrack_Imp::CreateShape() noexcept
 {
 	try{
-		if( std::unique_ptr<GeomMesh> pGeomMesh = m_Scene.CreateGeomTriangleMesh(); pGeomMesh ){
+		if( std::unique_ptr<GeomMesh> pGeomMesh = CreateGeomMesh(); pGeomMesh ){
 			std::vector<Position<Length>> points;
 			std::vector<int> indices;
 
-			BufferedPainter<Position<Length>> painter{ points, indices, TrackPainter::Mode::mode_localFrame, {1_m,1_m} };
-
-			if( GetSection() ){
-				painter.Paint( *this, *GetSection() );
-
-				if( pGeomMesh->Create( points, indices ) ){
-					pGeomMesh->SetMaterial( m_Material );
-					pGeomMesh->TypeFilter( Geom::fTrack );
-					m_pShape->Attach( std::move(pGeomMesh) );
-				}
-			}
-			else
-				std::cerr << "TrackPainter: No section for track!" << std::endl;
+			if( PaintMesh( points, indices ) && pGeomMesh->Create( points, indices ) )
+				AttachMesh( std::move(pGeomMesh) );
 		}
 	}
 	catch( const std::exception& e ){
@@ -125,14 +371,13 @@ void StaticTrack_Imp::CreateShape() noexcept
 ///////////////////////////////////////
 spat::Box<Length> GetBoxFor( const TrackBuilder& track, const Section* pSection )
 {
-	Length s = 0_m;	
 	Position<Length> position;
-	track.Transition( s, position );
+	track.Transition( 0_m, position );
 	spat::Box<Length> box{ position, position };
 
-	while( const Length ds = Segment_Checked( track, s, epsilon__length, { 1_m, +infinite__length } ) )
+	for( const Length s : Segmentation{ track, 1_m }.Segments( epsilon__length, { 1_m, +infinite__length } ) )
 	{
-		track.Transition( s += ds, position );
+		track.Transition( s, position );
 		box.Expand( position );
 	}
 
@@ -31,8 +31,12 @@
 #include "../Material.h"
 #include "trax/source/SectionTrack_Imp.h"
 
+#include <cstdint>
+
 namespace trax{
 
+	struct GeomMesh;
+
 	class StaticTrack_Imp : public StaticTrack,
 							public SectionTrack_Imp			
 	{
@@ -53,6 +57,24 @@ namespace trax{
 
 		const Shape& GetShape() const noexcept override;
 
+
+		// StaticTrackCooker:
+		std::unique_ptr<GeomMesh> CreateGeomMesh() const;
+
+		bool PaintMesh( std::vector<spat::Position<Length>>& points, std::vector<int>& indices ) const;
+
+		// Data that identifies the mesh PaintMesh() would paint, made from the 
+		// curve, twist and section. Returns false if the mesh can not get 
+		// identified without painting it, e.g. for a dynamic twist:
+		bool MeshKeyData( const std::string& cookingSignature, std::vector<unsigned char>& keyData ) const;
+
+		// Data that identifies a mesh painted by PaintMesh():
+		static void MeshKeyData( const std::string& cookingSignature, const std::vector<spat::Position<Length>>& points, const std::vector<int>& indices, std::vector<unsigned char>& keyData );
+
+		// Hash over the key data, to name the cache file with:
+		static std::uint64_t MeshKey( const std::vector<unsigned char>& keyData ) noexcept;
+
+		void AttachMesh( std::unique_ptr<GeomMesh> pGeomMesh );
 	protected:
 		// PoseImp:
 		void PropagateAbsoluteFrameToClients() noexcept override;
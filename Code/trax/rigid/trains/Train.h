@@ -263,6 +263,20 @@ namespace trax{
 	//	virtual std::pair<std::shared_ptr<Train>,EndType> GetCoupledTrain( EndType end ) const noexcept = 0;
 
 
+		/// \brief Sets the distance the reservation made by MakeReservation() 
+		/// reaches beyond the train's tip in TargetDirection().
+		///
+		/// The reservation of a Train covers the whole train plus this look-ahead
+		/// and gets updated incrementally by subsequent calls to MakeReservation(),
+		/// changing only the parts at the train's head and tail.
+		/// \throws std::invalid_argument if lookAhead is negative.
+		virtual void ReservationLookAhead( Length lookAhead ) = 0;
+
+
+		/// \returns The distance the reservation reaches beyond the train's tip.
+		virtual Length ReservationLookAhead() const noexcept = 0;
+
+
 		/// \brief Gets a Jack that pulses its Plug if a coupling inside the 
 		/// train (including all sub-Trains) is uncoupled for whatever reason.
 		virtual struct Jack& JackOnUnCoupleInternal() noexcept = 0;
@@ -37,7 +37,8 @@ namespace trax{
 	struct Consist : Collection<Consist,RollingStock>
 	{
 		/// \brief Makes a standard Consist object.
-		static dclspc std::unique_ptr<Consist> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<Consist> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 	};
 
 }
\ No newline at end of file
@@ -44,11 +44,15 @@ namespace trax{
 
 	/// \brief A Fleet holds Trains and (topmost) Bogies via their common interface
 	/// RailRunner.
+	///
+	/// Registered with a Scene, the Fleet registers its Trains as well; these
+	/// update their reservations with every simulation step.
 	struct Fleet : Collection<Fleet,Train>,
 	               Simulated
 	{
 		/// \brief Makes a standard TrackCollection object.
-		static dclspc std::unique_ptr<Fleet> Make() noexcept;
+		/// \param storage Selects the tree or the dense storage for the elements.
+		static dclspc std::unique_ptr<Fleet> Make( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 
 		virtual const char*	TypeName() const noexcept = 0;
@@ -29,17 +29,18 @@
 
 namespace trax{
 
-std::unique_ptr<Consist> trax::Consist::Make() noexcept
+std::unique_ptr<Consist> trax::Consist::Make( CollectionStorage storage ) noexcept
 {
 	try{
-		return std::make_unique<Consist_Imp>();
+		return std::make_unique<Consist_Imp>( storage );
 	}
 	catch( const std::bad_alloc& ){
 		return nullptr;
 	}
 }
 
-Consist_Imp::Consist_Imp() noexcept
+Consist_Imp::Consist_Imp( CollectionStorage storage ) noexcept
+	: Consist_Base{ storage }
 {}
 
 const char*	Consist_Imp::TypeName() const noexcept{
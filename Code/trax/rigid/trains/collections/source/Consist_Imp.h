@@ -38,7 +38,7 @@ namespace trax{
 
 	class Consist_Imp : public Consist_Base{
 	public:
-		Consist_Imp() noexcept;
+		explicit Consist_Imp( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 		const char* TypeName() const noexcept override;
 
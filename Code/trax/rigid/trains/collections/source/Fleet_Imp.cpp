@@ -28,29 +28,31 @@
 #include "Fleet_Imp.h"
 
 
+#include "trax/rigid/Scene.h"
 #include "trax/rigid/trains/Bogie.h"
 #include "trax/rigid/trains/RollingStock.h"
 #include "trax/rigid/trains/Train.h"
 #include "trax/rigid/trains/collections/Consist.h"
 
 
+#include <algorithm>
 #include <iostream>
 
 namespace trax{
 
-std::unique_ptr<Fleet> Fleet::Make() noexcept
+std::unique_ptr<Fleet> Fleet::Make( CollectionStorage storage ) noexcept
 {
 	try{
-		return std::make_unique<Fleet_Imp>();
+		return std::make_unique<Fleet_Imp>( storage );
 	}
 	catch( const std::bad_alloc& ){
 		return nullptr;
 	}
 }
 
-Fleet_Imp::Fleet_Imp() noexcept
-	: Fleet_Base				{}
-	, m_pConsist				{ Consist::Make() }
+Fleet_Imp::Fleet_Imp( CollectionStorage storage ) noexcept
+	: Fleet_Base				{ storage }
+	, m_pConsist				{ Consist::Make( storage ) }
 	, m_bTrainGenerationEnabled	{ true }
 {
 	
@@ -84,6 +86,7 @@ IDType Fleet_Imp::Add( std::shared_ptr<Train> pTrain ){
 				m_PlugEnumerators.emplace_back( std::make_unique<FPlugEnumerator>( *this, *pTrain ) );
 
 			RegisterBogies( *pTrain );
+			RegisterTrain( *pTrain );
 			return retval;
 		}
 	}
@@ -102,6 +105,7 @@ IDType Fleet_Imp::AddRelaxed( std::shared_ptr<Train> pTrain ) noexcept{
 				m_PlugEnumerators.emplace_back( std::make_unique<FPlugEnumerator>( *this, *pTrain ) );
 
 			RegisterBogies( *pTrain );
+			RegisterTrain( *pTrain );
 			return retval;
 		}
 	}
@@ -123,14 +127,21 @@ bool Fleet_Imp::Remove( Train* pTrain, bool zeroIDs ){
 	}
 	
 	UnregisterBogies( *pTrain );
+	UnregisterTrain( *pTrain );
+	pTrain->DeleteReservation();
 
 	return Fleet_Base::Remove( pTrain, zeroIDs );
 }
 
 void Fleet_Imp::Clear() noexcept
 {
+	for( Train& train : *this )
+		UnregisterTrain( train );
+
+	DeleteReservations();
 	m_pConsist->Clear();
 	m_Bogies.clear();
+	m_CouplingBuckets.clear();
 	m_PlugEnumerators.clear();
 	m_TrainsSeparated.clear();
 	Fleet_Base::Clear();
@@ -160,10 +171,20 @@ std::shared_ptr<RollingStock> Fleet_Imp::GetRollingStock( IDType rollingStockID
 }
 
 void Fleet_Imp::Registered( Scene & scene ) noexcept
-{}
+{
+	m_pScene = &scene;
 
-void Fleet_Imp::Unregistered( Scene & scene ) noexcept
-{}
+	for( Train& train : *this )
+		RegisterTrain( train );
+}
+
+void Fleet_Imp::Unregistered( Scene & /*scene*/ ) noexcept
+{
+	for( Train& train : *this )
+		UnregisterTrain( train );
+
+	m_pScene = nullptr;
+}
 
 bool Fleet_Imp::Start()
 {
@@ -176,58 +197,50 @@ void Fleet_Imp::Idle() noexcept
 
 void Fleet_Imp::PreUpdate()
 {
-	DeleteReservations();
 }
 
 void Fleet_Imp::Update( Time /*dt*/ )
 {
 	SeparateTrains();
 
-	std::vector<std::tuple<Bogie*,EndType,spat::Sphere<Length>>> activeCouplings;
-	for( auto bogie : m_Bogies )
 	// Don't update bogies, they are registered by their own.
+	UpdateCouplingBuckets();
+
+	if( auto iter = m_CouplingBuckets.find( 0 ); iter != m_CouplingBuckets.end() )
 	{
-		if( bogie->IsActivated( EndType::north ) )
-		{
-			activeCouplings.push_back( std::make_tuple( bogie, EndType::north, bogie->GetCoupling( EndType::north ) ) );
-		}
+		std::size_t countActive = 0;
+		for( const auto& [type,bucket] : m_CouplingBuckets )
+			countActive += bucket.entries.size();
 
-		if( bogie->IsActivated( EndType::south ) )
-		{
-			activeCouplings.push_back( std::make_tuple( bogie, EndType::south, bogie->GetCoupling( EndType::south ) ) );
-		}
+		if( countActive > 1 )
+			throw std::logic_error{ "Terminate, because invalid coupling should never be active!" };
 	}
 
-	// Couple all pairs of overlapping couplings (sphere-sphere intersection)
-    for( size_t i = 0; i < activeCouplings.size(); ++i )
-	{
-		const auto& [bogieA, endA, sphereA] = activeCouplings[i];
-		for( size_t j = i + 1; j < activeCouplings.size(); ++j ) 
+	// Couple all pairs of overlapping couplings (sphere-sphere intersection) 
+	// of the same coupling type. They get processed in the order of m_Bogies, 
+	// since coupling one pair might prevent coupling another:
+	std::vector<std::pair<const CouplingEntry*,const CouplingEntry*>>& candidates = m_CouplingCandidates;
+	candidates.clear();
+	CouplingCandidates( candidates );
+	std::sort( candidates.begin(), candidates.end(), 
+		[]( const std::pair<const CouplingEntry*,const CouplingEntry*>& a, const std::pair<const CouplingEntry*,const CouplingEntry*>& b ) noexcept
 		{
-			const auto& [bogieB, endB, sphereB] = activeCouplings[j];
-
-			if( bogieA->GetCouplingProps( endA ).CouplingTypeIdx == 0 ||
-				bogieB->GetCouplingProps( endB ).CouplingTypeIdx == 0 )
-				throw std::logic_error{ "Terminate, because invalid coupling should never be active!" };
+			return a.first->order < b.first->order || (a.first->order == b.first->order && a.second->order < b.second->order);
+		} );
 
-			if(	bogieA->GetCouplingProps( endA ).CouplingTypeIdx != bogieB->GetCouplingProps( endB ).CouplingTypeIdx )
-				continue; // Only couple if coupling types match
-
-			if( (sphereB.Center() - sphereA.Center()).Length() < sphereA.Radius() + sphereB.Radius() )
-			{
-				if( bogieA->Couple( endA, *bogieB, endB ) )
-				{
-					if( m_bTrainGenerationEnabled )
-						ProduceCommonTrain( *bogieA, endA, *bogieB, endB );
-				}
-				else
-					std::cerr << "Couldn't couple active bogies: " << bogieA->Reference( "name" ) << " ID: " << bogieA->ID()
-					          << " and " << bogieB->Reference( "name" ) << " ID: " << bogieB->ID()  << std::endl;
-			}
+	for( const auto& [pA,pB] : candidates )
+	{
+		Bogie* bogieA = pA->pBogie;
+		Bogie* bogieB = pB->pBogie;
+		if( bogieA->Couple( pA->end, *bogieB, pB->end ) )
+		{
+			if( m_bTrainGenerationEnabled )
+				ProduceCommonTrain( *bogieA, pA->end, *bogieB, pB->end );
 		}
+		else
+			std::cerr << "Couldn't couple active bogies: " << bogieA->Reference( "name" ) << " ID: " << bogieA->ID()
+			          << " and " << bogieB->Reference( "name" ) << " ID: " << bogieB->ID()  << std::endl;
 	}
-
-	MakeReservations();
 }
 
 void Fleet_Imp::Pause() noexcept
@@ -296,12 +309,18 @@ void Fleet_Imp::UnregisterBogies( const Train& train ) noexcept
 	}
 }
 
-void Fleet_Imp::MakeReservations() const noexcept
+void Fleet_Imp::RegisterTrain( Train& train ) noexcept
 {
-	for( const Train& train : *this )
-	{
-		train.MakeReservation();
-	}
+	if( m_pScene )
+		if( Simulated* pSimulated = dynamic_cast<Simulated*>(&train); pSimulated )
+			m_pScene->Register( *pSimulated );
+}
+
+void Fleet_Imp::UnregisterTrain( Train& train ) noexcept
+{
+	if( m_pScene )
+		if( Simulated* pSimulated = dynamic_cast<Simulated*>(&train); pSimulated )
+			m_pScene->Unregister( *pSimulated );
 }
 
 void Fleet_Imp::DeleteReservations() const noexcept
@@ -312,6 +331,154 @@ void Fleet_Imp::DeleteReservations() const noexcept
 	}
 }
 
+void Fleet_Imp::UpdateCouplingBuckets()
+{
+	// The actual state of all couplings, indexed by their order:
+	std::vector<CouplingEntry>& actives = m_CouplingActives;
+	std::vector<int>& types = m_CouplingTypes;
+	std::vector<std::pair<const Bogie*,std::size_t>>& indices = m_BogieIndices;
+	actives.assign( 2 * m_Bogies.size(), CouplingEntry{ nullptr, EndType::none, 0, {}, 0_m, 0_m } );
+	types.assign( actives.size(), 0 );
+	indices.clear();
+	for( std::size_t idx = 0; idx < m_Bogies.size(); ++idx )
+	{
+		Bogie* pBogie = m_Bogies[idx];
+		indices.emplace_back( pBogie, idx );
+
+		for( EndType end : { EndType::north, EndType::south } )
+		{
+			if( pBogie->IsActivated( end ) )
+			{
+				const std::size_t order = 2 * idx + (end == EndType::south ? 1 : 0);
+				actives[order] = { pBogie, end, order, pBogie->GetCoupling( end ), 0_m, 0_m };
+				types[order] = pBogie->GetCouplingProps( end ).CouplingTypeIdx;
+			}
+		}
+	}
+
+	std::sort( indices.begin(), indices.end() );
+
+	// Refresh the entries in place to keep their order, dropping the ones 
+	// gone inactive, changed their type or removed from the fleet:
+	std::vector<bool>& bucketed = m_CouplingBucketed;
+	bucketed.assign( actives.size(), false );
+	for( auto& [type,bucket] : m_CouplingBuckets )
+	{
+		std::size_t kept = 0;
+		for( const CouplingEntry& entry : bucket.entries )
+		{
+			if( auto iter = std::lower_bound( indices.begin(), indices.end(), std::make_pair( static_cast<const Bogie*>(entry.pBogie), std::size_t{ 0 } ) ); 
+				iter != indices.end() && iter->first == entry.pBogie )
+			{
+				const std::size_t order = 2 * iter->second + (entry.end == EndType::south ? 1 : 0);
+				if( actives[order].pBogie && types[order] == type && !bucketed[order] )
+				{
+					bucket.entries[kept++] = actives[order];
+					bucketed[order] = true;
+				}
+			}
+		}
+		bucket.entries.resize( kept );
+	}
+
+	for( std::size_t order = 0; order < actives.size(); ++order )
+	{
+		if( actives[order].pBogie && !bucketed[order] )
+		{
+			CouplingBucket& bucket = m_CouplingBuckets[types[order]];
+			bucket.entries.push_back( actives[order] );
+			bucket.bSorted = false;
+		}
+	}
+
+	for( auto iter = m_CouplingBuckets.begin(); iter != m_CouplingBuckets.end(); )
+	{
+		CouplingBucket& bucket = iter->second;
+		if( bucket.entries.empty() )
+		{
+			iter = m_CouplingBuckets.erase( iter );
+			continue;
+		}
+
+		// Sweep along the axis the couplings are spread the most:
+		spat::Position<Length> min = bucket.entries.front().sphere.Center(), max = min;
+		for( const CouplingEntry& entry : bucket.entries )
+		{
+			for( std::size_t axis = 0; axis < 3; ++axis )
+			{
+				min[axis] = std::min( min[axis], entry.sphere.Center()[axis] );
+				max[axis] = std::max( max[axis], entry.sphere.Center()[axis] );
+			}
+		}
+
+		std::size_t axis = 0;
+		for( std::size_t a = 1; a < 3; ++a )
+		{
+			if( max[a] - min[a] > max[axis] - min[axis] )
+				axis = a;
+		}
+
+		if( axis != bucket.axis )
+		{
+			bucket.axis = axis;
+			bucket.bSorted = false;
+		}
+
+		// The extent gets widened by epsilon__length, so that rounding can 
+		// not drop a pair the exact test would find intersecting:
+		for( CouplingEntry& entry : bucket.entries )
+		{
+			entry.lower = entry.sphere.Center()[axis] - entry.sphere.Radius() - epsilon__length;
+			entry.upper = entry.sphere.Center()[axis] + entry.sphere.Radius() + epsilon__length;
+		}
+
+		if( bucket.bSorted )
+		// Insertion sort is linear for the almost sorted entries:
+		{
+			for( std::size_t i = 1; i < bucket.entries.size(); ++i )
+			{
+				for( std::size_t j = i; j > 0 && bucket.entries[j].lower < bucket.entries[j-1].lower; --j )
+					std::swap( bucket.entries[j], bucket.entries[j-1] );
+			}
+		}
+		else
+		{
+			std::sort( bucket.entries.begin(), bucket.entries.end(),
+				[]( const CouplingEntry& a, const CouplingEntry& b ) noexcept
+				{
+					return a.lower < b.lower;
+				} );
+			bucket.bSorted = true;
+		}
+
+		++iter;
+	}
+}
+
+void Fleet_Imp::CouplingCandidates( std::vector<std::pair<const CouplingEntry*,const CouplingEntry*>>& candidates ) const
+{
+	for( const auto& [type,bucket] : m_CouplingBuckets )
+	{
+		if( type == 0 )
+			continue;
+
+		const std::vector<CouplingEntry>& entries = bucket.entries;
+		for( std::size_t i = 0; i < entries.size(); ++i )
+		{
+			for( std::size_t j = i + 1; j < entries.size() && entries[j].lower <= entries[i].upper; ++j )
+			{
+				const CouplingEntry* pA = &entries[i];
+				const CouplingEntry* pB = &entries[j];
+				if( pB->order < pA->order )
+					std::swap( pA, pB );
+
+				if( (pB->sphere.Center() - pA->sphere.Center()).Length() < pA->sphere.Radius() + pB->sphere.Radius() )
+					candidates.push_back( std::make_pair( pA, pB ) );
+			}
+		}
+	}
+}
+
 void Fleet_Imp::SeparateTrains()
 {
 	for( Train* pSeparated : m_TrainsSeparated )
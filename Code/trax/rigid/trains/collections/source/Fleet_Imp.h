@@ -32,6 +32,9 @@
 #include "trax/End.h"
 #include "trax/ImplementationHelper.h"
 #include "trax/Plug.h"
+#include "spat/Sphere.h"
+
+#include <map>
 
 namespace trax{
 
@@ -42,7 +45,7 @@ namespace trax{
 
 	class Fleet_Imp : public Fleet_Base{
 	public:
-		Fleet_Imp() noexcept;
+		explicit Fleet_Imp( CollectionStorage storage = CollectionStorage::tree ) noexcept;
 
 		const char* TypeName() const noexcept override;
 
@@ -105,9 +108,46 @@ namespace trax{
 		void RegisterBogies( const Train& train ) noexcept;
 		void UnregisterBogies( const Train& train ) noexcept;
 
-		void MakeReservations() const noexcept;
+		// The trains get updated by the scene on their own, like the bogies, 
+		// so that they can make their reservations concurrently:
+		Scene* m_pScene = nullptr;
+		void RegisterTrain( Train& train ) noexcept;
+		void UnregisterTrain( Train& train ) noexcept;
+
 		void DeleteReservations() const noexcept;
 
+		// Broad phase for the coupling spheres. The activated couplings get
+		// bucketed by coupling type and kept sorted along the axis of their 
+		// largest spread from step to step (sweep and prune), so with mostly
+		// standing rolling stock the sorting is almost for free:
+		struct CouplingEntry{
+			Bogie* pBogie;
+			EndType end;
+			std::size_t order;			// position of the coupling in m_Bogies, north before south.
+			spat::Sphere<Length> sphere;
+			Length lower, upper;		// extent along the sweep axis.
+		};
+
+		struct CouplingBucket{
+			std::size_t axis = 0;
+			bool bSorted = false;
+			std::vector<CouplingEntry> entries;
+		};
+
+		std::map<int,CouplingBucket> m_CouplingBuckets;
+
+		// Scratch buffers kept from step to step, so that a step does not
+		// allocate as long as the number of bogies and coupling types stays 
+		// the same:
+		std::vector<CouplingEntry> m_CouplingActives;	// the actual state of all couplings, indexed by their order.
+		std::vector<int> m_CouplingTypes;
+		std::vector<bool> m_CouplingBucketed;
+		std::vector<std::pair<const Bogie*,std::size_t>> m_BogieIndices; // sorted by bogie.
+		std::vector<std::pair<const CouplingEntry*,const CouplingEntry*>> m_CouplingCandidates;
+
+		void UpdateCouplingBuckets();
+		void CouplingCandidates( std::vector<std::pair<const CouplingEntry*,const CouplingEntry*>>& candidates ) const;
+
 		class FPlugEnumerator : public trax::PlugEnumerator
 		{
 		public:
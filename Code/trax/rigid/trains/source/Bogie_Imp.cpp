@@ -210,9 +210,9 @@ void Bogie_Imp::PreUpdate()
 void Bogie_Imp::Update( Time dt ) noexcept
 {
 	if( m_CouplingNorth.CheckCoupling( dt ) )
-		Uncouple( EndType::north );
+		UncoupleAfterUpdate( EndType::north );
 	if( m_CouplingSouth.CheckCoupling( dt ) )
-		Uncouple( EndType::south );
+		UncoupleAfterUpdate( EndType::south );
 
 	if( m_pSwivelChildNorth )
 	{
@@ -231,6 +231,22 @@ void Bogie_Imp::Update( Time dt ) noexcept
 	}
 }
 
+bool Bogie_Imp::ParallelUpdate() const noexcept{
+	return true;
+}
+
+void Bogie_Imp::UpdateNeighbours( std::vector<const void*>& neighbours ) const
+{
+	for( EndType end : { EndType::north, EndType::south } ){
+		if( std::shared_ptr<Bogie> pBogie = GetCoupledBogie( end ).first; pBogie )
+			neighbours.push_back( static_cast<const Simulated*>(pBogie.get()) );
+		if( std::shared_ptr<Bogie> pBogie = GetParent( end ).first; pBogie )
+			neighbours.push_back( static_cast<const Simulated*>(pBogie.get()) );
+		if( std::shared_ptr<Bogie> pBogie = GetChild( end ).first; pBogie )
+			neighbours.push_back( static_cast<const Simulated*>(pBogie.get()) );
+	}
+}
+
 void Bogie_Imp::Pause() noexcept{
 }
 
@@ -632,6 +648,29 @@ int Bogie_Imp::GetCouplingTypeIndex( EndType end ) const noexcept
 	return -1;
 }
 
+void Bogie_Imp::UncoupleAfterUpdate( EndType end ) noexcept
+{
+	// Releasing the joint writes to the physics scene, which must not 
+	// happen concurrently, so while updated in parallel this gets done 
+	// after all groups are finished. The bogie might be gone by then:
+	if( PulseQueue* pQueue = PulseQueue::Active(); pQueue ){
+		try{
+			if( std::shared_ptr<Bogie_Imp> pThis = std::dynamic_pointer_cast<Bogie_Imp>(This()) ){
+				pQueue->Defer( [pWeakBogie = std::weak_ptr<Bogie_Imp>{ pThis },end](){ 
+					if( std::shared_ptr<Bogie_Imp> pBogie = pWeakBogie.lock() )
+						pBogie->Uncouple( end ); 
+				} );
+				return;
+			}
+		}
+		catch( const std::bad_alloc& ){
+			assert( 0 );
+		}
+	}
+
+	Uncouple( end );
+}
+
 bool Bogie_Imp::Uncouple( EndType end, bool btriggerPulses ) noexcept
 {
 	switch( end )
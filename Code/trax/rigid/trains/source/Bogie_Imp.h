@@ -71,6 +71,10 @@ namespace trax{
 
 		void Update( Time dt ) noexcept override;
 
+		bool ParallelUpdate() const noexcept override;
+
+		void UpdateNeighbours( std::vector<const void*>& neighbours ) const override;
+
 		void Pause() noexcept override;
 
 		void Resume() noexcept override;
@@ -332,6 +336,9 @@ namespace trax{
 	private:
 		spat::Position<Length> GetLocalAnchor() const;
 
+		// Defers the uncoupling if updated in parallel:
+		void UncoupleAfterUpdate( EndType end ) noexcept;
+
 		// Coupling:
 		struct CouplingProps_Ext : CouplingProps{
 			CouplingProps_Ext( const Bogie_Imp& parentBogie ) noexcept;
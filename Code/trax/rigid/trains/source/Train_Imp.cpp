@@ -27,6 +27,7 @@
 
 #include "Train_Imp.h"
 #include "../Bogie.h"
+#include "trax/rigid/Scene.h"
 
 #include <iostream>
 
@@ -64,6 +65,9 @@ Train_Imp::Train_Imp()
 
 Train_Imp::~Train_Imp()
 {
+	if( m_pScene )
+		m_pScene->Unregister( *this );
+
 	Clear();
 }
 
@@ -465,15 +469,25 @@ std::pair<const Bogie&,EndType> Train_Imp::GetTipAt( EndType end ) const
 
 bool Train_Imp::MakeReservation() const noexcept
 {
-	if( m_Train.empty() )
+	if( m_Train.empty() || !ID() || !IsRailed() )
 		return false;
 
-	return false;
+	try{
+		m_Reservation.Reserve( GetLocation(), ReservationRange(), ID() );
+		return true;
+	}
+	catch( const std::exception& e ){
+		std::cerr << Verbosity::error << "Train_Imp::MakeReservation: " << e.what() << std::endl;
+		m_Reservation.Clear();
+		return false;
+	}
 }
 
 bool Train_Imp::DeleteReservation() const noexcept
 {
-	return false;
+	const bool bReserved = m_Reservation.CountPieces() > 0;
+	m_Reservation.Clear();
+	return bReserved;
 }
 
 std::shared_ptr<Train> Train_Imp::ThisTrain() const noexcept
@@ -900,6 +914,17 @@ bool Train_Imp::Couple( EndType end, Train& with, EndType withEnd ){
 	return coupling.first.Couple( coupling.second, withcoupling.first, withcoupling.second );
 }
 
+void Train_Imp::ReservationLookAhead( Length lookAhead ){
+	if( lookAhead < 0_m )
+		throw std::invalid_argument( "Train_Imp::ReservationLookAhead: look-ahead must not be negative!" );
+
+	m_ReservationLookAhead = lookAhead;
+}
+
+Length Train_Imp::ReservationLookAhead() const noexcept{
+	return m_ReservationLookAhead;
+}
+
 bool Train_Imp::IsUnCoupledInternally() const noexcept
 {
 	if( m_Train.size() < 2 )
@@ -924,6 +949,57 @@ Jack& Train_Imp::JackOnUnCoupleInternal() noexcept{
 	return m_JackOnUnCoupleInternal;
 }
 
+void Train_Imp::Registered( Scene& scene ) noexcept{
+	m_pScene = &scene;
+}
+
+void Train_Imp::Unregistered( Scene& /*scene*/ ) noexcept{
+	m_pScene = nullptr;
+}
+
+bool Train_Imp::Start() noexcept{
+	return true;
+}
+
+void Train_Imp::Idle() noexcept{
+}
+
+void Train_Imp::PreUpdate() noexcept{
+}
+
+void Train_Imp::Update( Time /*dt*/ ) noexcept
+{
+	// The reservation gets updated incrementally:
+	MakeReservation();
+}
+
+bool Train_Imp::ParallelUpdate() const noexcept{
+	return true;
+}
+
+void Train_Imp::UpdateNeighbours( std::vector<const void*>& neighbours ) const
+{
+	// The train reads the state of its bogies ...
+	CollectBogies( *this, neighbours );
+
+	// ... and changes the reservations on the tracks along its way:
+	if( m_Train.empty() || !ID() || !IsRailed() )
+		return;
+
+	m_ReservationTracks.clear();
+	m_Reservation.CollectTracks( GetLocation(), ReservationRange(), ID(), m_ReservationTracks );
+	neighbours.insert( neighbours.end(), m_ReservationTracks.begin(), m_ReservationTracks.end() );
+}
+
+void Train_Imp::Pause() noexcept{
+}
+
+void Train_Imp::Resume() noexcept{
+}
+
+void Train_Imp::Stop() noexcept{
+}
+
 int Train_Imp::CountJacks() const noexcept{
 	return Train_Base::CountJacks() + 1;
 }
@@ -990,6 +1066,36 @@ std::pair<std::shared_ptr<TrainComponent>,EndType> Train_Imp::GetTipAt(
 	return trainTip;
 }
 
+common::Interval<Length> Train_Imp::ReservationRange() const noexcept
+{
+	common::Interval<Length> range{ -GetOverhang( EndType::south ), GetOverhang( EndType::north ) };
+	switch( TargetDirection() ){
+	case EndType::north:
+		range.Far( range.Far() + m_ReservationLookAhead );
+		break;
+	case EndType::south:
+		range.Near( range.Near() - m_ReservationLookAhead );
+		break;
+	default:
+		break;
+	}
+
+	return range;
+}
+
+void Train_Imp::CollectBogies( const TrainComponent& component, std::vector<const void*>& bogies ) const
+{
+	if( const RollingStock* pRollingStock = dynamic_cast<const RollingStock*>(&component) ){
+		for( int idx = 0; idx < pRollingStock->GetNumberOfBogies(); ++idx )
+			bogies.push_back( static_cast<const Simulated*>(&pRollingStock->GetBogie( idx )) );
+	}
+	else if( const Train* pTrain = dynamic_cast<const Train*>(&component) ){
+		for( int idx = 0; idx < pTrain->GetNumberOfComponents(); ++idx )
+			if( std::shared_ptr<TrainComponent> pComponent = pTrain->GetComponent( idx ) )
+				CollectBogies( *pComponent, bogies );
+	}
+}
+
 void Train_Imp::Recouple() noexcept
 {
 	for( std::size_t index = 1; index < m_Train.size(); ++index )
@@ -30,6 +30,8 @@
 #include "../Train.h"
 
 #include "trax/ObjectID.h"
+#include "trax/ReservationSpan.h"
+#include "trax/Simulated.h"
 #include "trax/rigid/trains/source/TrainComponent_Imp.h"
 
 #include <deque>
@@ -38,7 +40,8 @@ namespace trax{
 
 	typedef TrainComponent_Imp<ObjectID_Imp<Train>> Train_Base;
 
-	class Train_Imp : public Train_Base{
+	class Train_Imp : public Train_Base,
+					  public Simulated{
 	public:
 		Train_Imp();
 		~Train_Imp();
@@ -162,10 +165,38 @@ namespace trax{
 		bool Couple( EndType end, Train& with, EndType withEnd ) override;
 				
 		bool IsUnCoupledInternally() const noexcept override;
+
+		void ReservationLookAhead( Length lookAhead ) override;
+
+		Length ReservationLookAhead() const noexcept override;
 		
 
 		Jack& JackOnUnCoupleInternal() noexcept override;
 
+
+		// Simulated:
+		void Registered( Scene& scene ) noexcept override;
+
+		void Unregistered( Scene& scene ) noexcept override;
+
+		bool Start() noexcept override;
+
+		void Idle() noexcept override;
+
+		void PreUpdate() noexcept override;
+
+		void Update( Time dt ) noexcept override;
+
+		bool ParallelUpdate() const noexcept override;
+
+		void UpdateNeighbours( std::vector<const void*>& neighbours ) const override;
+
+		void Pause() noexcept override;
+
+		void Resume() noexcept override;
+
+		void Stop() noexcept override;
+
 		// Inherited via JackEnumerator
 		int CountJacks() const noexcept override;
 
@@ -176,7 +207,16 @@ namespace trax{
 		void ConnectJacks() override;
 	private:
 		std::deque<std::shared_ptr<TrainComponent>> m_Train;
+
+		mutable ReservationSpan m_Reservation;
+		Length m_ReservationLookAhead = 0_m;
+		mutable std::vector<const Track*> m_ReservationTracks; // scratch buffer for UpdateNeighbours()
+		Scene* m_pScene = nullptr;
  
+		common::Interval<Length> ReservationRange() const noexcept;
+
+		void CollectBogies( const TrainComponent& component, std::vector<const void*>& bogies ) const;
+
 		std::pair<std::shared_ptr<TrainComponent>,EndType> GetTipAt( const TrainComponent& trainComponent, EndType end ) const;
 
 		void Recouple() noexcept;
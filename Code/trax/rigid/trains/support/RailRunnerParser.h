@@ -179,6 +179,8 @@ namespace trax{
 	};
 
 
+	void dclspc ParseRollingStock( const unsigned char* bufferStart, const unsigned char* bufferEnd, RollingStockParser& callback ) noexcept(false);
+
 	void dclspc ParseRollingStock( std::basic_istream<char>& stream, RollingStockParser& callback ) noexcept(false);
 
 	void dclspc ParseRollingStock( const std::filesystem::path& filePath, RollingStockParser& callback ) noexcept(false);
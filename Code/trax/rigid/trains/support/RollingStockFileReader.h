@@ -50,6 +50,15 @@ namespace trax{
 		/// \throws std::runtime_error on any kind of malformatted file content.
 		virtual bool Read( std::filesystem::path filePath ) = 0;
 
+
+		///\brief Reads an object from a buffer in memory.
+		///
+		/// The buffer is parsed in place, it does not get copied. References 
+		/// to other files are resolved relative to the base path.
+		///\returns true if the buffer could be read successfuly.
+		/// \throws std::runtime_error on any kind of malformatted buffer content.
+		virtual bool Read( const unsigned char* bufferStart, const unsigned char* bufferEnd ) = 0;
+
 	protected:
 		inline std::filesystem::path GetBasePath() const noexcept{
 			return m_BasePath;
@@ -75,6 +84,8 @@ namespace trax{
 		RollingStockFileReader( RollingStockParser& parser, std::filesystem::path basePath = std::filesystem::path{} ) noexcept;
 
 		bool Read( std::filesystem::path filePath ) override;
+
+		bool Read( const unsigned char* bufferStart, const unsigned char* bufferEnd ) override;
 	};
 
 } // namespace trax
@@ -39,6 +39,8 @@ namespace trax{
 		TrainFileReader( TrainParser& parser, std::filesystem::path basePath = std::filesystem::path{} ) noexcept;
 
 		bool Read( std::filesystem::path filePath ) override;
+
+		bool Read( const unsigned char* bufferStart, const unsigned char* bufferEnd ) override;
 	protected:
 	private:
 		TrainParser& m_Parser;
@@ -27,6 +27,8 @@
 
 #include "RailRunnerParser_Imp.h"
 
+#include "common/support/CommonSupportStream.h"
+
 #include "trax/support/TraxSupportXML.h"
 #include "trax/rigid/support/RigidSupportXML.h"
 
@@ -636,6 +638,17 @@ void ParseTrainRoot( const boost::property_tree::ptree& root, TrainParser& callb
 
 } // namespace ptreesupport
 
+void ParseRollingStock( const unsigned char* bufferStart, const unsigned char* bufferEnd, RollingStockParser& callback ) noexcept(false)
+{
+	common::MemoryInStream stream( bufferStart, bufferEnd );
+
+	boost::property_tree::ptree ptr;
+
+	read_xml( stream, ptr );
+
+	ptreesupport::ParseRollingStockRoot( ptr, callback );
+}
+
 void ParseRollingStock( std::basic_istream<char>& stream, RollingStockParser& callback ) noexcept(false)
 {
 	using boost::property_tree::ptree;
@@ -677,8 +690,7 @@ void ParseRollingStock( const Bogie& /*rollingStock*/, RollingStockParser& /*cal
 
 void ParseTrain( const unsigned char* bufferStart, const unsigned char* bufferEnd, TrainParser& callback ) noexcept(false)
 {
-	std::string string( (const char*)bufferStart, bufferEnd - bufferStart );
-	std::istringstream stream( string );
+	common::MemoryInStream stream( bufferStart, bufferEnd );
 
 	boost::property_tree::ptree ptr;
 
@@ -70,5 +70,11 @@ bool RollingStockFileReader::Read( std::filesystem::path filePath )
 	std::cerr << "File not found: " << filePath << std::endl;
 	return false;
 }
+
+bool RollingStockFileReader::Read( const unsigned char* bufferStart, const unsigned char* bufferEnd )
+{
+	ParseRollingStock( bufferStart, bufferEnd, m_Parser );
+	return true;
+}
 ///////////////////////////////////////
 } // namespace trax
\ No newline at end of file
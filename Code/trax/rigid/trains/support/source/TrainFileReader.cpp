@@ -49,6 +49,12 @@ bool TrainFileReader::Read( std::filesystem::path filePath )
 	std::cerr << "File not found: " << filePath << std::endl;
 	return false;
 }
+
+bool TrainFileReader::Read( const unsigned char* bufferStart, const unsigned char* bufferEnd )
+{
+	ParseTrain( bufferStart, bufferEnd, m_Parser );
+	return true;
+}
 ///////////////////////////////////////
 TrainFileReferenceReader::TrainFileReferenceReader( 
 		Scene& scene,
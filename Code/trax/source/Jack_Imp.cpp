@@ -25,9 +25,14 @@
 // For further information, please contact: horstmann@traxlibrary.dev
 
 #include "Jack_Imp.h"
+#include "Plug_Imp.h"
 #include "trax/Plug.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
 
 namespace trax{
 ///////////////////////////////////////
@@ -36,10 +41,17 @@ Jack_Imp::Jack_Imp( Jack_Imp&& jack ) noexcept
 		m_pPlug				{ jack.m_pPlug },
 		m_bPulsing			{ jack.m_bPulsing },
 		m_RefPlugID			{ jack.m_RefPlugID }/*,
-		m_Parent			{ jack.m_Parent }*/
+		m_Parent			{ jack.m_Parent }*/,
+		m_pPulseToken		{ std::move(jack.m_pPulseToken) }
 {
 	assert( !m_bPulsing );
 
+	if( m_pPulseToken )
+		*m_pPulseToken = this;
+
+	if( jack.m_pGraph )
+		jack.m_pGraph->Detach( jack );
+
 	if( m_pPlug )
 		m_pPlug->ConnectTo( *this );
 
@@ -69,6 +81,11 @@ Jack_Imp::Jack_Imp( const char* name )
 //}
 
 Jack_Imp::~Jack_Imp() noexcept{
+	m_pPulseToken.reset(); // pending deferred pulses become no-ops
+
+	if( m_pGraph )
+		m_pGraph->Detach( *this );
+
 	DoClear();
 }
 
@@ -88,6 +105,29 @@ void Jack_Imp::Pulse() noexcept{
 	if( m_bPulsing )
 		return; // break recursions
 
+	if( PulseQueue* pQueue = PulseQueue::Active() ){
+		if( m_pPlug ){
+			try{
+				if( !m_pPulseToken )
+					m_pPulseToken = std::make_shared<Jack_Imp*>( this );
+
+				pQueue->Defer( [pToken = std::weak_ptr<Jack_Imp*>{ m_pPulseToken }](){ 
+					if( std::shared_ptr<Jack_Imp*> pJack = pToken.lock() )
+						(*pJack)->Pulse(); 
+				} );
+			}
+			catch( const std::bad_alloc& ){
+				assert( 0 );
+			}
+		}
+		return;
+	}
+
+	if( m_pGraph && m_GraphNode >= 0 && m_pGraph->IsValid() ){
+		m_pGraph->Pulse( m_GraphNode );
+		return;
+	}
+
 	if( m_pPlug ){
 		m_bPulsing = true;
 		m_pPlug->Pulse( true );
@@ -145,6 +185,9 @@ void Jack_Imp::Clear() noexcept{
 void Jack_Imp::DoClear() noexcept{
 	assert( !m_bPulsing );
 
+	if( m_pGraph )
+		m_pGraph->Invalidate();
+
 	if( m_pPlug ){
 		m_pPlug->Release();
 		m_pPlug = nullptr;
@@ -152,5 +195,290 @@ void Jack_Imp::DoClear() noexcept{
 
 	m_RefPlugID = 0u;
 }
+///////////////////////////////////////
+static thread_local PulseQueue* tl_pActivePulseQueue = nullptr;
+
+PulseQueue::Scope::Scope( PulseQueue* pQueue ) noexcept
+	:	m_pPrevious{ tl_pActivePulseQueue }
+{
+	tl_pActivePulseQueue = pQueue;
+}
+
+PulseQueue::Scope::~Scope() noexcept{
+	tl_pActivePulseQueue = m_pPrevious;
+}
+
+PulseQueue* PulseQueue::Active() noexcept{
+	return tl_pActivePulseQueue;
+}
+
+void PulseQueue::Defer( std::function<void()> action ){
+	m_Actions.push_back( std::move(action) );
+}
+
+void PulseQueue::Append( PulseQueue&& queue ){
+	if( m_Actions.empty() )
+		m_Actions.swap( queue.m_Actions );
+	else{
+		m_Actions.reserve( m_Actions.size() + queue.m_Actions.size() );
+		std::move( queue.m_Actions.begin(), queue.m_Actions.end(), std::back_inserter( m_Actions ) );
+	}
+
+	queue.m_Actions.clear();
+}
+
+void PulseQueue::Commit() noexcept{
+	Scope scope{ nullptr };
+	const auto start = std::chrono::steady_clock::now();
+
+	// Pulses might trigger further pulses, but those go out right away:
+	const std::size_t depth = m_Actions.size();
+	for( std::size_t idx = 0; idx < m_Actions.size(); ++idx ){
+		try{
+			m_Actions[idx]();
+		}
+		catch( const std::exception& e ){
+			std::cerr << Verbosity::error << "PulseQueue::Commit: Exception caught in deferred action: " << e.what() << std::endl;
+		}
+		catch( ... ){
+			std::cerr << Verbosity::error << "PulseQueue::Commit: Unknown exception caught in deferred action." << std::endl;
+		}
+	}
+
+	m_Actions.clear();
+
+	m_Statistics.lastDelivery = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start );
+	m_Statistics.totalDelivery += m_Statistics.lastDelivery;
+	m_Statistics.lastDepth = depth;
+	m_Statistics.maxDepth = std::max( m_Statistics.maxDepth, depth );
+	m_Statistics.delivered += depth;
+	++m_Statistics.commits;
+}
+
+bool PulseQueue::Empty() const noexcept{
+	return m_Actions.empty();
+}
+
+std::size_t PulseQueue::Depth() const noexcept{
+	return m_Actions.size();
+}
+
+const PulseQueue::Statistics& PulseQueue::GetStatistics() const noexcept{
+	return m_Statistics;
+}
+
+void PulseQueue::ResetStatistics() noexcept{
+	m_Statistics = {};
+}
+///////////////////////////////////////
+PulseGraph::PulseGraph() noexcept
+	:	m_Head			{ -1 },
+		m_bValid		{ false },
+		m_bPropagating	{ false }
+{}
+
+PulseGraph::~PulseGraph() noexcept{
+	assert( !m_bPropagating );
+	Release();
+}
+
+void PulseGraph::Compile( JackEnumerator& jackEnumerator ){
+	std::vector<Jack*> jacks;
+	jacks.reserve( jackEnumerator.CountJacks() );
+	for( Jack& jack : jackEnumerator )
+		jacks.push_back( &jack );
+
+	Compile( jacks );
+}
+
+void PulseGraph::Compile( const std::vector<Jack*>& jacks ){
+	if( m_bPropagating )
+		throw std::logic_error( "PulseGraph: can not compile while delivering a pulse." );
+
+	Release();
+
+	auto AddNode = [this]( Jack_Imp& jack ) -> int {
+		if( jack.m_pGraph == this && jack.m_GraphNode >= 0 )
+			return jack.m_GraphNode;
+		if( jack.m_pGraph && jack.m_pGraph != this )
+			jack.m_pGraph->Invalidate();
+
+		m_Nodes.push_back( { &jack, 0, 0 } );
+		jack.m_pGraph = this;
+		jack.m_GraphNode = static_cast<int>(m_Nodes.size() - 1);
+		return jack.m_GraphNode;
+	};
+
+	try{
+		for( Jack* pJack : jacks )
+			if( Jack_Imp* pJack_Imp = dynamic_cast<Jack_Imp*>(pJack) )
+				AddNode( *pJack_Imp );
 
-}
\ No newline at end of file
+		// MultiPlugJacks found in the chains get appended as nodes:
+		for( std::size_t idx = 0; idx < m_Nodes.size(); ++idx ){
+			const int firstTarget = static_cast<int>(m_Targets.size());
+
+			for( Plug* pPlug = m_Nodes[idx].pJack->GetPlug(); pPlug; ){
+				Target target{ pPlug, -1, false, pPlug->ForewardsFirst() };
+				if( MultiPlugJack_Imp* pMultiPlugJack = dynamic_cast<MultiPlugJack_Imp*>(&pPlug->Parent()) )
+					target.node = AddNode( *pMultiPlugJack );
+
+				Jack_Imp* pNext = dynamic_cast<Jack_Imp*>(&pPlug->JackOnPulse());
+				target.bForeward = pNext == nullptr;
+				m_Targets.push_back( target );
+
+				if( !pNext )
+					break;
+				if( pNext->m_pGraph == this ){
+					if( pNext->m_GraphNode >= 0 ) // the chain continues with a node
+						m_Targets.push_back( { nullptr, pNext->m_GraphNode, false, false } );
+					break; // or is cyclic
+				}
+				if( pNext->m_pGraph )
+					pNext->m_pGraph->Invalidate();
+
+				pNext->m_pGraph = this;
+				pNext->m_GraphNode = -1;
+				m_ChainJacks.push_back( pNext );
+				pPlug = pNext->GetPlug();
+			}
+
+			m_Nodes[idx].firstTarget = firstTarget;
+			m_Nodes[idx].countTargets = static_cast<int>(m_Targets.size()) - firstTarget;
+		}
+
+		int maxChain = 0;
+		for( const Node& node : m_Nodes )
+			maxChain = std::max( maxChain, node.countTargets );
+
+		m_Queue.reserve( m_Nodes.size() );
+		m_Unwind.assign( maxChain, 0 );
+	}
+	catch( ... ){
+		Release();
+		throw;
+	}
+
+	m_bValid = true;
+}
+
+bool PulseGraph::IsValid() const noexcept{
+	return m_bValid;
+}
+
+void PulseGraph::Invalidate() noexcept{
+	m_bValid = false;
+
+	// The nodes are needed to finish the delivery:
+	if( !m_bPropagating )
+		Release();
+}
+
+int PulseGraph::CountNodes() const noexcept{
+	return static_cast<int>(m_Nodes.size());
+}
+
+int PulseGraph::CountTargets() const noexcept{
+	return static_cast<int>(m_Targets.size());
+}
+
+void PulseGraph::Pulse( int node ) noexcept{
+	if( m_bPropagating ){
+		Enqueue( node );
+		return;
+	}
+
+	m_bPropagating = true;
+	m_Queue.clear();
+	m_Head = -1;
+	Enqueue( node );
+
+	for( std::size_t head = 0; head < m_Queue.size(); ++head ){
+		m_Head = static_cast<int>(head);
+		const Node& current = m_Nodes[m_Queue[head].node];
+		if( !current.pJack )
+			continue;
+
+		if( !m_bValid ){
+			current.pJack->Pulse();
+			continue;
+		}
+
+		current.pJack->m_bPulsing = true;
+		int unwind = 0;
+		for( int idx = current.firstTarget; idx < current.firstTarget + current.countTargets && m_bValid; ++idx ){
+			const Target& target = m_Targets[idx];
+			if( target.node >= 0 )
+				Enqueue( target.node );
+			else if( target.bActsLast && !target.bForeward )
+				m_Unwind[unwind++] = idx;
+			else
+				target.pPlug->Pulse( target.bForeward );
+		}
+
+		// Plugs that forward first act after the rest of their chain:
+		while( unwind > 0 && m_bValid )
+			m_Targets[m_Unwind[--unwind]].pPlug->Pulse( false );
+
+		if( current.pJack )
+			current.pJack->m_bPulsing = false;
+	}
+
+	m_Head = -1;
+	m_bPropagating = false;
+	if( !m_bValid )
+		Release();
+}
+
+void PulseGraph::Enqueue( int node ) noexcept{
+	assert( node >= 0 && node < static_cast<int>(m_Nodes.size()) );
+
+	// A jack that is delivering this pulse already would pulse recursively:
+	for( int entry = m_Head; entry >= 0; entry = m_Queue[entry].parent )
+		if( m_Queue[entry].node == node )
+			return;
+
+	try{
+		m_Queue.push_back( { node, m_Head } );
+	}
+	catch( const std::bad_alloc& ){
+		assert( 0 );
+	}
+}
+
+void PulseGraph::Detach( Jack_Imp& jack ) noexcept{
+	if( jack.m_GraphNode >= 0 )
+		m_Nodes[jack.m_GraphNode].pJack = nullptr;
+	else
+		std::replace( m_ChainJacks.begin(), m_ChainJacks.end(), &jack, static_cast<Jack_Imp*>(nullptr) );
+
+	jack.m_pGraph = nullptr;
+	jack.m_GraphNode = -1;
+	Invalidate();
+}
+
+void PulseGraph::Release() noexcept{
+	for( const Node& node : m_Nodes ){
+		if( node.pJack && node.pJack->m_pGraph == this ){
+			node.pJack->m_pGraph = nullptr;
+			node.pJack->m_GraphNode = -1;
+		}
+	}
+
+	for( Jack_Imp* pJack : m_ChainJacks ){
+		if( pJack && pJack->m_pGraph == this ){
+			pJack->m_pGraph = nullptr;
+			pJack->m_GraphNode = -1;
+		}
+	}
+
+	m_Nodes.clear();
+	m_Targets.clear();
+	m_ChainJacks.clear();
+	m_Queue.clear();
+	m_Unwind.clear();
+	m_Head = -1;
+	m_bValid = false;
+}
+///////////////////////////////////////
+}
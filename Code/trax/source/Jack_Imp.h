@@ -37,6 +37,7 @@ namespace trax{
 	class JackEnumerator_Imp :	public Base,
 								public JackEnumerator{
 	public:
+		using Base::Base;
 
 		int CountJacks() const override{
 			int count = 0;
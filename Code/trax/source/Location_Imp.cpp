@@ -193,57 +193,59 @@ std::pair<Length,bool> Location::Move( Length dParam, Orientation principalDirec
 
 	std::pair<Length,bool> retval = { 0_m, false };
 
-	const common::Interval<Length> range{
-		m_TLocation.parameter,
-		m_TLocation.parameter + (m_TLocation.orientation ? +dParam : -dParam) };
+	// One track per iteration, so moving over many short 
+	// tracks needs neither recursion nor allocations:
+	for(;;){
+		const common::Interval<Length> range{
+			m_TLocation.parameter,
+			m_TLocation.parameter + (m_TLocation.orientation ? +dParam : -dParam) };
+
+		if( pSignalTarget /*&& pSignalTarget->Active()*/ ){
+			if( !m_pTrack->DoSignal( range, m_TLocation.orientation ? principalDirection : !principalDirection, *pSignalTarget ) )
+				return retval;
+		}
 
-	if( pSignalTarget /*&& pSignalTarget->Active()*/ ){
-		if( !m_pTrack->DoSignal( range, m_TLocation.orientation ? principalDirection : !principalDirection, *pSignalTarget ) )
+		if( abs(dParam) <= Length{epsilon} ) // zero distance is no movement
 			return retval;
-	}
 
-	if( abs(dParam) <= Length{epsilon} ) // zero distance is no movement
-		return retval;
+		if( pEvent )
+		{
+			//if( !pEvent->Moving( *this, range ) ){
+			//	retval.first = dParam;
+			//	return retval;
+			//}
 
-	if( pEvent )
-	{
-		//if( !pEvent->Moving( *this, range ) ){
-		//	retval.first = dParam;
-		//	return retval;
-		//}
+			m_pTrack->DoTrigger( range, *pEvent );
+		}
 
-		m_pTrack->DoTrigger( range, *pEvent );
-	}
+		const Length trackLength = m_pTrack->GetLength();
+		if( range.Far() < 0_m )
+		{
+			dParam -= common::Sign(dParam) * m_TLocation.parameter;
+			m_TLocation.parameter = 0_m;
+			if( !TrackTransition( EndType::north, pEvent ) ){
+				retval.first = dParam;
+				return retval;
+			}
 
-	if( range.Far() < 0_m )
-	{
-		dParam -= common::Sign(dParam) * m_TLocation.parameter;
-		m_TLocation.parameter = 0_m;
-		if( !TrackTransition( EndType::north, pEvent ) ){
-			retval.first = dParam;
-			return retval;
+			retval.second = true;
 		}
+		else if ( range.Far() > trackLength )
+		{
+			dParam -= common::Sign(dParam) * (trackLength - m_TLocation.parameter);
+			m_TLocation.parameter = trackLength;
+			if( !TrackTransition( EndType::south, pEvent ) ){
+				retval.first = dParam;
+				return retval;
+			}
 
-		retval.second = true;
-		retval.first = Move( dParam, principalDirection, pEvent, pSignalTarget ).first;
-	}
-	else if ( range.Far() > m_pTrack->GetLength() )
-	{
-		dParam -= common::Sign(dParam) * (m_pTrack->GetLength() - m_TLocation.parameter);
-		m_TLocation.parameter = m_pTrack->GetLength();
-		if( !TrackTransition( EndType::south, pEvent ) ){
-			retval.first = dParam;
+			retval.second = true;
+		}
+		else{
+			m_TLocation.parameter = range.Far();
 			return retval;
 		}
-
-		retval.second = true;
-		retval.first = Move( dParam, principalDirection, pEvent, pSignalTarget ).first;
 	}
-	else{
-		m_TLocation.parameter = range.Far();
-	}
-
-	return retval;
 }
 
 std::pair<Length,bool> Location::Move( Length dParam, const Event* pEvent ){
@@ -347,15 +349,23 @@ Length Location::Distance( const Location& loc, const Length maxdistance ) const
 
 	Location thisLoc{ *this };
 	Length distance{0};
+	const bool bForward = maxdistance > 0_m;
 
-	while( thisLoc.GetTrack() != loc.GetTrack() ){
-		const auto delta = thisLoc.MoveTransit( Orientation{ maxdistance > 0_m } );
-		distance += delta.first;
+	while( thisLoc.m_pTrack != loc.m_pTrack ){
+		// Transit to the next track like MoveTransit() does, 
+		// but without the detour over Move():
+		const bool bToSouth = static_cast<bool>(thisLoc.m_TLocation.orientation) == bForward;
+		const Length trackLength = thisLoc.m_pTrack->GetLength();
+		const Length paramlength = bToSouth ? trackLength - thisLoc.m_TLocation.parameter : thisLoc.m_TLocation.parameter;
+		distance += bForward ? paramlength : -paramlength;
+
+		thisLoc.m_TLocation.parameter = bToSouth ? trackLength : 0_m;
+		const bool bTransitioned = thisLoc.TrackTransition( bToSouth ? EndType::south : EndType::north, nullptr );
 
 		if( abs(distance) >= abs(maxdistance) )
 			return maxdistance;
 
-		if( !delta.second )
+		if( !bTransitioned )
 			throw std::out_of_range{ "Reached open track end while searching for location!" };
 	}
 
@@ -437,26 +447,22 @@ bool Location::TrackTransition( EndType frontend, const Event* pEvent ) noexcept
 		}
 	}
 
-	m_pTrack = nextTrackEnd.pTrack;
+	m_pTrack = std::move( nextTrackEnd.pTrack );
 	return true;
 }
 
 bool Location::Resolve() noexcept{
-	if( IsResolved() )
-		return true;
-
-	if( m_TLocation.parameter < 0_m ){
-		if( TrackTransition( EndType::north, nullptr ) )
-			return Resolve();
-		else
-			return false;
-	}
-
-	if( m_TLocation.parameter > m_pTrack->GetLength() ){
-		if( TrackTransition( EndType::south, nullptr ) )
-			return Resolve();
+	while( !IsResolved() ){
+		if( m_TLocation.parameter < 0_m ){
+			if( !TrackTransition( EndType::north, nullptr ) )
+				return false;
+		}
+		else if( m_TLocation.parameter > m_pTrack->GetLength() ){
+			if( !TrackTransition( EndType::south, nullptr ) )
+				return false;
+		}
 		else
-			return false;
+			break;
 	}
 
 	return true;
@@ -263,6 +263,10 @@ namespace trax{
 				assert( !"Try to set incomplete or ill formed item!" );
 			}
 		}
+
+		bool ForewardsFirst() const noexcept override{
+			return true;
+		}
 	private:
 		TargetType& m_Target;
 	};
@@ -0,0 +1,241 @@
+//	trax track library
+//	AD 2026
+//
+//  "Keep on movin', don't stop, no"
+//
+//				Soul II Soul
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "trax/ReservationSpan.h"
+
+#include "Track_Imp.h"
+
+#include <algorithm>
+
+namespace trax{
+
+static Track_Imp* ToTrack_Imp( const std::shared_ptr<const Track>& pTrack ) noexcept{
+	return dynamic_cast<Track_Imp*>(const_cast<Track*>(pTrack.get()));
+}
+
+ReservationSpan::~ReservationSpan(){
+	Clear();
+}
+
+bool ReservationSpan::Reserve( const Location& location, common::Interval<Length> range, IDType forID ){
+	if( !location.IsOnTrack() )
+		throw std::logic_error( "ReservationSpan: the location is not sitting on a track!" );
+
+	if( !forID ){
+		const bool bHadPieces = !m_Pieces.empty();
+		Clear();
+		return bHadPieces;
+	}
+
+	if( forID != m_ID )
+		Clear();
+	else if( IsUnchanged( location, range, forID ) )
+		return false;
+
+	m_ID = forID;
+	m_Location = location;
+	m_Range = range;
+	m_LatestRevision = Track_Imp::LatestRevision();
+
+	Walk( location, range );
+
+	auto Matches = []( const Piece& a, const Piece& b ) noexcept{
+		return a.pTrack == b.pTrack && a.range.Normal() == b.range.Normal();
+	};
+
+	// Align the recent pieces with the new ones. Moving ahead, some pieces
+	// fall off at the tail, moving back some get added there:
+	bool bChanged = false;
+	std::size_t i = 0, j = 0;
+	if( !m_Pieces.empty() && !m_Walk.empty() ){
+		const auto iter = std::find_if( m_Pieces.begin(), m_Pieces.end(),
+			[this,&Matches]( const Piece& piece ) noexcept{ return Matches( piece, m_Walk.front() ); } );
+		if( iter != m_Pieces.end() ){
+			for( ; i < static_cast<std::size_t>(iter - m_Pieces.begin()); ++i, bChanged = true )
+				Delete( m_Pieces[i] );
+		}
+		else{
+			const auto iter2 = std::find_if( m_Walk.begin(), m_Walk.end(),
+				[this,&Matches]( const Piece& piece ) noexcept{ return Matches( m_Pieces.front(), piece ); } );
+			if( iter2 != m_Walk.end() ){
+				for( ; j < static_cast<std::size_t>(iter2 - m_Walk.begin()); ++j, bChanged = true )
+					Make( m_Walk[j] );
+			}
+		}
+	}
+
+	for( ; i < m_Pieces.size() && j < m_Walk.size() && Matches( m_Pieces[i], m_Walk[j] ); ++i, ++j ){
+		if( !(m_Pieces[i].range == m_Walk[j].range) ){
+			Change( m_Pieces[i], m_Walk[j] );
+			bChanged = true;
+		}
+	}
+
+	// Whatever is left did not match:
+	for( ; i < m_Pieces.size(); ++i, bChanged = true )
+		Delete( m_Pieces[i] );
+	for( ; j < m_Walk.size(); ++j, bChanged = true )
+		Make( m_Walk[j] );
+
+	std::swap( m_Pieces, m_Walk );
+	m_Walk.clear();
+
+	m_Revisions.resize( m_Pieces.size() );
+	for( std::size_t idx = 0; idx < m_Pieces.size(); ++idx ){
+		const Track_Imp* pTrack = ToTrack_Imp( m_Pieces[idx].pTrack );
+		m_Revisions[idx] = pTrack ? pTrack->Revision() : 0;
+	}
+
+	return bChanged;
+}
+
+void ReservationSpan::CollectTracks( const Location& location, common::Interval<Length> range, IDType forID, std::vector<const Track*>& tracks ){
+	if( !location.IsOnTrack() || IsUnchanged( location, range, forID ) )
+		return;
+
+	for( const Piece& piece : m_Pieces )
+		tracks.push_back( piece.pTrack.get() );
+
+	if( forID ){
+		Walk( location, range );
+		for( const Piece& piece : m_Walk )
+			tracks.push_back( piece.pTrack.get() );
+		m_Walk.clear();
+	}
+}
+
+void ReservationSpan::Clear() noexcept{
+	for( const Piece& piece : m_Pieces )
+		Delete( piece );
+
+	m_ID = anyID;
+	m_Location = Location{};
+	m_Range = {};
+	m_Pieces.clear();
+	m_Walk.clear();
+	m_Revisions.clear();
+	m_LatestRevision = 0;
+}
+
+IDType ReservationSpan::ID() const noexcept{
+	return m_ID;
+}
+
+Length ReservationSpan::GetLength() const noexcept{
+	Length length = 0_m;
+	for( const Piece& piece : m_Pieces )
+		length += abs( piece.range.Length() );
+
+	return length;
+}
+
+std::size_t ReservationSpan::CountPieces() const noexcept{
+	return m_Pieces.size();
+}
+
+const ReservationSpan::Piece& ReservationSpan::GetPiece( std::size_t idx ) const{
+	return m_Pieces.at( idx );
+}
+
+bool ReservationSpan::IsUnchanged( const Location& location, common::Interval<Length> range, IDType forID ) const noexcept{
+	if( forID != m_ID || !m_Location.IsOnTrack() )
+		return false;
+
+	if( location.GetTrack() != m_Location.GetTrack() ||
+		location.Orient() != m_Location.Orient() ||
+		abs( location.Param() - m_Location.Param() ) >= epsilon__length ||
+		abs( range.Near() - m_Range.Near() ) >= epsilon__length ||
+		abs( range.Far() - m_Range.Far() ) >= epsilon__length )
+		return false;
+
+	// Most of the time no track at all will have changed:
+	if( Track_Imp::LatestRevision() == m_LatestRevision )
+		return true;
+
+	for( std::size_t idx = 0; idx < m_Pieces.size(); ++idx ){
+		const Track_Imp* pTrack = ToTrack_Imp( m_Pieces[idx].pTrack );
+		if( pTrack && pTrack->Revision() != m_Revisions[idx] )
+			return false;
+	}
+
+	return true;
+}
+
+void ReservationSpan::Walk( const Location& location, common::Interval<Length> range ){
+	m_Walk.clear();
+
+	Location start = location;
+	const Length reached = range.Near() - start.Move( range.Near() ).first;
+	if( range.Far() < range.Near() )
+		start.Flip();
+
+	// A dead end might have stopped the start location:
+	Length remaining = range.Normal() ? range.Far() - reached : reached - range.Far();
+
+	std::shared_ptr<const Track> pTrack = start.GetTrack();
+	Length param = start.Param();
+	Orientation orientation = start.Orient();
+	while( remaining > 0_m ){
+		const Length toEnd = orientation ? pTrack->GetLength() - param : param;
+		const Length step = std::min( toEnd, remaining );
+		const Length farParam = orientation ? param + step : param - step;
+		if( step > 0_m )
+			m_Walk.push_back( { pTrack, { param, farParam } } );
+
+		remaining -= step;
+		if( remaining <= 0_m )
+			break;
+
+		const Track::TrackEnd nextTrackEnd = pTrack->TransitionEnd( orientation ? EndType::south : EndType::north );
+		if( !nextTrackEnd.pTrack )
+			break;
+
+		const bool bFromNorth = nextTrackEnd.end == EndType::north;
+		orientation = bFromNorth ? Orientation::Value::para : Orientation::Value::anti;
+		param = bFromNorth ? 0_m : nextTrackEnd.pTrack->GetLength();
+		pTrack = nextTrackEnd.pTrack;
+	}
+}
+
+void ReservationSpan::Delete( const Piece& piece ) const noexcept{
+	if( Track_Imp* pTrack = ToTrack_Imp( piece.pTrack ); pTrack )
+		pTrack->ChangeReservationLocally( piece.range, { 0_m, 0_m }, m_ID );
+}
+
+void ReservationSpan::Make( const Piece& piece ) const{
+	if( Track_Imp* pTrack = ToTrack_Imp( piece.pTrack ); pTrack )
+		pTrack->ReserveLocally( piece.range, m_ID );
+}
+
+void ReservationSpan::Change( const Piece& piece, const Piece& toPiece ) const{
+	if( Track_Imp* pTrack = ToTrack_Imp( piece.pTrack ); pTrack ){
+		if( !pTrack->ChangeReservationLocally( piece.range, toPiece.range, m_ID ) )
+			// the piece was deleted by someone else:
+			pTrack->ReserveLocally( toPiece.range, m_ID );
+	}
+}
+
+}
@@ -753,6 +753,10 @@ Angle DirectionalTwist_Imp::DoTwist( Length s ) const{
 AnglePerLength DirectionalTwist_Imp::DoD1( Length s ) const{
 	return DirectionalTwist_ImpBase<DirectionalTwist>::DoD1_( s, A );
 }
+
+Angle DirectionalTwist_Imp::DoTwistD1( Length s, AnglePerLength& d1 ) const{
+	return DirectionalTwist_ImpBase<DirectionalTwist>::DoTwistD1_( s, A, d1 );
+}
 ///////////////////////////////////////
 std::unique_ptr<PiecewiseDirectionalTwist> PiecewiseDirectionalTwist::Make() noexcept
 {
@@ -1023,6 +1027,13 @@ AnglePerLength CombinedTwist_Imp::DoD1( Length s ) const{
 	return m_pTwist1->DoD1(s) + m_pTwist2->DoD1(s);
 }
 
+Angle CombinedTwist_Imp::DoTwistD1( Length s, AnglePerLength& d1 ) const{
+	AnglePerLength d1_2;
+	const Angle twist = m_pTwist1->DoTwistD1( s, d1 ) + m_pTwist2->DoTwistD1( s, d1_2 );
+	d1 += d1_2;
+	return twist;
+}
+
 void CombinedTwist_Imp::AttachTwist1( std::unique_ptr<RoadwayTwist> pTwist ){
 	if( !pTwist )
 		throw std::invalid_argument( "Detach a twist propperly from a CombinedTwist!" );
@@ -60,6 +60,10 @@ namespace trax{
 			return DoD1(s);
 		}
 
+		Angle TwistD1( Length s, AnglePerLength& d1 ) const override{
+			return this->DoTwistD1( s, d1 ) + ZeroFlip(s);
+		}
+
 		bool ZeroFlip( bool bActive ) noexcept override{
 			const bool retval = m_bZeroFlip;
 			m_bZeroFlip = bActive;
@@ -510,6 +514,36 @@ namespace trax{
 			return -std::atan2( AN, AB );
 		}
 
+		inline Angle DoTwistD1_( Length s, const spat::Vector<One>& A, AnglePerLength& d1 ) const{
+			if( m_pCurve == nullptr ){
+				d1 = 0_1Im;
+				return 0;
+			}
+
+			spat::Frame<Length,One> F;
+			AnglePerLength k, t;
+			m_pCurve->Transition( c(s), F, k, t );
+
+			if( !m_CurveSegment.Normal() ){
+				F.T *= -1;
+				F.B *= -1;
+			}
+
+			const Real AB = A*F.B;
+			const Real AN = A*F.N;
+			if( std::abs(AB) < epsilon && std::abs(AN) < epsilon ){
+				d1 = DoD1_( s, A );
+				return DoTwist_( s, A );
+			}
+
+			if( AB )
+				d1 = k * (A*F.T/AB) / (1 + std::pow(AN/AB,2)) - Turn() * t;
+			else
+				d1 = -Turn() * t;
+
+			return -std::atan2( AN, AB );
+		}
+
 		inline AnglePerLength DoD1_( Length s, const spat::Vector<One>& A ) const{
 			if( m_pCurve == nullptr )
 				return 0_1Im;
@@ -593,6 +627,8 @@ namespace trax{
 		Angle DoTwist( Length s ) const override;
 		
 		AnglePerLength DoD1( Length s ) const override;
+
+		Angle DoTwistD1( Length s, AnglePerLength& d1 ) const override;
 	private:
 		spat::Vector<One> GlobalA, A;
 		bool m_bFrozen = false;
@@ -674,6 +710,8 @@ namespace trax{
 
 		AnglePerLength DoD1( Length s ) const override;
 
+		Angle DoTwistD1( Length s, AnglePerLength& d1 ) const override;
+
 		void OnAttach( const TrackBuilder& track ) noexcept override;
 
 		void OnDetach() noexcept override;
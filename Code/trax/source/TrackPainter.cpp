@@ -26,8 +26,11 @@
 
 #include "trax/TrackPainter.h"
 #include "trax/Track.h"
+#include "Track_Imp.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace trax{
 	using namespace common;
@@ -63,23 +66,64 @@ static Length Segment_Constant( const Track& track, Length s, Length, common::In
 	return segmentLimits.Far();
 }
 
-Length TrackPainter::Paint( const TrackBuilder& track, const Section& section, Length offset )
-{
+// The ends of the segments to paint the track with. The checked modes get all
+// the segments from one Segmentation, instead of probing each segment anew.
+// parameters is reused to keep its capacity:
+static void SegmentEnds( const TrackBuilder& track, int mode, Length e, common::Interval<Length> segmentLimits, std::vector<Length>& parameters ){
+	const bool bIgnoreCuvesTorsion = mode & TrackPainter::mode_ignoreCuvesTorsion;
+	if( segmentLimits.Length() > 0_m )
+	{
+		if( mode & TrackPainter::mode_totallycheckedSegmentLength ){
+			parameters = Segmentation{ track, segmentLimits.Near(), bIgnoreCuvesTorsion }.Segments( e, segmentLimits );
+			return;
+		}
+
+		if( mode & TrackPainter::mode_checkedSegmentLength ){
+			// Segment_Checked() only looks at the segment ends, so a coarse grid will do:
+			const Length resolution = std::max( segmentLimits.Near(), std::min( segmentLimits.Far(), track.GetLength() / 64 ) );
+			parameters = Segmentation{ track, resolution, bIgnoreCuvesTorsion }.Segments( e, segmentLimits );
+			return;
+		}
+	}
+
+	using SegmentFuncType = Length(*)(const Track&, Length, Length, common::Interval<Length>, bool);
+	SegmentFuncType SegmentFunction = Segment;	
+	if( segmentLimits.Length() == 0_m || (mode & TrackPainter::mode_constantSegmentLength) )
+		SegmentFunction = Segment_Constant;
+
+	parameters.clear();
+	Length ds, s = 0_m;
+	while( (ds = SegmentFunction( track, s, e, segmentLimits, bIgnoreCuvesTorsion )) )
+		parameters.push_back( s += ds );
+}
+
+static void CheckPaintable( const TrackBuilder& track, const Section& section ){
 	if( !track.IsValid() )
 		throw std::invalid_argument( "Invalid track!" );
 	if( section.CountPoints() < 2 )
 		throw std::invalid_argument( "Invalid section for track! Count profile points < 2." );
 	if( track.GetLength() == infinite__length )
 		throw std::invalid_argument( "Invalid track! Length is infinite." );
+}
 
-	m_CountSegmentsLastPaint = 0;
-
-	if( GetMode() & mode_localFrame )
-		m_Transformation = track.GetAbsoluteFrame() * track.GetFrame();
-	else if( GetMode() & mode_startFrame )
-		track.Transition( 0_m, m_Transformation );
+static Frame<Length,One> PaintTransformation( const TrackBuilder& track, int mode ){
+	Frame<Length,One> transformation;
+	if( mode & TrackPainter::mode_localFrame )
+		transformation = track.GetAbsoluteFrame() * track.GetFrame();
+	else if( mode & TrackPainter::mode_startFrame )
+		track.Transition( 0_m, transformation );
 	else
-		m_Transformation.Init();
+		transformation.Init();
+
+	return transformation;
+}
+
+Length TrackPainter::Paint( const TrackBuilder& track, const Section& section, Length offset )
+{
+	CheckPaintable( track, section );
+
+	m_CountSegmentsLastPaint = 0;
+	m_Transformation = PaintTransformation( track, GetMode() );
 
 	Frame<Length,One> frame;
 	track.Transition( 0_m, frame );
@@ -88,28 +132,18 @@ Length TrackPainter::Paint( const TrackBuilder& track, const Section& section, L
 
 	StartPaint( frame, offset, section );
 
-	Length ds, s = 0_m;
-	using SegmentFuncType = Length(*)(const Track&, Length, Length, common::Interval<Length>, bool);
-	SegmentFuncType SegmentFunction = Segment;	
-	if( m_SegmentLimits.Length() == 0_m )
-		SegmentFunction = Segment_Constant;
-	else
-	{
-		if( GetMode() & mode_constantSegmentLength )
-			SegmentFunction = Segment_Constant;
-		if( GetMode() & mode_checkedSegmentLength )
-			SegmentFunction = Segment_Checked;
-		if( GetMode() & mode_totallycheckedSegmentLength )
-			SegmentFunction = Segment_TotallyChecked;
-	}
+	SegmentEnds( track, GetMode(), m_Epsilon, m_SegmentLimits, m_Parameters );
+
+	m_Frames.resize( m_Parameters.size() );
+	track.Transition( m_Parameters.data(), m_Parameters.data() + m_Parameters.size(), m_Frames.data() );
 
-	while( (ds = SegmentFunction( track, s, m_Epsilon, m_SegmentLimits, GetMode() & mode_ignoreCuvesTorsion )) )
+	for( std::size_t i = 0; i < m_Frames.size(); ++i )
 	{
-		track.Transition( s += ds, frame );
+		frame = m_Frames[i];
 		if( GetMode() & (mode_localFrame | mode_startFrame) )
 			m_Transformation.FromParent( frame );
 
-		PaintSegment( frame, ds, section );
+		PaintSegment( frame, m_Parameters[i] - (i ? m_Parameters[i-1] : 0_m), section );
 
 		++m_CountSegmentsLastPaint;
 	}
@@ -181,4 +215,117 @@ void SectionPainter::AddVertexRowAt( const Frame<Length,One>& rFrame, const Sect
 	}
 }
 ///////////////////////////////////////
-}
\ No newline at end of file
+
+LODPainter::LODPainter( std::vector<Length> epsilons, int mode, common::Interval<Length> segmentLimits )
+	:	m_Epsilons		{std::move(epsilons)},
+		m_Mode			{mode},
+		m_SegmentLimits	{segmentLimits}
+{
+	if( m_Epsilons.empty() )
+		throw std::invalid_argument( "LODPainter: at least one level of detail is needed!" );
+	if( *std::min_element( m_Epsilons.begin(), m_Epsilons.end() ) <= 0_m )
+		throw std::invalid_argument( "LODPainter: the epsilon values must be > 0_m!" );
+
+	if( !m_SegmentLimits.Normal() )
+		throw std::invalid_argument( "LODPainter: The segment limits have to specify the lower limit as \
+the Near value and the upper limit as the Far() value." );
+
+	if( !(m_SegmentLimits > Interval<Length>{-infinite__length,0_m}) )
+		throw std::invalid_argument( "LODPainter: The limits both must be > 0." );
+
+	std::sort( m_Epsilons.begin(), m_Epsilons.end() );
+}
+
+// The frame at the track's end, taken from the connected track 
+// with the lower ID, if any, so both tracks paint the same row there:
+static Frame<Length,One> JointFrame( const TrackBuilder& track, EndType end ){
+	Frame<Length,One> frame;
+	const Track::TrackEnd other = track.TransitionEnd( end );
+	if( other.pTrack && other.pTrack->IsValid() && other.pTrack->ID() < track.ID() ){
+		other.pTrack->Transition( other.end == EndType::north ? 0_m : other.pTrack->GetLength(), frame );
+		if( other.end == end ){
+			frame.T *= -1;
+			frame.N *= -1;
+		}
+	}
+	else
+		track.Transition( end == EndType::north ? 0_m : track.GetLength(), frame );
+
+	return frame;
+}
+
+void LODPainter::Tessellate( const TrackBuilder& track, const Section& section )
+{
+	CheckPaintable( track, section );
+
+	// Sample with the finest level:
+	SegmentEnds( track, m_Mode, m_Epsilons.front(), m_SegmentLimits, m_Parameters );
+	m_Parameters.insert( m_Parameters.begin(), 0_m );
+	if( m_Parameters.size() < 2 )
+		m_Parameters.push_back( track.GetLength() );
+
+	m_Frames.resize( m_Parameters.size() );
+	track.Transition( m_Parameters.data(), m_Parameters.data() + m_Parameters.size(), m_Frames.data() );
+	m_Frames.front() = JointFrame( track, EndType::north );
+	m_Frames.back() = JointFrame( track, EndType::south );
+
+	if( m_Mode & (TrackPainter::mode_localFrame | TrackPainter::mode_startFrame) ){
+		const Frame<Length,One> transformation = PaintTransformation( track, m_Mode );
+		for( Frame<Length,One>& frame : m_Frames )
+			transformation.FromParent( frame );
+	}
+
+	// Coarser levels drop rows from the next finer one as long as 
+	// the dropped vertices stay near enough to the mesh:
+	const int nRows = common::narrow_cast<int>(m_Parameters.size());
+	const int nPoints = section.CountPoints();
+	std::vector<Position<Length>> vertices( static_cast<std::size_t>(nRows) * nPoints );
+	for( int row = 0; row < nRows; ++row )
+		for( int i = 0; i < nPoints; ++i )
+			vertices[row * nPoints + i] = SectionVertex<Position<Length>>( m_Frames[row], section.Get( i ), {} );
+
+	auto SpanFits = [&]( int from, int to, Length epsilon ) noexcept -> bool{
+		const Length span = m_Parameters[to] - m_Parameters[from];
+		if( span > m_SegmentLimits.Far() )
+			return false;
+
+		for( int row = from + 1; row < to; ++row ){
+			const One t = (m_Parameters[row] - m_Parameters[from]) / span;
+			for( int i = 0; i < nPoints; ++i ){
+				const Position<Length>& a = vertices[from * nPoints + i];
+				const Position<Length>& b = vertices[to * nPoints + i];
+				if( (vertices[row * nPoints + i] - (a + t * (b - a))).Length() > epsilon )
+					return false;
+			}
+		}
+
+		return true;
+	};
+
+	m_Rows.resize( m_Epsilons.size() );
+	m_Rows.front().resize( nRows );
+	for( int row = 0; row < nRows; ++row )
+		m_Rows.front()[row] = row;
+
+	for( std::size_t lod = 1; lod < m_Epsilons.size(); ++lod ){
+		const std::vector<int>& finer = m_Rows[lod-1];
+		std::vector<int>& rows = m_Rows[lod];
+		rows.assign( 1, finer.front() );
+
+		for( std::size_t next = 1; next < finer.size(); ++next ){
+			if( next + 1 < finer.size() && SpanFits( rows.back(), finer[next+1], m_Epsilons[lod] ) )
+				continue;
+
+			rows.push_back( finer[next] );
+		}
+	}
+}
+
+std::uint64_t LODPainter::Revision( const Track& track ) noexcept{
+	if( const Track_Imp* pTrackImp = dynamic_cast<const Track_Imp*>(&track) )
+		return pTrackImp->Revision();
+
+	return 0;
+}
+
+}
@@ -0,0 +1,282 @@
+//	trax track library
+//	AD 2026
+//
+//  "The long and winding road
+//	 that leads to your door"
+//
+//				The Beatles
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#include "trax/TrackPath.h"
+
+#include "Track_Imp.h"
+
+#include "common/Helpers.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace trax{
+
+TrackPath::TrackPath( const Location& start, Length horizon ){
+	Build( start, horizon );
+}
+
+void TrackPath::Build( const Location& start, Length horizon ){
+	if( !start.IsOnTrack() )
+		throw std::logic_error( "TrackPath: the start location is not sitting on a track!" );
+	if( horizon < 0_m )
+		throw std::invalid_argument( "TrackPath: the horizon must not be negative!" );
+	if( !std::isfinite( horizon.Units() ) )
+		throw std::invalid_argument( "TrackPath: the horizon must be finite!" );
+
+	Clear();
+	m_LatestRevision = Track_Imp::LatestRevision();
+
+	std::shared_ptr<const Track> pTrack = start.GetTrack();
+	Length param = start.Param();
+	Orientation orientation = start.Orient();
+	Length offset = 0_m;
+
+	// The walk is a sequence of track/orientation states; a state seen
+	// before means the walk goes round in circles. Back at the start, the 
+	// remainder of the start track closes the loop. Other cycles get found
+	// by comparing against a checkpoint state that moves ahead in 
+	// doubling intervals (Brent):
+	const Track* pCheckpoint = pTrack.get();
+	Orientation checkpointOrientation = orientation;
+	std::size_t stepsToCheckpoint = 1, checkpointInterval = 1;
+	bool bClosing = false;
+	for(;;){
+		const Length farParam = bClosing ? start.Param() : orientation ? pTrack->GetLength() : 0_m;
+		const common::Interval<Length> range{ param, farParam };
+
+		const Track_Imp* pTrackImp = dynamic_cast<const Track_Imp*>(pTrack.get());
+		if( pTrackImp ){
+			const std::size_t first = m_Signals.size();
+			pTrackImp->Signals( range, orientation, m_Signals );
+			for( std::size_t i = first; i < m_Signals.size(); ++i )
+				m_Signals[i].first = m_Signals[i].first + offset;
+		}
+
+		m_Revisions.push_back( std::make_pair( pTrackImp, pTrackImp ? pTrackImp->Revision() : 0 ) );
+		m_ByTrack.push_back( std::make_pair( pTrack.get(), m_Entries.size() ) );
+		m_Entries.push_back( { pTrack, range, orientation, offset } );
+
+		offset += abs( range.Length() );
+		if( bClosing ){
+			m_bComplete = true;
+			break;
+		}
+		if( offset >= horizon )
+			break;
+
+		const Track::TrackEnd nextTrackEnd = pTrack->TransitionEnd( orientation ? EndType::south : EndType::north );
+		if( !nextTrackEnd.pTrack ){
+			m_bOpenEnded = true;
+			break;
+		}
+
+		const bool bFromNorth = nextTrackEnd.end == EndType::north;
+		orientation = bFromNorth ? Orientation::Value::para : Orientation::Value::anti;
+		param = bFromNorth ? 0_m : nextTrackEnd.pTrack->GetLength();
+		pTrack = nextTrackEnd.pTrack;
+
+		if( pTrack == start.GetTrack() && orientation == start.Orient() ){
+			if( param == start.Param() ){
+				m_bComplete = true;
+				break;
+			}
+
+			bClosing = true;
+		}
+		else if( pTrack.get() == pCheckpoint && orientation == checkpointOrientation ){
+			m_bComplete = true;
+			break;
+		}
+		else if( ++stepsToCheckpoint > checkpointInterval ){
+			pCheckpoint = pTrack.get();
+			checkpointOrientation = orientation;
+			checkpointInterval *= 2;
+			stepsToCheckpoint = 1;
+		}
+	}
+
+	std::sort( m_ByTrack.begin(), m_ByTrack.end() );
+
+	std::stable_sort( m_Signals.begin(), m_Signals.end(),
+		[]( const std::pair<common::Interval<Length>,Signal*>& a, const std::pair<common::Interval<Length>,Signal*>& b ) noexcept
+		{
+			return a.first.Near() < b.first.Near();
+		} );
+
+	m_SignalsReach.resize( m_Signals.size() );
+	for( std::size_t i = 0; i < m_Signals.size(); ++i )
+		m_SignalsReach[i] = i > 0 ? std::max( m_Signals[i].first.Far(), m_SignalsReach[i-1] ) : m_Signals[i].first.Far();
+}
+
+void TrackPath::Clear() noexcept{
+	m_Entries.clear();
+	m_bOpenEnded = false;
+	m_bComplete = false;
+	m_Revisions.clear();
+	m_LatestRevision = 0;
+	m_ByTrack.clear();
+	m_Signals.clear();
+	m_SignalsReach.clear();
+}
+
+bool TrackPath::IsValid() const noexcept{
+	if( m_Entries.empty() )
+		return false;
+
+	// Most of the time no track at all will have changed:
+	const std::uint64_t latestRevision = Track_Imp::LatestRevision();
+	if( latestRevision == m_LatestRevision )
+		return true;
+
+	for( const auto& pair : m_Revisions ){
+		if( pair.first && pair.first->Revision() != pair.second )
+			return false;
+	}
+
+	m_LatestRevision = latestRevision;
+	return true;
+}
+
+Length TrackPath::GetLength() const noexcept{
+	return m_Entries.empty() ? 0_m : m_Entries.back().offset + abs( m_Entries.back().range.Length() );
+}
+
+bool TrackPath::IsOpenEnded() const noexcept{
+	return m_bOpenEnded;
+}
+
+bool TrackPath::IsComplete() const noexcept{
+	return m_bComplete;
+}
+
+std::size_t TrackPath::CountEntries() const noexcept{
+	return m_Entries.size();
+}
+
+const TrackPath::Entry& TrackPath::GetEntry( std::size_t idx ) const{
+	return m_Entries.at( idx );
+}
+
+std::vector<TrackPath::Entry>::const_iterator TrackPath::begin() const noexcept{
+	return m_Entries.begin();
+}
+
+std::vector<TrackPath::Entry>::const_iterator TrackPath::end() const noexcept{
+	return m_Entries.end();
+}
+
+std::size_t TrackPath::Find( Length distance ) const noexcept{
+	if( distance < 0_m || distance > GetLength() )
+		return m_Entries.size();
+
+	const auto iter = std::upper_bound( m_Entries.begin(), m_Entries.end(), distance,
+		[]( Length distance, const Entry& entry ) noexcept
+		{
+			return distance < entry.offset;
+		} );
+
+	return static_cast<std::size_t>(iter - m_Entries.begin()) - 1;
+}
+
+Location TrackPath::LocationAt( Length distance ) const{
+	const std::size_t idx = Find( distance );
+	if( idx == m_Entries.size() )
+		throw std::out_of_range( "TrackPath: distance is not on the path!" );
+
+	const Entry& entry = m_Entries[idx];
+	Length param = entry.range.Near() + (entry.orientation ? +1 : -1) * (distance - entry.offset);
+	common::Clip( param, 0_m, entry.pTrack->GetLength() );
+	return Location{ entry.pTrack, TrackLocation{ param, entry.orientation } };
+}
+
+Length TrackPath::Distance( const Location& loc ) const noexcept{
+	if( !loc.IsOnTrack() )
+		return +infinite__length;
+
+	const Track* pTrack = loc.GetTrack().get();
+	auto iter = std::lower_bound( m_ByTrack.begin(), m_ByTrack.end(), std::make_pair( pTrack, std::size_t{0} ) );
+	for( ; iter != m_ByTrack.end() && iter->first == pTrack; ++iter ){
+		const Entry& entry = m_Entries[iter->second];
+		if( entry.range.Min() <= loc.Param() && loc.Param() <= entry.range.Max() )
+			return entry.offset + abs( loc.Param() - entry.range.Near() );
+	}
+
+	return +infinite__length;
+}
+
+std::pair<Signal*,Length> TrackPath::NextSignal( Length from ) const noexcept{
+	// Signals before the first one that reaches up to from can not 
+	// intersect; from there on the first intersecting one is the next:
+	const common::Interval<Length> ahead{ from, +infinite__length };
+	for( auto idx = std::lower_bound( m_SignalsReach.begin(), m_SignalsReach.end(), from ) - m_SignalsReach.begin(); 
+		idx < static_cast<std::ptrdiff_t>(m_Signals.size()); ++idx )
+	{
+		const auto& pair = m_Signals[idx];
+		if( Intersecting( pair.first, ahead ) )
+			return std::make_pair( pair.second, pair.first.Near() );
+	}
+
+	return std::make_pair( nullptr, +infinite__length );
+}
+
+std::pair<IDType,Length> TrackPath::NextReservation( IDType exceptID, Length from, Length to ) const{
+	for( std::size_t idx = Find( std::max( from, 0_m ) ); idx < m_Entries.size(); ++idx ){
+		const Entry& entry = m_Entries[idx];
+		if( entry.offset > to )
+			break;
+
+		// The part of the entry between from and to in track parameters:
+		const int sign = entry.orientation ? +1 : -1;
+		const common::Interval<Length> range{
+			entry.range.Near() + sign * std::max( from - entry.offset, 0_m ),
+			entry.range.Near() + sign * std::min( to - entry.offset, abs( entry.range.Length() ) ) };
+
+		std::pair<IDType,Length> nearest{ anyID, +infinite__length };
+		for( auto iter = entry.pTrack->BeginReservations(); iter != entry.pTrack->EndReservations(); ++iter ){
+			if( exceptID && std::get<0>(*iter) == exceptID )
+				continue;
+
+			const common::Interval<Length>& reserved = std::get<1>(*iter);
+			if( !Intersecting( reserved, range ) )
+				continue;
+
+			const Length distance = entry.offset + (entry.orientation ?
+				std::max( reserved.Min(), range.Min() ) - entry.range.Near() :
+				entry.range.Near() - std::min( reserved.Max(), range.Max() ));
+			if( distance < nearest.second )
+				nearest = std::make_pair( std::get<0>(*iter), distance );
+		}
+
+		if( nearest.first )
+			return nearest;
+	}
+
+	return std::make_pair( anyID, +infinite__length );
+}
+
+}
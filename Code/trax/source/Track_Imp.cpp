@@ -39,6 +39,7 @@
 #include "dim/support/DimSupportStream.h"
 
 #include <algorithm>
+#include <numeric>
 #include <iostream>
 #include <iomanip>
 
@@ -90,9 +91,42 @@ void Track_Imp::AddConnector( Connector* pConnector, EndType atend ) noexcept{
 	}
 }
 
+std::atomic<std::uint64_t> Track_Imp::sm_LatestRevision{0};
+
+std::uint64_t Track_Imp::Revision() const noexcept{
+	return m_Revision;
+}
+
+std::uint64_t Track_Imp::LatestRevision() noexcept{
+	return sm_LatestRevision.load( std::memory_order_acquire );
+}
+
+void Track_Imp::Touch() noexcept{
+	m_Revision = sm_LatestRevision.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+}
+
+void Track_Imp::SetGeometryListener( TrackGeometryListener* pListener ) noexcept{
+	m_pGeometryListener = pListener;
+}
+
+TrackGeometryListener* Track_Imp::GetGeometryListener() const noexcept{
+	return m_pGeometryListener;
+}
+
+void Track_Imp::SetReservationListener( TrackReservationListener* pListener ) noexcept{
+	m_pReservationListener = pListener;
+}
+
+TrackReservationListener* Track_Imp::GetReservationListener() const noexcept{
+	return m_pReservationListener;
+}
+
 void Track_Imp::PropagateAbsoluteFrameToClients() noexcept{
 	TrackBase::PropagateAbsoluteFrameToClients();
 	m_TotalFrame = GetAbsoluteFrame() * GetFrame();
+
+	if( m_pGeometryListener )
+		m_pGeometryListener->OnGeometryChanged( *this );
 	try{
 		m_pTwist->OnDetach();
 		m_pTwist->OnAttach( *this );
@@ -381,9 +415,23 @@ spat::Vector<One> Track_Imp::LocalUp() const{
 }
 
 void Track_Imp::Transition( Length s, TrackData<Real>& td, Real engine_meters_per_unit ) const{
-	Frame<Length,One> F, wF;
-	TNBFrame( s, F );
-	Transition( s, wF );
+	TestTransition( s );
+
+	Frame<Length,One> F;
+	AnglePerLength curvature, torsion, twistD1;
+	m_pCurve->Transition( c(s), F, curvature, torsion );
+
+	if( !m_CurveSegment.Normal() ){
+		F.T *= -1;
+		F.B *= -1;
+	}
+
+	Frame<Length,One> wF = F;
+	if( const Angle twist = m_pTwist->TwistD1( s, twistD1 ) )
+		wF.RotateTan( twist );
+
+	F = m_TotalFrame * F;
+	wF = m_TotalFrame * wF;
 
 	td.F.P.x = _m(F.P.x) / engine_meters_per_unit;
 	td.F.P.y = _m(F.P.y) / engine_meters_per_unit;
@@ -399,8 +447,8 @@ void Track_Imp::Transition( Length s, TrackData<Real>& td, Real engine_meters_pe
 	td.wF.N = spatial_cast<Real>(wF.N);
 	td.wF.B = spatial_cast<Real>(wF.B);
 
-	td.c = _1Im(Curvature( s )) * engine_meters_per_unit;
-	td.t = _1Im(Torsion( s )) * engine_meters_per_unit;
+	td.c = _1Im(curvature) * engine_meters_per_unit;
+	td.t = _1Im(torsion + twistD1) * engine_meters_per_unit;
 }
 
 void Track_Imp::Transition( Length s, Position<Length>& pos ) const{
@@ -462,15 +510,42 @@ void Track_Imp::Transition( Length s, Frame<Length,One>& frame ) const{
 	frame = m_TotalFrame * frame;
 }
 
+void Track_Imp::Transition( const Length* sBegin, const Length* sEnd, Position<Length>* pos ) const{
+	const std::vector<Length>& curveParameters = CurveParameters( sBegin, sEnd );
+
+	m_pCurve->Transition( curveParameters.data(), curveParameters.data() + curveParameters.size(), pos );
+
+	for( std::size_t i = 0; i < curveParameters.size(); ++i )
+		pos[i] = m_TotalFrame * pos[i];
+}
+
+void Track_Imp::Transition( const Length* sBegin, const Length* sEnd, Frame<Length,One>* frame ) const{
+	const std::vector<Length>& curveParameters = CurveParameters( sBegin, sEnd );
+
+	m_pCurve->Transition( curveParameters.data(), curveParameters.data() + curveParameters.size(), frame );
+
+	const bool bFlip = !m_CurveSegment.Normal();
+	for( std::size_t i = 0; i < curveParameters.size(); ++i ){
+		if( bFlip ){
+			frame[i].T *= -1;
+			frame[i].B *= -1;
+		}
+
+		if( const Angle twist = m_pTwist->Twist( sBegin[i] ) )
+			frame[i].RotateTan( twist );
+
+		frame[i] = m_TotalFrame * frame[i];
+	}
+}
+
 void Track_Imp::DoTrigger( const Interval<Length>& range, const Event& _event ) const{
+	// m_Sensors is sorted by parameter, so the first sensor in range
+	// is found by binary search.
 	if( range.Normal() ){
-		for( auto iter = std::find_if( m_Sensors.begin(), m_Sensors.end(),
-						[&range]( const std::pair<TrackLocation,std::shared_ptr<Sensor>>& pair ) noexcept->bool
+		for( auto iter = std::lower_bound( m_Sensors.begin(), m_Sensors.end(), range.Near(),
+						[]( const std::pair<TrackLocation,std::shared_ptr<Sensor>>& pair, Length near ) noexcept->bool
 						{
-							if( pair.first.orientation == Orientation::Value::anti )
-								return false;
-
-							return pair.first.parameter >= range.Near();
+							return pair.first.parameter < near;
 						} );
 				iter != m_Sensors.end() && iter->first.parameter < range.Far();
 				++iter )
@@ -482,14 +557,11 @@ void Track_Imp::DoTrigger( const Interval<Length>& range, const Event& _event )
 		}
 	}
 	else{
-		for( auto iter = std::find_if( m_Sensors.rbegin(), m_Sensors.rend(),
-						[&range]( const std::pair<TrackLocation,std::shared_ptr<Sensor>>& pair ) noexcept->bool
+		for( auto iter = std::make_reverse_iterator( std::upper_bound( m_Sensors.begin(), m_Sensors.end(), range.Near(),
+						[]( Length near, const std::pair<TrackLocation,std::shared_ptr<Sensor>>& pair ) noexcept->bool
 						{
-							if( pair.first.orientation == Orientation::Value::para )
-								return false;
-
-							return pair.first.parameter <= range.Near();
-						} );
+							return near < pair.first.parameter;
+						} ) );
 				iter != m_Sensors.rend() && iter->first.parameter > range.Far(); 
 				++iter )
 		{
@@ -502,13 +574,18 @@ void Track_Imp::DoTrigger( const Interval<Length>& range, const Event& _event )
 }
 
 bool Track_Imp::DoSignal( const Interval<Length>& range, Orientation orientation, SignalTarget& signalTarget ) const{
-	for( const auto& pair : m_Signals )
-		if( pair.first.m_Orientation == orientation && IntersectingClosed( pair.first, range ) ){
+	const auto candidates = SignalCandidates( orientation, range );
+
+	// notify in the order of travel:
+	for( std::size_t i = 0; i < candidates.second - candidates.first; ++i ){
+		const auto& pair = m_Signals[m_SignalsOrder[orientation == Orientation::Value::anti ? candidates.second - 1 - i : candidates.first + i]];
+		if( IntersectingClosed( pair.first, range ) ){
 			if( !signalTarget.Notify( 
 				*pair.second,
 				-pair.second->GetLocation().Distance( Location{ shared_from_this(), TrackLocation{ range.m_Far, orientation } }, -1_km ) ) )
 				return false;
 		}
+	}
 
 	return true;
 }
@@ -519,9 +596,15 @@ Signal* Track_Imp::GetSignal( const TrackLocation& loc ) const noexcept{
 		return nullptr;
 	}
 
-	for( const auto& pair : m_Signals )
-		if( pair.first.m_Orientation == loc.orientation && Intersecting( pair.first, Interval<Length>{ loc.parameter, loc.orientation ? GetLength() : 0_m } ) )
+	const Interval<Length> range{ loc.parameter, loc.orientation ? GetLength() : 0_m };
+	const auto candidates = SignalCandidates( loc.orientation, range );
+
+	// the first one in the direction of loc:
+	for( std::size_t i = 0; i < candidates.second - candidates.first; ++i ){
+		const auto& pair = m_Signals[m_SignalsOrder[loc.orientation == Orientation::Value::anti ? candidates.second - 1 - i : candidates.first + i]];
+		if( Intersecting( pair.first, range ) )
 			return pair.second.get();
+	}
 
 	if( TrackEnd nextTrackEnd = TransitionEnd( loc.orientation ? EndType::south : EndType::north ); nextTrackEnd.pTrack ){
 		m_LoopBraker = true;
@@ -533,6 +616,86 @@ Signal* Track_Imp::GetSignal( const TrackLocation& loc ) const noexcept{
 	return nullptr;
 }
 
+void Track_Imp::Signals( const Interval<Length>& range, Orientation orientation, std::vector<std::pair<Interval<Length>,Signal*>>& signals ) const{
+	const auto candidates = SignalCandidates( orientation, range );
+
+	for( std::size_t i = candidates.first; i < candidates.second; ++i ){
+		const auto& pair = m_Signals[m_SignalsOrder[i]];
+		if( Intersecting( pair.first, range ) ){
+			if( orientation == Orientation::Value::anti )
+				signals.push_back( std::make_pair( Interval<Length>{ std::max( 0_m, range.Near() - pair.first.Max() ), range.Near() - pair.first.Min() }, pair.second.get() ) );
+			else
+				signals.push_back( std::make_pair( Interval<Length>{ std::max( 0_m, pair.first.Min() - range.Near() ), pair.first.Max() - range.Near() }, pair.second.get() ) );
+		}
+	}
+}
+
+static int SignalGroup( Orientation orientation ) noexcept{
+	return orientation == Orientation::Value::para ? 0 : orientation == Orientation::Value::anti ? 1 : 2;
+}
+
+void Track_Imp::SortSignals(){
+	// m_Signals keeps its order, since the plug and jack enumeration 
+	// and the written layouts depend on it:
+	m_SignalsOrder.resize( m_Signals.size() );
+	std::iota( m_SignalsOrder.begin(), m_SignalsOrder.end(), std::size_t{0} );
+	std::stable_sort( m_SignalsOrder.begin(), m_SignalsOrder.end(), 
+		[this]( std::size_t a, std::size_t b ) noexcept
+		{
+			const OrientedInterval& A = m_Signals[a].first;
+			const OrientedInterval& B = m_Signals[b].first;
+			if( SignalGroup( A.m_Orientation ) != SignalGroup( B.m_Orientation ) )
+				return SignalGroup( A.m_Orientation ) < SignalGroup( B.m_Orientation );
+
+			return A.Min() < B.Min();
+		} );
+
+	m_SignalsReach.resize( m_SignalsOrder.size() );
+	for( std::size_t i = 0; i < m_SignalsOrder.size(); ++i ){
+		const OrientedInterval& range = m_Signals[m_SignalsOrder[i]].first;
+		m_SignalsReach[i] = range.Max();
+		if( i > 0 && SignalGroup( m_Signals[m_SignalsOrder[i-1]].first.m_Orientation ) == SignalGroup( range.m_Orientation ) )
+			m_SignalsReach[i] = std::max( m_SignalsReach[i], m_SignalsReach[i-1] );
+	}
+
+	Touch();
+}
+
+// The window [first,last) of the elements in [begin,end), sorted by the lower
+// bound of their intervals, that possibly intersect range. reach holds the 
+// running maximum of the upper bounds of the intervals, starting at begin.
+template<typename Iterator,typename LowerBound>
+static std::pair<Iterator,Iterator> IntersectionCandidates( 
+	Iterator begin, 
+	Iterator end, 
+	std::vector<Length>::const_iterator reach, 
+	const Interval<Length>& range, 
+	LowerBound lowerBound ) noexcept
+{
+	const Iterator last = std::upper_bound( begin, end, range.Max(),
+		[&lowerBound]( Length max, const auto& element ) noexcept
+		{
+			return max < lowerBound( element );
+		} );
+
+	const auto first = std::lower_bound( reach, reach + (last - begin), range.Min() );
+	return { begin + (first - reach), last };
+}
+
+std::pair<std::size_t,std::size_t> Track_Imp::SignalCandidates( Orientation orientation, const Interval<Length>& range ) const noexcept{
+	const int g = SignalGroup( orientation );
+	const auto groupBegin = std::partition_point( m_SignalsOrder.begin(), m_SignalsOrder.end(),
+		[this,g]( std::size_t idx ) noexcept{ return SignalGroup( m_Signals[idx].first.m_Orientation ) < g; } );
+	const auto groupEnd = std::partition_point( groupBegin, m_SignalsOrder.end(),
+		[this,g]( std::size_t idx ) noexcept{ return SignalGroup( m_Signals[idx].first.m_Orientation ) == g; } );
+
+	const auto candidates = IntersectionCandidates( groupBegin, groupEnd, 
+		m_SignalsReach.cbegin() + (groupBegin - m_SignalsOrder.begin()), range,
+		[this]( std::size_t idx ) noexcept{ return m_Signals[idx].first.Min(); } );
+
+	return { static_cast<std::size_t>(candidates.first - m_SignalsOrder.begin()), static_cast<std::size_t>(candidates.second - m_SignalsOrder.begin()) };
+}
+
 void Track_Imp::Reserve( Interval<Length> range, IDType forID )
 {
 	if( forID < IDType{1u} )
@@ -545,18 +708,68 @@ void Track_Imp::Reserve( Interval<Length> range, IDType forID )
 		throw std::range_error( "Reservation outside of this track!" );
 	}
 
-	for( auto& tuple : m_Reservations )
+	const auto candidates = ReservationCandidates( range );
+	for( std::size_t i = candidates.first; i < candidates.second; ++i ){
+		auto& tuple = m_Reservations[i];
 		if( std::get<0>(tuple) == forID && 
 			std::get<1>(tuple).Normal() == range.Normal() &&
 			Intersecting(std::get<1>(tuple),range) )
 		{
-			std::get<1>(tuple).Union( range );
-			ReserveConnected( tuple );
+			Reservation reservation = tuple; // connected tracks might loop back to this
+			std::get<1>(reservation).Union( range );
+			EraseReservation( i );
+			InsertReservation( reservation );
+			ReserveConnected( reservation );
 			return;
 		}
+	}
+
+	const Reservation reservation = std::make_tuple( forID, range );
+	InsertReservation( reservation );
 
-	m_Reservations.push_back( std::make_tuple( forID, range ) );
-	ReserveConnected( m_Reservations.back() );
+	if( m_pReservationListener )
+		m_pReservationListener->OnReserved( *this, forID );
+
+	ReserveConnected( reservation );
+}
+
+void Track_Imp::ReserveLocally( Interval<Length> range, IDType forID )
+{
+	if( forID < IDType{1u} )
+		return;
+	if( range.Length() == 0_m )
+		return;
+	if( !Range().Touches( range.Min() ) || !Range().Touches( range.Max() ) )
+		throw std::range_error( "Track_Imp::ReserveLocally: reservation outside of this track!" );
+
+	InsertReservation( std::make_tuple( forID, range ) );
+
+	if( m_pReservationListener )
+		m_pReservationListener->OnReserved( *this, forID );
+}
+
+bool Track_Imp::ChangeReservationLocally( Interval<Length> range, Interval<Length> toRange, IDType forID )
+{
+	if( toRange.Length() != 0_m && (!Range().Touches( toRange.Min() ) || !Range().Touches( toRange.Max() )) )
+		throw std::range_error( "Track_Imp::ChangeReservationLocally: reservation outside of this track!" );
+
+	for( auto candidates = ReservationCandidates( range ); candidates.first < candidates.second; ++candidates.first ){
+		auto iter = m_Reservations.begin() + candidates.first;
+		if( std::get<0>(*iter) == forID && std::get<1>(*iter) == range )
+		{
+			EraseReservation( candidates.first );
+			if( toRange.Length() == 0_m ){
+				if( m_pReservationListener )
+					m_pReservationListener->OnReservationDeleted( *this, forID );
+			}
+			else
+				InsertReservation( std::make_tuple( forID, toRange ) );
+
+			return true;
+		}
+	}
+
+	return false;
 }
 
 Track::ReservationIterator Track_Imp::BeginReservations() const noexcept{
@@ -591,10 +804,28 @@ void Track_Imp::DeleteReservation( Interval<Length> range, IDType forID ) noexce
 	if( m_ReserveLoopBrakerFront || m_ReserveLoopBrakerEnd )
 		return;
 
-	auto iter = m_Reservations.begin();
-	while( iter != m_Reservations.end() ){
-		if( (forID == anyID || forID == std::get<0>(*iter)) && 
-			Intersecting(std::get<1>(*iter),range) )
+	// Erasing keeps the order, so the reservations stay sorted and only 
+	// the reach needs an update. The notifications are made afterwards,
+	// with the reservations in a consistent state. The scratch buffer is 
+	// taken over, since the notifications might get back here:
+	std::vector<Reservation> deleted;
+	deleted.swap( m_DeletedReservations );
+	deleted.clear();
+	const auto candidates = ReservationCandidates( range );
+	try{
+		deleted.reserve( candidates.second - candidates.first );
+	}
+	catch( const std::bad_alloc& ){
+		// Better keep the reservations than lose track of them:
+		std::cerr << Verbosity::error << "Track_Imp::DeleteReservation: out of memory, reservations not deleted!" << std::endl;
+		return;
+	}
+
+	std::size_t keep = candidates.first;
+	for( std::size_t i = candidates.first; i < candidates.second; ++i ){
+		const Reservation& reservation = m_Reservations[i];
+		if( (forID == anyID || forID == std::get<0>(reservation)) && 
+			Intersecting(std::get<1>(reservation),range) )
 		{
 			//if( (std::get<1>(*iter).Touches( GetLength() ) && !std::get<1>(*iter).Touches( 0_m )) ||
 			//	(std::get<1>(*iter).Touches( 0_m ) && !std::get<1>(*iter).Touches( GetLength() )) )
@@ -628,14 +859,30 @@ void Track_Imp::DeleteReservation( Interval<Length> range, IDType forID ) noexce
 
 
 
-			DeleteConnected( *iter );
-			iter = m_Reservations.erase( iter );
+			deleted.push_back( reservation );
 			continue;
 		}
-		
-		++iter;
+
+		if( keep != i )
+			m_Reservations[keep] = std::move(m_Reservations[i]);
+		++keep;
 	}
 
+	if( !deleted.empty() ){
+		m_Reservations.erase( m_Reservations.begin() + keep, m_Reservations.begin() + candidates.second );
+		UpdateReservationsReach( candidates.first );
+
+		for( const Reservation& reservation : deleted ){
+			if( m_pReservationListener )
+				m_pReservationListener->OnReservationDeleted( *this, std::get<0>(reservation) );
+
+			DeleteConnected( reservation );
+		}
+	}
+
+	if( deleted.capacity() > m_DeletedReservations.capacity() )
+		deleted.swap( m_DeletedReservations );
+
 
 	//if( range.Length() > 0_m )
 	//// On cyclic connected tracks, there might be a coda left at the other
@@ -709,10 +956,13 @@ void Track_Imp::DeleteConnected( const Reservation& reservation ) noexcept
 
 bool Track_Imp::IsReserved( Interval<Length> range, IDType forID ) const noexcept
 {
-	for( const auto& tuple : m_Reservations )
+	const auto candidates = ReservationCandidates( range );
+	for( std::size_t i = candidates.first; i < candidates.second; ++i ){
+		const auto& tuple = m_Reservations[i];
 		if( (forID == anyID || std::get<0>(tuple) == forID) && 
 			Intersecting(std::get<1>(tuple),range) )
 			return true;
+	}
 
 	return false;
 }
@@ -722,31 +972,23 @@ std::vector<Track::Overlap> Track_Imp::Overlaps( IDType withID ) const
 	std::vector<Track::Overlap> overlaps;
 
 	if( !m_LoopBraker ){
-		for( const auto& tuple1 : m_Reservations )
-			if( std::get<0>(tuple1) == withID )
-			{
-				for( const auto& tuple2 : m_Reservations )
-					if( tuple1 != tuple2 &&
-						Intersecting( std::get<1>(tuple1), std::get<1>(tuple2) ) )
-						overlaps.push_back( {	std::get<0>(tuple1),
-												std::get<1>(tuple2).Includes( std::get<1>(tuple1).Near() ),
-												std::get<1>(tuple2).Includes( std::get<1>(tuple1).Far() ),
-												std::get<0>(tuple2),
-												std::get<1>(tuple1).Includes( std::get<1>(tuple2).Near() ),
-												std::get<1>(tuple1).Includes( std::get<1>(tuple2).Far() ) } );
-
-				common::FlagBlocker block{m_LoopBraker};
-
-				if( TrackEnd lastTrack = TransitionEnd( EndType::north ); lastTrack.pTrack ){
-					std::vector<Track::Overlap> overlapsLast = lastTrack.pTrack->Overlaps( withID );
-					overlaps.insert( overlaps.end(), overlapsLast.begin(), overlapsLast.end() );
-				}
+		Overlaps( withID, overlaps );
 
-				if( TrackEnd nextTrack = TransitionEnd( EndType::south ); nextTrack.pTrack ){
-					std::vector<Track::Overlap> overlapsNext = nextTrack.pTrack->Overlaps( withID );
-					overlaps.insert( overlaps.end(), overlapsNext.begin(), overlapsNext.end() );
-				}
+		if( std::find_if( m_Reservations.begin(), m_Reservations.end(), 
+			[withID]( const Reservation& tuple ) noexcept { return std::get<0>(tuple) == withID; } ) != m_Reservations.end() )
+		{
+			common::FlagBlocker block{m_LoopBraker};
+
+			if( TrackEnd lastTrack = TransitionEnd( EndType::north ); lastTrack.pTrack ){
+				std::vector<Track::Overlap> overlapsLast = lastTrack.pTrack->Overlaps( withID );
+				overlaps.insert( overlaps.end(), overlapsLast.begin(), overlapsLast.end() );
+			}
+
+			if( TrackEnd nextTrack = TransitionEnd( EndType::south ); nextTrack.pTrack ){
+				std::vector<Track::Overlap> overlapsNext = nextTrack.pTrack->Overlaps( withID );
+				overlaps.insert( overlaps.end(), overlapsNext.begin(), overlapsNext.end() );
 			}
+		}
 
 		//remove duplicates...
 		std::sort( overlaps.begin(), overlaps.end() );
@@ -756,6 +998,73 @@ std::vector<Track::Overlap> Track_Imp::Overlaps( IDType withID ) const
 	return overlaps;
 }
 
+void Track_Imp::Overlaps( IDType withID, std::vector<Overlap>& overlaps ) const
+{
+	for( const auto& tuple1 : m_Reservations )
+		if( std::get<0>(tuple1) == withID )
+		{
+			const auto candidates = ReservationCandidates( std::get<1>(tuple1) );
+			for( std::size_t i = candidates.first; i < candidates.second; ++i ){
+				const auto& tuple2 = m_Reservations[i];
+				if( tuple1 != tuple2 &&
+					Intersecting( std::get<1>(tuple1), std::get<1>(tuple2) ) )
+					overlaps.push_back( {	std::get<0>(tuple1),
+											std::get<1>(tuple2).Includes( std::get<1>(tuple1).Near() ),
+											std::get<1>(tuple2).Includes( std::get<1>(tuple1).Far() ),
+											std::get<0>(tuple2),
+											std::get<1>(tuple1).Includes( std::get<1>(tuple2).Near() ),
+											std::get<1>(tuple1).Includes( std::get<1>(tuple2).Far() ) } );
+			}
+		}
+}
+
+void Track_Imp::SortReservations(){
+	std::stable_sort( m_Reservations.begin(), m_Reservations.end(), 
+		[]( const Reservation& a, const Reservation& b ) noexcept
+		{
+			return std::get<1>(a).Min() < std::get<1>(b).Min();
+		} );
+
+	UpdateReservationsReach();
+}
+
+void Track_Imp::UpdateReservationsReach( std::size_t from ) noexcept{
+	m_ReservationsReach.resize( m_Reservations.size() );
+	for( std::size_t i = from; i < m_Reservations.size(); ++i )
+		m_ReservationsReach[i] = i > 0 ? 
+			std::max( std::get<1>(m_Reservations[i]).Max(), m_ReservationsReach[i-1] ) : 
+			std::get<1>(m_Reservations[i]).Max();
+}
+
+void Track_Imp::InsertReservation( const Reservation& reservation ){
+	const Length min = std::get<1>(reservation).Min();
+	const Length max = std::get<1>(reservation).Max();
+	const auto iter = std::upper_bound( m_Reservations.begin(), m_Reservations.end(), min,
+		[]( Length min, const Reservation& tuple ) noexcept{ return min < std::get<1>(tuple).Min(); } );
+	const std::size_t idx = iter - m_Reservations.begin();
+
+	m_ReservationsReach.reserve( m_Reservations.size() + 1 );
+	m_Reservations.insert( iter, reservation );
+	m_ReservationsReach.insert( m_ReservationsReach.begin() + idx, idx > 0 ? std::max( max, m_ReservationsReach[idx-1] ) : max );
+
+	// The running maximum only changes until it exceeds max:
+	for( std::size_t i = idx + 1; i < m_ReservationsReach.size() && m_ReservationsReach[i] < max; ++i )
+		m_ReservationsReach[i] = max;
+}
+
+void Track_Imp::EraseReservation( std::size_t idx ) noexcept{
+	m_Reservations.erase( m_Reservations.begin() + idx );
+	UpdateReservationsReach( idx );
+}
+
+std::pair<std::size_t,std::size_t> Track_Imp::ReservationCandidates( const Interval<Length>& range ) const noexcept{
+	const auto candidates = IntersectionCandidates( m_Reservations.begin(), m_Reservations.end(), 
+		m_ReservationsReach.cbegin(), range,
+		[]( const Reservation& tuple ) noexcept{ return std::get<1>(tuple).Min(); } );
+
+	return { static_cast<std::size_t>(candidates.first - m_Reservations.begin()), static_cast<std::size_t>(candidates.second - m_Reservations.begin()) };
+}
+
 void Track_Imp::Connect( 
 	std::pair<std::shared_ptr<TrackBuilder>,EndType> thisEnd, 
 	std::pair<std::shared_ptr<TrackBuilder>,EndType> othersEnd  )
@@ -815,6 +1124,10 @@ void Track_Imp::Connect(
 				CreateEndTransitionSignal( EndType::south );
 		}
 	}
+
+	Touch();
+	if( auto pOther = std::dynamic_pointer_cast<Track_Imp>(othersEnd.first) )
+		pOther->Touch();
 }
 
 void Track_Imp::Disconnect( EndType thisend, bool oneSided ){
@@ -831,6 +1144,9 @@ void Track_Imp::Disconnect( EndType thisend, bool oneSided ){
 
 	if( thisend == EndType::north ){
 		if( m_TrackFront.first ){
+			Touch();
+			m_TrackFront.first->Touch();
+
 			if( !oneSided ){
 				if( m_TrackFront.second == EndType::north && m_TrackFront.first->m_TrackFront.first.get() == this ){
 					m_TrackFront.first->m_TrackFront.first.reset();
@@ -857,6 +1173,9 @@ void Track_Imp::Disconnect( EndType thisend, bool oneSided ){
 	}
 	else if( thisend == EndType::south ){
 		if( m_TrackEnd.first ){
+			Touch();
+			m_TrackEnd.first->Touch();
+
 			if( !oneSided ){
 				if( m_TrackEnd.second == EndType::north && m_TrackEnd.first->m_TrackFront.first.get() == this ){
 					m_TrackEnd.first->m_TrackFront.first.reset();
@@ -903,7 +1222,7 @@ void Track_Imp::Attach( std::shared_ptr<const Curve> pCurve, common::Interval<Le
 		m_CurveSegment.Intersection( m_pCurve->Range() );
 
 	m_pTwist->OnAttach( *this );
-	OnGeometryChanged();
+	NotifyGeometryChanged();
 }
 
 void Track_Imp::Attach( std::pair<std::shared_ptr<const Curve>, common::Interval<Length>> curve ){
@@ -918,7 +1237,7 @@ std::pair<std::shared_ptr<const Curve>,common::Interval<Length>> Track_Imp::Deta
 	auto retval = std::make_pair( m_pCurve, m_CurveSegment );
 	m_pCurve.reset();
 	m_CurveSegment = {-infinite__length,+infinite__length};
-	OnGeometryChanged();
+	NotifyGeometryChanged();
 	return retval;
 }
 
@@ -933,7 +1252,7 @@ void Track_Imp::Attach( std::unique_ptr<RoadwayTwist> pTwist ){
 	m_pTwist->OnDetach();
 	m_pTwist = std::move(pTwist);
 	m_pTwist->OnAttach( *this );
-	OnGeometryChanged();
+	NotifyGeometryChanged();
 }
 
 std::unique_ptr<RoadwayTwist> Track_Imp::DetachTwist(){
@@ -943,7 +1262,7 @@ std::unique_ptr<RoadwayTwist> Track_Imp::DetachTwist(){
 	m_pTwist.reset( new ConstantTwist_Imp );
 
 	m_pTwist->OnAttach( *this );
-	OnGeometryChanged();
+	NotifyGeometryChanged();
 	return retval;
 }
 
@@ -1034,6 +1353,7 @@ void Track_Imp::Attach( std::shared_ptr<Signal> pSignal, const Interval<Length>&
 			throw std::logic_error( "Cannot attach a signal to the same track twice." );
 
 		pair.first.m_Signals.push_back( std::make_pair( Track_Imp::OrientedInterval(pair.second), pSignal ) );
+		pair.first.SortSignals();
 	}
 }
 
@@ -1049,6 +1369,7 @@ void Track_Imp::Attach( std::shared_ptr<Signal> pSignal, const TrackLocation& lo
 			throw std::logic_error( "Cannot attach a signal to the same track twice." );
 
 		pTrack->m_Signals.push_back( std::make_pair( OrientedInterval{loc.Param(),loc.Param(),loc.Orient()}, pSignal ) );
+		pTrack->SortSignals();
 	}
 }
 
@@ -1079,6 +1400,7 @@ void Track_Imp::Detach( const Signal& signal ){
 			for( auto iter2 = pair.first.m_Signals.begin(); iter2 != pair.first.m_Signals.end(); ++iter2 ){
 				if( iter2->second.get() == &signal ){
 					pair.first.m_Signals.erase( iter2 );
+					pair.first.SortSignals();
 					break;
 				}
 			}
@@ -1102,6 +1424,12 @@ void Track_Imp::Flip( bool flipAttached )
 	if( m_TrackEnd.first )
 		(m_TrackEnd.second == EndType::north ? m_TrackEnd.first->m_TrackFront.second : m_TrackEnd.first->m_TrackEnd.second) = EndType::south;
 
+	Touch();
+	if( m_TrackFront.first )
+		m_TrackFront.first->Touch();
+	if( m_TrackEnd.first )
+		m_TrackEnd.first->Touch();
+
 	if( flipAttached ){
 		std::swap( m_pConnectorFront, m_pConnectorEnd );
 		if( m_pConnectorFront ){
@@ -1128,13 +1456,16 @@ void Track_Imp::Flip( bool flipAttached )
 		std::reverse( m_Sensors.begin(), m_Sensors.end() );
 
 		for( auto& pair : m_Signals ){
+			const Orientation orientation = !pair.first.m_Orientation;
 			pair.first = GetLength() - pair.first;
-			pair.first.m_Orientation = !pair.first.m_Orientation;
+			pair.first.m_Orientation = orientation;
 		}
 		std::reverse( m_Signals.begin(), m_Signals.end() );
+		SortSignals();
 
 		for( auto& tuple : m_Reservations )
 			std::get<1>(tuple) = GetLength() - std::get<1>(tuple);
+		SortReservations();
 	}
 	else
 	{
@@ -1295,6 +1626,14 @@ const Jack& Track_Imp::_GetJack( int idx ) const{
 	return *jacks.at(common::narrow_cast<size_t>(idx));
 }
 
+void Track_Imp::NotifyGeometryChanged() noexcept{
+	OnGeometryChanged();
+	Touch();
+
+	if( m_pGeometryListener )
+		m_pGeometryListener->OnGeometryChanged( *this );
+}
+
 void Track_Imp::TestTransition( Length s ) const{
 	if( !m_pCurve )
 		throw std::logic_error( "Tried to parametrize track with no Curve attached" );
@@ -1305,6 +1644,18 @@ void Track_Imp::TestTransition( Length s ) const{
 	}
 }
 
+const std::vector<Length>& Track_Imp::CurveParameters( const Length* sBegin, const Length* sEnd ) const{
+	thread_local std::vector<Length> curveParameters;
+	curveParameters.clear();
+
+	for( ; sBegin != sEnd; ++sBegin ){
+		TestTransition( *sBegin );
+		curveParameters.push_back( c(*sBegin) );
+	}
+
+	return curveParameters;
+}
+
 std::vector<std::pair<Track_Imp&,common::Interval<Length>>> Track_Imp::GetRanges( const common::Interval<Length>& range ){
 	std::vector<std::pair<Track_Imp&,common::Interval<Length>>> list;
 	if( IntersectingClosed( range, Range() ) ){
@@ -1399,11 +1750,15 @@ Track::TrackType TrackType( const char* type ) noexcept{
 		return Track::TrackType::unknown;
 }
 
-static inline Length Calculate_ds( const Track& track, Length s, Length e, bool ignoreCuvesTorsion ){
-	const AnglePerLength sqrtk2t2 = sqrt( pow<2>(track.Curvature(s)) + pow<2>( ignoreCuvesTorsion ? track.GetTwistD1(s) : track.Torsion(s) ) );
+static inline Length Calculate_ds( AnglePerLength k, AnglePerLength t, Length e ) noexcept{
+	const AnglePerLength sqrtk2t2 = sqrt( pow<2>(k) + pow<2>(t) );
 	return (sqrtk2t2 > 0_1Im ? sqrt(e / sqrtk2t2) : +infinite__length);
 }
 
+static inline Length Calculate_ds( const Track& track, Length s, Length e, bool ignoreCuvesTorsion ){
+	return Calculate_ds( track.Curvature(s), ignoreCuvesTorsion ? track.GetTwistD1(s) : track.Torsion(s), e );
+}
+
 Length Segment( const Track& track, Length s, Length e, Interval<Length> segmentLimits, bool ignoreCuvesTorsion ){
 	assert( 0_m <= s && s <= track.GetLength() );
 	assert( 0_m < e );
@@ -1416,10 +1771,7 @@ Length Segment( const Track& track, Length s, Length e, Interval<Length> segment
 	return ds;
 }
 
-static inline Length Calculate_ds( const Track& track, Length s, Length e, Length w, Length h, bool ignoreCuvesTorsion ){
-	const AnglePerLength k = track.Curvature(s);
-	const AnglePerLength t = ignoreCuvesTorsion ? track.GetTwistD1(s) : track.Torsion(s);
-
+static inline Length Calculate_ds( AnglePerLength k, AnglePerLength t, Length e, Length w, Length h ) noexcept{
 	const AnglePerLength sqrtk2t2 = sqrt( pow<2>(k) + pow<2>(t) );
 	return std::min( std::min( 
 					k > 0_1Im ? sqrt(e/k) : +infinite__length,
@@ -1427,6 +1779,10 @@ static inline Length Calculate_ds( const Track& track, Length s, Length e, Lengt
 					fabs(t) > 0_1Im ? ( (h > 0_m) ? e/(h/2*fabs(t)) : sqrt(e/fabs(t)) ) : +infinite__length );
 }
 
+static inline Length Calculate_ds( const Track& track, Length s, Length e, Length w, Length h, bool ignoreCuvesTorsion ){
+	return Calculate_ds( track.Curvature(s), ignoreCuvesTorsion ? track.GetTwistD1(s) : track.Torsion(s), e, w, h );
+}
+
 Length Segment( const Track& track, Length s, Length e, Length w, Length h, common::Interval<Length> segmentLimits, bool ignoreCuvesTorsion ){
 	assert( 0_m <= s && s <= track.GetLength() );
 	assert( 0_m < e );
@@ -1532,6 +1888,192 @@ Length Segment_TotallyChecked(
 	return dsMax;
 }
 
+///////////////////////////////////////
+// Analytic bounds, if known for the whole curve:
+static std::optional<AnglePerLength> CurvatureBound( const Curve& curve, Length s ){
+	switch( curve.GetCurveType() ){
+	case Curve::CurveType::Line:
+	case Curve::CurveType::LineP:
+	case Curve::CurveType::Arc:
+	case Curve::CurveType::ArcP:
+	case Curve::CurveType::Helix:
+	case Curve::CurveType::HelixP:
+		return abs(curve.Curvature( s ));
+	case Curve::CurveType::Rotator:
+	case Curve::CurveType::RotatorWithOffset:
+		if( const Rotator* pRotator = dynamic_cast<const Rotator*>(&curve) )
+			return sqrt( pow<2>(pRotator->GetData().a) + pow<2>(pRotator->GetData().b) );
+		return std::nullopt;
+	default:
+		return std::nullopt;
+	}
+}
+
+static std::optional<AnglePerLength> TorsionBound( const Curve& curve, Length s ){
+	switch( curve.GetCurveType() ){
+	case Curve::CurveType::Line:
+	case Curve::CurveType::LineP:
+	case Curve::CurveType::Arc:
+	case Curve::CurveType::ArcP:
+	case Curve::CurveType::Helix:
+	case Curve::CurveType::HelixP:
+		return abs(curve.Torsion( s ));
+	case Curve::CurveType::Clothoid:
+		return 0_1Im;
+	default:
+		return std::nullopt;
+	}
+}
+
+static bool ConstantD1( const RoadwayTwist& twist ) noexcept{
+	switch( twist.GetTwistType() ){
+	case RoadwayTwist::TwistType::Zero:
+	case RoadwayTwist::TwistType::Constant:
+	case RoadwayTwist::TwistType::Linear:
+		return true;
+	default:
+		return false;
+	}
+}
+
+Segmentation::Segmentation( const Track& track, Length resolution, bool ignoreCuvesTorsion )
+{
+	if( !track.IsValid() )
+		throw std::invalid_argument( "Segmentation: invalid track!" );
+	if( track.GetLength() == +infinite__length )
+		throw std::invalid_argument( "Segmentation: track of infinite length!" );
+	if( resolution <= 0_m )
+		throw std::invalid_argument( "Segmentation: resolution must be > 0_m!" );
+
+	m_Length = track.GetLength();
+
+	std::optional<AnglePerLength> k, t;
+	if( const TrackBuilder* pTrackBuilder = dynamic_cast<const TrackBuilder*>(&track) ){
+		if( const Curve* pCurve = pTrackBuilder->GetCurve().first.get() ){
+			const Length s0 = pTrackBuilder->GetCurve().second.Near();
+			k = CurvatureBound( *pCurve, s0 );
+
+			if( ConstantD1( pTrackBuilder->GetTwist() ) ){
+				const AnglePerLength d1 = abs(track.GetTwistD1( 0_m ));
+				if( ignoreCuvesTorsion )
+					t = d1;
+				else if( const std::optional<AnglePerLength> curveTorsion = TorsionBound( *pCurve, s0 ) )
+					t = *curveTorsion + d1;
+			}
+		}
+	}
+
+	Sample( resolution, 
+		k, [&track]( Length s ){ return track.Curvature( s ); },
+		t, [&track,ignoreCuvesTorsion]( Length s ){ return ignoreCuvesTorsion ? track.GetTwistD1( s ) : track.Torsion( s ); } );
+}
+
+Segmentation::Segmentation( const Curve& curve, common::Interval<Length> range, Length resolution )
+{
+	if( !curve.IsValid() )
+		throw std::invalid_argument( "Segmentation: invalid curve!" );
+	range.Intersection( curve.Range() );
+	range.Normalize();
+	if( range.Length() <= 0_m || range.Length() == +infinite__length )
+		throw std::invalid_argument( "Segmentation: empty or infinite range!" );
+	if( resolution <= 0_m )
+		throw std::invalid_argument( "Segmentation: resolution must be > 0_m!" );
+
+	m_Start = range.Near();
+	m_Length = range.Length();
+
+	Sample( resolution,
+		CurvatureBound( curve, m_Start ), [&curve,this]( Length s ){ return curve.Curvature( m_Start + s ); },
+		TorsionBound( curve, m_Start ), [&curve,this]( Length s ){ return curve.Torsion( m_Start + s ); } );
+}
+
+template<class Curvature, class Torsion>
+void Segmentation::Sample( Length resolution, std::optional<AnglePerLength> k, Curvature curvature, std::optional<AnglePerLength> t, Torsion torsion )
+{
+	m_Cells.clear();
+	if( k && t ){
+		m_Cells.push_back( { 0_m, *k, *t } );
+		return;
+	}
+
+	const int nCells = std::max( 1, static_cast<int>(std::ceil( m_Length / resolution )) );
+	const Length pitch = m_Length / nCells;
+	m_Cells.reserve( nCells );
+
+	AnglePerLength kPrev = k ? *k : abs(curvature( 0_m ));
+	AnglePerLength tPrev = t ? *t : abs(torsion( 0_m ));
+	for( int i = 0; i < nCells; ++i ){
+		const Length s = (i + 1 == nCells) ? m_Length : (i + 1) * pitch;
+		const AnglePerLength kNext = k ? *k : abs(curvature( s ));
+		const AnglePerLength tNext = t ? *t : abs(torsion( s ));
+		m_Cells.push_back( { i * pitch, std::max( kPrev, kNext ), std::max( tPrev, tNext ) } );
+		kPrev = kNext;
+		tPrev = tNext;
+	}
+}
+
+std::pair<AnglePerLength,AnglePerLength> Segmentation::Bounds( common::Interval<Length> range ) const noexcept{
+	range.Normalize();
+	range.Move( -m_Start );
+
+	std::pair<AnglePerLength,AnglePerLength> bounds{ 0_1Im, 0_1Im };
+	auto iter = std::upper_bound( m_Cells.begin(), m_Cells.end(), range.Near(), []( Length s, const Cell& cell ){ return s < cell.s; } );
+	if( iter != m_Cells.begin() )
+		--iter;
+
+	for( ; iter != m_Cells.end() && iter->s <= range.Far(); ++iter ){
+		bounds.first = std::max( bounds.first, iter->k );
+		bounds.second = std::max( bounds.second, iter->t );
+	}
+
+	return bounds;
+}
+
+template<class SegmentFunction>
+std::vector<Length> Segmentation::Segments( common::Interval<Length> segmentLimits, SegmentFunction segment_ds ) const
+{
+	std::vector<Length> parameters;
+	std::size_t cell = 0;
+	for( Length s = 0_m; s < m_Length; ){
+		// Widen the segment while it reaches into the next cell, taking
+		// the bounds of that cell into account:
+		AnglePerLength k = 0_1Im, t = 0_1Im;
+		Length ds;
+		for( std::size_t next = cell; ; ++next ){
+			k = std::max( k, m_Cells[next].k );
+			t = std::max( t, m_Cells[next].t );
+			ds = std::min( segment_ds( k, t ), segmentLimits.Far() );
+			if( next + 1 == m_Cells.size() || s + ds <= m_Cells[next+1].s )
+				break;
+		}
+
+		segmentLimits.Clip( ds );
+		if( s + ds > m_Length )
+			ds = m_Length - s;
+
+		s += ds;
+		parameters.push_back( m_Start + s );
+		while( cell + 1 < m_Cells.size() && m_Cells[cell+1].s <= s )
+			++cell;
+	}
+
+	return parameters;
+}
+
+std::vector<Length> Segmentation::Segments( Length e, common::Interval<Length> segmentLimits ) const{
+	assert( 0_m < e );
+	return Segments( segmentLimits, [e]( AnglePerLength k, AnglePerLength t ) noexcept { 
+		return Calculate_ds( k, t, e ); } );
+}
+
+std::vector<Length> Segmentation::Segments( Length e, Length w, Length h, common::Interval<Length> segmentLimits ) const{
+	assert( 0_m < e );
+	assert( 0_m <= w );
+	assert( 0_m <= h );
+	return Segments( segmentLimits, [e,w,h]( AnglePerLength k, AnglePerLength t ) noexcept { 
+		return Calculate_ds( k, t, e, w, h ); } );
+}
+///////////////////////////////////////
 bool SetFrame( TrackBuilder& track, const spat::Frame<Length, One>& start, Length s ) noexcept{
 	try{
 		track.SetFrame( start, s );
@@ -32,6 +32,9 @@
 #include "trax/TrackLocation.h"
 #include "trax/ImplementationHelper.h"
 
+#include <atomic>
+#include <cstdint>
+
 namespace trax{
 
 	using common::Interval;
@@ -42,6 +45,26 @@ namespace trax{
 
 	typedef Pose_Imp<ObjectID_Imp<TrackBuilder>> TrackBase;
 
+	class Track_Imp;
+
+	/// \brief Gets notified if the track's shape or its position in space changes.
+	struct TrackGeometryListener{
+
+		virtual void OnGeometryChanged( const Track_Imp& track ) noexcept = 0;
+	protected:
+		~TrackGeometryListener() = default;
+	};
+
+	/// \brief Gets notified if a reservation for an id gets added to or removed from a track.
+	struct TrackReservationListener{
+
+		virtual void OnReserved( const Track_Imp& track, IDType forID ) noexcept = 0;
+
+		virtual void OnReservationDeleted( const Track_Imp& track, IDType forID ) noexcept = 0;
+	protected:
+		~TrackReservationListener() = default;
+	};
+
 	class Track_Imp : public TrackBase,
 					  public JackEnumerator,
 					  public PlugEnumerator,
@@ -62,6 +85,55 @@ namespace trax{
 	//	void SetWeakPointerToSelf( std::weak_ptr<Track_Imp> pThis ) noexcept;
 		
 		void AddConnector( Connector* pConnector, EndType atend ) noexcept;
+
+		/// \brief Sets a listener to get notified on changes of curve, twist or frame.
+		///
+		/// There is only one listener per track; the track collection holding
+		/// the track uses it to keep its spatial index up to date.
+		void SetGeometryListener( TrackGeometryListener* pListener ) noexcept;
+
+		TrackGeometryListener* GetGeometryListener() const noexcept;
+
+		/// \brief Sets a listener to get notified on added or deleted reservations.
+		///
+		/// There is only one listener per track; the track collection holding
+		/// the track uses it to index the tracks by reservation ids.
+		void SetReservationListener( TrackReservationListener* pListener ) noexcept;
+
+		TrackReservationListener* GetReservationListener() const noexcept;
+
+		/// \brief Collects the overlaps with reservations for withID on this 
+		/// track only, without looking into connected tracks.
+		void Overlaps( IDType withID, std::vector<Overlap>& overlaps ) const;
+
+		/// \brief Reserves range on this track only, neither merging it with 
+		/// other reservations nor forwarding it to connected tracks.
+		///
+		/// Used by ReservationSpan, that reserves track by track.
+		/// \throws std::range_error if range is not inside the track.
+		void ReserveLocally( Interval<Length> range, IDType forID );
+
+		/// \brief Changes a reservation made by ReserveLocally() to toRange.
+		///
+		/// The reservation gets deleted if toRange has zero length.
+		/// \returns false if there is no reservation for forID with exactly range.
+		/// \throws std::range_error if toRange is not inside the track.
+		bool ChangeReservationLocally( Interval<Length> range, Interval<Length> toRange, IDType forID );
+
+		/// \brief Collects the signals for travelling along range in
+		/// orientation on this track only.
+		///
+		/// \param signals Receives the signals together with their ranges 
+		/// as distances from range.Near() in travel direction. The near 
+		/// distance is 0_m if the signal's range contains range.Near().
+		void Signals( const Interval<Length>& range, Orientation orientation, std::vector<std::pair<Interval<Length>,Signal*>>& signals ) const;
+
+		/// \brief Changes whenever the connections, the geometry or the 
+		/// signals of this track change.
+		std::uint64_t Revision() const noexcept;
+
+		/// \returns The revision most recently given to any track.
+		static std::uint64_t LatestRevision() noexcept;
 		
 		// Pose_Imp:
 		void PropagateAbsoluteFrameToClients() noexcept override;
@@ -152,6 +224,10 @@ namespace trax{
 
 		void Transition	( Length s, spat::Frame<Length,One>& frame ) const override;
 
+		void Transition	( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const override;
+
+		void Transition	( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const override;
+
 		void DoTrigger( const Interval<Length>& range, const Event& _event ) const override;
 
 		bool DoSignal( const Interval<Length>& range, Orientation orientation, SignalTarget& signalTarget ) const override;
@@ -280,13 +356,44 @@ namespace trax{
 			}
 		};
 
-		// Signals operating on this track with their total 
-		// range and orientation relative to this track:
+		// Signals operating on this track with their total
+		// range and orientation relative to this track, in the 
+		// order of attachment:
 		std::vector<std::pair<OrientedInterval,std::shared_ptr<Signal>>> m_Signals;
+		// Indices into m_Signals, grouped by orientation (para, anti, 
+		// none) and sorted by the lower bound of the range within 
+		// each group:
+		std::vector<std::size_t> m_SignalsOrder;
+		// Running maximum of the upper range bounds within each
+		// orientation group of m_SignalsOrder:
+		std::vector<Length> m_SignalsReach;
+
+		void SortSignals();
+
+		// Index range [first,last) into m_SignalsOrder of the signals 
+		// with orientation whose ranges possibly intersect range:
+		std::pair<std::size_t,std::size_t> SignalCandidates( Orientation orientation, const Interval<Length>& range ) const noexcept;
+
 		Connector* m_pConnectorFront;
 		Connector* m_pConnectorEnd;
 
+		// Reservations, sorted by the lower bound of their ranges:
 		std::vector<Reservation> m_Reservations;
+		// Running maximum of the upper bounds of the reservation ranges:
+		std::vector<Length> m_ReservationsReach;
+		// Scratch buffer for DeleteReservation(), kept to not allocate:
+		std::vector<Reservation> m_DeletedReservations;
+
+		void SortReservations();
+		void UpdateReservationsReach( std::size_t from = 0 ) noexcept;
+		// Inserts behind the reservations with the same lower bound:
+		void InsertReservation( const Reservation& reservation );
+		void EraseReservation( std::size_t idx ) noexcept;
+
+		// Index range [first,last) of the reservations whose 
+		// ranges possibly intersect range:
+		std::pair<std::size_t,std::size_t> ReservationCandidates( const Interval<Length>& range ) const noexcept;
+
 		bool m_ReserveLoopBrakerFront = false;
 		bool m_ReserveLoopBrakerEnd = false;
 
@@ -298,6 +405,10 @@ namespace trax{
 		}
 
 		void TestTransition( Length s ) const;
+
+		// Maps the track parameters to curve parameters into a per thread scratch
+		// buffer, that stays valid until the next call on the same thread:
+		const std::vector<Length>& CurveParameters( const Length* sBegin, const Length* sEnd ) const;
 	
 		// Resolves a given range relative to this track into a list of resolved 
 		// track/ranges pairs. It contains all the tracks that the range intersects,
@@ -308,7 +419,17 @@ namespace trax{
 		// Recalculates track parameters with respect to a connected track.
 		Track* Transform( Interval<Length>& range, EndType& toTrackAtEnd ) const noexcept;
 
+		std::uint64_t m_Revision = 0;
+		static std::atomic<std::uint64_t> sm_LatestRevision;
+
+		// Gives the track a new revision:
+		void Touch() noexcept;
+
 		mutable bool m_LoopBraker; // used by iterations along track chains
 		TrackUserData* m_pData = nullptr;
+		TrackGeometryListener* m_pGeometryListener = nullptr;
+		TrackReservationListener* m_pReservationListener = nullptr;
+
+		void NotifyGeometryChanged() noexcept;
 	};
 }
\ No newline at end of file
@@ -104,6 +104,27 @@ void Arc_Imp::Transition( Length s, spat::Frame<Length,One>& frame ) const noexc
 	frame.B = Ez<One>;
 }
 
+void Arc_Imp::Transition( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const noexcept{
+	const Length r = 1 / k;
+	for( ; sBegin != sEnd; ++sBegin, ++pos ){
+		const Angle phi = k * *sBegin;
+		*pos = { r * cos(phi), r * sin(phi), 0_m };
+	}
+}
+
+void Arc_Imp::Transition( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const noexcept{
+	const Length r = 1 / k;
+	for( ; sBegin != sEnd; ++sBegin, ++frame ){
+		const Angle phi = k * *sBegin;
+		const One c = cos(phi);
+		const One sn = sin(phi);
+		frame->P = { r * c, r * sn, 0_m };
+		frame->T = { -sn, c, 0 };
+		frame->N = { -c, -sn, 0 };
+		frame->B = Ez<One>;
+	}
+}
+
 std::vector<Length> Arc_Imp::ZeroSet() const noexcept{
 	return {};
 }
@@ -277,6 +277,18 @@ Interval<Length> Cubic_Imp::Shorten( Interval<Length> toRange ){
 	return Sample();
 }
 
+Interval<Length> Cubic_Imp::HighAccuracyParametrization( bool bHighAccuracy ){
+	return HighAccuracy( bHighAccuracy );
+}
+
+bool Cubic_Imp::HighAccuracyParametrization() const noexcept{
+	return HighAccuracy();
+}
+
+Length Cubic_Imp::ParametrizationError() const{
+	return ArcLengthError();
+}
+
 Length Cubic_Imp::MaxDistance( const Curve& originalCurve, common::Interval<Length> range ) const
 {
 	Length sMax = 0_m;
@@ -880,6 +892,18 @@ common::Interval<Length> Spline_Imp::Shorten( common::Interval<Length> toRange )
 	return Sample();
 }
 
+Interval<Length> Spline_Imp::HighAccuracyParametrization( bool bHighAccuracy ){
+	return HighAccuracy( bHighAccuracy );
+}
+
+bool Spline_Imp::HighAccuracyParametrization() const noexcept{
+	return HighAccuracy();
+}
+
+Length Spline_Imp::ParametrizationError() const{
+	return ArcLengthError();
+}
+
 Length Spline_Imp::Subdivide( 
 	Spline::Data& data,
 	const Curve& originalCurve, 
@@ -114,6 +114,12 @@ namespace trax{
 		std::pair<common::Interval<Length>,Length> Create( const Curve& originalCurve, common::Interval<Length> range, Length maxDeviation = epsilon__length ) override;
 
 		Interval<Length> Shorten( Interval<Length> toRange ) override;
+
+		Interval<Length> HighAccuracyParametrization( bool bHighAccuracy ) override;
+
+		bool HighAccuracyParametrization() const noexcept override;
+
+		Length ParametrizationError() const override;
 	private:
 		Length MaxDistance( const Curve& originalCurve, common::Interval<Length> range ) const;		
 	};
@@ -252,6 +258,12 @@ namespace trax{
 		Interval<Length> CreateBezier( const std::vector<spat::Position<Length>>& controlPoints, WrapTypes wrap = WrapTypes::nonperiodic ) override;
 
 		Interval<Length> Shorten( common::Interval<Length> toRange ) override;
+
+		Interval<Length> HighAccuracyParametrization( bool bHighAccuracy ) override;
+
+		bool HighAccuracyParametrization() const noexcept override;
+
+		Length ParametrizationError() const override;
 	private:
 
 		// \returns The end parameter of the approximisation.
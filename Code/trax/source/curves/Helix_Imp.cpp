@@ -104,6 +104,28 @@ void Helix_Imp::Transition( Length s, spat::Frame<Length,One>& frame ) const noe
 	frame.B = frame.T % frame.N;
 }
 
+void Helix_Imp::Transition( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const noexcept{
+	const One slope = b / sqrta2b2;
+	for( ; sBegin != sEnd; ++sBegin, ++pos ){
+		const Angle phi = *sBegin / sqrta2b2;
+		*pos = { a * cos(phi), a * sin(phi), slope * *sBegin };
+	}
+}
+
+void Helix_Imp::Transition( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const noexcept{
+	const One cosSlope = a / sqrta2b2;
+	const One sinSlope = b / sqrta2b2;
+	for( ; sBegin != sEnd; ++sBegin, ++frame ){
+		const Angle phi = *sBegin / sqrta2b2;
+		const One c = cos(phi);
+		const One sn = sin(phi);
+		frame->P = { a * c, a * sn, sinSlope * *sBegin };
+		frame->T = { -cosSlope * sn, cosSlope * c, sinSlope };
+		frame->N = { -c, -sn, 0 };
+		frame->B = { sinSlope * sn, -sinSlope * c, cosSlope };
+	}
+}
+
 std::vector<Length> Helix_Imp::ZeroSet() const noexcept{
 	return {};
 }
@@ -106,6 +106,20 @@ void Line_Imp::Transition( Length s, spat::Frame<Length,One>& frame ) const noex
 	frame.B = Ez<One>;
 }
 
+void Line_Imp::Transition( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const noexcept{
+	for( ; sBegin != sEnd; ++sBegin, ++pos )
+		*pos = { *sBegin, 0_m, 0_m };
+}
+
+void Line_Imp::Transition( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const noexcept{
+	for( ; sBegin != sEnd; ++sBegin, ++frame ){
+		frame->P = { *sBegin, 0_m, 0_m };
+		frame->T = Ex<One>;
+		frame->N = Ey<One>;
+		frame->B = Ez<One>;
+	}
+}
+
 std::vector<Length> Line_Imp::ZeroSet() const noexcept{
 	return {};
 }
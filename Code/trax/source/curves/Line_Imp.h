@@ -58,6 +58,10 @@ namespace trax{
 
 		void Transition( Length s, spat::Frame<Length,One>& frame ) const noexcept override;
 
+		void Transition( const Length* sBegin, const Length* sEnd, spat::Position<Length>* pos ) const noexcept override;
+
+		void Transition( const Length* sBegin, const Length* sEnd, spat::Frame<Length,One>* frame ) const noexcept override;
+
 		std::vector<Length> ZeroSet() const noexcept override;
 
 		common::Interval<Length> Range() const noexcept override;
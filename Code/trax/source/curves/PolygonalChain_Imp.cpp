@@ -26,6 +26,8 @@
 
 #include "PolygonalChain_Imp.h"
 
+#include "trax/Track.h"
+
 #include "common/NarrowCast.h"
 #include "spat/support/SpatSupportStream.h"
 
@@ -61,16 +63,20 @@ common::Interval<Length> PolygonalChain_Imp::Create(
 		throw std::invalid_argument( "PolygonalChain_Imp::Create: invalid parameter minPointDistance." );
 
 
+	// Segments with a chord deviation of about k*ds*ds/8 <= maxDeviation/8,
+	// so the chain through their ends already keeps maxDeviation:
+	const std::vector<Length> parameters = Segmentation{ originalCurve, range, minPointDistance }.Segments( maxDeviation, { minPointDistance, +infinite__length } );
+
 	m_Data.clear();
-	m_Data.reserve( common::narrow_cast<size_t>(std::ceil( abs(range.Length()) / minPointDistance )) );
+	m_Data.reserve( parameters.size() + 1 );
 
-	common::Sample( range, [ this, &originalCurve, minPointDistance ]( Length s )
-	{
-		spat::Position<Length> pos;
+	spat::Position<Length> pos;
+	originalCurve.Transition( range.Near(), pos );
+	m_Data.push_back( pos );
+	for( const Length s : parameters ){
 		originalCurve.Transition( s, pos );
 		m_Data.push_back( pos );
-		return minPointDistance;
-	} );
+	}
 
 	DouglasPeucker( m_Data, m_Data.begin(), m_Data.end() - 1, maxDeviation, []( Data::iterator i ) -> const spat::Position<Length>& { return *i; } );
 
@@ -0,0 +1,58 @@
+//	trax track library
+//	AD 2013 
+//
+//  "the resolution of all the fruitless searches"
+//
+//								Peter Gabriel
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software 
+// and associated source code (the "Software"), to use, view, and study the 
+// Software for personal or internal business purposes, subject to the following 
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the 
+// Software is NOT permitted without prior written consent from the copyright 
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express 
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+
+#if defined( WITH_BOOST_TESTS )
+#include <boost/test/unit_test.hpp>
+
+#include "common/ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(common_tests)
+
+BOOST_AUTO_TEST_CASE( ThreadPoolTest )
+{
+	common::ThreadPool pool{ 3 };
+	BOOST_CHECK_LE( pool.Workers(), 3u );
+
+	// Every index gets done exactly once, batch after batch:
+	for( std::size_t count : { 0, 1, 7, 1000 } ){
+		std::vector<std::atomic<int>> calls( count );
+		pool.Run( count, [&calls]( std::size_t idx ){ ++calls[idx]; } );
+		for( const std::atomic<int>& call : calls )
+			BOOST_CHECK_EQUAL( call.load(), 1 );
+	}
+
+	std::vector<int> results( 100, 0 );
+	common::ParallelFor( results.size(), 4, [&results]( std::size_t idx ){ results[idx] = static_cast<int>(idx * idx); } );
+	for( std::size_t idx = 0; idx < results.size(); ++idx )
+		BOOST_CHECK_EQUAL( results[idx], static_cast<int>(idx * idx) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() //common_tests
+#endif
@@ -33,6 +33,8 @@
 #include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
 #include "../Test/spat/BoostTestSpatialHelpers.h"
 
+#include <chrono>
+
 using namespace trax;
 using namespace spat;
 
@@ -133,6 +135,39 @@ BOOST_AUTO_TEST_CASE( test_HelixWriteRead )
 	BOOST_CHECK_EQUAL( pHelix->GetData().b, data.b );
 }
 
+BOOST_AUTO_TEST_CASE( batchTransitionEqualsSingleTransition )
+{
+	auto pLine = Line::Make();
+	auto pArc = Arc::Make();
+	pArc->Create( Arc::Data{ 1/50_m } );
+	auto pHelix = Helix::Make();
+	pHelix->Create( Helix::Data{ 30_m, 5_m } );
+	auto pClothoid = Clothoid::Make();
+	pClothoid->Create( trax::Clothoid::Data{} );
+	auto pCubic = Cubic::Make();
+	pCubic->Create( {{0_m,0_m,0_m},{100_m,0_m,0_m}}, {{50_m,50_m,10_m},{0_m,100_m,0_m}} );
+
+	std::vector<Length> parameters;
+	for( int i = 0; i <= 40; ++i )
+		parameters.push_back( i * 1.5_m );
+
+	for( const trax::Curve* pCurve : std::initializer_list<const trax::Curve*>{ pLine.get(), pArc.get(), pHelix.get(), pClothoid.get(), pCubic.get() } ){
+		std::vector<Position<Length>> positions( parameters.size() );
+		std::vector<Frame<Length,One>> frames( parameters.size() );
+		pCurve->Transition( parameters.data(), parameters.data() + parameters.size(), positions.data() );
+		pCurve->Transition( parameters.data(), parameters.data() + parameters.size(), frames.data() );
+
+		for( std::size_t i = 0; i < parameters.size(); ++i ){
+			Position<Length> pos;
+			Frame<Length,One> frame;
+			pCurve->Transition( parameters[i], pos );
+			pCurve->Transition( parameters[i], frame );
+			BOOST_CHECK_CLOSE_SPATIAL( positions[i], pos, epsilon__length );
+			BOOST_CHECK_CLOSE_SPATIAL2( frames[i], frame, epsilon__length, epsilon__angle );
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE(CurveArc)
 
 BOOST_AUTO_TEST_CASE( curveArc_TBN_correctness )
@@ -720,6 +755,64 @@ BOOST_AUTO_TEST_CASE( cubicShortenCompareTangents ){
 	BOOST_CHECK_CLOSE_SPATIAL2( bundleA, bundleB, epsilon__length, epsilon__angle );
 }
 
+BOOST_AUTO_TEST_CASE( cubicHighAccuracyParametrization ){
+	auto pCurve = Cubic::Make();
+	const Length length = pCurve->Create( {{0_m,0_m,0_m},{250_m,0_m,0_m}}, {{50_m,80_m,5_m},{0_m,20_m,0_m}} ).Length();
+	BOOST_CHECK( !pCurve->HighAccuracyParametrization() );
+	const Length linearError = pCurve->ParametrizationError();
+
+	std::vector<Position<Length>> linearPositions;
+	for( Length s = 0_m; s <= length; s += 0.37_m ){
+		Position<Length> pos;
+		pCurve->Transition( s, pos );
+		linearPositions.push_back( pos );
+	}
+
+	pCurve->HighAccuracyParametrization( true );
+	BOOST_CHECK( pCurve->HighAccuracyParametrization() );
+	const Length hermiteError = pCurve->ParametrizationError();
+	BOOST_CHECK_LT( 10 * hermiteError, linearError );
+	BOOST_CHECK_LT( hermiteError, epsilon__length );
+
+	std::size_t i = 0;
+	for( Length s = 0_m; s <= length; s += 0.37_m, ++i ){
+		Position<Length> pos;
+		pCurve->Transition( s, pos );
+		BOOST_CHECK_CLOSE_SPATIAL( pos, linearPositions[i], linearError + epsilon__length );
+	}
+
+	std::unique_ptr<trax::Curve> pClone = pCurve->Clone();
+	BOOST_CHECK( dynamic_cast<Cubic&>(*pClone).HighAccuracyParametrization() );
+
+	pCurve->Create( {{0_m,0_m,0_m},{100_m,0_m,0_m}}, {{50_m,50_m,10_m},{0_m,100_m,0_m}} );
+	BOOST_CHECK( pCurve->HighAccuracyParametrization() );
+	BOOST_CHECK_LT( pCurve->ParametrizationError(), 0.1f * epsilon__length );
+}
+
+BOOST_AUTO_TEST_CASE( cubicParametrizationPerformance ){
+	auto pCurve = Cubic::Make();
+	const Length length = pCurve->Create( {{0_m,0_m,0_m},{250_m,0_m,0_m}}, {{50_m,80_m,5_m},{0_m,20_m,0_m}} ).Length();
+	const int count = 1000000;
+
+	for( bool bHighAccuracy : { false, true } ){
+		pCurve->HighAccuracyParametrization( bHighAccuracy );
+
+		Position<Length> pos, sum = Origin3D<Length>;
+		const auto start = std::chrono::steady_clock::now();
+		for( int i = 0; i < count; ++i ){
+			pCurve->Transition( (i % 1000) * length / 1000, pos );
+			sum.x += pos.x;
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const auto duration = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+		std::cout << "Cubic position evaluations (" << (bHighAccuracy ? "Hermite" : "linear") << " t(s)): ";
+		std::cout << (duration ? count * 1000000ll / duration : 0) << " per second; ";
+		std::cout << "parametrization error: " << _m(pCurve->ParametrizationError()) << "m" << std::endl;
+		BOOST_CHECK_GT( sum.x, 0_m );
+	}
+}
+
 BOOST_AUTO_TEST_CASE( BezierColocatedControlPoints )
 {
 	auto pBezier = Cubic::Make();
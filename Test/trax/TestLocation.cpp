@@ -29,9 +29,15 @@
 
 #include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
 #include "trax/support/Fixtures.h"
+#include "trax/Event.h"
 #include "trax/Location.h"
+#include "trax/LogicElements.h"
+#include "trax/Plug.h"
+#include "trax/Sensor.h"
 #include "trax/support/TraxSupportStream.h"
 
+#include <chrono>
+
 using namespace trax;
 using namespace spat;
 using namespace std;
@@ -369,6 +375,85 @@ BOOST_FIXTURE_TEST_CASE( resolveFromEnd, ThreeTracksInALineFixture )
 
 }
 
+BOOST_AUTO_TEST_CASE( moveOverManyShortTracks )
+// A single long move over many short tracks with alternating orientations 
+// has to end up at the same place and trigger the same sensors as a lot 
+// of small moves.
+{
+	const int nTracks = 1000;
+	const Length trackLength = 3_m;
+	std::vector<std::shared_ptr<TrackBuilder>> tracks;
+	std::vector<std::unique_ptr<PulseCounter>> counters;
+	std::vector<std::shared_ptr<Sensor>> sensors;
+	for( int i = 0; i < nTracks; ++i ){
+		const bool bReversed = i % 3 == 1;
+		tracks.push_back( TrackBuilder::Make() );
+		tracks.back()->Attach( Line::Make(), { 0_m, trackLength } );
+		if( i > 0 ){
+			const bool bPrevReversed = (i-1) % 3 == 1;
+			tracks.back()->Connect( 
+				std::make_pair( tracks.back(), bReversed ? EndType::south : EndType::north ), 
+				std::make_pair( tracks[i-1], bPrevReversed ? EndType::north : EndType::south ) );
+		}
+
+		sensors.push_back( Sensor::Make() );
+		counters.push_back( PulseCounter::Make() );
+		sensors.back()->JackOnTrigger().Insert( &counters.back()->PlugToCountUp() );
+		tracks.back()->Attach( sensors.back(), TrackLocation{ trackLength / 2, !bReversed } );
+	}
+
+	std::unique_ptr<Event> pEvent = Event::Make();
+	const Length distance = nTracks * trackLength - 1_m;
+
+	Location locBulk{ tracks.front(), TrackLocation{ 0.5_m, true } };
+	const auto rest = locBulk.Move( distance, pEvent.get() );
+	BOOST_CHECK_EQUAL( rest.first, 0_m );
+	BOOST_CHECK( rest.second );
+
+	Location locSteps{ tracks.front(), TrackLocation{ 0.5_m, true } };
+	const Length step = 0.7_m;
+	const int nSteps = static_cast<int>(distance / step);
+	for( int i = 0; i < nSteps; ++i )
+		locSteps.Move( step, pEvent.get() );
+	locSteps.Move( distance - nSteps * step, pEvent.get() );
+
+	BOOST_CHECK_EQUAL( locBulk.GetTrack(), tracks.back() );
+	BOOST_CHECK_EQUAL( locSteps.GetTrack(), tracks.back() );
+	BOOST_CHECK_EQUAL( locBulk.Orient(), locSteps.Orient() );
+	BOOST_CHECK_CLOSE_DIMENSION( locBulk.Param(), locSteps.Param(), 0.1 );
+	for( const auto& pCounter : counters )
+		BOOST_CHECK_EQUAL( pCounter->Counter(), 2 );
+
+	const Location start{ tracks.front(), TrackLocation{ 0.5_m, true } };
+	BOOST_CHECK_CLOSE_DIMENSION( start.Distance( locBulk, 10_km ), distance, 0.01 );
+	BOOST_CHECK_CLOSE_DIMENSION( locBulk.Distance( start, -10_km ), -distance, 0.01 );
+	BOOST_CHECK_EQUAL( start.Distance( locBulk, 100_m ), 100_m );
+
+	const int nRounds = 200;
+	const auto startMove = std::chrono::steady_clock::now();
+	for( int round = 0; round < nRounds; ++round ){
+		locBulk.Move( -distance );
+		locBulk.Move( +distance );
+	}
+	const auto endMove = std::chrono::steady_clock::now();
+	BOOST_CHECK_EQUAL( locBulk.GetTrack(), tracks.back() );
+
+	Length sum = 0_m;
+	const auto startDistance = std::chrono::steady_clock::now();
+	for( int round = 0; round < nRounds; ++round )
+		sum += start.Distance( locBulk, 10_km );
+	const auto endDistance = std::chrono::steady_clock::now();
+	BOOST_CHECK_CLOSE_DIMENSION( sum, nRounds * distance, 0.1 );
+
+	std::cout << "Moved " << 2 * nRounds << " times over " << nTracks << " tracks in " 
+		<< std::chrono::duration_cast<std::chrono::microseconds>( endMove - startMove ).count() / 1000 << "ms; measured " 
+		<< nRounds << " distances in " 
+		<< std::chrono::duration_cast<std::chrono::microseconds>( endDistance - startDistance ).count() / 1000 << "ms." << std::endl;
+
+	for( auto& pTrack : tracks )
+		pTrack->Disconnect();
+}
+
 BOOST_AUTO_TEST_SUITE_END() //Location_tests
 BOOST_AUTO_TEST_SUITE_END() //trax_tests
 #endif
\ No newline at end of file
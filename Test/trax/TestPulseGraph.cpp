@@ -0,0 +1,232 @@
+//	trax track library
+//	AD 2026
+//
+//  "Good vibrations"
+//
+//				The Beach Boys
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#if defined( WITH_BOOST_TESTS )
+#include <boost/test/unit_test.hpp>
+
+#include "trax/Jack.h"
+#include "trax/LogicElements.h"
+#include "trax/Plug.h"
+#include "trax/Signal.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace trax;
+
+struct PulseCounterTreeFixture{
+	// A source counter that fans out to m_Counters, each of which
+	// fans out to the following ones in the vector.
+	PulseCounterTreeFixture( int countCounters = 10, int fanOut = 3 )
+		: m_pSource{ PulseCounter::Make() }
+	{
+		for( int i = 0; i < countCounters; ++i )
+			m_Counters.push_back( PulseCounter::Make() );
+
+		for( int i = 0; i < fanOut && i < countCounters; ++i )
+			m_pSource->JackOnCountUp().InsertAtTail( &m_Counters[i]->PlugToCountUp().Make() );
+
+		for( int i = 0; i < countCounters; ++i )
+			for( int j = fanOut * (i+1); j < fanOut * (i+2) && j < countCounters; ++j )
+				m_Counters[i]->JackOnCountUp().InsertAtTail( &m_Counters[j]->PlugToCountUp().Make() );
+	}
+
+	std::vector<Jack*> Jacks() const{
+		std::vector<Jack*> jacks;
+		for( Jack& jack : dynamic_cast<JackEnumerator&>(*m_pSource) )
+			jacks.push_back( &jack );
+		for( const auto& pCounter : m_Counters )
+			for( Jack& jack : dynamic_cast<JackEnumerator&>(*pCounter) )
+				jacks.push_back( &jack );
+		return jacks;
+	}
+
+	std::vector<int> Counts() const{
+		std::vector<int> counts;
+		for( const auto& pCounter : m_Counters )
+			counts.push_back( pCounter->Counter() );
+		return counts;
+	}
+
+	std::unique_ptr<PulseCounter> m_pSource;
+	std::vector<std::unique_ptr<PulseCounter>> m_Counters;
+};
+
+BOOST_AUTO_TEST_SUITE(trax_tests)
+BOOST_AUTO_TEST_SUITE(PulseGraph_tests)
+
+BOOST_FIXTURE_TEST_CASE( compiledFanOutMatchesRecursive, PulseCounterTreeFixture )
+{
+	m_pSource->CountUp();
+	const std::vector<int> recursive = Counts();
+	BOOST_CHECK( std::all_of( recursive.begin(), recursive.end(), []( int count ){ return count == 1; } ) );
+
+	PulseGraph graph;
+	graph.Compile( Jacks() );
+	BOOST_REQUIRE( graph.IsValid() );
+	BOOST_CHECK_EQUAL( graph.CountNodes(), 4 * 11 );
+	BOOST_CHECK_EQUAL( graph.CountTargets(), 10 );
+
+	m_pSource->CountUp();
+	const std::vector<int> compiled = Counts();
+	BOOST_CHECK( std::all_of( compiled.begin(), compiled.end(), []( int count ){ return count == 2; } ) );
+}
+
+BOOST_AUTO_TEST_CASE( compiledCycleTerminates )
+{
+	std::unique_ptr<PulseCounter> pA = PulseCounter::Make();
+	std::unique_ptr<PulseCounter> pB = PulseCounter::Make();
+	pA->JackOnCountUp().Insert( &pB->PlugToCountUp() );
+	pB->JackOnCountUp().Insert( &pA->PlugToCountUp() );
+
+	pA->CountUp();
+	BOOST_CHECK_EQUAL( pA->Counter(), 2 );
+	BOOST_CHECK_EQUAL( pB->Counter(), 1 );
+
+	PulseGraph graph;
+	graph.Compile( { &pA->JackOnCountUp(), &pB->JackOnCountUp() } );
+	BOOST_REQUIRE( graph.IsValid() );
+
+	pA->CountUp();
+	BOOST_CHECK_EQUAL( pA->Counter(), 4 );
+	BOOST_CHECK_EQUAL( pB->Counter(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( compiledFanInMatchesRecursive )
+{
+	// Diamond: A -> B, C -> D -> E
+	std::unique_ptr<PulseCounter> pA = PulseCounter::Make(), pB = PulseCounter::Make(), pC = PulseCounter::Make(), pD = PulseCounter::Make(), pE = PulseCounter::Make();
+	pA->JackOnCountUp().InsertAtTail( &pB->PlugToCountUp().Make() );
+	pA->JackOnCountUp().InsertAtTail( &pC->PlugToCountUp().Make() );
+	pB->JackOnCountUp().Insert( &pD->PlugToCountUp().Make() );
+	pC->JackOnCountUp().Insert( &pD->PlugToCountUp().Make() );
+	pD->JackOnCountUp().Insert( &pE->PlugToCountUp() );
+
+	pA->CountUp();
+	BOOST_CHECK_EQUAL( pD->Counter(), 2 );
+	BOOST_CHECK_EQUAL( pE->Counter(), 2 );
+
+	PulseGraph graph;
+	graph.Compile( { &pA->JackOnCountUp(), &pB->JackOnCountUp(), &pC->JackOnCountUp(), &pD->JackOnCountUp() } );
+	pA->CountUp();
+	BOOST_CHECK_EQUAL( pD->Counter(), 4 );
+	BOOST_CHECK_EQUAL( pE->Counter(), 4 );	// D's jack pulses once per incoming pulse.
+}
+
+BOOST_AUTO_TEST_CASE( compiledChainKeepsPlugOrder )
+{
+	// The toggle plug forwards the pulse before it toggles the signal, so 
+	// D gets counted up before the signal's change resets it:
+	std::unique_ptr<PulseCounter> pS = PulseCounter::Make(), pC = PulseCounter::Make(), pD = PulseCounter::Make();
+	std::unique_ptr<VelocityControl> pSignal = VelocityControl::Make();
+	pSignal->SetVelocity( Signal::Status::stop, 0_kmIh, 0_kmIh );
+	pSignal->SetVelocity( Signal::Status::clear, 0_kmIh, 100_kmIh );
+	pSignal->Set( Signal::Status::stop, false );
+	pS->JackOnCountUp().InsertAtTail( &pSignal->PlugToToggle() );
+	pS->JackOnCountUp().InsertAtTail( &pC->PlugToCountUp().Make() );
+	pC->JackOnCountUp().Insert( &pD->PlugToCountUp().Make() );
+	pSignal->JackOnChange().Insert( &pD->PlugToReset().Make() );
+
+	pS->CountUp();
+	BOOST_CHECK_EQUAL( pC->Counter(), 1 );
+	BOOST_CHECK_EQUAL( pD->Counter(), 0 );
+
+	PulseGraph graph;
+	graph.Compile( { &pS->JackOnCountUp(), &pC->JackOnCountUp(), &pSignal->JackOnChange() } );
+	BOOST_REQUIRE( graph.IsValid() );
+
+	pS->CountUp();
+	BOOST_CHECK_EQUAL( pC->Counter(), 2 );
+	BOOST_CHECK_EQUAL( pD->Counter(), 0 );
+}
+
+BOOST_FIXTURE_TEST_CASE( rewiringInvalidatesGraph, PulseCounterTreeFixture )
+{
+	PulseGraph graph;
+	graph.Compile( Jacks() );
+	BOOST_REQUIRE( graph.IsValid() );
+
+	std::unique_ptr<PulseCounter> pCounter = PulseCounter::Make();
+	m_Counters.back()->JackOnCountUp().InsertAtTail( &pCounter->PlugToCountUp().Make() );
+	BOOST_CHECK( !graph.IsValid() );
+	BOOST_CHECK_EQUAL( graph.CountNodes(), 0 );
+
+	m_pSource->CountUp();
+	BOOST_CHECK_EQUAL( pCounter->Counter(), 1 );
+
+	graph.Compile( Jacks() );
+	BOOST_REQUIRE( graph.IsValid() );
+	m_pSource->CountUp();
+	BOOST_CHECK_EQUAL( pCounter->Counter(), 2 );
+
+	// Destroying a plug changes the wiring too:
+	m_Counters.pop_back();
+	BOOST_CHECK( !graph.IsValid() );
+	m_pSource->CountUp();
+	BOOST_CHECK_EQUAL( pCounter->Counter(), 2 );
+	BOOST_CHECK_EQUAL( m_Counters.front()->Counter(), 3 );
+
+	PulseGraph other;
+	graph.Compile( Jacks() );
+	other.Compile( { &m_pSource->JackOnCountUp() } );
+	BOOST_CHECK( !graph.IsValid() );
+	BOOST_CHECK( other.IsValid() );
+	BOOST_CHECK_EQUAL( other.CountNodes(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( pulseGraphPerformance )
+{
+	PulseCounterTreeFixture tree{ 1000, 4 };
+	const int nPulses = 1000;
+
+	const auto startRecursive = std::chrono::steady_clock::now();
+	for( int i = 0; i < nPulses; ++i )
+		tree.m_pSource->CountUp();
+	const auto endRecursive = std::chrono::steady_clock::now();
+	const std::vector<int> recursive = tree.Counts();
+
+	PulseGraph graph;
+	graph.Compile( tree.Jacks() );
+	BOOST_REQUIRE( graph.IsValid() );
+
+	const auto startCompiled = std::chrono::steady_clock::now();
+	for( int i = 0; i < nPulses; ++i )
+		tree.m_pSource->CountUp();
+	const auto endCompiled = std::chrono::steady_clock::now();
+	const std::vector<int> compiled = tree.Counts();
+
+	for( std::size_t i = 0; i < compiled.size(); ++i )
+		BOOST_CHECK_EQUAL( compiled[i], 2 * recursive[i] );
+
+	std::cout << "Delivered " << nPulses << " pulses to " << tree.m_Counters.size() << " counters recursively in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>( endRecursive - startRecursive ).count() / 1000 << "ms, with PulseGraph in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>( endCompiled - startCompiled ).count() / 1000 << "ms." << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END() //PulseGraph_tests
+BOOST_AUTO_TEST_SUITE_END() //trax_tests
+
+#endif // WITH_BOOST_TESTS
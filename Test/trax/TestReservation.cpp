@@ -28,8 +28,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include "trax/support/Fixtures.h"
+#include "trax/collections/TrackCollection.h"
+#include "trax/ReservationSpan.h"
 #include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
 
+#include <chrono>
+#include <random>
+
 namespace reservation_tests{
 
 using namespace common;
@@ -229,6 +234,27 @@ BOOST_FIXTURE_TEST_CASE( reserveOverlapping, TrackFixture ){
 	BOOST_CHECK( overlaps[1].withFar );
 }
 
+BOOST_FIXTURE_TEST_CASE( deleteSeveralOverlapping, TrackFixture ){
+	// short and long reservations, so that the running maximum of 
+	// the range ends matters:
+	for( int i = 0; i < 70; ++i )
+		m_pTrack->Reserve( { 1_m * i, 1_m * i + (i % 7 ? 5_m : 10_m) }, i + 1 );
+
+	m_pTrack->DeleteReservation( { 30_m, 40_m } );
+
+	std::vector<Track::Reservation> left{ m_pTrack->BeginReservations(), m_pTrack->EndReservations() };
+	BOOST_CHECK( std::is_sorted( left.begin(), left.end(),
+		[]( const Track::Reservation& a, const Track::Reservation& b ){ return std::get<1>(a).Min() < std::get<1>(b).Min(); } ) );
+	for( int i = 0; i < 70; ++i ){
+		const Interval<Length> range{ 1_m * i, 1_m * i + (i % 7 ? 5_m : 10_m) };
+		const bool bDeleted = Intersecting( range, Interval<Length>{ 30_m, 40_m } );
+		BOOST_CHECK_EQUAL( m_pTrack->IsReserved( { range.Center(), range.Center() }, i + 1 ), !bDeleted );
+	}
+
+	m_pTrack->DeleteReservation( m_pTrack->Range() );
+	BOOST_CHECK( m_pTrack->BeginReservations() == m_pTrack->EndReservations() );
+}
+
 BOOST_FIXTURE_TEST_CASE( reserveOverlapOnConnectedTrack, TrackCircle )
 // reservations overlapping on track 1, but we ask at track 2 for the overlapping.
 {
@@ -385,6 +411,277 @@ BOOST_FIXTURE_TEST_CASE( deleteReservationViaLocation, TrackCircle ){
 	BOOST_CHECK( !m_pTrack4->IsReserved( {0_m,m_pTrack4->GetLength()}, 1) );
 }
 
+BOOST_AUTO_TEST_CASE( reservationStressTest )
+// thousands of reservations on a long line of connected tracks, indexed by the collection.
+{
+	const int nTracks = 200;
+	const int nIDs = 2000;
+	const Length trackLength = 100_m;
+
+	std::shared_ptr<TrackCollection> pCollection = TrackCollection::Make();
+	std::shared_ptr<Line> pLine = Line::Make();
+	std::vector<std::shared_ptr<TrackBuilder>> tracks;
+	Frame<Length,One> frame = Identity<Length,One>;
+	for( int i = 0; i < nTracks; ++i ){
+		tracks.push_back( TrackBuilder::Make() );
+		tracks.back()->Attach( pLine, { 0_m, trackLength } );
+		tracks.back()->SetFrame( frame );
+		frame.TransportTan( trackLength );
+		pCollection->Add( tracks.back() );
+
+		if( i > 0 )
+			tracks[i-1]->Connect( std::make_pair( tracks[i-1], EndType::south ), std::make_pair( tracks[i], EndType::north ) );
+	}
+
+	std::mt19937 generator{ 42 };
+	std::uniform_int_distribution<int> trackDistribution{ 0, nTracks - 1 };
+	std::uniform_real_distribution<Real> parameterDistribution{ 0, 1 };
+
+	const auto startReserve = std::chrono::steady_clock::now();
+	for( int id = 1; id <= nIDs; ++id ){
+		const Length near = parameterDistribution( generator ) * trackLength;
+		const Length length = (5 + 145 * parameterDistribution( generator )) * 1_m;
+		tracks[trackDistribution( generator )]->Reserve( { near, near + (id % 2 ? +length : -length) }, id );
+	}
+	const auto endReserve = std::chrono::steady_clock::now();
+
+	// brute force over all the reservations on all the tracks:
+	auto expectedOverlaps = [&tracks]( IDType forID ){
+		std::vector<Track::Overlap> overlaps;
+		for( const auto& pTrack : tracks )
+			for( auto iter1 = pTrack->BeginReservations(); iter1 != pTrack->EndReservations(); ++iter1 )
+				if( std::get<0>(*iter1) == forID )
+					for( auto iter2 = pTrack->BeginReservations(); iter2 != pTrack->EndReservations(); ++iter2 )
+						if( *iter1 != *iter2 && Intersecting( std::get<1>(*iter1), std::get<1>(*iter2) ) )
+							overlaps.push_back( {	std::get<0>(*iter1),
+													std::get<1>(*iter2).Includes( std::get<1>(*iter1).Near() ),
+													std::get<1>(*iter2).Includes( std::get<1>(*iter1).Far() ),
+													std::get<0>(*iter2),
+													std::get<1>(*iter1).Includes( std::get<1>(*iter2).Near() ),
+													std::get<1>(*iter1).Includes( std::get<1>(*iter2).Far() ) } );
+
+		std::sort( overlaps.begin(), overlaps.end() );
+		overlaps.erase( std::unique( overlaps.begin(), overlaps.end() ), overlaps.end() );
+		return overlaps;
+	};
+
+	const auto startOverlaps = std::chrono::steady_clock::now();
+	std::size_t nOverlaps = 0;
+	for( int id = 1; id <= nIDs; ++id )
+		nOverlaps += Overlaps( *pCollection, id ).size();
+	const auto endOverlaps = std::chrono::steady_clock::now();
+
+	BOOST_CHECK_GT( nOverlaps, 0u );
+	for( int id = 1; id <= nIDs; id += 97 )
+		BOOST_CHECK( Overlaps( *pCollection, id ) == expectedOverlaps( id ) );
+
+	for( int probe = 0; probe < 1000; ++probe ){
+		const auto& pTrack = tracks[trackDistribution( generator )];
+		const Interval<Length> range{ parameterDistribution( generator ) * trackLength, parameterDistribution( generator ) * trackLength };
+		const IDType id = 1 + trackDistribution( generator ) * nIDs / nTracks;
+
+		bool bExpected = false;
+		for( auto iter = pTrack->BeginReservations(); iter != pTrack->EndReservations(); ++iter )
+			if( std::get<0>(*iter) == id && Intersecting( std::get<1>(*iter), range ) )
+				bExpected = true;
+
+		BOOST_CHECK_EQUAL( pTrack->IsReserved( range, id ), bExpected );
+	}
+
+	const auto startDelete = std::chrono::steady_clock::now();
+	for( int id = 2; id <= nIDs; id += 2 )
+		DeleteReservations( *pCollection, id );
+	const auto endDelete = std::chrono::steady_clock::now();
+
+	int nReservations = 0;
+	for( const auto& pTrack : tracks )
+		for( auto iter = pTrack->BeginReservations(); iter != pTrack->EndReservations(); ++iter ){
+			BOOST_CHECK( std::get<0>(*iter) % 2 == 1 );
+			++nReservations;
+		}
+	BOOST_CHECK_GE( nReservations, nIDs / 2 );
+
+	for( int id = 1; id <= nIDs; id += 2 )
+		DeleteReservations( *pCollection, id );
+	for( const auto& pTrack : tracks )
+		BOOST_CHECK( pTrack->BeginReservations() == pTrack->EndReservations() );
+
+	using namespace std::chrono;
+	std::cout << nIDs << " reservations on " << nTracks << " tracks: reserve " << duration_cast<milliseconds>( endReserve - startReserve ).count() << "ms; ";
+	std::cout << "overlaps (" << nOverlaps << ") " << duration_cast<milliseconds>( endOverlaps - startOverlaps ).count() << "ms; ";
+	std::cout << "delete half of them " << duration_cast<milliseconds>( endDelete - startDelete ).count() << "ms." << std::endl;
+
+	for( const auto& pTrack : tracks )
+		pTrack->Disconnect();
+}
+
+BOOST_AUTO_TEST_CASE( reservationSpanFollowsLocation )
+// a span changes only the pieces at head and tail and leaves no leftovers.
+{
+	std::vector<std::shared_ptr<TrackBuilder>> tracks;
+	for( int i = 0; i < 4; ++i ){
+		tracks.push_back( TrackBuilder::Make() );
+		tracks.back()->Attach( Line::Make(), { 0_m, 100_m } );
+		if( i > 0 ) // the third track the other way round
+			tracks[i-1]->Connect( std::make_pair( tracks[i-1], i == 3 ? EndType::north : EndType::south ), std::make_pair( tracks[i], i == 2 ? EndType::south : EndType::north ) );
+	}
+
+	auto CountReservations = []( const Track& track ){
+		return std::distance( track.BeginReservations(), track.EndReservations() );
+	};
+
+	Location location{ tracks[1], TrackLocation{ 50_m, Orientation::Value::para } };
+	{
+		ReservationSpan span;
+		BOOST_CHECK( span.Reserve( location, { -70_m, 30_m }, 7 ) );
+		BOOST_CHECK_EQUAL( span.ID(), IDType{7} );
+		BOOST_REQUIRE_EQUAL( span.CountPieces(), 2u );
+		BOOST_CHECK( span.GetPiece( 0 ).pTrack == tracks[0] );
+		BOOST_CHECK( span.GetPiece( 0 ).range == (Interval<Length>{ 80_m, 100_m }) );
+		BOOST_CHECK( span.GetPiece( 1 ).range == (Interval<Length>{ 0_m, 80_m }) );
+		BOOST_CHECK_CLOSE_DIMENSION( span.GetLength(), 100_m, 0.01 );
+		BOOST_CHECK( tracks[0]->IsReserved( { 90_m, 90_m }, 7 ) );
+		BOOST_CHECK( !tracks[0]->IsReserved( { 70_m, 70_m }, 7 ) );
+
+		std::vector<const Track*> collected;
+		span.CollectTracks( location, { -70_m, 30_m }, 7, collected );
+		BOOST_CHECK( collected.empty() );
+		BOOST_CHECK( !span.Reserve( location, { -70_m, 30_m }, 7 ) );
+
+		location.Move( 60_m );
+		auto Collected = [&collected]( const std::shared_ptr<TrackBuilder>& pTrack ){
+			return std::find( collected.begin(), collected.end(), pTrack.get() ) != collected.end();
+		};
+		span.CollectTracks( location, { -70_m, 30_m }, 7, collected );
+		BOOST_CHECK( Collected( tracks[0] ) );
+		BOOST_CHECK( Collected( tracks[1] ) );
+		BOOST_CHECK( Collected( tracks[2] ) );
+		BOOST_CHECK( !Collected( tracks[3] ) );
+		BOOST_CHECK( span.Reserve( location, { -70_m, 30_m }, 7 ) );
+		BOOST_REQUIRE_EQUAL( span.CountPieces(), 2u );
+		BOOST_CHECK( span.GetPiece( 1 ).pTrack == tracks[2] );
+		BOOST_CHECK( span.GetPiece( 0 ).range == (Interval<Length>{ 40_m, 100_m }) );
+		BOOST_CHECK( span.GetPiece( 1 ).range == (Interval<Length>{ 100_m, 60_m }) );
+		BOOST_CHECK_EQUAL( CountReservations( *tracks[0] ), 0 );
+		BOOST_CHECK_EQUAL( CountReservations( *tracks[1] ), 1 );
+		BOOST_CHECK_EQUAL( CountReservations( *tracks[2] ), 1 );
+		BOOST_CHECK( tracks[1]->IsReserved( { 50_m, 50_m }, 7 ) );
+		BOOST_CHECK( !tracks[1]->IsReserved( { 30_m, 30_m }, 7 ) );
+
+		location.Move( 1000_m );
+		BOOST_CHECK( span.Reserve( location, { -70_m, 30_m }, 7 ) );
+		BOOST_REQUIRE_EQUAL( span.CountPieces(), 1u );
+		BOOST_CHECK( span.GetPiece( 0 ).pTrack == tracks[3] );
+		BOOST_CHECK_CLOSE_DIMENSION( span.GetLength(), 70_m, 0.01 );
+
+		location.Move( -120_m );
+		BOOST_CHECK( span.Reserve( location, { -70_m, 30_m }, 7 ) );
+		BOOST_CHECK_EQUAL( span.CountPieces(), 2u );
+		BOOST_CHECK_EQUAL( CountReservations( *tracks[1] ), 0 );
+		BOOST_CHECK_EQUAL( CountReservations( *tracks[2] ), 1 );
+		BOOST_CHECK_EQUAL( CountReservations( *tracks[3] ), 1 );
+
+		BOOST_CHECK( span.Reserve( location, { -70_m, 30_m }, 9 ) );
+		BOOST_CHECK( !tracks[2]->IsReserved( { 0_m, 100_m }, 7 ) );
+		BOOST_CHECK( tracks[2]->IsReserved( { 0_m, 100_m }, 9 ) );
+	}
+
+	for( const auto& pTrack : tracks ){
+		BOOST_CHECK_EQUAL( CountReservations( *pTrack ), 0 );
+		pTrack->Disconnect();
+	}
+}
+
+BOOST_AUTO_TEST_CASE( reservationsForManyTrains )
+// a few hundred trains, most of them standing; compare reserving anew every step
+// with updating a span.
+{
+	const int nTracks = 1000;
+	const int nTrains = 300;
+	const int nSteps = 200;
+	const Length trackLength = 100_m;
+	const Interval<Length> trainRange{ -150_m, 200_m }; // train and look-ahead
+
+	std::vector<std::shared_ptr<TrackBuilder>> tracks;
+	for( int i = 0; i < nTracks; ++i ){
+		tracks.push_back( TrackBuilder::Make() );
+		tracks.back()->Attach( Line::Make(), { 0_m, trackLength } );
+		if( i > 0 )
+			tracks[i-1]->Connect( std::make_pair( tracks[i-1], EndType::south ), std::make_pair( tracks[i], EndType::north ) );
+	}
+
+	// every tenth train is moving:
+	auto Locations = [&](){
+		std::vector<Location> locations;
+		for( int i = 0; i < nTrains; ++i )
+			locations.push_back( Location{ tracks[3 * i + 2], TrackLocation{ 50_m, Orientation::Value::para } } );
+		return locations;
+	};
+	const Length step = 1_m;
+
+	std::vector<Location> locations = Locations();
+	const auto startAnew = std::chrono::steady_clock::now();
+	for( int s = 0; s < nSteps; ++s ){
+		for( int i = 0; i < nTrains; ++i ){
+			locations[i].DeleteReservation( i + 1 );
+			if( i % 10 == 0 )
+				locations[i].Move( step );
+			locations[i].Reserve( trainRange, i + 1 );
+		}
+	}
+	const auto endAnew = std::chrono::steady_clock::now();
+
+	std::vector<std::size_t> expected( nTracks );
+	for( int t = 0; t < nTracks; ++t )
+		expected[t] = std::distance( tracks[t]->BeginReservations(), tracks[t]->EndReservations() );
+	for( int i = 0; i < nTrains; ++i )
+		locations[i].DeleteReservation( i + 1 );
+
+	locations = Locations();
+	std::vector<std::unique_ptr<ReservationSpan>> spans;
+	for( int i = 0; i < nTrains; ++i )
+		spans.push_back( std::make_unique<ReservationSpan>() );
+
+	int nChanged = 0;
+	const auto startSpan = std::chrono::steady_clock::now();
+	for( int s = 0; s < nSteps; ++s ){
+		for( int i = 0; i < nTrains; ++i ){
+			if( i % 10 == 0 )
+				locations[i].Move( step );
+			if( spans[i]->Reserve( locations[i], trainRange, i + 1 ) )
+				++nChanged;
+		}
+	}
+	const auto endSpan = std::chrono::steady_clock::now();
+
+	BOOST_CHECK_EQUAL( nChanged, nTrains + (nSteps - 1) * nTrains / 10 );
+	for( int i = 0; i < nTrains; ++i ){
+		BOOST_CHECK( locations[i].GetTrack()->IsReserved( { locations[i].Param(), locations[i].Param() }, i + 1 ) );
+		BOOST_CHECK_CLOSE_DIMENSION( spans[i]->GetLength(), trainRange.Length(), 0.01 );
+	}
+
+	// A span has at most one piece per track, like the single forwarded reservation:
+	for( int t = 0; t < nTracks; ++t ){
+		BOOST_CHECK_EQUAL( static_cast<std::size_t>(std::distance( tracks[t]->BeginReservations(), tracks[t]->EndReservations() )), expected[t] );
+		BOOST_CHECK( std::is_sorted( tracks[t]->BeginReservations(), tracks[t]->EndReservations(),
+			[]( const Track::Reservation& a, const Track::Reservation& b ){ return std::get<1>(a).Min() < std::get<1>(b).Min(); } ) );
+		for( auto iter = tracks[t]->BeginReservations(); iter != tracks[t]->EndReservations(); ++iter )
+			BOOST_CHECK( tracks[t]->IsReserved( std::get<1>(*iter), std::get<0>(*iter) ) );
+	}
+
+	spans.clear();
+	for( const auto& pTrack : tracks )
+		BOOST_CHECK( pTrack->BeginReservations() == pTrack->EndReservations() );
+
+	using namespace std::chrono;
+	std::cout << nTrains << " trains, every tenth moving, for " << nSteps << " steps: reserving anew " 
+		<< duration_cast<microseconds>( endAnew - startAnew ).count() / 1000 << "ms; with ReservationSpan "
+		<< duration_cast<microseconds>( endSpan - startSpan ).count() / 1000 << "ms." << std::endl;
+
+	for( const auto& pTrack : tracks )
+		pTrack->Disconnect();
+}
+
 BOOST_AUTO_TEST_SUITE_END() //Reservation_tests
 
 }
@@ -25,6 +25,9 @@
 #include "trax/support/TraxSupportStream.h"
 #include "trax/support/Fixtures.h"
 
+#include <chrono>
+#include <stdexcept>
+
 using namespace trax;
 using namespace spat;
 using namespace std;
@@ -75,6 +78,108 @@ BOOST_FIXTURE_TEST_CASE( trigger_test1, SensorFixture )
 	BOOST_CHECK_EQUAL( m_pPulseCounter->Counter(), 2 );
 }
 
+BOOST_FIXTURE_TEST_CASE( trigger_deferred_by_pulsequeue, SensorFixture )
+	// while a PulseQueue is active, the pulses arrive on Commit()
+{
+	m_pTrack1->Attach( m_pSensor, TrackLocation( m_pTrack1->GetLength() / 2, true ) );
+	m_Location.PutOn( m_pTrack1 , TrackLocation( m_pTrack1->GetLength() / 4, true ) );
+
+	PulseQueue queue;
+	{
+		PulseQueue::Scope scope{ &queue };
+		BOOST_CHECK_EQUAL( PulseQueue::Active(), &queue );
+
+		m_Location.MoveToEnd( Orientation::Value::para, m_pEvent.get() );
+		m_Location.MoveToEnd( Orientation::Value::anti, m_pEvent.get() );
+		m_Location.MoveToEnd( Orientation::Value::para, m_pEvent.get() );
+		BOOST_CHECK_EQUAL( m_pPulseCounter->Counter(), 0 );
+		BOOST_CHECK( !queue.Empty() );
+	}
+	BOOST_CHECK( PulseQueue::Active() == nullptr );
+
+	queue.Commit();
+	BOOST_CHECK_EQUAL( m_pPulseCounter->Counter(), 2 );
+	BOOST_CHECK( queue.Empty() );
+}
+
+BOOST_FIXTURE_TEST_CASE( pulsequeue_append_and_statistics, SensorFixture )
+	// queues filled separately get delivered in the order they were appended
+{
+	std::unique_ptr<PulseCounter> pPulseCounter2 = PulseCounter::Make();
+	m_pPulseCounter->Threshold( 1 );
+	m_pPulseCounter->JackOnReachThreshold().Insert( &pPulseCounter2->PlugToReset() );
+
+	PulseQueue queue1, queue2;
+	{
+		PulseQueue::Scope scope{ &queue1 };
+		m_pPulseCounter->CountUp();
+	}
+	{
+		PulseQueue::Scope scope{ &queue2 };
+		pPulseCounter2->CountUp();
+		pPulseCounter2->CountUp();
+	}
+	BOOST_CHECK_EQUAL( queue1.Depth(), 1u );
+	BOOST_CHECK_EQUAL( queue2.Depth(), 0u );
+	BOOST_CHECK_EQUAL( pPulseCounter2->Counter(), 2 );
+
+	queue2.Append( std::move(queue1) );
+	BOOST_CHECK( queue1.Empty() );
+	BOOST_CHECK_EQUAL( queue2.Depth(), 1u );
+
+	queue2.Commit();
+	BOOST_CHECK_EQUAL( pPulseCounter2->Counter(), 0 );
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().commits, 1u );
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().delivered, 1u );
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().lastDepth, 1u );
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().maxDepth, 1u );
+	BOOST_CHECK( queue2.GetStatistics().totalDelivery >= queue2.GetStatistics().lastDelivery );
+
+	queue2.Commit();
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().commits, 2u );
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().lastDepth, 0u );
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().maxDepth, 1u );
+
+	queue2.ResetStatistics();
+	BOOST_CHECK_EQUAL( queue2.GetStatistics().commits, 0u );
+}
+
+BOOST_FIXTURE_TEST_CASE( pulsequeue_jack_destroyed_before_commit, SensorFixture )
+	// a pulse deferred by a jack that is gone on Commit() gets dropped
+{
+	std::unique_ptr<PulseCounter> pPulseCounter1 = PulseCounter::Make();
+	std::unique_ptr<PulseCounter> pPulseCounter2 = PulseCounter::Make();
+	pPulseCounter1->Threshold( 1 );
+	pPulseCounter1->JackOnReachThreshold().Insert( &pPulseCounter2->PlugToCountUp() );
+
+	PulseQueue queue;
+	{
+		PulseQueue::Scope scope{ &queue };
+		pPulseCounter1->CountUp();
+	}
+	BOOST_CHECK_EQUAL( queue.Depth(), 1u );
+
+	pPulseCounter1.reset();
+	queue.Commit();
+	BOOST_CHECK_EQUAL( pPulseCounter2->Counter(), 0 );
+	BOOST_CHECK( queue.Empty() );
+}
+
+BOOST_AUTO_TEST_CASE( pulsequeue_action_throws )
+	// an action that throws on Commit() does not keep the others from getting done
+{
+	int done = 0;
+	PulseQueue queue;
+	queue.Defer( [&done](){ ++done; } );
+	queue.Defer( [](){ throw std::runtime_error( "deferred action failed" ); } );
+	queue.Defer( [&done](){ ++done; } );
+
+	queue.Commit();
+	BOOST_CHECK_EQUAL( done, 2 );
+	BOOST_CHECK( queue.Empty() );
+	BOOST_CHECK_EQUAL( queue.GetStatistics().delivered, 3u );
+}
+
 BOOST_FIXTURE_TEST_CASE( trigger_test2, SensorFixture )
 	// going to and fro over a sensor, sensor negative orientated
 {		 
@@ -173,6 +278,62 @@ BOOST_FIXTURE_TEST_CASE( twosensors_trigger_right_order2, SensorFixture )
 	BOOST_CHECK_EQUAL( pPulseCounter2->Counter(), 0 );
 }
 
+BOOST_AUTO_TEST_CASE( moveOverHeavilyInstrumentedTrack )
+	// many locations moving over a long track with lots of sensors and signals
+{
+	std::shared_ptr<TrackBuilder> pTrack = TrackBuilder::Make();
+	pTrack->Attach( Line::Make(), { 0_m, 1000_m } );
+
+	const int nSensors = 400;
+	std::vector<std::shared_ptr<Sensor>> sensors;
+	std::vector<std::unique_ptr<PulseCounter>> counters;
+	for( int i = 0; i < nSensors; ++i ){
+		sensors.push_back( Sensor::Make() );
+		counters.push_back( PulseCounter::Make() );
+		sensors.back()->JackOnTrigger().Insert( &counters.back()->PlugToCountUp() );
+		pTrack->Attach( sensors.back(), TrackLocation{ 2.5_m * i + 0.3_m, i % 2 == 0 } );
+	}
+
+	const int nSignals = 100;
+	for( int i = 0; i < nSignals; ++i ){
+		std::shared_ptr<VelocityControl> pSignal = VelocityControl::Make();
+		if( i % 2 == 0 )
+			pTrack->Attach( pSignal, common::Interval<Length>{ 10_m * i, 10_m * i + 5_m } );
+		else
+			pTrack->Attach( pSignal, common::Interval<Length>{ 10_m * i + 5_m, 10_m * i } );
+	}
+
+	std::unique_ptr<Event> pEvent = Event::Make();
+	TestSignalTarget signalTarget;
+
+	const int nLocations = 200;
+	const int nSteps = 900;
+	std::vector<Location> locations( nLocations );
+	for( int j = 0; j < nLocations; ++j )
+		locations[j].PutOn( pTrack, TrackLocation{ 0.5_m * j + 0.1_m, Orientation::Value::para } );
+
+	const auto start = std::chrono::steady_clock::now();
+	for( int step = 0; step < nSteps; ++step )
+		for( Location& location : locations )
+			location.Move( 1_m, Orientation::Value::para, pEvent.get(), &signalTarget );
+	const auto end = std::chrono::steady_clock::now();
+
+	BOOST_CHECK( signalTarget.m_bNotifyFlag );
+	for( int i = 0; i < nSensors; ++i ){
+		int expected = 0;
+		if( i % 2 == 0 )
+			for( int j = 0; j < nLocations; ++j )
+				if( 0.5f * j + 0.1f <= 2.5f * i + 0.3f && 2.5f * i + 0.3f < 0.5f * j + 0.1f + nSteps )
+					++expected;
+
+		BOOST_CHECK_EQUAL( counters[i]->Counter(), expected );
+	}
+
+	const auto duration = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+	std::cout << "Moved " << nLocations * nSteps << " times over a track with " << nSensors << " sensors and " << nSignals << " signals in ";
+	std::cout << duration / 1000 << "ms; " << 1000.0 * nLocations * nSteps / std::max( duration, decltype(duration){1} ) << " moves per ms." << std::endl;
+}
+
 BOOST_AUTO_TEST_SUITE_END() //Sensor_tests
 BOOST_AUTO_TEST_SUITE_END() //trax_tests
 
@@ -29,6 +29,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "trax/Curve.h"
+#include "trax/Jack.h"
 #include "trax/Signal.h"
 #include "trax/Track.h"
 
@@ -130,6 +131,75 @@ BOOST_FIXTURE_TEST_CASE( distanceoverseveraltracks2, ThreeTracksInALineFixture )
 	BOOST_CHECK( !signalTarget2.m_bNotifyFlag );
 }
 
+BOOST_FIXTURE_TEST_CASE( signalsInTravelOrder, ThreeTracksInALineFixture )
+// GetSignal finds the nearest signal and DoSignal notifies in the order of travel.
+{
+	class RecordingSignalTarget : public TestSignalTarget{
+	public:
+		bool Notify( const Signal& signal, Length distance ) override{
+			m_Signals.push_back( &signal );
+			return TestSignalTarget::Notify( signal, distance );
+		}
+
+		std::vector<const Signal*> m_Signals;
+	};
+
+	std::shared_ptr<VelocityControl> pSignal8 = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignal3 = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignal5 = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignalAnti2 = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignalAnti6 = VelocityControl::Make();
+	m_pTrack2->Attach( pSignal8, common::Interval<Length>{ 8_m, 8.5_m } );
+	m_pTrack2->Attach( pSignalAnti2, common::Interval<Length>{ 2.5_m, 2_m } );
+	m_pTrack2->Attach( pSignal3, common::Interval<Length>{ 3_m, 4_m } );
+	m_pTrack2->Attach( pSignalAnti6, common::Interval<Length>{ 6.5_m, 6_m } );
+	m_pTrack2->Attach( pSignal5, common::Interval<Length>{ 5_m, 5.5_m } );
+
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 1_m, Orientation::Value::para } ), pSignal3.get() );
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 4.5_m, Orientation::Value::para } ), pSignal5.get() );
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 9_m, Orientation::Value::anti } ), pSignalAnti6.get() );
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 5_m, Orientation::Value::anti } ), pSignalAnti2.get() );
+	BOOST_CHECK( m_pTrack2->GetSignal( TrackLocation{ 9_m, Orientation::Value::para } ) == nullptr );
+
+	RecordingSignalTarget paraTarget;
+	m_pTrack2->DoSignal( m_pTrack2->Range(), Orientation::Value::para, paraTarget );
+	BOOST_REQUIRE_EQUAL( paraTarget.m_Signals.size(), 3u );
+	BOOST_CHECK_EQUAL( paraTarget.m_Signals[0], pSignal3.get() );
+	BOOST_CHECK_EQUAL( paraTarget.m_Signals[1], pSignal5.get() );
+	BOOST_CHECK_EQUAL( paraTarget.m_Signals[2], pSignal8.get() );
+
+	RecordingSignalTarget antiTarget;
+	m_pTrack2->DoSignal( common::Interval<Length>{ 10_m, 0_m }, Orientation::Value::anti, antiTarget );
+	BOOST_REQUIRE_EQUAL( antiTarget.m_Signals.size(), 2u );
+	BOOST_CHECK_EQUAL( antiTarget.m_Signals[0], pSignalAnti6.get() );
+	BOOST_CHECK_EQUAL( antiTarget.m_Signals[1], pSignalAnti2.get() );
+
+	RecordingSignalTarget partialTarget;
+	m_pTrack2->DoSignal( common::Interval<Length>{ 4.5_m, 7_m }, Orientation::Value::para, partialTarget );
+	BOOST_REQUIRE_EQUAL( partialTarget.m_Signals.size(), 1u );
+	BOOST_CHECK_EQUAL( partialTarget.m_Signals[0], pSignal5.get() );
+
+	// The jacks get enumerated in the order of attachment:
+	std::vector<const Jack*> expectedJacks, trackJacks;
+	for( const Signal* pSignal : { pSignal8.get(), pSignalAnti2.get(), pSignal3.get(), pSignalAnti6.get(), pSignal5.get() } )
+		if( const JackEnumerator* pJackEnumerator = dynamic_cast<const JackEnumerator*>(pSignal) )
+			for( int idx = 0; idx < pJackEnumerator->CountJacks(); ++idx )
+				expectedJacks.push_back( &pJackEnumerator->GetJack( idx ) );
+	const JackEnumerator* pTrackJacks = dynamic_cast<const JackEnumerator*>(m_pTrack2.get());
+	BOOST_REQUIRE( pTrackJacks );
+	for( int idx = 0; idx < pTrackJacks->CountJacks(); ++idx )
+		trackJacks.push_back( &pTrackJacks->GetJack( idx ) );
+	BOOST_CHECK( !expectedJacks.empty() );
+	BOOST_CHECK( trackJacks == expectedJacks );
+
+	m_pTrack2->Flip( true );
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 1_m, Orientation::Value::para } ), pSignalAnti6.get() );
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 9_m, Orientation::Value::anti } ), pSignal3.get() );
+
+	m_pTrack2->Detach( *pSignal3 );
+	BOOST_CHECK_EQUAL( m_pTrack2->GetSignal( TrackLocation{ 9_m, Orientation::Value::anti } ), pSignal5.get() );
+}
+
 BOOST_AUTO_TEST_SUITE_END() //Switch_tests
 BOOST_AUTO_TEST_SUITE_END() //trax_tests
 #endif
\ No newline at end of file
@@ -0,0 +1,177 @@
+//	trax track library
+//	AD 2026
+//
+//  "Paint it black"
+//
+//				The Rolling Stones
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#if defined( WITH_BOOST_TESTS )
+#include <boost/test/unit_test.hpp>
+
+#include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
+#include "trax/Curve.h"
+#include "trax/TrackPainter.h"
+#include "trax/support/TraxSupportStream.h"
+
+using namespace trax;
+using namespace spat;
+using namespace std;
+
+struct SectionTrackChainFixture{
+	// An arc between two lines, connected north to south.
+	SectionTrackChainFixture()
+		: m_pSection{ Section::Make( Section::SpecialSections::standard ) }
+	{
+		for( int i = 0; i < 3; ++i ){
+			m_Tracks.push_back( SectionTrack::Make() );
+			m_Tracks.back()->ID( i + 1 );
+			m_Tracks.back()->Attach( m_pSection );
+			if( i == 1 ){
+				std::shared_ptr<Arc> pArc = Arc::Make();
+				pArc->Create( { 1_1/100_m } );
+				m_Tracks.back()->Attach( pArc, { 0_m, 50_m } );
+			}
+			else
+				m_Tracks.back()->Attach( Line::Make(), { 0_m, 20_m } );
+
+			if( i > 0 ){
+				Frame<Length,One> frame;
+				m_Tracks[i-1]->Transition( m_Tracks[i-1]->GetLength(), frame );
+				frame.TransportNor( 1_mm ); // slightly off
+				m_Tracks.back()->SetFrame( frame, 0_m );
+				m_Tracks.back()->Connect(
+					std::make_pair( m_Tracks.back(), EndType::north ),
+					std::make_pair( m_Tracks[i-1], EndType::south ) );
+			}
+		}
+	}
+
+	~SectionTrackChainFixture(){
+		for( auto& pTrack : m_Tracks )
+			pTrack->Disconnect();
+	}
+
+	std::shared_ptr<const Section> m_pSection;
+	std::vector<std::shared_ptr<SectionTrack>> m_Tracks;
+};
+
+BOOST_AUTO_TEST_SUITE(trax_tests)
+BOOST_AUTO_TEST_SUITE(TrackPainter_tests)
+
+BOOST_FIXTURE_TEST_CASE( lodRowsDecreaseWithEpsilon, SectionTrackChainFixture )
+{
+	LODPainter painter{ { 1_m, 1_mm, 10_cm, 1_cm } };
+	BOOST_REQUIRE_EQUAL( painter.CountLODs(), 4 );
+	BOOST_CHECK_EQUAL( painter.Epsilon( 0 ), 1_mm );
+	BOOST_CHECK_EQUAL( painter.Epsilon( 3 ), 1_m );
+
+	painter.Tessellate( *m_Tracks[1], *m_pSection );
+	BOOST_REQUIRE_EQUAL( painter.Parameters().size(), painter.Frames().size() );
+	BOOST_CHECK_EQUAL( painter.Rows( 0 ).size(), painter.Parameters().size() );
+
+	for( int lod = 1; lod < painter.CountLODs(); ++lod ){
+		const std::vector<int>& rows = painter.Rows( lod );
+		BOOST_CHECK_LE( rows.size(), painter.Rows( lod - 1 ).size() );
+		BOOST_REQUIRE_GE( rows.size(), 2u );
+		BOOST_CHECK_EQUAL( rows.front(), 0 );
+		BOOST_CHECK_EQUAL( rows.back(), painter.Rows( 0 ).back() );
+		BOOST_CHECK( std::is_sorted( rows.begin(), rows.end() ) );
+	}
+
+	BOOST_CHECK_LT( painter.Rows( 3 ).size(), painter.Rows( 0 ).size() );
+	BOOST_CHECK_EQUAL( painter.Parameters().back(), m_Tracks[1]->GetLength() );
+
+	BOOST_CHECK_THROW( LODPainter{ {} }, std::invalid_argument );
+	BOOST_CHECK_THROW( LODPainter{ { 0_m } }, std::invalid_argument );
+}
+
+BOOST_FIXTURE_TEST_CASE( lodChunksArePresized, SectionTrackChainFixture )
+{
+	LODPainter painter;
+	std::vector<MeshChunk<std::pair<VectorBundle<Length,One>,Position2D<One>>>> chunks;
+	BOOST_CHECK_EQUAL( painter.Paint( *m_Tracks[1], *m_pSection, chunks, 10_m ), 60_m );
+	BOOST_REQUIRE_EQUAL( chunks.size(), 4u );
+
+	const std::size_t nPoints = m_pSection->CountPoints();
+	for( int lod = 0; lod < painter.CountLODs(); ++lod ){
+		const std::size_t nRows = painter.Rows( lod ).size();
+		BOOST_CHECK_EQUAL( chunks[lod].epsilon, painter.Epsilon( lod ) );
+		BOOST_CHECK_EQUAL( chunks[lod].points.size(), nRows * nPoints );
+		BOOST_CHECK_EQUAL( chunks[lod].indices.size(), (nRows - 1) * (nPoints - 1) * 6 );
+		BOOST_CHECK( std::all_of( chunks[lod].indices.begin(), chunks[lod].indices.end(),
+			[&]( int index ){ return index >= 0 && index < static_cast<int>(chunks[lod].points.size()); } ) );
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE( lodJointsShareVertices, SectionTrackChainFixture )
+{
+	LODPainter painter;
+	std::vector<MeshChunk<Position<Length>>> chunks1, chunks2;
+	painter.Paint( *m_Tracks[0], *m_pSection, chunks1 );
+	painter.Paint( *m_Tracks[1], *m_pSection, chunks2 );
+
+	const std::size_t nPoints = m_pSection->CountPoints();
+	for( int lod = 0; lod < painter.CountLODs(); ++lod ){
+		const std::vector<Position<Length>>& points1 = chunks1[lod].points;
+		const std::vector<Position<Length>>& points2 = chunks2[lod].points;
+		BOOST_REQUIRE_GE( points1.size(), 2 * nPoints );
+		BOOST_REQUIRE_GE( points2.size(), 2 * nPoints );
+		for( std::size_t i = 0; i < nPoints; ++i )
+			BOOST_CHECK( points1[points1.size() - nPoints + i] == points2[i] );
+	}
+
+	// Without the shared joint the gap shows:
+	Frame<Length,One> start;
+	m_Tracks[1]->Transition( 0_m, start );
+	BOOST_CHECK_GT( (chunks2.front().points.front() - SectionVertex<Position<Length>>( start, m_pSection->Get( 0 ), {} )).Length(), 0.5_mm );
+}
+
+BOOST_FIXTURE_TEST_CASE( meshCacheRepaintsChangedTracks, SectionTrackChainFixture )
+{
+	TrackMeshCache<Position<Length>> cache;
+	BOOST_CHECK_EQUAL( cache.Update( m_Tracks ), 3 );
+	BOOST_CHECK_EQUAL( cache.Count(), 3u );
+	BOOST_REQUIRE( cache.Get( 2 ) );
+	BOOST_CHECK_EQUAL( cache.Get( 2 )->size(), 4u );
+	BOOST_CHECK( cache.Get( 4 ) == nullptr );
+
+	BOOST_CHECK_EQUAL( cache.Update( m_Tracks ), 0 );
+
+	// The neighbour's end row depends on the changed track:
+	m_Tracks[2]->Attach( Line::Make(), { 0_m, 30_m } );
+	BOOST_CHECK_EQUAL( cache.Update( m_Tracks ), 2 );
+	BOOST_CHECK_EQUAL( cache.Update( m_Tracks ), 0 );
+
+	cache.Invalidate( 1 );
+	BOOST_CHECK_EQUAL( cache.Update( m_Tracks ), 1 );
+
+	m_Tracks[2]->Disconnect();
+	m_Tracks.pop_back();
+	cache.Update( m_Tracks );
+	BOOST_CHECK_EQUAL( cache.Count(), 2u );
+	BOOST_CHECK( cache.Get( 3 ) == nullptr );
+}
+
+BOOST_AUTO_TEST_SUITE_END() //TrackPainter_tests
+BOOST_AUTO_TEST_SUITE_END() //trax_tests
+
+#endif // WITH_BOOST_TESTS
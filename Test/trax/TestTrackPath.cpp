@@ -0,0 +1,304 @@
+//	trax track library
+//	AD 2026
+//
+//  "The long and winding road
+//	 that leads to your door"
+//
+//				The Beatles
+//
+// Copyright (c) 2025 Trend Redaktions- und Verlagsgesellschaft mbH
+// Copyright (c) 2019 Marc-Michael Horstmann
+//
+// Permission is hereby granted to any person obtaining a copy of this software
+// and associated source code (the "Software"), to use, view, and study the
+// Software for personal or internal business purposes, subject to the following
+// conditions:
+//
+// 1. Redistribution, modification, sublicensing, or commercial use of the
+// Software is NOT permitted without prior written consent from the copyright
+// holder.
+//
+// 2. The Software is provided "AS IS", without warranty of any kind, express
+// or implied.
+//
+// 3. All copies of the Software must retain this license notice.
+//
+// For further information, please contact: horstmann@traxlibrary.dev
+
+#if defined( WITH_BOOST_TESTS )
+#include <boost/test/unit_test.hpp>
+
+#include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
+#include "trax/Curve.h"
+#include "trax/Signal.h"
+#include "trax/Switch.h"
+#include "trax/TrackPath.h"
+#include "trax/support/TraxSupportStream.h"
+
+#include <chrono>
+
+using namespace trax;
+using namespace spat;
+using namespace std;
+
+struct TrackChainFixture{
+	// Tracks of 100_m, every third one connected the other way round.
+	TrackChainFixture( int nTracks = 10 ){
+		for( int i = 0; i < nTracks; ++i ){
+			m_Tracks.push_back( TrackBuilder::Make() );
+			m_Tracks.back()->Attach( Line::Make(), { 0_m, 100_m } );
+			if( i > 0 )
+				m_Tracks.back()->Connect( 
+					std::make_pair( m_Tracks.back(), Reversed( i ) ? EndType::south : EndType::north ), 
+					std::make_pair( m_Tracks[i-1], Reversed( i-1 ) ? EndType::north : EndType::south ) );
+		}
+	}
+
+	~TrackChainFixture(){
+		for( auto& pTrack : m_Tracks )
+			pTrack->Disconnect();
+	}
+
+	static bool Reversed( int i ) noexcept{
+		return i % 3 == 1;
+	}
+
+	std::vector<std::shared_ptr<TrackBuilder>> m_Tracks;
+};
+
+BOOST_AUTO_TEST_SUITE(trax_tests)
+BOOST_AUTO_TEST_SUITE(TrackPath_tests)
+
+BOOST_FIXTURE_TEST_CASE( pathAlongTrackChain, TrackChainFixture )
+// The path agrees with moving a location along the tracks.
+{
+	const Location start{ m_Tracks[0], TrackLocation{ 30_m, Orientation::Value::para } };
+	TrackPath path{ start, 250_m };
+	BOOST_CHECK( path.IsValid() );
+	BOOST_CHECK( !path.IsOpenEnded() );
+	BOOST_REQUIRE_EQUAL( path.CountEntries(), 3u );
+	BOOST_CHECK_EQUAL( path.GetLength(), 270_m );
+	BOOST_CHECK( path.GetEntry( 1 ).pTrack == m_Tracks[1] );
+	BOOST_CHECK_EQUAL( path.GetEntry( 1 ).orientation, Orientation::Value::anti );
+	BOOST_CHECK_EQUAL( path.GetEntry( 2 ).offset, 170_m );
+
+	for( Length distance = 0_m; distance < path.GetLength(); distance += 15_m ){
+		Location loc{ start };
+		loc.Move( distance );
+		BOOST_CHECK( path.LocationAt( distance ) == loc );
+		BOOST_CHECK_CLOSE_DIMENSION( path.Distance( loc ), start.Distance( loc, 1_km ), 0.01 );
+	}
+
+	BOOST_CHECK_EQUAL( path.Distance( Location{ m_Tracks[5], TrackLocation{ 10_m } } ), +infinite__length );
+	BOOST_CHECK_EQUAL( path.Find( 300_m ), path.CountEntries() );
+	BOOST_CHECK_THROW( path.LocationAt( 300_m ), std::out_of_range );
+
+	TrackPath openPath{ start, 10_km };
+	BOOST_CHECK( openPath.IsOpenEnded() );
+	BOOST_CHECK_EQUAL( openPath.CountEntries(), m_Tracks.size() );
+	BOOST_CHECK_CLOSE_DIMENSION( openPath.GetLength(), 970_m, 0.01 );
+}
+
+BOOST_AUTO_TEST_CASE( pathAroundLoop )
+// On a closed loop the path ends back at the start.
+{
+	TrackChainFixture loop{ 4 };
+	loop.m_Tracks[3]->Connect( 
+		std::make_pair( loop.m_Tracks[3], EndType::south ), 
+		std::make_pair( loop.m_Tracks[0], EndType::north ) );
+
+	const Location start{ loop.m_Tracks[0], TrackLocation{ 30_m, Orientation::Value::para } };
+	TrackPath path{ start, 10_km };
+	BOOST_CHECK( path.IsComplete() );
+	BOOST_CHECK( !path.IsOpenEnded() );
+	BOOST_REQUIRE_EQUAL( path.CountEntries(), 5u );
+	BOOST_CHECK_CLOSE_DIMENSION( path.GetLength(), 400_m, 0.01 );
+	BOOST_CHECK( path.GetEntry( 4 ).pTrack == loop.m_Tracks[0] );
+	BOOST_CHECK_EQUAL( path.GetEntry( 4 ).range.Far(), 30_m );
+	BOOST_CHECK_CLOSE_DIMENSION( path.Distance( Location{ loop.m_Tracks[0], TrackLocation{ 10_m } } ), 380_m, 0.01 );
+
+	const Location startOnEnd{ loop.m_Tracks[0], TrackLocation{ 0_m, Orientation::Value::para } };
+	path.Build( startOnEnd, 10_km );
+	BOOST_CHECK( path.IsComplete() );
+	BOOST_CHECK_EQUAL( path.CountEntries(), 4u );
+	BOOST_CHECK_CLOSE_DIMENSION( path.GetLength(), 400_m, 0.01 );
+
+	path.Build( start, 150_m );
+	BOOST_CHECK( !path.IsComplete() );
+	BOOST_CHECK_EQUAL( path.CountEntries(), 2u );
+
+	BOOST_CHECK_THROW( path.Build( start, +infinite__length ), std::invalid_argument );
+}
+
+BOOST_FIXTURE_TEST_CASE( pathSignals, TrackChainFixture )
+// Next signal along the path is the one GetSignal finds.
+{
+	std::shared_ptr<VelocityControl> pSignal1 = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignal2 = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignalWrongWay = VelocityControl::Make();
+	std::shared_ptr<VelocityControl> pSignal3 = VelocityControl::Make();
+	m_Tracks[0]->Attach( pSignal1, common::Interval<Length>{ 50_m, 60_m } );
+	m_Tracks[1]->Attach( pSignal2, common::Interval<Length>{ 40_m, 20_m } ); // reversed track
+	m_Tracks[1]->Attach( pSignalWrongWay, common::Interval<Length>{ 10_m, 15_m } );
+	m_Tracks[2]->Attach( pSignal3, common::Interval<Length>{ 0_m, 5_m } );
+
+	const Location start{ m_Tracks[0], TrackLocation{ 30_m, Orientation::Value::para } };
+	TrackPath path{ start, 500_m };
+
+	auto next = path.NextSignal();
+	BOOST_CHECK_EQUAL( next.first, pSignal1.get() );
+	BOOST_CHECK_CLOSE_DIMENSION( next.second, 20_m, 0.01 );
+
+	next = path.NextSignal( 25_m );
+	BOOST_CHECK_EQUAL( next.first, pSignal1.get() );
+
+	next = path.NextSignal( 61_m );
+	BOOST_CHECK_EQUAL( next.first, pSignal2.get() );
+	BOOST_CHECK_CLOSE_DIMENSION( next.second, 130_m, 0.01 );
+
+	next = path.NextSignal( 151_m );
+	BOOST_CHECK_EQUAL( next.first, pSignal3.get() );
+	BOOST_CHECK_CLOSE_DIMENSION( next.second, 170_m, 0.01 );
+
+	next = path.NextSignal( 176_m );
+	BOOST_CHECK( next.first == nullptr );
+	BOOST_CHECK_EQUAL( next.second, +infinite__length );
+
+	for( Length distance = 0_m; distance < 170_m; distance += 7_m ){
+		const Location loc = path.LocationAt( distance );
+		TrackLocation tl;
+		loc.Get( tl );
+		BOOST_CHECK_EQUAL( path.NextSignal( distance ).first, loc.GetTrack()->GetSignal( tl ) );
+	}
+
+	m_Tracks[1]->Detach( *pSignal2 );
+	BOOST_CHECK( !path.IsValid() );
+	path.Build( start, 500_m );
+	BOOST_CHECK( path.IsValid() );
+	BOOST_CHECK_EQUAL( path.NextSignal( 61_m ).first, pSignal3.get() );
+}
+
+BOOST_FIXTURE_TEST_CASE( pathReservations, TrackChainFixture )
+// Finds the nearest reservation of others ahead.
+{
+	m_Tracks[1]->Reserve( common::Interval<Length>{ 40_m, 20_m }, 7 );
+	m_Tracks[2]->Reserve( common::Interval<Length>{ 10_m, 20_m }, 8 );
+
+	const Location start{ m_Tracks[0], TrackLocation{ 30_m, Orientation::Value::para } };
+	const TrackPath path{ start, 500_m };
+	BOOST_CHECK( path.IsValid() );
+
+	auto next = path.NextReservation( anyID, 0_m, 500_m );
+	BOOST_CHECK_EQUAL( next.first, 7 );
+	BOOST_CHECK_CLOSE_DIMENSION( next.second, 130_m, 0.01 );
+
+	next = path.NextReservation( 7, 0_m, 500_m );
+	BOOST_CHECK_EQUAL( next.first, 8 );
+	BOOST_CHECK_CLOSE_DIMENSION( next.second, 180_m, 0.01 );
+
+	next = path.NextReservation( anyID, 140_m, 500_m );
+	BOOST_CHECK_EQUAL( next.first, 7 );
+	BOOST_CHECK_CLOSE_DIMENSION( next.second, 140_m, 0.01 );
+
+	next = path.NextReservation( anyID, 0_m, 100_m );
+	BOOST_CHECK( !next.first );
+	BOOST_CHECK_EQUAL( next.second, +infinite__length );
+
+	m_Tracks[1]->DeleteReservation( m_Tracks[1]->Range() );
+	m_Tracks[2]->DeleteReservation( m_Tracks[2]->Range() );
+}
+
+BOOST_AUTO_TEST_CASE( pathInvalidatedBySwitch )
+// Switching a connector on the path invalidates it; changes elsewhere do not.
+{
+	std::shared_ptr<TrackBuilder> pTrack1 = TrackBuilder::Make();
+	std::shared_ptr<TrackBuilder> pTrack2 = TrackBuilder::Make();
+	std::shared_ptr<TrackBuilder> pTrack3 = TrackBuilder::Make();
+	std::shared_ptr<TrackBuilder> pTrackElsewhere = TrackBuilder::Make();
+	pTrack1->Attach( Line::Make(), { 0_m, 100_m } );
+	pTrack2->Attach( Line::Make(), { 0_m, 100_m } );
+	pTrack3->Attach( Line::Make(), { 0_m, 100_m } );
+	pTrackElsewhere->Attach( Line::Make(), { 0_m, 100_m } );
+
+	std::unique_ptr<Switch> pSwitch = Switch::Make();
+	pSwitch->NarrowTrack( pTrack1, EndType::south );
+	pSwitch->StraightTrack( pTrack2, EndType::north );
+	pSwitch->DivergedTrack( pTrack3, EndType::north );
+	pSwitch->Set( Switch::Status::go );
+
+	const Location start{ pTrack1, TrackLocation{ 50_m, Orientation::Value::para } };
+	TrackPath path{ start, 200_m };
+	BOOST_CHECK( path.IsValid() );
+	BOOST_REQUIRE_EQUAL( path.CountEntries(), 2u );
+	BOOST_CHECK( path.GetEntry( 1 ).pTrack == pTrack2 );
+
+	pTrackElsewhere->Attach( VelocityControl::Make(), common::Interval<Length>{ 10_m, 20_m } );
+	BOOST_CHECK( path.IsValid() );
+
+	pSwitch->Set( Switch::Status::branch );
+	BOOST_CHECK( !path.IsValid() );
+
+	path.Build( start, 200_m );
+	BOOST_CHECK( path.IsValid() );
+	BOOST_REQUIRE_EQUAL( path.CountEntries(), 2u );
+	BOOST_CHECK( path.GetEntry( 1 ).pTrack == pTrack3 );
+
+	pTrack1->Disconnect();
+	pTrack2->Disconnect();
+	pTrack3->Disconnect();
+}
+
+BOOST_AUTO_TEST_CASE( lookAheadOverManyTracks )
+// A location moving along a long chain of tracks asks for the next signal
+// every step; compare the cached path with walking the tracks.
+{
+	TrackChainFixture chain{ 1000 };
+	std::vector<std::shared_ptr<VelocityControl>> signals;
+	for( std::size_t i = 0; i < chain.m_Tracks.size(); i += 50 ){
+		signals.push_back( VelocityControl::Make() );
+		if( TrackChainFixture::Reversed( static_cast<int>(i) ) )
+			chain.m_Tracks[i]->Attach( signals.back(), common::Interval<Length>{ 60_m, 50_m } );
+		else
+			chain.m_Tracks[i]->Attach( signals.back(), common::Interval<Length>{ 50_m, 60_m } );
+	}
+
+	const int nSteps = 20000;
+	const Length step = 4_m;
+
+	Location loc{ chain.m_Tracks[0], TrackLocation{ 0_m, Orientation::Value::para } };
+	std::vector<Signal*> walked;
+	walked.reserve( nSteps );
+	const auto startWalk = std::chrono::steady_clock::now();
+	for( int i = 0; i < nSteps; ++i ){
+		TrackLocation tl;
+		loc.Get( tl );
+		walked.push_back( loc.GetTrack()->GetSignal( tl ) );
+		loc.Move( step );
+	}
+	const auto endWalk = std::chrono::steady_clock::now();
+
+	loc.PutOn( chain.m_Tracks[0], TrackLocation{ 0_m, Orientation::Value::para } );
+	TrackPath path;
+	std::vector<Signal*> cached;
+	cached.reserve( nSteps );
+	const auto startPath = std::chrono::steady_clock::now();
+	for( int i = 0; i < nSteps; ++i ){
+		if( !path.IsValid() || path.Distance( loc ) > path.GetLength() - 5_km )
+			path.Build( loc, 10_km );
+		const Length here = path.Distance( loc );
+		cached.push_back( path.NextSignal( here ).first );
+		loc.Move( step );
+	}
+	const auto endPath = std::chrono::steady_clock::now();
+
+	BOOST_CHECK( walked == cached );
+
+	std::cout << "Looked ahead " << nSteps << " times by walking the tracks in " 
+		<< std::chrono::duration_cast<std::chrono::microseconds>( endWalk - startWalk ).count() / 1000 << "ms, with TrackPath in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>( endPath - startPath ).count() / 1000 << "ms." << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END() //TrackPath_tests
+BOOST_AUTO_TEST_SUITE_END() //trax_tests
+
+#endif // WITH_BOOST_TESTS
@@ -30,6 +30,7 @@
 
 #include "trax/Track.h"
 #include "trax/ParallelTrack.h"
+#include "trax/TrackData.h"
 #include "trax/support/TraxSupportStream.h"
 #include "trax/support/Fixtures.h"
 #include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
@@ -1085,6 +1086,72 @@ BOOST_AUTO_TEST_CASE( flippedCombinedTwistMirrorZ )
 	BOOST_CHECK_GT( frame.B * Up, 0 );
 }
 
+BOOST_AUTO_TEST_CASE( batchTransitionOnFlippedTwistedTrack )
+{
+	auto pBuildTrack = TrackBuilder::Make();
+	auto pArc = ArcP::Make();
+	pArc->Create( VectorBundle2<Length,One>{ {10_m,10_m,10_m}, {1,0,0}, {0,1,0} }, 1/100_m );
+	pBuildTrack->Attach( std::move(pArc), {0_m,50_m} );
+	pBuildTrack->Attach( LinearTwist::Make(10_deg,-20_deg) );
+	pBuildTrack->Flip();
+
+	std::vector<Length> parameters;
+	for( int i = 0; i <= 10; ++i )
+		parameters.push_back( i * 5_m );
+
+	std::vector<Position<Length>> positions( parameters.size() );
+	std::vector<Frame<Length,One>> frames( parameters.size() );
+	pBuildTrack->Transition( parameters.data(), parameters.data() + parameters.size(), positions.data() );
+	pBuildTrack->Transition( parameters.data(), parameters.data() + parameters.size(), frames.data() );
+
+	for( std::size_t i = 0; i < parameters.size(); ++i ){
+		Position<Length> pos;
+		Frame<Length,One> frame;
+		pBuildTrack->Transition( parameters[i], pos );
+		pBuildTrack->Transition( parameters[i], frame );
+		BOOST_CHECK_CLOSE_SPATIAL( positions[i], pos, epsilon__length );
+		BOOST_CHECK_CLOSE_SPATIAL2( frames[i], frame, epsilon__length, epsilon__angle );
+	}
+
+	parameters.push_back( 60_m );
+	frames.resize( parameters.size() );
+	BOOST_CHECK_THROW( pBuildTrack->Transition( parameters.data(), parameters.data() + parameters.size(), frames.data() ), std::range_error );
+}
+
+BOOST_AUTO_TEST_CASE( trackDataEqualsSingleQueries )
+{
+	auto pCubicTrack = TrackBuilder::Make();
+	auto pCubic = Cubic::Make();
+	pCubic->Create( {{0_m,0_m,0_m},{100_m,0_m,0_m}}, {{50_m,50_m,10_m},{0_m,100_m,0_m}} );
+	pCubicTrack->Attach( std::move(pCubic) );
+	pCubicTrack->Attach( DirectionalTwist::Make() );
+
+	auto pClothoidTrack = TrackBuilder::Make();
+	auto pClothoid = Clothoid::Make();
+	pClothoid->Create( Clothoid::Data{} );
+	pClothoidTrack->Attach( std::move(pClothoid), {0_m,80_m} );
+	auto pCombined = CombinedTwist::Make();
+	pCombined->AttachTwist1( DirectionalTwist::Make() );
+	pCombined->AttachTwist2( LinearTwist::Make(10_deg,-10_deg) );
+	pClothoidTrack->Attach( std::move(pCombined) );
+	pClothoidTrack->Flip();
+
+	for( const Track* pTrack : std::initializer_list<const Track*>{ pCubicTrack.get(), pClothoidTrack.get() } ){
+		for( Length s = 0_m; s <= pTrack->GetLength(); s += pTrack->GetLength() / 10 ){
+			TrackData<Real> td;
+			pTrack->Transition( s, td, 1 );
+
+			Frame<Length,One> F, wF;
+			pTrack->TNBFrame( s, F );
+			pTrack->Transition( s, wF );
+			BOOST_CHECK_CLOSE_SPATIAL2( td.F, spatial_cast<Real>(F), _m(epsilon__length), epsilon__angle );
+			BOOST_CHECK_CLOSE_SPATIAL2( td.wF, spatial_cast<Real>(wF), _m(epsilon__length), epsilon__angle );
+			BOOST_CHECK_SMALL( td.c - _1Im(pTrack->Curvature( s )), _1(epsilon__angle) );
+			BOOST_CHECK_SMALL( td.t - _1Im(pTrack->Torsion( s )), _1(epsilon__angle) );
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END() //RoadwayTwist_Tests
 BOOST_AUTO_TEST_SUITE(ParallelTrack_Tests)
 
@@ -2196,5 +2263,107 @@ BOOST_FIXTURE_TEST_CASE( switchShapeTest, SwichFixture ){
 }
 
 BOOST_AUTO_TEST_SUITE_END() //Switch_tests
+BOOST_AUTO_TEST_SUITE(Segmentation_tests)
+
+BOOST_AUTO_TEST_CASE( segmentationOfArcNeedsOneCell )
+{
+	auto pTrack = TrackBuilder::Make();
+	auto pArc = Arc::Make();
+	pArc->Create( { 1_1/100_m } );
+	pTrack->Attach( std::move(pArc), { 0_m, 100_m } );
+	pTrack->Attach( LinearTwist::Make( 0_deg, 10_deg ) );
+
+	const Segmentation segmentation{ *pTrack, 1_cm };
+	BOOST_CHECK_EQUAL( segmentation.CountCells(), 1 );
+
+	const common::Interval<Length> limits{ 1_cm, 10_m };
+	const std::vector<Length> parameters = segmentation.Segments( 1_mm, limits );
+	BOOST_REQUIRE( !parameters.empty() );
+	BOOST_CHECK_EQUAL( parameters.back(), pTrack->GetLength() );
+
+	// Agrees with stepping by Segment():
+	Length s = 0_m;
+	for( const Length end : parameters ){
+		s += Segment( *pTrack, s, 1_mm, limits );
+		BOOST_CHECK_CLOSE_DIMENSION( end, s, 0.001 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( segmentationOfClothoidKeepsTheLimits )
+{
+	auto pTrack = TrackBuilder::Make();
+	auto pClothoid = Clothoid::Make();
+	pClothoid->Create( Clothoid::Data{ 50_m } );
+	pTrack->Attach( std::move(pClothoid), { 10_m, 60_m } );
+
+	const Length e = 1_mm;
+	const common::Interval<Length> limits{ 1_cm, 10_m };
+	const Segmentation segmentation{ *pTrack, limits.Near() };
+	BOOST_CHECK_GT( segmentation.CountCells(), 1 );
+
+	const std::vector<Length> parameters = segmentation.Segments( e, limits );
+	BOOST_REQUIRE( !parameters.empty() );
+	BOOST_CHECK_EQUAL( parameters.back(), pTrack->GetLength() );
+
+	// Each segment is shorter than what Segment() allows anywhere on it, 
+	// unless Segment() got shortened to the track's end:
+	Length s = 0_m;
+	for( const Length end : parameters ){
+		const Length ds = end - s;
+		for( int i = 0; i <= 10; ++i ){
+			const Length si = s + ds * i / 10;
+			const Length dsi = Segment( *pTrack, si, e, { epsilon__length, +infinite__length } );
+			if( si + dsi < pTrack->GetLength() - epsilon__length )
+				BOOST_CHECK_LE( ds, dsi * 1.0001f + epsilon__length );
+		}
+		s = end;
+	}
+
+	// Not much more segments than the totally checked ones:
+	int count = 0;
+	for( Length ds, t = 0_m; (ds = Segment_TotallyChecked( *pTrack, t, e, limits )); t += ds )
+		++count;
+	BOOST_CHECK_LE( parameters.size(), static_cast<std::size_t>(count + count / 10 + 1) );
+}
+
+BOOST_AUTO_TEST_CASE( segmentationBoundsRotatorCurvature )
+{
+	auto pTrack = TrackBuilder::Make();
+	auto pRotator = Rotator::Make();
+	pRotator->Create( Rotator::Data{ 20_deg / 90_m, 10_deg / 90_m } );
+	pTrack->Attach( std::move(pRotator), { 0_m, 90_m } );
+	pTrack->Attach( DirectionalTwist::Make() );
+
+	const Segmentation segmentation{ *pTrack, 1_m };
+	for( Length s = 0_m; s <= pTrack->GetLength(); s += 5_m ){
+		const auto bounds = segmentation.Bounds( { s, s } );
+		BOOST_CHECK_LE( abs(pTrack->Curvature( s )), bounds.first * 1.0001f );
+	}
+
+	BOOST_CHECK_THROW( Segmentation( *pTrack, 0_m ), std::invalid_argument );
+	BOOST_CHECK_THROW( Segmentation( *TrackBuilder::Make(), 1_m ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( polygonalChainFromSegmentation )
+{
+	auto pArc = ArcP::Make();
+	pArc->Create( { Origin3D<Length>, {1,0,0}, {0,100,0} } );
+
+	auto pPolygonalChain = PolygonalChain::Make();
+	const common::Interval<Length> range = pPolygonalChain->Create( *pArc, { 0_m, 100_m }, 1_cm, 1_m );
+	BOOST_CHECK_GE( pPolygonalChain->GetData().size(), 3u );
+	BOOST_CHECK_LT( pPolygonalChain->GetData().size(), 101u );
+	BOOST_CHECK_SMALL( range.Length() - 100_m, 2_cm );
+
+	// The vertices are on the arc:
+	Frame<Length,One> start;
+	pArc->Transition( 0_m, start );
+	const Length radius = 1 / pArc->Curvature( 0_m );
+	const Position<Length> center = start.P + radius * start.N;
+	for( const auto& vertex : pPolygonalChain->GetData() )
+		BOOST_CHECK_SMALL( (vertex.P - center).Length() - radius, 1_mm );
+}
+
+BOOST_AUTO_TEST_SUITE_END() //Segmentation_tests
 BOOST_AUTO_TEST_SUITE_END() //trax_tests
 #endif
\ No newline at end of file
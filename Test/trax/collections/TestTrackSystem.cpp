@@ -12,17 +12,45 @@
 #include <boost/test/unit_test.hpp>
 
 #include "trax/collections/support/FixturesCollections.h"
+#include "trax/collections/support/TrackSystemBuilder.h"
+#include "trax/Connector.h"
+#include "trax/Jack.h"
+#include "trax/Plug.h"
+#include "trax/Sensor.h"
 #include "trax/Track.h"
 #include "trax/Section.h"
+#include "trax/SectionTrack.h"
 //#include "trax/StaticTrack.h"
+#include "trax/collections/ConnectorCollection.h"
+#include "trax/collections/TimerCollection.h"
 #include "trax/collections/TrackSystem.h"
 #include "trax/collections/TrackCollection.h"
 #include "trax/collections/TrackCollectionContainer.h"
+#include "trax/collections/support/TrackSystemReader.h"
+#include "trax/collections/support/TrackSystemSnapshot.h"
+#include "trax/support/Fixtures.h"
 #include "trax/support/TraxSupportStream.h"
 
 #include "../Test/dim/BoostTestDimensionedValuesHelpers.h"
 #include "../Test/spat/BoostTestSpatialHelpers.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+#if defined( _WIN32 )
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <sys/resource.h>
+#endif
+
 using namespace trax;
 using namespace spat;
 using namespace std;
@@ -100,6 +128,172 @@ BOOST_FIXTURE_TEST_CASE( CollectionFrameShift_Test2, TrackSystemFixture )
 	BOOST_CHECK_CLOSE_SPATIAL( frame1.P, frame2.P, epsilon__length );
 }
 
+BOOST_AUTO_TEST_CASE( Collection_DenseStorage )
+	// The dense storage has to behave exactly like the tree.
+{
+	std::unique_ptr<TrackCollection> pTree = TrackCollection::Make();
+	std::unique_ptr<TrackCollection> pDense = TrackCollection::Make( CollectionStorage::dense );
+	BOOST_REQUIRE( pTree );
+	BOOST_REQUIRE( pDense );
+
+	for( TrackCollection* pCollection : { pTree.get(), pDense.get() } ){
+		std::vector<std::shared_ptr<TrackBuilder>> tracks;
+		for( IDType id : { 7, 3, 5, 0, 0, 0 } ){
+			tracks.push_back( TrackBuilder::Make() );
+			tracks.back()->ID( id );
+			pCollection->Add( tracks.back() );
+		}
+
+		// The free ids get filled from below:
+		BOOST_CHECK_EQUAL( tracks[3]->ID(), 1 );
+		BOOST_CHECK_EQUAL( tracks[4]->ID(), 2 );
+		BOOST_CHECK_EQUAL( tracks[5]->ID(), 4 );
+		BOOST_CHECK_EQUAL( pCollection->PeekFree(), 6 );
+		BOOST_CHECK_EQUAL( pCollection->Count(), 6 );
+		BOOST_CHECK_EQUAL( pCollection->MinID(), 1 );
+		BOOST_CHECK_EQUAL( pCollection->MaxID(), 7 );
+
+		std::shared_ptr<TrackBuilder> pDuplicate = TrackBuilder::Make();
+		pDuplicate->ID( 5 );
+		BOOST_CHECK_THROW( pCollection->Add( pDuplicate ), std::invalid_argument );
+		BOOST_CHECK_EQUAL( pCollection->AddRelaxed( pDuplicate ), 6 );
+
+		std::vector<IDType> ids;
+		for( const TrackBuilder& track : *pCollection )
+			ids.push_back( track.ID() );
+		BOOST_CHECK( ids == std::vector<IDType>( { 1, 2, 3, 4, 5, 6, 7 } ) );
+
+		BOOST_CHECK( pCollection->Get( 3 ) == tracks[1] );
+		BOOST_CHECK( pCollection->Get( 8 ) == nullptr );
+		BOOST_CHECK( pCollection->GetNext( tracks[1] ) == tracks[5] );
+		BOOST_CHECK( pCollection->GetPrevious( tracks[1] ) == tracks[4] );
+		BOOST_CHECK( pCollection->GetLast() == tracks[0] );
+
+		BOOST_CHECK( pCollection->Remove( tracks[1].get() ) );
+		BOOST_CHECK( !pCollection->Remove( tracks[1].get() ) );
+		BOOST_CHECK( !pCollection->IsMember( 3 ) );
+		BOOST_CHECK( pCollection->IsMember( *tracks[5] ) );
+		BOOST_CHECK( pCollection->GetNext( tracks[4] ) == tracks[5] );
+		BOOST_CHECK_EQUAL( pCollection->PeekFree(), 3 );
+
+		pCollection->ShiftIDs( 10 );
+		BOOST_CHECK_EQUAL( pCollection->MinID(), 11 );
+		BOOST_CHECK( pCollection->Get( 15 ) == tracks[2] );
+		BOOST_CHECK( pCollection->Get( 5 ) == nullptr );
+		BOOST_CHECK_EQUAL( pCollection->PeekFree(), 1 );
+	}
+
+	pTree->Clear();
+	pTree->Add( TrackBuilder::Make() );
+	BOOST_CHECK_EQUAL( pTree->Take( *pDense ), 1 );
+	BOOST_CHECK_EQUAL( pDense->Count(), 0 );
+	BOOST_CHECK_EQUAL( pTree->Count(), 7 );
+	BOOST_CHECK_EQUAL( pTree->MaxID(), 18 );
+
+	BOOST_CHECK_EQUAL( pDense->Take( *pTree ), 0 );
+	BOOST_CHECK_EQUAL( pDense->Count(), 7 );
+	BOOST_CHECK( pDense->GetFirst() && pDense->GetFirst()->ID() == 1 );
+	pDense->Clear();
+	BOOST_CHECK_EQUAL( pDense->Count(), 0 );
+	BOOST_CHECK( pDense->begin() == pDense->end() );
+}
+
+BOOST_AUTO_TEST_CASE( Collection_DenseStorageSparseIDs )
+	// Ids too sparse for the slot table make the dense storage fall back to the tree.
+{
+	std::unique_ptr<TrackCollection> pDense = TrackCollection::Make( CollectionStorage::dense );
+	BOOST_REQUIRE( pDense );
+
+	std::vector<std::shared_ptr<TrackBuilder>> tracks;
+	for( IDType id : { IDType{ 2 }, IDType{ 4000000000u }, IDType{ 0 } } ){
+		tracks.push_back( TrackBuilder::Make() );
+		tracks.back()->ID( id );
+		pDense->Add( tracks.back() );
+	}
+
+	BOOST_CHECK_EQUAL( pDense->Count(), 3 );
+	BOOST_CHECK_EQUAL( tracks[2]->ID(), 1 );
+	BOOST_CHECK_EQUAL( pDense->MaxID(), 4000000000u );
+	BOOST_CHECK( pDense->Get( 4000000000u ) == tracks[1] );
+	BOOST_CHECK( pDense->GetNext( tracks[0] ) == tracks[1] );
+	BOOST_CHECK_EQUAL( pDense->PeekFree(), 3 );
+
+	std::vector<IDType> ids;
+	for( const TrackBuilder& track : *pDense )
+		ids.push_back( track.ID() );
+	BOOST_CHECK( ids == std::vector<IDType>( { 1, 2, 4000000000u } ) );
+
+	std::unique_ptr<TrackCollection> pShifted = TrackCollection::Make( CollectionStorage::dense );
+	pShifted->Add( TrackBuilder::Make() );
+	pShifted->Add( TrackBuilder::Make() );
+	pShifted->ShiftIDs( 2000000000 );
+	BOOST_CHECK_EQUAL( pShifted->MinID(), 2000000001u );
+	BOOST_CHECK_EQUAL( pShifted->MaxID(), 2000000002u );
+	BOOST_CHECK( pShifted->Get( 2000000002u ) == pShifted->GetLast() );
+}
+
+BOOST_AUTO_TEST_CASE( Collection_StorageBenchmarks )
+{
+	using Clock = std::chrono::steady_clock;
+	const int count = 100000;
+
+	for( CollectionStorage storage : { CollectionStorage::tree, CollectionStorage::dense } ){
+		const char* name = storage == CollectionStorage::tree ? "tree" : "dense";
+
+		std::unique_ptr<TimerCollection> pTimers = TimerCollection::Make( storage );
+		BOOST_REQUIRE( pTimers );
+		for( int i = 0; i < count; ++i ){
+			std::shared_ptr<Timer> pTimer = Timer::Make();
+			pTimer->Start();
+			pTimers->Add( pTimer );
+		}
+
+		auto start = Clock::now();
+		pTimers->Update();
+		const auto updateTime = Clock::now() - start;
+
+		// Assemble a straight line of tracks:
+		std::unique_ptr<TrackCollectionContainer> pContainer = TrackCollectionContainer::Make();
+		std::unique_ptr<TrackCollection> pCollection = TrackCollection::Make( storage );
+		BOOST_REQUIRE( pContainer );
+		BOOST_REQUIRE( pCollection );
+		std::shared_ptr<Line> pLine = Line::Make();
+		Frame<Length,One> frame;
+		frame.Init();
+		for( int i = 0; i < count; ++i ){
+			std::shared_ptr<TrackBuilder> pTrack = TrackBuilder::Make();
+			pTrack->Attach( pLine, { 0_m, 10_m } );
+			pTrack->SetFrame( frame );
+			pCollection->Add( pTrack );
+			frame.TransportTan( 10_m );
+		}
+		pContainer->Add( std::move(pCollection) );
+		std::shared_ptr<TrackSystem> pTrackSystem = TrackSystem::Make( std::move(pContainer) );
+		BOOST_REQUIRE( pTrackSystem );
+
+		start = Clock::now();
+		pTrackSystem->ConnectAll( 1_cm, pi/8 );
+		const auto connectTime = Clock::now() - start;
+
+		start = Clock::now();
+		int connected = 0;
+		for( const TrackBuilder& track : *pTrackSystem->GetCollectionContainer()->GetFirst() ){
+			if( track.IsConnected( EndType::north ) )
+				++connected;
+			if( track.IsConnected( EndType::south ) )
+				++connected;
+		}
+		const auto iterateTime = Clock::now() - start;
+		BOOST_CHECK_EQUAL( connected, 2 * (count - 1) );
+
+		pTrackSystem->DisconnectAll();
+
+		BOOST_TEST_MESSAGE( name << ": TimerCollection::Update " << std::chrono::duration_cast<std::chrono::microseconds>( updateTime ).count() 
+			<< "us, ConnectAll " << std::chrono::duration_cast<std::chrono::microseconds>( connectTime ).count() 
+			<< "us, iteration " << std::chrono::duration_cast<std::chrono::microseconds>( iterateTime ).count() << "us" );
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END() //Collection_Tests
 BOOST_AUTO_TEST_SUITE(TrackSystem_Tests)
 
@@ -235,6 +429,479 @@ BOOST_FIXTURE_TEST_CASE( FoR_TrackTrackCollection6_Test, TrackAndTrackSystem )
 	BOOST_CHECK( LocBefore.Equals( LocAfter, epsilon__length, 0.001f) );
 }
 
+BOOST_FIXTURE_TEST_CASE( FindTrackLocations_SpatialIndex, TrackSystemFixture )
+	// The spatial index must deliver the same results as testing
+	// every single track, also after moving tracks and collections.
+{
+	std::shared_ptr<trax::ArcP> pArc = ArcP::Make();
+	pArc->Create( { Origin3D<Length>, {1,0,0}, {0,50,0} } );
+
+	std::vector<std::shared_ptr<TrackBuilder>> tracks;
+	for( int i = 0; i < 10; ++i ){
+		for( int j = 0; j < 10; ++j ){
+			std::shared_ptr<TrackBuilder> pTrack = TrackBuilder::Make();
+			pTrack->Attach( pArc, {0_m,40_m} );
+			Frame<Length,One> frame;
+			frame.Init();
+			frame.P = { i*60_m, j*60_m, 0_m };
+			frame.RotateBin( i*j*10_deg );
+			pTrack->SetFrame( frame );
+			m_pTrackSystem->Add( pTrack );
+			tracks.push_back( pTrack );
+		}
+	}
+
+	auto BruteForce = [&tracks]( const Sphere<Length>& area ){
+		std::vector<std::pair<IDType,Length>> result;
+		for( const auto& pTrack : tracks ){
+			const Length s = Closest( area.Center(), *pTrack, false );
+			if( s >= 0_m ){
+				Position<Length> p;
+				pTrack->Transition( s, p );
+				if( (p - area.Center()).Length() < area.Radius() )
+					result.push_back( { pTrack->ID(), s } );
+			}
+		}
+		return result;
+	};
+
+	auto CheckAreas = [this,&BruteForce](){
+		for( Length x = -20_m; x < 620_m; x += 45_m ){
+			for( Length y = -20_m; y < 620_m; y += 45_m ){
+				const Sphere<Length> area{ {x,y,0_m}, 15_m };
+				const auto expected = BruteForce( area );
+				const auto found = FindTrackLocations( *m_pTrackSystem, area, false );
+
+				BOOST_REQUIRE_EQUAL( found.size(), expected.size() );
+				for( std::size_t k = 0; k < found.size(); ++k ){
+					BOOST_CHECK_EQUAL( found[k].first.GetTrack()->ID(), expected[k].first );
+					BOOST_CHECK_CLOSE_DIMENSION( found[k].first.Param(), expected[k].second, 0.001f );
+				}
+			}
+		}
+	};
+
+	CheckAreas();
+
+	Frame<Length,One> frame = tracks[42]->GetFrame();
+	frame.P = { 330_m, 330_m, 0_m };
+	tracks[42]->SetFrame( frame );
+	CheckAreas();
+
+	frame.Init();
+	frame.P = { 0_m, 0_m, 0_m };
+	frame.RotateBin( 30_deg );
+	m_pTrackSystem->SetCollectionFrame( m_pTrackSystem->GetActiveCollection(), frame );
+	CheckAreas();
+
+	m_pTrackSystem->Remove( tracks[17].get() );
+	tracks.erase( tracks.begin() + 17 );
+	CheckAreas();
+}
+
+BOOST_AUTO_TEST_CASE( ConnectAll_SameAsSingleConnects )
+	// ConnectAll() uses a grid of the track ends; it has to produce
+	// the same connections as connecting every end on its own.
+{
+	int countConnections = 0;
+	for( const char* layout : { "NewCurves.anl3", "DefaultLayout.anl4", "TestTrackSystem2.anl4" } ){
+		for( const auto& tolerances : { std::make_pair( 1_m, Angle{pi} ), std::make_pair( 5_cm, Angle{pi/8} ) } ){
+			BOOST_TEST_MESSAGE( layout );
+			std::shared_ptr<TrackSystem> pTrackSystemGrid = TrackSystemReader{}.Read( FixtureBase::FixturePath() / layout );
+			std::shared_ptr<TrackSystem> pTrackSystemSingle = TrackSystemReader{}.Read( FixtureBase::FixturePath() / layout );
+			BOOST_REQUIRE( pTrackSystemGrid );
+			BOOST_REQUIRE( pTrackSystemSingle );
+			BOOST_REQUIRE_EQUAL( pTrackSystemGrid->Count(), pTrackSystemSingle->Count() );
+
+			pTrackSystemGrid->DisconnectAll();
+			pTrackSystemGrid->ConnectAll( tolerances.first, tolerances.second );
+
+			pTrackSystemSingle->DisconnectAll();
+			for( const TrackCollection& collection : *pTrackSystemSingle->GetCollectionContainer() ){
+				for( const TrackBuilder& track : collection ){
+					if( !track.IsConnected( EndType::north ) )
+						Connect( collection, {std::const_pointer_cast<TrackBuilder>(track.This()), EndType::north}, tolerances.first, tolerances.second );
+					if( !track.IsConnected( EndType::south ) )
+						Connect( collection, {std::const_pointer_cast<TrackBuilder>(track.This()), EndType::south}, tolerances.first, tolerances.second );
+				}
+			}
+
+			for( const TrackBuilder& trackGrid : *pTrackSystemGrid ){
+				std::shared_ptr<TrackBuilder> pTrackSingle = pTrackSystemSingle->Get( trackGrid.ID() );
+				BOOST_REQUIRE( pTrackSingle );
+
+				for( EndType end : { EndType::north, EndType::south } ){
+					const Track::TrackEnd endGrid = trackGrid.TransitionEnd( end );
+					const Track::TrackEnd endSingle = pTrackSingle->TransitionEnd( end );
+					BOOST_REQUIRE_EQUAL( endGrid.pTrack != nullptr, endSingle.pTrack != nullptr );
+					if( endGrid.pTrack ){
+						BOOST_CHECK_EQUAL( endGrid.pTrack->ID(), endSingle.pTrack->ID() );
+						BOOST_CHECK( endGrid.end == endSingle.end );
+						++countConnections;
+					}
+				}
+			}
+		}
+	}
+
+	BOOST_CHECK_GT( countConnections, 0 );
+
+	std::shared_ptr<TrackSystem> pTrackSystem = TrackSystemReader{}.Read( FixtureBase::FixturePath() / "DefaultLayout.anl4" );
+	BOOST_REQUIRE( pTrackSystem );
+	BOOST_CHECK_THROW( pTrackSystem->ConnectAll( 0_m, pi ), std::invalid_argument );
+	BOOST_CHECK_THROW( pTrackSystem->ConnectAll( 1_m, 0_deg ), std::invalid_argument );
+}
+
+// ID of the plug a jack is wired to, whether it is resolved or not:
+static IDType WiredPlugID( const Jack& jack ){
+	if( jack.Plugged() )
+		if( const Plug* pPlug = GetFirstNonZeroIDPlugInChain( *jack.GetPlug() ) )
+			return pPlug->ID();
+
+	return jack.RefPlugID();
+}
+
+BOOST_AUTO_TEST_CASE( Snapshot_RoundTrip )
+{
+	using Clock = std::chrono::steady_clock;
+
+	for( const char* layout : { "DefaultLayout.anl4", "DefaultLayoutWrite.anl4", "TestTrackSystem2.anl4" } ){
+		BOOST_TEST_MESSAGE( layout );
+
+		Clock::time_point start = Clock::now();
+		std::shared_ptr<TrackSystem> pTrackSystem = TrackSystemReader{}.Read( FixtureBase::FixturePath() / layout );
+		const auto xmlTime = Clock::now() - start;
+		BOOST_REQUIRE( pTrackSystem );
+
+		// The fixtures have no sensors; attach some, the first one wired to a switch:
+		Connector* pConnector = pTrackSystem->GetConnectorCollection() ? pTrackSystem->GetConnectorCollection()->GetFirst().get() : nullptr;
+		int idxTrack = 0;
+		for( TrackBuilder& track : *pTrackSystem ){
+			if( idxTrack % 2 == 0 ){
+				std::shared_ptr<Sensor> pSensor = Sensor::Make();
+				BOOST_REQUIRE( pSensor );
+				pSensor->ID( 2000 + idxTrack );
+				track.Attach( pSensor, TrackLocation{ track.GetLength() / 3, idxTrack % 4 == 0 } );
+
+				if( pConnector && idxTrack == 0 ){
+					Plug& plug = pConnector->PlugToToggle().Make();
+					plug.ID( 10000 );
+					pSensor->JackOnTrigger().Insert( &plug );
+				}
+			}
+
+			++idxTrack;
+		}
+
+		std::vector<unsigned char> buffer;
+		BOOST_REQUIRE_NO_THROW( WriteSnapshot( *pTrackSystem, buffer ) );
+		BOOST_CHECK( IsSnapshot( buffer.data(), buffer.data() + buffer.size() ) );
+
+		const std::filesystem::path snapshotPath = std::filesystem::temp_directory_path() / (std::string{ layout } + ".trxsnap");
+		BOOST_REQUIRE_NO_THROW( WriteSnapshot( *pTrackSystem, snapshotPath ) );
+
+		start = Clock::now();
+		std::shared_ptr<TrackSystem> pFromFile = TrackSystemReader{}.Read( snapshotPath );
+		const auto snapshotTime = Clock::now() - start;
+		std::shared_ptr<TrackSystem> pFromBuffer = ReadSnapshot( buffer.data(), buffer.data() + buffer.size() );
+		std::filesystem::remove( snapshotPath );
+
+		BOOST_TEST_MESSAGE( "xml: " << std::chrono::duration_cast<std::chrono::microseconds>( xmlTime ).count() << "us, snapshot: "
+			<< std::chrono::duration_cast<std::chrono::microseconds>( snapshotTime ).count() << "us, " << buffer.size() << " bytes" );
+
+		for( const std::shared_ptr<TrackSystem>& pCopy : { pFromFile, pFromBuffer } ){
+			BOOST_REQUIRE( pCopy );
+			BOOST_REQUIRE_EQUAL( pCopy->Count(), pTrackSystem->Count() );
+			BOOST_CHECK_EQUAL( pCopy->GetConnectorCollection() ? pCopy->GetConnectorCollection()->Count() : 0,
+				pTrackSystem->GetConnectorCollection() ? pTrackSystem->GetConnectorCollection()->Count() : 0 );
+
+			for( const TrackBuilder& track : *pTrackSystem ){
+				std::shared_ptr<TrackBuilder> pTrack = pCopy->Get( track.ID() );
+				BOOST_REQUIRE( pTrack );
+				BOOST_CHECK_EQUAL( pTrack->GetLength(), track.GetLength() );
+				BOOST_CHECK( pTrack->GetFrame() == track.GetFrame() );
+
+				BOOST_REQUIRE_EQUAL( pTrack->CountSensors(), track.CountSensors() );
+				for( int idx = 0; idx < track.CountSensors(); ++idx ){
+					std::shared_ptr<Sensor> pSensor = track.GetSensor( idx );
+					BOOST_REQUIRE( pSensor );
+					std::shared_ptr<Sensor> pSensorCopy;
+					for( int idxCopy = 0; idxCopy < pTrack->CountSensors(); ++idxCopy )
+						if( pTrack->GetSensor( idxCopy ) && pTrack->GetSensor( idxCopy )->ID() == pSensor->ID() )
+							pSensorCopy = pTrack->GetSensor( idxCopy );
+					BOOST_REQUIRE( pSensorCopy );
+
+					TrackLocation location, locationCopy;
+					BOOST_CHECK( track.Attached( *pSensor, &location ) );
+					BOOST_CHECK( pTrack->Attached( *pSensorCopy, &locationCopy ) );
+					BOOST_CHECK_EQUAL( locationCopy.parameter, location.parameter );
+					BOOST_CHECK( locationCopy.orientation == location.orientation );
+					BOOST_CHECK_EQUAL( WiredPlugID( pSensorCopy->JackOnTrigger() ), WiredPlugID( pSensor->JackOnTrigger() ) );
+					if( pSensor->JackOnTrigger().Plugged() ){
+						BOOST_CHECK( pSensorCopy->JackOnTrigger().Plugged() );
+						BOOST_CHECK_EQUAL( pSensorCopy->JackOnTrigger().ID(), pSensor->JackOnTrigger().ID() );
+					}
+				}
+
+				for( Length s = 0_m; s <= track.GetLength(); s += track.GetLength() / 4 ){
+					Frame<Length,One> A, B;
+					track.Transition( s, A );
+					pTrack->Transition( s, B );
+					BOOST_CHECK( A.Equals( B, epsilon__length ) );
+				}
+
+				for( EndType end : { EndType::north, EndType::south } ){
+					const Track::End connected = track.TransitionEnd( end );
+					const Track::End connectedCopy = pTrack->TransitionEnd( end );
+					BOOST_CHECK_EQUAL( connectedCopy.id, connected.id );
+					BOOST_CHECK( connectedCopy.type == connected.type );
+				}
+			}
+
+			if( const ConnectorCollection* pConnectorCollection = pTrackSystem->GetConnectorCollection() ){
+				for( const Connector& connector : *pConnectorCollection ){
+					std::shared_ptr<Connector> pConnector = pCopy->GetConnectorCollection()->Get( connector.ID() );
+					BOOST_REQUIRE( pConnector );
+					BOOST_CHECK( pConnector->Get() == connector.Get() );
+					BOOST_REQUIRE_EQUAL( pConnector->CntSlots(), connector.CntSlots() );
+					for( int slot = 0; slot < connector.CntSlots(); ++slot ){
+						BOOST_CHECK_EQUAL( pConnector->Slot( slot ).first != nullptr, connector.Slot( slot ).first != nullptr );
+						if( connector.Slot( slot ).first && pConnector->Slot( slot ).first )
+							BOOST_CHECK_EQUAL( pConnector->Slot( slot ).first->ID(), connector.Slot( slot ).first->ID() );
+					}
+
+					// The jacks are wired to the same plugs:
+					const JackEnumerator& jacks = dynamic_cast<const JackEnumerator&>(connector);
+					const JackEnumerator& jacksCopy = dynamic_cast<const JackEnumerator&>(*pConnector);
+					BOOST_REQUIRE_EQUAL( jacksCopy.CountJacks(), jacks.CountJacks() );
+					for( int idx = 0; idx < jacks.CountJacks(); ++idx )
+						BOOST_CHECK_EQUAL( WiredPlugID( jacksCopy.GetJack( idx ) ), WiredPlugID( jacks.GetJack( idx ) ) );
+
+					// The plugged plugs are there with their IDs:
+					const PlugEnumerator& plugs = dynamic_cast<const PlugEnumerator&>(connector);
+					const PlugEnumerator& plugsCopy = dynamic_cast<const PlugEnumerator&>(*pConnector);
+					for( int idx = 0; idx < plugs.CountPlugs(); ++idx ){
+						const Plug& plug = plugs.GetPlug( idx );
+						if( !plug.Plugged() || !plug.ID() )
+							continue;
+
+						bool bWired = false;
+						for( int idxCopy = 0; idxCopy < plugsCopy.CountPlugs(); ++idxCopy ){
+							const Plug& plugCopy = plugsCopy.GetPlug( idxCopy );
+							if( plugCopy.ID() == plug.ID() && plugCopy.Plugged() )
+								bWired = plugCopy.Plugged()->ID() == plug.Plugged()->ID();
+						}
+						BOOST_CHECK_MESSAGE( bWired, "plug " << plug.ID() << " is not wired in the copy." );
+					}
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Snapshot_BrokenData )
+	// Truncated or garbled snapshots have to get rejected before anything big gets allocated.
+{
+	std::shared_ptr<TrackSystem> pTrackSystem = TrackSystem::Make();
+	BOOST_REQUIRE( pTrackSystem );
+	pTrackSystem->CreateCollection();
+
+	std::shared_ptr<SectionTrack> pTrack = SectionTrack::Make();
+	BOOST_REQUIRE( pTrack );
+	pTrack->Attach( Line::Make(), { 0_m, 100_m } );
+	std::unique_ptr<Section> pSection = Section::Make( Section::SpecialSections::custom );
+	BOOST_REQUIRE( pSection );
+	pSection->SetCntPoints( 3 );
+	for( int idx = 0; idx < 3; ++idx )
+		pSection->Set( idx, Section::SectionPoint{ { 0.123_m * (idx + 1), 0.456_m } } );
+	const Section::SectionPoint firstPoint = pSection->Get( 0 );
+	pTrack->Attach( std::move(pSection) );
+	pTrackSystem->Add( pTrack );
+
+	std::vector<unsigned char> buffer;
+	BOOST_REQUIRE_NO_THROW( WriteSnapshot( *pTrackSystem, buffer ) );
+	BOOST_REQUIRE( ReadSnapshot( buffer.data(), buffer.data() + buffer.size() ) );
+
+	for( std::size_t size : { std::size_t{ 0 }, std::size_t{ 20 }, std::size_t{ 40 }, buffer.size() / 2, buffer.size() - 1 } )
+		BOOST_CHECK_THROW( ReadSnapshot( buffer.data(), buffer.data() + size ), std::runtime_error );
+
+	// A payload size that would overflow the size check; it follows the 
+	// magic and four 32 bit fields in the header:
+	std::vector<unsigned char> garbled = buffer;
+	const std::uint64_t payloadSize = std::numeric_limits<std::uint64_t>::max();
+	std::memcpy( garbled.data() + 24, &payloadSize, sizeof(payloadSize) );
+	BOOST_CHECK_THROW( ReadSnapshot( garbled.data(), garbled.data() + garbled.size() ), std::runtime_error );
+
+	// The point count of the custom section precedes its first point:
+	const unsigned char* pFirstPoint = reinterpret_cast<const unsigned char*>(&firstPoint);
+	const auto iter = std::search( buffer.begin(), buffer.end(), pFirstPoint, pFirstPoint + sizeof(firstPoint) );
+	BOOST_REQUIRE( iter != buffer.end() );
+	const std::size_t countAt = (iter - buffer.begin()) - sizeof(std::uint32_t);
+	std::uint32_t countPoints = 0;
+	std::memcpy( &countPoints, buffer.data() + countAt, sizeof(countPoints) );
+	BOOST_REQUIRE_EQUAL( countPoints, 3u );
+
+	for( std::uint32_t count : { 0x7fffffffu, 0xffffffffu } ){
+		garbled = buffer;
+		std::memcpy( garbled.data() + countAt, &count, sizeof(count) );
+		BOOST_CHECK_THROW( ReadSnapshot( garbled.data(), garbled.data() + garbled.size() ), std::runtime_error );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( StreamingParser_BuildsTrackSystem )
+{
+	using Clock = std::chrono::steady_clock;
+
+	for( const char* layout : { "DefaultLayout.anl4", "TestTrackSystem2.anl4" } ){
+		BOOST_TEST_MESSAGE( layout );
+
+		Clock::time_point start = Clock::now();
+		std::shared_ptr<TrackSystem> pTrackSystem = TrackSystemReader{}.Read( FixtureBase::FixturePath() / layout );
+		const auto domTime = Clock::now() - start;
+		BOOST_REQUIRE( pTrackSystem );
+
+		TrackSystemBuilder builder;
+		start = Clock::now();
+		BOOST_REQUIRE( ParseTrackSystem( (FixtureBase::FixturePath() / layout).string(), builder ) );
+		const auto streamTime = Clock::now() - start;
+		std::shared_ptr<TrackSystem> pStreamed = builder.GetTrackSystem();
+		BOOST_REQUIRE( pStreamed );
+
+		BOOST_TEST_MESSAGE( "property tree: " << std::chrono::duration_cast<std::chrono::microseconds>( domTime ).count() << "us, streaming: "
+			<< std::chrono::duration_cast<std::chrono::microseconds>( streamTime ).count() << "us" );
+
+		BOOST_REQUIRE_EQUAL( pStreamed->Count(), pTrackSystem->Count() );
+		for( const TrackBuilder& track : *pTrackSystem ){
+			std::shared_ptr<TrackBuilder> pTrack = pStreamed->Get( track.ID() );
+			BOOST_REQUIRE( pTrack );
+			BOOST_CHECK_EQUAL( pTrack->GetLength(), track.GetLength() );
+			BOOST_CHECK( pTrack->GetFrame() == track.GetFrame() );
+
+			for( Length s = 0_m; s <= track.GetLength(); s += track.GetLength() / 4 ){
+				Frame<Length,One> A, B;
+				track.Transition( s, A );
+				pTrack->Transition( s, B );
+				BOOST_CHECK( A.Equals( B, epsilon__length ) );
+			}
+		}
+
+		if( !pTrackSystem->GetConnectorCollection() || pTrackSystem->GetConnectorCollection()->Count() == 0 ){
+			// Without switches all the connections are made by the tracks:
+			for( const TrackBuilder& track : *pTrackSystem ){
+				for( EndType end : { EndType::north, EndType::south } ){
+					const Track::End connected = track.TransitionEnd( end );
+					const Track::End connectedStreamed = pStreamed->Get( track.ID() )->TransitionEnd( end );
+					BOOST_CHECK_EQUAL( connectedStreamed.id, connected.id );
+					BOOST_CHECK( connectedStreamed.type == connected.type );
+				}
+			}
+		}
+	}
+}
+
+// Peak memory the process used so far in bytes, or 0 if unknown:
+static std::size_t PeakMemory() noexcept{
+#if defined( _WIN32 )
+	PROCESS_MEMORY_COUNTERS counters{};
+	if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof(counters) ) )
+		return counters.PeakWorkingSetSize;
+	return 0;
+#else
+	rusage usage{};
+	if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+		return 0;
+#	if defined( __APPLE__ )
+	return static_cast<std::size_t>(usage.ru_maxrss);
+#	else
+	return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#	endif
+#endif
+}
+
+BOOST_AUTO_TEST_CASE( StreamingParser_Throughput )
+{
+	struct TrackCounter : TrackSystemParser{
+		int tracks = 0;
+		int curves = 0;
+
+		bool TrackStart( IDType, const std::string& ) override { ++tracks; return true; }
+		void CurveEnd() override { ++curves; }
+	};
+
+	std::ifstream file{ FixtureBase::FixturePath() / "DefaultLayout.anl4", std::ios::binary };
+	const std::string layout{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	const std::size_t collectionsStart = layout.find( "<TrackCollection" );
+	const std::size_t collectionsEnd = layout.rfind( "</TrackCollection>" ) + std::strlen( "</TrackCollection>" );
+	BOOST_REQUIRE( collectionsStart != std::string::npos );
+	BOOST_REQUIRE( collectionsEnd > collectionsStart );
+
+	TrackCounter single;
+	BOOST_REQUIRE( ParseTrackSystem( layout.data(), layout.data() + layout.size(), single ) );
+	BOOST_CHECK_GT( single.tracks, 0 );
+	BOOST_CHECK_EQUAL( single.curves, single.tracks );
+
+	// A hundred times the track collections:
+	const int factor = 100;
+	std::string scaled = layout.substr( 0, collectionsStart );
+	for( int i = 0; i < factor; ++i )
+		scaled.append( layout, collectionsStart, collectionsEnd - collectionsStart );
+	scaled.append( layout, collectionsEnd );
+
+	TrackCounter counter;
+	const std::size_t peakBefore = PeakMemory();
+	const auto start = std::chrono::steady_clock::now();
+	BOOST_REQUIRE( ParseTrackSystem( scaled.data(), scaled.data() + scaled.size(), counter ) );
+	const auto time = std::chrono::steady_clock::now() - start;
+	const std::size_t peakAfter = PeakMemory();
+	BOOST_CHECK_EQUAL( counter.tracks, factor * single.tracks );
+	BOOST_CHECK_EQUAL( counter.curves, factor * single.curves );
+
+	// The parser streams; it must not hold anything like a document tree in memory.
+	// The peak is for the whole process, so the parser might have stayed below an earlier one:
+	BOOST_CHECK_LT( peakAfter - peakBefore, scaled.size() );
+
+	const auto us = std::max<long long>( 1, std::chrono::duration_cast<std::chrono::microseconds>( time ).count() );
+	BOOST_TEST_MESSAGE( scaled.size() << " bytes in " << us << "us, " << scaled.size() / us << " MB/s, peak memory " 
+		<< peakAfter / 1024 << "kB (" << (peakAfter - peakBefore) / 1024 << "kB more while parsing)" );
+}
+
+BOOST_AUTO_TEST_CASE( StreamingParser_MalformedInput )
+{
+	TrackSystemParser callback;
+	const std::string unterminated = "<traxML><Module><TrackSystem><TrackCollection id=\"1\">";
+	BOOST_CHECK_THROW( ParseTrackSystem( unterminated.data(), unterminated.data() + unterminated.size(), callback ), std::runtime_error );
+
+	const std::string mismatched = "<traxML><TrackSystem></TrackCollection></traxML>";
+	BOOST_CHECK_THROW( ParseTrackSystem( mismatched.data(), mismatched.data() + mismatched.size(), callback ), std::runtime_error );
+
+	const std::string noTrackSystem = "<?xml version=\"1.0\"?><!-- nothing --><traxML/>";
+	BOOST_CHECK( !ParseTrackSystem( noTrackSystem.data(), noTrackSystem.data() + noTrackSystem.size(), callback ) );
+}
+
+BOOST_AUTO_TEST_CASE( Reader_FromBuffer )
+{
+	for( const char* layout : { "DefaultLayout.anl4", "TestTrackSystem2.anl4" } ){
+		BOOST_TEST_MESSAGE( layout );
+
+		std::ifstream file{ FixtureBase::FixturePath() / layout, std::ios::binary };
+		BOOST_REQUIRE( file );
+		const std::vector<unsigned char> buffer{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+		std::shared_ptr<TrackSystem> pFromFile = TrackSystemReader{}.Read( FixtureBase::FixturePath() / layout );
+		std::shared_ptr<TrackSystem> pFromBuffer = TrackSystemReader{}.Read( buffer.data(), buffer.data() + buffer.size() );
+		BOOST_REQUIRE( pFromFile );
+		BOOST_REQUIRE( pFromBuffer );
+		BOOST_REQUIRE_EQUAL( pFromBuffer->Count(), pFromFile->Count() );
+
+		for( const TrackBuilder& track : *pFromFile ){
+			std::shared_ptr<TrackBuilder> pTrack = pFromBuffer->Get( track.ID() );
+			BOOST_REQUIRE( pTrack );
+			BOOST_CHECK_EQUAL( pTrack->GetLength(), track.GetLength() );
+			BOOST_CHECK( pTrack->GetFrame() == track.GetFrame() );
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END() //TrackSystem_Tests
 BOOST_AUTO_TEST_SUITE_END() //trax_tests
 #endif // WITH_BOOST_TESTS
\ No newline at end of file
@@ -13,9 +13,11 @@
 
 #include "trax/rigid/Scene.h"
 #include "trax/rigid/Simulator.h"
+#include "trax/rigid/Geom.h"
 #include "trax/rigid/Gestalt.h"
 #include "trax/LogicElements.h"
 #include "trax/Plug.h"
+#include "trax/rigid/engines/PhysX/source/PhysX_Scene.h"
 
 #include "dim/support/DimSupportStream.h"
 #include "dim/BoostTestDimensionedValuesHelpers.h"
@@ -203,5 +205,43 @@ BOOST_AUTO_TEST_CASE( testBodyParameters2 )
 	BOOST_CHECK_CLOSE_SPATIAL( bodyFrame.ToParent(pGestalt->CenterOfMass()), COMWord, epsilon__length );
 }
 
+BOOST_AUTO_TEST_CASE( testCylinderTessellation )
+{
+	std::unique_ptr<Simulator> pSimulator = Simulator::Make( Simulator::Type::PhysX );
+	BOOST_REQUIRE( pSimulator );
+	std::unique_ptr<Scene> pScene = Scene::Make( *pSimulator );
+	BOOST_REQUIRE( pScene );
+
+	std::unique_ptr<GeomCylinder> pCylinder1 = pScene->CreateGeomCylinder();
+	std::unique_ptr<GeomCylinder> pCylinder2 = pScene->CreateGeomCylinder();
+	BOOST_CHECK_EQUAL( pCylinder1->Tessellation(), 16 );
+	BOOST_CHECK_THROW( pCylinder1->Tessellation( 2 ), std::invalid_argument );
+	BOOST_CHECK_THROW( pCylinder1->Tessellation( 128 ), std::invalid_argument );
+
+	// Cylinders with equal dimensions share their mesh:
+	pCylinder1->Radius( 0.5_m );
+	pCylinder1->SetLength( 0.1_m );
+	pCylinder2->Radius( 0.5_m );
+	pCylinder2->SetLength( 0.1_m );
+	pCylinder2->Tessellation( 8 );
+	BOOST_CHECK_EQUAL( pCylinder2->Tessellation(), 8 );
+	std::unique_ptr<Geom> pCylinder3 = pCylinder1->Instance();
+
+	std::unique_ptr<Gestalt> pGestalt = pScene->CreateGestalt();
+	pGestalt->Attach( std::move(pCylinder1), 500_kg );
+	pGestalt->Attach( std::move(pCylinder2), 500_kg );
+	pGestalt->Attach( std::move(pCylinder3), 500_kg );
+	BOOST_CHECK_CLOSE_FRACTION_DIMENSION( pGestalt->GetMass(), 1500_kg, epsilon__mass );
+
+	// The scene hands out the same mesh for dimensions that quantize equally:
+	const PhysX_Scene& physxScene = dynamic_cast<const PhysX_Scene&>(*pScene);
+	std::shared_ptr<physx::PxConvexMesh> pMesh = physxScene.CylinderMesh( 0.5_m, 0.1_m, 16 );
+	BOOST_REQUIRE( pMesh );
+	BOOST_CHECK( physxScene.CylinderMesh( 0.5_m, 0.1_m, 16 ) == pMesh );
+	BOOST_CHECK( physxScene.CylinderMesh( 0.5_m + epsilon__length / 4, 0.1_m - epsilon__length / 4, 16 ) == pMesh );
+	BOOST_CHECK( physxScene.CylinderMesh( 0.5_m, 0.1_m, 8 ) != pMesh );
+	BOOST_CHECK( physxScene.CylinderMesh( 0.5_m, 0.1_m, 8 ) != nullptr );
+	BOOST_CHECK( physxScene.CylinderMesh( 0.6_m, 0.1_m, 16 ) != pMesh );
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@
 #include "trax/rigid/Scene.h"
 #include "trax/rigid/Simulator.h"
 #include "trax/rigid/StaticTrack.h"
+#include "trax/rigid/StaticTrackCooker.h"
 #include "trax/Curve.h"
 #include "trax/Section.h"
 
@@ -38,6 +39,9 @@
 #include "spat/Frame.h"
 #include "spat/BoostTestSpatialHelpers.h"
 
+#include <filesystem>
+#include <fstream>
+
 using namespace dim;
 using namespace spat;
 using namespace trax;
@@ -106,4 +110,92 @@ BOOST_FIXTURE_TEST_CASE( CollectionFrameShift_Test3, TrackSystemFixture )
 	m_pTrackSystem.reset();
 }
 
+BOOST_AUTO_TEST_CASE( cookerCachesMeshes )
+{
+	std::unique_ptr<Simulator> pSimulator = Simulator::Make( Simulator::Type::PhysX );
+	BOOST_REQUIRE( pSimulator );
+	std::unique_ptr<Scene> pScene = Scene::Make( *pSimulator );
+	BOOST_REQUIRE( pScene );
+
+	const std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "trax_TestStaticTrack_cooker";
+	std::filesystem::remove_all( cacheDirectory );
+
+	std::shared_ptr<Section> pSection = Section::Make( Section::SpecialSections::vignol_UIC60 );
+	auto MakeTracks = [&pScene,&pSection](){
+		std::vector<std::shared_ptr<StaticTrack>> tracks;
+		for( int i = 1; i <= 8; ++i ){
+			std::shared_ptr<StaticTrack> pTrack = StaticTrack::Make( *pScene );
+			std::shared_ptr<ArcP> pArc = ArcP::Make();
+			const Length R = i * 100_m;
+			pArc->Create( { Origin3D<Length>, {1,0,0}, {0,_m(R),0} } );
+			pTrack->Attach( pSection );
+			pTrack->Attach( pArc, { 0_m, 50_m } );
+			tracks.push_back( pTrack );
+		}
+		return tracks;
+	};
+
+	{
+		StaticTrackCooker cooker;
+		cooker.CacheDirectory( cacheDirectory );
+		std::vector<std::shared_ptr<StaticTrack>> tracks;
+		{
+			StaticTrackCooker::Scope scope{ cooker };
+			tracks = MakeTracks();
+		}
+
+		BOOST_CHECK_GE( cooker.Count(), tracks.size() );
+		BOOST_CHECK_EQUAL( cooker.Cook(), 8 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().cooked, 8 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().painted, 8 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().loaded, 0 );
+		BOOST_CHECK_EQUAL( cooker.Count(), 0u );
+	}
+
+	{
+		StaticTrackCooker cooker;
+		cooker.CacheDirectory( cacheDirectory );
+		std::vector<std::shared_ptr<StaticTrack>> tracks;
+		{
+			StaticTrackCooker::Scope scope{ cooker };
+			tracks = MakeTracks();
+		}
+
+		BOOST_CHECK_EQUAL( cooker.Cook(), 8 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().cooked, 0 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().painted, 0 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().loaded, 8 );
+	}
+
+	// A file with a different key, e.g. one with a colliding name, is not used:
+	int countFiles = 0;
+	for( const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{ cacheDirectory } ){
+		std::fstream file{ entry.path(), std::ios::binary | std::ios::in | std::ios::out };
+		BOOST_REQUIRE( file );
+		const std::streamoff keyStart = 16; // behind the magic and the key size
+		file.seekg( keyStart );
+		const char byte = static_cast<char>(file.get() ^ 0xff);
+		file.seekp( keyStart );
+		file.put( byte );
+		++countFiles;
+	}
+	BOOST_CHECK_EQUAL( countFiles, 8 );
+
+	{
+		StaticTrackCooker cooker;
+		cooker.CacheDirectory( cacheDirectory );
+		std::vector<std::shared_ptr<StaticTrack>> tracks;
+		{
+			StaticTrackCooker::Scope scope{ cooker };
+			tracks = MakeTracks();
+		}
+
+		BOOST_CHECK_EQUAL( cooker.Cook(), 8 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().cooked, 8 );
+		BOOST_CHECK_EQUAL( cooker.GetStatistics().loaded, 0 );
+	}
+
+	std::filesystem::remove_all( cacheDirectory );
+}
+
 BOOST_AUTO_TEST_SUITE_END() //TestStaticTrack
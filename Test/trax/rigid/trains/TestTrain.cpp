@@ -32,10 +32,13 @@
 #include "trax/rigid/trains/support/FixturesTrain.h"
 
 #include "trax/support/TraxSupportStream.h"
+#include "trax/LogicElements.h"
+#include "trax/Simulated.h"
 #include "trax/rigid/StaticTrack.h"
 #include "trax/collections/TrackSystem.h"
 #include "trax/rigid/trains/support/RollingStockCreator.h"
 #include "trax/rigid/trains/support/TrainFileReader.h"
+#include "trax/rigid/trains/Bogie.h"
 #include "trax/rigid/trains/RollingStock.h"
 #include "trax/rigid/trains/Train.h"
 #include "trax/rigid/trains/collections/Fleet.h"
@@ -45,6 +48,9 @@
 #include "dim/BoostTestDimensionedValuesHelpers.h"
 #include "spat/BoostTestSpatialHelpers.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace spat;
 using namespace trax;
 
@@ -476,6 +482,325 @@ BOOST_FIXTURE_TEST_CASE( testMultipleTrainsRunning, MultiTrackSystemFixture )
 	m_pTrackSystem.reset();
 }
 
+BOOST_FIXTURE_TEST_CASE( testEngineThreadsStepTime, MultiTrackSystemFixture )
+{
+	BOOST_CHECK_THROW( m_pScene->EngineThreads( -1 ), std::invalid_argument );
+
+	{
+		const int cntSystems = 8;
+		BuildFixture( cntSystems );
+
+		std::vector<std::shared_ptr<Train>> trains;
+		for( int i = 0; i < cntSystems; ++i )
+		{
+			TrainFileReferenceReader reader{ *m_pScene, FixturePath() };
+			BOOST_REQUIRE( reader( "Cargo.train" ) );
+			std::shared_ptr<Train> pTrain = reader.GetTrain();
+			BOOST_REQUIRE( pTrain );
+
+			pTrain->Rail( Location{ m_pTrackSystem->Get( 4*i+1 ), TrackLocation{ 0_m, true } } );
+			pTrain->TargetVelocity( 10_mIs );
+			pTrain->Thrust( 0.75 );
+			BOOST_REQUIRE( pTrain->IsRailed() );
+
+			trains.push_back( pTrain );
+		}
+
+		const int hardware = static_cast<int>(std::max( 1u, std::thread::hardware_concurrency() ));
+		const int nSteps = 500;
+		for( int nThreads : { 0, 1, 2, 4, hardware } )
+		{
+			m_pScene->EngineThreads( nThreads );
+			BOOST_CHECK_EQUAL( m_pScene->EngineThreads(), nThreads );
+
+			const auto start = std::chrono::steady_clock::now();
+			for( int step = 0; step < nSteps; ++step )
+				m_pScene->Step();
+			const auto end = std::chrono::steady_clock::now();
+
+			const auto duration = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+			std::cout << "Engine threads: " << nThreads << "; mean step time: " << duration / nSteps << "us" << std::endl;
+		}
+
+		m_pScene->EngineThreads( 2, true );
+		BOOST_CHECK_EQUAL( m_pScene->EngineThreads(), 2 );
+		for( int step = 0; step < 10; ++step )
+			m_pScene->Step();
+		m_pScene->DumpTasksTo( std::cout );
+
+		for( const auto& pTrain : trains )
+			BOOST_CHECK( pTrain->IsRailed() );
+	}
+
+	m_pTrackSystem.reset();
+}
+
+BOOST_FIXTURE_TEST_CASE( testPipelinedStepTime, MultiTrackSystemFixture )
+{
+	{
+		const int cntSystems = 8;
+		BuildFixture( cntSystems );
+
+		std::vector<std::shared_ptr<Train>> trains;
+		for( int i = 0; i < cntSystems; ++i )
+		{
+			TrainFileReferenceReader reader{ *m_pScene, FixturePath() };
+			BOOST_REQUIRE( reader( "Cargo.train" ) );
+			std::shared_ptr<Train> pTrain = reader.GetTrain();
+			BOOST_REQUIRE( pTrain );
+
+			pTrain->Rail( Location{ m_pTrackSystem->Get( 4*i+1 ), TrackLocation{ 0_m, true } } );
+			pTrain->TargetVelocity( 10_mIs );
+			pTrain->Thrust( 0.75 );
+			BOOST_REQUIRE( pTrain->IsRailed() );
+
+			trains.push_back( pTrain );
+		}
+
+		// Stands in for the work a game loop does between the steps, e.g. 
+		// extracting the train positions for rendering:
+		std::vector<Position<Length>> positions( trains.size() );
+		auto Extract = [&trains,&positions](){
+			for( std::size_t i = 0; i < trains.size(); ++i )
+				for( int repeat = 0; repeat < 100; ++repeat )
+					trains[i]->GetLocation().Transition( positions[i] );
+		};
+
+		const int nSteps = 500;
+		auto Run = [this,&Extract,nSteps](){
+			const auto start = std::chrono::steady_clock::now();
+			for( int step = 0; step < nSteps; ++step ){
+				m_pScene->Step();
+				Extract();
+			}
+			const auto end = std::chrono::steady_clock::now();
+			return std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+		};
+
+		m_pScene->BeginSimulation();
+
+		BOOST_CHECK( !m_pScene->Pipelined() );
+		const auto serial = Run();
+
+		m_pScene->Pipelined( true );
+		BOOST_CHECK( m_pScene->Pipelined() );
+		const auto pipelined = Run();
+		m_pScene->Pipelined( false );
+
+		m_pScene->EndSimulation();
+
+		std::cout << "Mean step time serial: " << serial / nSteps << "us, pipelined: " << pipelined / nSteps << "us; speedup: " 
+			<< static_cast<double>(serial) / std::max( pipelined, decltype(pipelined){1} ) << std::endl;
+
+		BOOST_CHECK_CLOSE_DIMENSION( m_pScene->SimulationTime(), 2 * nSteps * fixed_timestep, 0.1 );
+		for( const auto& pTrain : trains )
+			BOOST_CHECK( pTrain->IsRailed() );
+	}
+
+	m_pTrackSystem.reset();
+}
+
+BOOST_FIXTURE_TEST_CASE( testDeferredPulses, TrainFixture )
+{
+	// Pulses a jack on every update and records what the counter plugged 
+	// into it had counted at that moment:
+	struct Pulser : Simulated{
+		Pulser( PulseCounter& counter, bool bParallel )
+			: m_Counter{ counter }, m_bParallel{ bParallel }
+		{
+			m_JackOnUpdate.Insert( &counter.PlugToCountUp().Make() );
+		}
+
+		const char*	TypeName() const noexcept override{ return "Pulser"; }
+		void Registered( Scene& ) noexcept override{}
+		void Unregistered( Scene& ) noexcept override{}
+		bool Start() override{ return true; }
+		void Idle() override{}
+		void PreUpdate() override{}
+		void Update( Time ) override{
+			m_JackOnUpdate.Pulse();
+			m_Seen.push_back( m_Counter.Counter() );
+		}
+		bool ParallelUpdate() const noexcept override{ return m_bParallel; }
+		void Pause() noexcept override{}
+		void Resume() noexcept override{}
+		void Stop() noexcept override{}
+
+		PulseCounter& m_Counter;
+		const bool m_bParallel;
+		Jack_Imp m_JackOnUpdate{ "JackOnUpdate" };
+		std::vector<int> m_Seen;
+	};
+
+	std::unique_ptr<PulseCounter> pCounter = PulseCounter::Make();
+	Pulser serial{ *pCounter, false }, parallel{ *pCounter, true };
+	m_pScene->Register( serial );
+	m_pScene->Register( parallel );
+	m_pScene->UpdateThreads( 2 );
+	m_pScene->BeginSimulation();
+
+	BOOST_CHECK( !m_pScene->DeferPulses() );
+	m_pScene->Step();
+	BOOST_CHECK_EQUAL( pCounter->Counter(), 2 );
+	BOOST_CHECK_EQUAL( serial.m_Seen.back(), 1 );
+	BOOST_CHECK_EQUAL( m_pScene->PulseStatistics().commits, 0u );
+
+	m_pScene->DeferPulses( true );
+	BOOST_CHECK( m_pScene->DeferPulses() );
+	m_pScene->Step();
+	m_pScene->Step();
+	BOOST_CHECK_EQUAL( pCounter->Counter(), 6 );
+	BOOST_CHECK_EQUAL( serial.m_Seen.back(), 4 );
+	BOOST_CHECK_EQUAL( parallel.m_Seen.back(), 4 );
+
+	const PulseQueue::Statistics& statistics = m_pScene->PulseStatistics();
+	BOOST_CHECK_EQUAL( statistics.commits, 2u );
+	BOOST_CHECK_EQUAL( statistics.delivered, 4u );
+	BOOST_CHECK_EQUAL( statistics.maxDepth, 2u );
+	std::cout << "Deferred pulse delivery took " << statistics.totalDelivery.count() / statistics.commits << "ns per step." << std::endl;
+
+	m_pScene->DeferPulses( false );
+	m_pScene->Unregister( parallel );
+	m_pScene->Unregister( serial );
+	m_pScene->Step(); // gets the unregistrations done
+	m_pScene->EndSimulation();
+	m_pScene->UpdateThreads( 1 );
+}
+
+BOOST_FIXTURE_TEST_CASE( testParallelUpdateGroups, TrainFixture )
+// Objects that share data get updated on one thread in order of registration:
+{
+	struct Member : Simulated{
+		Member( std::atomic<int>& sequence, const void* pShared )
+			: m_Sequence{ sequence }, m_pShared{ pShared }
+		{}
+
+		const char*	TypeName() const noexcept override{ return "Member"; }
+		void Registered( Scene& ) noexcept override{}
+		void Unregistered( Scene& ) noexcept override{}
+		bool Start() override{ return true; }
+		void Idle() override{}
+		void PreUpdate() override{}
+		void Update( Time ) override{
+			m_Thread = std::this_thread::get_id();
+			m_Order = m_Sequence++;
+		}
+		bool ParallelUpdate() const noexcept override{ return true; }
+		void UpdateNeighbours( std::vector<const void*>& neighbours ) const override{
+			if( m_pShared )
+				neighbours.push_back( m_pShared );
+		}
+		void Pause() noexcept override{}
+		void Resume() noexcept override{}
+		void Stop() noexcept override{}
+
+		std::atomic<int>& m_Sequence;
+		const void* m_pShared;
+		std::thread::id m_Thread;
+		int m_Order = -1;
+	};
+
+	// a and c share a track, d names b:
+	std::atomic<int> sequence{ 0 };
+	Member a{ sequence, m_pTrack1.get() }, b{ sequence, nullptr }, c{ sequence, m_pTrack1.get() }; 
+	Member d{ sequence, static_cast<const Simulated*>(&b) };
+	for( Member* pMember : { &a, &b, &c, &d } )
+		m_pScene->Register( *pMember );
+
+	m_pScene->BeginSimulation();
+	m_pScene->Step();
+	BOOST_CHECK_LT( a.m_Order, b.m_Order );
+	BOOST_CHECK_LT( b.m_Order, c.m_Order );
+	BOOST_CHECK_LT( c.m_Order, d.m_Order );
+
+	m_pScene->UpdateThreads( 4 );
+	for( int step = 0; step < 20; ++step ){
+		m_pScene->Step();
+		BOOST_CHECK( a.m_Thread == c.m_Thread );
+		BOOST_CHECK_LT( a.m_Order, c.m_Order );
+		BOOST_CHECK( b.m_Thread == d.m_Thread );
+		BOOST_CHECK_LT( b.m_Order, d.m_Order );
+	}
+
+	for( Member* pMember : { &a, &b, &c, &d } )
+		m_pScene->Unregister( *pMember );
+	m_pScene->Step(); // gets the unregistrations done
+	m_pScene->EndSimulation();
+	m_pScene->UpdateThreads( 1 );
+}
+
+BOOST_AUTO_TEST_CASE( testParallelUpdateDeterminism )
+// Updating the bogies and trains in parallel has to come to the very 
+// same results as updating them serially:
+{
+	struct Result{
+		std::vector<Position<Length>> positions;
+		std::vector<Velocity> velocities;
+		std::vector<Track::Reservation> reservations;
+	};
+
+	auto Run = []( int nThreads ){
+		Result result;
+		MultiTrackSystemFixture fixture;
+		const int cntSystems = 4;
+		fixture.BuildFixture( cntSystems );
+		fixture.m_pScene->UpdateThreads( nThreads );
+		BOOST_CHECK_EQUAL( fixture.m_pScene->UpdateThreads(), nThreads );
+
+		std::unique_ptr<Fleet> pFleet = Fleet::Make();
+		BOOST_REQUIRE( pFleet );
+		fixture.m_pScene->Register( *pFleet );
+
+		std::vector<std::shared_ptr<Train>> trains;
+		for( int i = 0; i < cntSystems; ++i )
+		{
+			TrainFileReferenceReader reader{ *fixture.m_pScene, FixtureBase::FixturePath() };
+			BOOST_REQUIRE( reader( "Cargo.train" ) );
+			std::shared_ptr<Train> pTrain = reader.GetTrain();
+			BOOST_REQUIRE( pTrain );
+
+			pFleet->Add( pTrain );
+			pTrain->ReservationLookAhead( 50_m );
+			pTrain->Rail( Location{ fixture.m_pTrackSystem->Get( 4*i+1 ), TrackLocation{ 0_m, true } } );
+			pTrain->TargetVelocity( 10_mIs );
+			pTrain->Thrust( 0.75 );
+			BOOST_REQUIRE( pTrain->IsRailed() );
+
+			trains.push_back( pTrain );
+		}
+
+		for( int step = 0; step < 300; ++step )
+			fixture.m_pScene->Step();
+
+		for( const auto& pTrain : trains ){
+			Position<Length> position;
+			pTrain->GetLocation().Transition( position );
+			result.positions.push_back( position );
+			result.velocities.push_back( pTrain->GetVelocity() );
+		}
+
+		for( const TrackBuilder& track : *fixture.m_pTrackSystem )
+			result.reservations.insert( result.reservations.end(), track.BeginReservations(), track.EndReservations() );
+
+		pFleet->Clear();
+		fixture.m_pScene->Unregister( *pFleet );
+		fixture.m_pScene->Step(); // gets the unregistrations done
+		return result;
+	};
+
+	const Result serial = Run( 1 );
+	const Result parallel = Run( 4 );
+
+	BOOST_REQUIRE_EQUAL( serial.positions.size(), parallel.positions.size() );
+	for( std::size_t idx = 0; idx < serial.positions.size(); ++idx ){
+		BOOST_CHECK_EQUAL( serial.positions[idx], parallel.positions[idx] );
+		BOOST_CHECK_EQUAL( serial.velocities[idx], parallel.velocities[idx] );
+	}
+
+	BOOST_CHECK( !serial.reservations.empty() );
+	BOOST_CHECK( serial.reservations == parallel.reservations );
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TrainRunningTests
 BOOST_AUTO_TEST_SUITE(TrainCouplingTests)
 
@@ -924,6 +1249,99 @@ BOOST_FIXTURE_TEST_CASE( testTrainCoupleWitSingleRollingStock, TrainFixture )
 	BOOST_CHECK( pTrain->GetIndexOf( *pRollingStock ) >= 0 );
 }
 
+BOOST_FIXTURE_TEST_CASE( testFleetCouplingBroadPhase, TrainFixture )
+// The broad phase has to come to the same coupling decisions as testing all 
+// pairs of activated couplings would:
+{
+	TrainFileReferenceReader reader{ *m_pScene, FixturePath() };
+	BOOST_REQUIRE( reader( "Cargo.train" ) );
+	std::shared_ptr<Train> pTrain = reader.GetTrain();
+	BOOST_REQUIRE( pTrain );
+
+	std::unique_ptr<Fleet> pFleet = Fleet::Make();
+	m_pScene->Register( *pFleet );
+	m_pScene->Pipelined( false );
+	pFleet->Add( pTrain );
+
+	pTrain->Rail( m_Location );
+	pTrain->ActivateCoupling( EndType::north );
+	pTrain->ActivateCoupling( EndType::south );
+
+	RollingStockCreator creator{ *m_pScene };
+	RollingStockFileReader rs_reader{ creator, FixturePath() };
+	BOOST_REQUIRE( rs_reader( "BR212_267-9_2cb_SM2.rollingstock" ) );
+	std::shared_ptr<RollingStock> pRollingStock = creator.GetRollingStock();
+	BOOST_REQUIRE( pRollingStock );
+	std::shared_ptr<Train> pTrainSingle = Train::Make();
+	pTrainSingle->Create( *pRollingStock );
+	pFleet->Add( pTrainSingle );
+	pTrainSingle->ActivateCoupling( EndType::north );
+	pTrainSingle->ActivateCoupling( EndType::south );
+	m_Location.Move( pTrain->GetLength() );
+	pRollingStock->Rail( m_Location );
+
+	std::vector<Bogie*> bogies;
+	auto CollectBogies = [&bogies]( const RollingStock& rollingStock ){
+		for( int idx = 0; idx < rollingStock.GetNumberOfBogies(); ++idx )
+			bogies.push_back( &rollingStock.GetBogie( idx ) );
+	};
+	for( int idx = 0; idx < pTrain->GetNumberOfComponents(); ++idx )
+		if( std::shared_ptr<RollingStock> pComponent = std::dynamic_pointer_cast<RollingStock>(pTrain->GetComponent( idx )) )
+			CollectBogies( *pComponent );
+	CollectBogies( *pRollingStock );
+
+	pTrain->TargetVelocity( 25_kmIh );
+	pTrain->Thrust( 0.75 );
+	pTrain->Brake( 0.75 );
+
+	const Length l = pTrain->GetLength();
+	const Acceleration a = pTrain->ThrustAbsolute()/2 / pTrain->TotalMass();
+	const Time simulationTime = sqrt( 2 * l / a );
+
+	int countCoupled = 0;
+	for( Time t = 0_s; t < simulationTime; t += fixed_timestep )
+	{
+		std::vector<std::pair<Bogie*,EndType>> activated;
+		for( Bogie* pBogie : bogies )
+			for( EndType end : { EndType::north, EndType::south } )
+				if( pBogie->IsActivated( end ) )
+					activated.push_back( { pBogie, end } );
+
+		m_pScene->Step();
+
+		// Not pipelined, the couplings are still where the fleet found them:
+		for( std::size_t i = 0; i < activated.size(); ++i )
+		{
+			const auto [pA,endA] = activated[i];
+			const Sphere<Length> A = pA->GetCoupling( endA );
+			if( const std::pair<std::shared_ptr<Bogie>,EndType> coupled = pA->GetCoupledBogie( endA ); coupled.first )
+			{
+				const Sphere<Length> B = coupled.first->GetCoupling( coupled.second );
+				BOOST_CHECK_LT( (B.Center() - A.Center()).Length(), A.Radius() + B.Radius() );
+				++countCoupled;
+				continue;
+			}
+
+			for( std::size_t j = i + 1; j < activated.size(); ++j )
+			{
+				const auto [pB,endB] = activated[j];
+				if( pB == pA || pB->GetCoupledBogie( endB ).first )
+					continue;
+
+				const int typeIdx = pA->GetCouplingProps( endA ).CouplingTypeIdx;
+				if( typeIdx <= 0 || typeIdx != pB->GetCouplingProps( endB ).CouplingTypeIdx )
+					continue;
+
+				const Sphere<Length> B = pB->GetCoupling( endB );
+				BOOST_CHECK_GE( (B.Center() - A.Center()).Length(), A.Radius() + B.Radius() );
+			}
+		}
+	}
+
+	BOOST_CHECK_GT( countCoupled, 0 );
+	BOOST_CHECK( pRollingStock->GetTrain() == pTrain.get() );
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TrainCouplingTests
 
 BOOST_AUTO_TEST_SUITE(TrainRailingTests)
@@ -30,11 +30,14 @@
 #include <boost/test/unit_test.hpp>
 
 #include "trax/support/Fixtures.h"
+#include "trax/collections/support/FixturesCollections.h"
+#include "trax/collections/support/TrackSystemSnapshot.h"
 
 #include "trax/support/TraxSupportStream.h"
 #include "trax/rigid/Simulator.h"
 #include "trax/rigid/Scene.h"
 #include "trax/rigid/trains/WheelFrame.h"
+#include "trax/rigid/trains/WheelFrameSensors.h"
 #include "trax/rigid/Body.h"
 #include "trax/support/TraxSupportStream.h"
 
@@ -131,6 +134,16 @@ BOOST_FIXTURE_TEST_CASE( testWheelFrameResetAnchor, TrackFixture )
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE( testSnapshotRejectsIntervalSensors, TrackSystemCircleFixture )
+{
+	std::shared_ptr<IntervalSensor> pSensor = IntervalSensor::Make();
+	BOOST_REQUIRE( pSensor );
+	m_pTrack1->Attach( pSensor, TrackLocation{ m_pTrack1->GetLength()/2 } );
+
+	std::vector<unsigned char> buffer;
+	BOOST_CHECK_THROW( WriteSnapshot( *m_pTrackSystem, buffer ), std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END() //trax_tests
 #endif
\ No newline at end of file